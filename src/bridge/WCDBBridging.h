@@ -26,6 +26,7 @@
 #include "DatabaseBridge.h"
 #include "ErrorBridge.h"
 #include "FTSBridge.h"
+#include "HandleBlobBridge.h"
 #include "HandleBridge.h"
 #include "HandleStatementBridge.h"
 
@@ -0,0 +1,109 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "HandleBlobBridge.h"
+#include "AbstractHandle.hpp"
+#include "HandleBlob.hpp"
+#include "ObjectBridge.hpp"
+
+CPPError WCDBHandleBlobGetError(CPPHandleBlob handleBlob)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, CPPError());
+    WCDB::AbstractHandle* cppHandle = cppHandleBlob->getHandle();
+    if (!cppHandle) {
+        return CPPError();
+    }
+    const WCDB::Error& error = cppHandle->getError();
+    return WCDBCreateUnmanagedCPPObject(CPPError, &error);
+}
+
+bool WCDBHandleBlobOpen(CPPHandleBlob handleBlob,
+                        const char* _Nullable schema,
+                        const char* _Nonnull table,
+                        const char* _Nonnull column,
+                        signed long long rowid,
+                        bool writable)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, false);
+    return cppHandleBlob->open(schema != nullptr ? WCDB::Schema(schema) : WCDB::Schema::main(),
+                               WCDB::UnsafeStringView(table),
+                               WCDB::UnsafeStringView(column),
+                               rowid,
+                               writable);
+}
+
+bool WCDBHandleBlobReopen(CPPHandleBlob handleBlob, signed long long rowid)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, false);
+    return cppHandleBlob->reopen(rowid);
+}
+
+bool WCDBHandleBlobIsOpened(CPPHandleBlob handleBlob)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, false);
+    return cppHandleBlob->isOpened();
+}
+
+void WCDBHandleBlobClose(CPPHandleBlob handleBlob)
+{
+    WCDBGetObjectOrReturn(handleBlob, WCDB::HandleBlob, cppHandleBlob);
+    cppHandleBlob->close();
+}
+
+int WCDBHandleBlobGetSize(CPPHandleBlob handleBlob)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, 0);
+    return cppHandleBlob->getSize();
+}
+
+bool WCDBHandleBlobRead(CPPHandleBlob handleBlob, unsigned char* _Nonnull buffer, int length, int offset)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, false);
+    return cppHandleBlob->read(buffer, length, offset);
+}
+
+bool WCDBHandleBlobWrite(CPPHandleBlob handleBlob,
+                         const unsigned char* _Nonnull buffer,
+                         int length,
+                         int offset)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, false);
+    return cppHandleBlob->write(WCDB::UnsafeData::immutable(buffer, length), offset);
+}
+
+bool WCDBHandleBlobStreamRead(CPPHandleBlob handleBlob,
+                              bool decompress,
+                              void* _Nullable context,
+                              WCDBBlobChunkCallback _Nonnull callback)
+{
+    WCDBGetObjectOrReturnValue(handleBlob, WCDB::HandleBlob, cppHandleBlob, false);
+    auto onChunk = [=](const WCDB::UnsafeData& chunk) {
+        return callback(context, chunk.buffer(), chunk.size());
+    };
+    if (decompress) {
+        return cppHandleBlob->streamReadDecompressed(onChunk);
+    }
+    return cppHandleBlob->streamRead(onChunk);
+}
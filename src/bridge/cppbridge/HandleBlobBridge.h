@@ -0,0 +1,64 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include "ErrorBridge.h"
+#include "ObjectBridge.h"
+
+WCDB_EXTERN_C_BEGIN
+
+WCDBDefineCPPBridgedType(CPPHandleBlob)
+
+CPPError WCDBHandleBlobGetError(CPPHandleBlob handleBlob);
+
+bool WCDBHandleBlobOpen(CPPHandleBlob handleBlob,
+                        const char* _Nullable schema,
+                        const char* _Nonnull table,
+                        const char* _Nonnull column,
+                        signed long long rowid,
+                        bool writable);
+bool WCDBHandleBlobReopen(CPPHandleBlob handleBlob, signed long long rowid);
+bool WCDBHandleBlobIsOpened(CPPHandleBlob handleBlob);
+void WCDBHandleBlobClose(CPPHandleBlob handleBlob);
+
+int WCDBHandleBlobGetSize(CPPHandleBlob handleBlob);
+bool WCDBHandleBlobRead(CPPHandleBlob handleBlob,
+                        unsigned char* _Nonnull buffer,
+                        int length,
+                        int offset);
+bool WCDBHandleBlobWrite(CPPHandleBlob handleBlob,
+                         const unsigned char* _Nonnull buffer,
+                         int length,
+                         int offset);
+
+typedef bool (*WCDBBlobChunkCallback)(void* _Nullable context,
+                                      const unsigned char* _Nonnull buffer,
+                                      unsigned long long length);
+bool WCDBHandleBlobStreamRead(CPPHandleBlob handleBlob,
+                              bool decompress,
+                              void* _Nullable context,
+                              WCDBBlobChunkCallback _Nonnull callback);
+
+WCDB_EXTERN_C_END
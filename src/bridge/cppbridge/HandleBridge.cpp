@@ -72,12 +72,35 @@ WCDBHandleGetOrCreatePreparedSQL(CPPHandle handle, const char* _Nonnull sql)
     return WCDBCreateUnmanagedCPPObject(CPPHandleStatement, stmt);
 }
 
+CPPHandleStatement WCDBHandleGetOrCreatePreparedEncodedStatement(
+CPPHandle handle, const unsigned char* _Nonnull encodedStatement, long size)
+{
+    WCDBGetObjectOrReturnValue(handle, WCDB::InnerHandle, cppHandle, CPPHandleStatement());
+    WCDB::HandleStatement* stmt = cppHandle->getOrCreatePreparedEncodedStatement(
+    WCDB::UnsafeData::immutable(encodedStatement, size));
+    return WCDBCreateUnmanagedCPPObject(CPPHandleStatement, stmt);
+}
+
 void WCDBHandleFinalizeStatements(CPPHandle handle)
 {
     WCDBGetObjectOrReturn(handle, WCDB::InnerHandle, cppHandle);
     cppHandle->finalizeStatements();
 }
 
+CPPHandleBlob WCDBHandleGetBlob(CPPHandle handle)
+{
+    WCDBGetObjectOrReturnValue(handle, WCDB::InnerHandle, cppHandle, CPPHandleBlob());
+    WCDB::HandleBlob* blob = cppHandle->getBlob();
+    return WCDBCreateUnmanagedCPPObject(CPPHandleBlob, blob);
+}
+
+void WCDBHandleReturnBlob(CPPHandle handle, CPPHandleBlob handleBlob)
+{
+    WCDBGetObjectOrReturn(handle, WCDB::InnerHandle, cppHandle);
+    WCDBGetObjectOrReturn(handleBlob, WCDB::HandleBlob, cppHandleBlob);
+    cppHandle->returnBlob(cppHandleBlob);
+}
+
 bool WCDBHandleExecute(CPPHandle handle, CPPObject* statement)
 {
     WCDBGetObjectOrReturnValue(handle, WCDB::InnerHandle, cppHandle, false);
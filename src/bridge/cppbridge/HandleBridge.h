@@ -26,6 +26,7 @@
 #include "ObjectBridge.h"
 
 #include "ErrorBridge.h"
+#include "HandleBlobBridge.h"
 #include "HandleStatementBridge.h"
 #include "WinqBridge.h"
 
@@ -41,7 +42,12 @@ CPPHandleStatement
 WCDBHandleGetOrCreatePreparedStatement(CPPHandle handle, CPPObject* _Nonnull statement);
 CPPHandleStatement
 WCDBHandleGetOrCreatePreparedSQL(CPPHandle handle, const char* _Nonnull sql);
+// The statement is encoded as described in StatementEncoding.hpp.
+CPPHandleStatement WCDBHandleGetOrCreatePreparedEncodedStatement(
+CPPHandle handle, const unsigned char* _Nonnull encodedStatement, long size);
 void WCDBHandleFinalizeStatements(CPPHandle handle);
+CPPHandleBlob WCDBHandleGetBlob(CPPHandle handle);
+void WCDBHandleReturnBlob(CPPHandle handle, CPPHandleBlob handleBlob);
 bool WCDBHandleExecute(CPPHandle handle, CPPObject* _Nonnull statement);
 bool WCDBHandleExecuteSQL(CPPHandle handle, const char* _Nonnull sql);
 OptionalBool WCDBHandleExistTable(CPPHandle handle, const char* _Nonnull tableName);
@@ -24,9 +24,27 @@
 
 #include "HandleStatementBridge.h"
 #include "AbstractHandle.hpp"
+#include "Assertion.hpp"
 #include "HandleStatement.hpp"
 #include "ObjectBridge.hpp"
 #include "UnsafeData.hpp"
+#include <cstring>
+
+static WCDBColumnValueType WCDBColumnValueTypeFromColumnType(WCDB::Syntax::ColumnType type)
+{
+    switch (type) {
+    case WCDB::Syntax::ColumnType::Integer:
+        return WCDBColumnValueTypeInterger;
+    case WCDB::Syntax::ColumnType::Float:
+        return WCDBColumnValueTypeFloat;
+    case WCDB::Syntax::ColumnType::BLOB:
+        return WCDBColumnValueTypeBLOB;
+    case WCDB::Syntax::ColumnType::Text:
+        return WCDBColumnValueTypeString;
+    case WCDB::Syntax::ColumnType::Null:
+        return WCDBColumnValueTypeNull;
+    }
+}
 
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement)
 {
@@ -140,6 +158,40 @@ void WCDBHandleStatementBindNull(CPPHandleStatement handleStatement, int index)
     cppHandleStatement->bindNull(index);
 }
 
+void WCDBHandleStatementBindPackedRow(CPPHandleStatement handleStatement,
+                                      const CPPPackedRows* _Nonnull rows,
+                                      int rowIndex)
+{
+    WCDBGetObjectOrReturn(handleStatement, WCDB::HandleStatement, cppHandleStatement);
+    WCTRemedialAssert(rowIndex >= 0 && rowIndex < rows->rowCapacity, "Row index out of range.", return;);
+    const WCDBColumnValueType* types = rows->types + rowIndex * rows->columnCount;
+    const CPPPackedCell* cells = rows->cells + rowIndex * rows->columnCount;
+    for (int i = 0; i < rows->columnCount; i++) {
+        switch (types[i]) {
+        case WCDBColumnValueTypeInterger:
+            cppHandleStatement->bindInteger(cells[i].intValue, i + 1);
+            break;
+        case WCDBColumnValueTypeFloat:
+            cppHandleStatement->bindDouble(cells[i].doubleValue, i + 1);
+            break;
+        case WCDBColumnValueTypeString:
+            cppHandleStatement->bindText(
+            WCDB::UnsafeStringView((const char*) rows->arena + cells[i].offset,
+                                   (size_t) cells[i].size),
+            i + 1);
+            break;
+        case WCDBColumnValueTypeBLOB:
+            cppHandleStatement->bindBLOB(
+            WCDB::UnsafeData::immutable(rows->arena + cells[i].offset, (size_t) cells[i].size),
+            i + 1);
+            break;
+        case WCDBColumnValueTypeNull:
+            cppHandleStatement->bindNull(i + 1);
+            break;
+        }
+    }
+}
+
 int WCDBHandleStatementBindParameterIndex(CPPHandleStatement handleStatement,
                                           const char* parameterName)
 {
@@ -153,18 +205,7 @@ WCDBHandleStatementGetColumnType(CPPHandleStatement handleStatement, int index)
 {
     WCDBGetObjectOrReturnValue(
     handleStatement, WCDB::HandleStatement, cppHandleStatement, WCDBColumnValueTypeNull);
-    switch (cppHandleStatement->getType(index)) {
-    case WCDB::Syntax::ColumnType::Integer:
-        return WCDBColumnValueTypeInterger;
-    case WCDB::Syntax::ColumnType::Float:
-        return WCDBColumnValueTypeFloat;
-    case WCDB::Syntax::ColumnType::BLOB:
-        return WCDBColumnValueTypeBLOB;
-    case WCDB::Syntax::ColumnType::Text:
-        return WCDBColumnValueTypeString;
-    case WCDB::Syntax::ColumnType::Null:
-        return WCDBColumnValueTypeNull;
-    }
+    return WCDBColumnValueTypeFromColumnType(cppHandleStatement->getType(index));
 }
 
 signed long long WCDBHandleStatementGetInteger(CPPHandleStatement handleStatement, int index)
@@ -254,3 +295,84 @@ bool WCDBHandleStatementIsReadOnly(CPPHandleStatement handleStatement)
     handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
     return cppHandleStatement->isReadOnly();
 }
+
+static bool
+WCDBHandleStatementFillPackedRow(WCDB::HandleStatement* handleStatement, CPPPackedRows* rows, int rowIndex)
+{
+    WCDBColumnValueType* types = rows->types + rowIndex * rows->columnCount;
+    CPPPackedCell* cells = rows->cells + rowIndex * rows->columnCount;
+    unsigned long long requiredSize = 0;
+    for (int i = 0; i < rows->columnCount; i++) {
+        types[i] = WCDBColumnValueTypeFromColumnType(handleStatement->getType(i));
+        if (types[i] == WCDBColumnValueTypeString) {
+            requiredSize += handleStatement->getColumnSize(i) + 1;
+        } else if (types[i] == WCDBColumnValueTypeBLOB) {
+            requiredSize += handleStatement->getColumnSize(i);
+        }
+    }
+    if (rows->arenaSize + requiredSize > rows->arenaCapacity) {
+        if (rows->arenaSize == 0) {
+            rows->arenaSize = requiredSize;
+        }
+        return false;
+    }
+    for (int i = 0; i < rows->columnCount; i++) {
+        switch (types[i]) {
+        case WCDBColumnValueTypeInterger:
+            cells[i].intValue = handleStatement->getInteger(i);
+            break;
+        case WCDBColumnValueTypeFloat:
+            cells[i].doubleValue = handleStatement->getDouble(i);
+            break;
+        case WCDBColumnValueTypeString: {
+            WCDB::UnsafeStringView text = handleStatement->getText(i);
+            cells[i].offset = rows->arenaSize;
+            cells[i].size = text.length();
+            if (text.length() > 0) {
+                memcpy(rows->arena + rows->arenaSize, text.data(), text.length());
+            }
+            rows->arena[rows->arenaSize + text.length()] = '\0';
+            rows->arenaSize += text.length() + 1;
+        } break;
+        case WCDBColumnValueTypeBLOB: {
+            const WCDB::UnsafeData blob = handleStatement->getBLOB(i);
+            cells[i].offset = rows->arenaSize;
+            cells[i].size = blob.size();
+            if (blob.size() > 0) {
+                memcpy(rows->arena + rows->arenaSize, blob.buffer(), blob.size());
+            }
+            rows->arenaSize += blob.size();
+        } break;
+        case WCDBColumnValueTypeNull:
+            cells[i].intValue = 0;
+            cells[i].size = 0;
+            break;
+        }
+    }
+    return true;
+}
+
+int WCDBHandleStatementFetchPackedRows(CPPHandleStatement handleStatement,
+                                       CPPPackedRows* _Nonnull rows,
+                                       bool* _Nonnull succeed)
+{
+    *succeed = false;
+    WCDBGetObjectOrReturnValue(handleStatement, WCDB::HandleStatement, cppHandleStatement, 0);
+    WCTRemedialAssert(rows->columnCount <= cppHandleStatement->getNumberOfColumns(),
+                      "Column count of rows exceeds the one of statement.",
+                      return 0;);
+    *succeed = true;
+    rows->arenaSize = 0;
+    int fetched = 0;
+    while (fetched < rows->rowCapacity && !cppHandleStatement->done()) {
+        if (!WCDBHandleStatementFillPackedRow(cppHandleStatement, rows, fetched)) {
+            break;
+        }
+        ++fetched;
+        if (!cppHandleStatement->step()) {
+            *succeed = false;
+            break;
+        }
+    }
+    return fetched;
+}
@@ -39,6 +39,31 @@ enum WCDBColumnValueType {
     WCDBColumnValueTypeNull,
 };
 
+typedef struct CPPPackedCell {
+    union {
+        signed long long intValue;
+        double doubleValue;
+        // Offset of text or blob in the arena.
+        unsigned long long offset;
+    };
+    // Byte size of text or blob, excluding the null terminator of text.
+    unsigned long long size;
+} CPPPackedCell;
+
+typedef struct CPPPackedRows {
+    int columnCount;
+    int rowCapacity;
+    // Row-major arrays with rowCapacity * columnCount elements.
+    enum WCDBColumnValueType* _Nonnull types;
+    CPPPackedCell* _Nonnull cells;
+    // Contents of text and blob. Each text is followed by a null terminator.
+    unsigned char* _Nullable arena;
+    unsigned long long arenaCapacity;
+    // Bytes used in arena.
+    // If the current row can't be filled into an empty arena, it is set to the bytes required by that row.
+    unsigned long long arenaSize;
+} CPPPackedRows;
+
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement);
 
 bool WCDBHandleStatementPrepare(CPPHandleStatement handleStatement,
@@ -69,6 +94,11 @@ void WCDBHandleStatementBindBlob(CPPHandleStatement handleStatement,
                                  unsigned long long buffLength);
 void WCDBHandleStatementBindNull(CPPHandleStatement handleStatement, int index);
 
+// Bind the cells of row at rowIndex to the parameters from 1 to columnCount.
+void WCDBHandleStatementBindPackedRow(CPPHandleStatement handleStatement,
+                                      const CPPPackedRows* _Nonnull rows,
+                                      int rowIndex);
+
 int WCDBHandleStatementBindParameterIndex(CPPHandleStatement handleStatement,
                                           const char* _Nullable parameterName);
 
@@ -96,4 +126,14 @@ const char* _Nullable WCDBHandleStatementGetColumnTableName(CPPHandleStatement h
 
 bool WCDBHandleStatementIsReadOnly(CPPHandleStatement handleStatement);
 
+/*
+ Copy the current row into rows and step, until the statement is done, rowCapacity rows are copied or the arena is full.
+ The statement should have been stepped once before the first call.
+ It returns the number of copied rows. The row which can't be filled into arena keeps current.
+ If stepping fails, succeed is set to false and the error can be got by WCDBHandleStatementGetError. The rows copied before the failure are still returned.
+ */
+int WCDBHandleStatementFetchPackedRows(CPPHandleStatement handleStatement,
+                                       CPPPackedRows* _Nonnull rows,
+                                       bool* _Nonnull succeed);
+
 WCDB_EXTERN_C_END
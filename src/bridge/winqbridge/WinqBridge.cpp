@@ -30,6 +30,7 @@
 #include "SQL.hpp"
 #include "Schema.hpp"
 #include "Statement.hpp"
+#include "StatementEncoding.hpp"
 #include "TableOrSubquery.hpp"
 
 const char* _Nonnull WCDBWinqGetDescription(CPPObject* statement)
@@ -44,6 +45,16 @@ bool WCDBStatementNeedToWrite(CPPObject* _Nonnull statement)
     return innerValue->isWriteStatement();
 }
 
+CPPObject* _Nullable WCDBStatementCreateFromEncoded(const unsigned char* _Nonnull data, long size)
+{
+    auto statement
+    = WCDB::StatementEncoding::decode(WCDB::UnsafeData::immutable(data, size));
+    if (!statement.hasValue()) {
+        return nullptr;
+    }
+    return WCDB::ObjectBridge::copyCPPObject(std::move(statement.value()));
+}
+
 namespace WCDB {
 
 Order WinqBridge::changeOrder(enum WCDBSyntaxOrder order)
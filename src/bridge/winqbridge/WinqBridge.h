@@ -91,6 +91,9 @@ enum WCDBSyntaxTransactionType {
 
 bool WCDBStatementNeedToWrite(CPPObject* _Nonnull statement);
 
+// Decode a statement built in one buffer as described in StatementEncoding.hpp. Null is returned for malformed data.
+CPPObject* _Nullable WCDBStatementCreateFromEncoded(const unsigned char* _Nonnull data, long size);
+
 WCDBDefineCPPBridgedType(CPPBindParameter);
 WCDBDefineCPPBridgedType(CPPColumn);
 WCDBDefineCPPBridgedType(CPPColumnConstraint);
@@ -29,6 +29,7 @@
 #include "Notifier.hpp"
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #ifndef _WIN32
 #include <sys/mman.h>
 #else
@@ -373,6 +374,24 @@ const size_t &FileHandle::memoryPageSize()
     return s_memoryPageSize;
 }
 
+#pragma mark - Read Ahead
+void FileHandle::adviseWillNeed(offset_t offset, size_t length)
+{
+    WCTAssert(isOpened());
+    WCTAssert(length > 0);
+#if defined(__APPLE__)
+    struct radvisory advisory;
+    advisory.ra_offset = offset;
+    advisory.ra_count = (int) std::min<size_t>(length, INT_MAX);
+    fcntl(m_fd, F_RDADVISE, &advisory);
+#elif defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(m_fd, offset, length, POSIX_FADV_WILLNEED);
+#else
+    WCDB_UNUSED(offset);
+    WCDB_UNUSED(length);
+#endif
+}
+
 #pragma mark - Error
 void FileHandle::markErrorAsIgnorable(bool flag)
 {
@@ -79,6 +79,11 @@ public:
 protected:
     static const size_t &memoryPageSize();
 
+#pragma mark - Read Ahead
+public:
+    // Hint the system to read the range into page cache asynchronously. It's a no-op where unsupported.
+    void adviseWillNeed(offset_t offset, size_t length);
+
 #pragma mark - Error
 public:
     void markErrorAsIgnorable(bool flag = true);
@@ -78,6 +78,17 @@ public:
 
     bool exists(const Key& key) const { return m_map.find(key) != m_map.end(); }
 
+    bool erase(const Key& key)
+    {
+        auto it = m_map.find(key);
+        if (it == m_map.end()) {
+            return false;
+        }
+        m_list.erase(it->second);
+        m_map.erase(it);
+        return true;
+    }
+
     size_t size() const { return m_map.size(); }
 
     bool empty() const { return m_map.empty(); }
@@ -27,6 +27,7 @@
 #include "Macro.h"
 #include "SysTypes.h"
 #include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -266,5 +267,15 @@ public:
 
 } // namespace WCDB
 
+namespace std {
+template<>
+struct hash<WCDB::StringView> {
+    size_t operator()(const WCDB::StringView& string) const
+    {
+        return string.hash();
+    }
+};
+} // namespace std
+
 WCDB_API std::ostream&
 operator<<(std::ostream& stream, const WCDB::UnsafeStringView& string);
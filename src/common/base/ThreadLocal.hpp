@@ -45,6 +45,16 @@ protected:
         new std::map<Identifier, T>());
         return *s_storage;
     }
+    struct Cache {
+        Identifier identifier;
+        T* value;
+    };
+    // The last hit of current thread. Since nodes of the storage are never erased, it keeps valid during the thread lifetime.
+    static Cache& threadedCache()
+    {
+        thread_local Cache s_cache = { 0, nullptr };
+        return s_cache;
+    }
 };
 
 template<typename T>
@@ -52,6 +62,7 @@ class ThreadLocal : public UntypedThreadLocal<T> {
 public:
     using UntypedThreadLocal<T>::nextIdentifier;
     using UntypedThreadLocal<T>::threadedStorage;
+    using UntypedThreadLocal<T>::threadedCache;
     using Identifier = typename UntypedThreadLocal<T>::Identifier;
     ThreadLocal(const typename std::enable_if<std::is_default_constructible<T>::value>::type* = nullptr)
     : m_identifier(nextIdentifier()), m_default()
@@ -70,12 +81,18 @@ public:
 
     T& getOrCreate()
     {
+        auto& cache = threadedCache();
+        if (cache.identifier == m_identifier) {
+            return *cache.value;
+        }
         auto& storage = threadedStorage();
         auto iter = storage.find(m_identifier);
         if (iter == storage.end()) {
             iter = storage.emplace(m_identifier, m_default).first;
         }
-        return *(&iter->second);
+        cache.identifier = m_identifier;
+        cache.value = &iter->second;
+        return *cache.value;
     }
 
 private:
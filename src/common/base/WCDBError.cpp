@@ -217,7 +217,8 @@ void Error::setCode(Code code, const UnsafeStringView& message)
 {
     m_code = code;
     if (message.empty()) {
-        m_message = UnsafeStringView(codeName(code));
+        // Code names are literals, which can be referred without copying.
+        m_message = StringView::makeConstant(codeName(code));
     } else {
         m_message = message;
     }
@@ -269,7 +270,13 @@ void Error::setWinSystemCode(int systemCode, Code code, const UnsafeStringView&
 void Error::setSQLiteCode(int rc, const UnsafeStringView& message)
 {
     Code code = rc2c(rc);
-    setCode(code, message.empty() ? sqlite3_errstr(rc) : message);
+    if (message.empty()) {
+        // The message of sqlite3_errstr is static, so it can be referred without copying.
+        m_code = code;
+        m_message = StringView::makeConstant(sqlite3_errstr(rc));
+    } else {
+        setCode(code, message);
+    }
     if (c2rc(code) == rc) {
         infos.erase(ErrorIntKeyExtCode);
     } else {
@@ -31,6 +31,7 @@
 #include "FTSConst.h"
 #include "FileManager.hpp"
 #include "Global.hpp"
+#include "MemoryGovernor.hpp"
 #include "Notifier.hpp"
 #include "OneOrBinaryTokenizer.hpp"
 #include "PinyinTokenizer.hpp"
@@ -52,6 +53,7 @@ Core::Core()
 // Database
 : m_databasePool(this)
 , m_scalarFunctionModules(std::make_shared<ScalarFunctionModules>())
+, m_aggregateFunctionModules(std::make_shared<AggregateFunctionModules>())
 , m_tokenizerModules(std::make_shared<TokenizerModules>())
 , m_auxiliaryFunctionModules(std::make_shared<AuxiliaryFunctionModules>())
 , m_operationQueue(std::make_shared<OperationQueue>(OperationQueueName, this))
@@ -130,6 +132,10 @@ void Core::purgeDatabasePool()
 void Core::releaseSQLiteMemory(int bytes)
 {
     sqlite3_release_memory(bytes);
+    // Mapped pages are not counted by sqlite, which are released by closing the idle handles.
+    if (MmapConfig::suspendForMemoryPressure()) {
+        purgeDatabasePool();
+    }
 }
 
 void Core::setSoftHeapLimit(int64_t limit)
@@ -213,6 +219,25 @@ std::shared_ptr<Config> Core::scalarFunctionConfig(const UnsafeStringView& scala
     return std::make_shared<ScalarFunctionConfig>(scalarFunctionName, m_scalarFunctionModules);
 }
 
+#pragma mark - AggregateFunction
+void Core::registerAggregateFunction(const UnsafeStringView& name,
+                                     const AggregateFunctionModule& module)
+{
+    m_aggregateFunctionModules->add(name, module);
+}
+
+bool Core::aggregateFunctionExists(const UnsafeStringView& name) const
+{
+    return m_aggregateFunctionModules->get(name) != nullptr;
+}
+
+std::shared_ptr<Config>
+Core::aggregateFunctionConfig(const UnsafeStringView& aggregateFunctionName)
+{
+    return std::make_shared<AggregateFunctionConfig>(aggregateFunctionName,
+                                                     m_aggregateFunctionModules);
+}
+
 #pragma mark - Tokenizer
 void Core::registerTokenizer(const UnsafeStringView& name, const TokenizerModule& module)
 {
@@ -224,6 +249,11 @@ bool Core::tokenizerExists(const UnsafeStringView& name) const
     return m_tokenizerModules->get(name) != nullptr;
 }
 
+const TokenizerModule* Core::getTokenizer(const UnsafeStringView& name) const
+{
+    return m_tokenizerModules->get(name);
+}
+
 std::shared_ptr<Config> Core::tokenizerConfig(const UnsafeStringView& tokenizeName)
 {
     return std::make_shared<TokenizerConfig>(tokenizeName, m_tokenizerModules);
@@ -280,8 +310,9 @@ void Core::backupShouldBeOperated(const UnsafeStringView& path)
 void Core::checkpointShouldBeOperated(const UnsafeStringView& path)
 {
     RecyclableDatabase database = m_databasePool.getOrCreate(path);
-    if (database != nullptr) {
-        database->checkpoint(true);
+    if (database != nullptr && !database->checkpoint(true) && database->hasLiveSnapshot()) {
+        // Retry later since there may be no more writes to trigger it after the snapshots are released.
+        m_operationQueue->asyncCheckpoint(path);
     }
 }
 
@@ -306,6 +337,21 @@ void Core::purgeShouldBeOperated()
     purgeDatabasePool();
 }
 
+void Core::handlePoolShouldBeAdjusted(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getOrCreate(path);
+    if (database != nullptr) {
+        database->adjustHandlePool();
+    }
+}
+
+bool Core::memoryShouldBeRebalanced()
+{
+    MemoryGovernor& governor = MemoryGovernor::shared();
+    governor.rebalance();
+    return governor.isEnabled();
+}
+
 void Core::stopAllDatabaseEvent(const UnsafeStringView& path)
 {
     m_operationQueue->stopAllDatabaseEvent(path);
@@ -355,6 +401,21 @@ void Core::setNotificationWhenDatabaseCorrupted(const UnsafeStringView& path,
     m_operationQueue->setNotificationWhenCorrupted(path, underlyingNotification);
 }
 
+#pragma mark - Handle Pool
+void Core::asyncAdjustHandlePool(const UnsafeStringView& path, double delay)
+{
+    m_operationQueue->asyncAdjustHandlePool(path, delay);
+}
+
+#pragma mark - Memory Governor
+void Core::setPageCacheBudget(int64_t budget)
+{
+    MemoryGovernor::shared().setBudget(budget);
+    if (budget > 0) {
+        m_operationQueue->asyncRebalanceMemory();
+    }
+}
+
 #pragma mark - Checkpoint
 void Core::enableAutoCheckpoint(InnerDatabase* database, bool enable)
 {
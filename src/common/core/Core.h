@@ -36,6 +36,7 @@
 #include "Config.hpp"
 #include "Configs.hpp"
 #include "CustomConfig.hpp"
+#include "MmapConfig.hpp"
 #include "PerformanceTraceConfig.hpp"
 #include "SQLTraceConfig.hpp"
 #include "TokenizerConfig.hpp"
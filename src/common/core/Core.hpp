@@ -33,6 +33,7 @@
 
 #include "DatabasePool.hpp"
 
+#include "AggregateFunctionConfig.hpp"
 #include "AuxiliaryFunctionConfig.hpp"
 #include "ScalarFunctionConfig.hpp"
 #include "TokenizerModules.hpp"
@@ -87,11 +88,23 @@ public:
 protected:
     std::shared_ptr<ScalarFunctionModules> m_scalarFunctionModules;
 
+#pragma mark - AggregateFunction
+public:
+    void registerAggregateFunction(const UnsafeStringView& name,
+                                   const AggregateFunctionModule& module);
+    std::shared_ptr<Config>
+    aggregateFunctionConfig(const UnsafeStringView& aggregateFunctionName);
+    bool aggregateFunctionExists(const UnsafeStringView& name) const;
+
+protected:
+    std::shared_ptr<AggregateFunctionModules> m_aggregateFunctionModules;
+
 #pragma mark - Tokenizer
 public:
     void registerTokenizer(const UnsafeStringView& name, const TokenizerModule& module);
     std::shared_ptr<Config> tokenizerConfig(const UnsafeStringView& tokenizeName);
     bool tokenizerExists(const UnsafeStringView& name) const;
+    const TokenizerModule* getTokenizer(const UnsafeStringView& name) const;
 
 protected:
     std::shared_ptr<TokenizerModules> m_tokenizerModules;
@@ -122,9 +135,20 @@ protected:
     void checkpointShouldBeOperated(const UnsafeStringView& path) override final;
     void integrityShouldBeChecked(const UnsafeStringView& path) override final;
     void purgeShouldBeOperated() override final;
+    void handlePoolShouldBeAdjusted(const UnsafeStringView& path) override final;
+    bool memoryShouldBeRebalanced() override final;
 
     std::shared_ptr<OperationQueue> m_operationQueue;
 
+#pragma mark - Handle Pool
+public:
+    void asyncAdjustHandlePool(const UnsafeStringView& path, double delay);
+
+#pragma mark - Memory Governor
+public:
+    // See `MemoryGovernor`. 0 means disabled.
+    void setPageCacheBudget(int64_t budget);
+
 #pragma mark - Checkpoint
 public:
     void enableAutoCheckpoint(InnerDatabase* database, bool enable);
@@ -26,6 +26,8 @@
 
 namespace WCDB {
 
+WCDBLiteralStringImplement(WorkerPoolName);
+
 WCDBLiteralStringImplement(OperationQueueName);
 
 WCDBLiteralStringImplement(AutoCheckpointConfigName);
@@ -40,6 +42,8 @@ WCDBLiteralStringImplement(AutoMergeFTSIndexConfigName);
 
 WCDBLiteralStringImplement(AutoMergeFTSIndexQueueName);
 
+WCDBLiteralStringImplement(FTS5BulkBuildRecordTable);
+
 WCDBLiteralStringImplement(BasicConfigName);
 
 WCDBLiteralStringImplement(BusyRetryConfigName);
@@ -60,6 +64,8 @@ WCDBLiteralStringImplement(AuxiliaryFunctionConfigPrefix);
 
 WCDBLiteralStringImplement(ScalarFunctionConfigPrefix);
 
+WCDBLiteralStringImplement(AggregateFunctionConfigPrefix);
+
 WCDBLiteralStringImplement(NotifierPreprocessorName);
 
 WCDBLiteralStringImplement(NotifierLoggerName);
@@ -32,6 +32,10 @@ namespace WCDB {
 #pragma mark - Async Queue
 static constexpr const double AsyncQueueTimeOutForExiting = 10.0;
 
+#pragma mark - Worker Pool
+WCDBLiteralStringDefine(WorkerPoolName, "WCDB.Worker");
+static constexpr const size_t WorkerPoolMaxNumberOfWorkers = 4;
+
 #pragma mark - Operation Queue
 WCDBLiteralStringDefine(OperationQueueName, "WCDB.Operation");
 static constexpr double OperationQueueTimeIntervalForRetringAfterFailure = 5.0;
@@ -46,6 +50,8 @@ static constexpr const double OperationQueueTimeIntervalForPurgingAgain = 30.0;
 static constexpr const double OperationQueueRateForTooManyFileDescriptors = 0.7;
 #pragma mark - Operation Queue - Checkpoint
 static constexpr const double OperationQueueTimeIntervalForCheckpoint = 10.0;
+// Auto checkpoint stops waiting for live snapshots after being postponed this many times in a row.
+static constexpr const int OperationQueueMaxPostponedTimesForCheckpoint = 60;
 #pragma mark - Operation Queue - Backup
 #ifndef WCDB_QUICK_TESTS
 static double OperationQueueTimeIntervalForBackup = 600.0;
@@ -70,6 +76,15 @@ WCDBLiteralStringDefine(AutoMergeFTSIndexQueueName, "WCDB.MergeIndex");
 static constexpr const int AutoMergeFTS5IndexMinSegmentCount = 4;
 static constexpr const double AutoMergeFTSIndexMaxExpectingDuration = 0.02;
 static constexpr const double AutoMergeFTSIndexMaxInitializeDuration = 0.005;
+#pragma mark - FTS5 Bulk Build
+// Defaults of fts5, which are restored when the options are not set before bulk building.
+static constexpr const int FTS5DefaultAutoMerge = 4;
+static constexpr const int FTS5DefaultCrisisMerge = 16;
+static constexpr const int FTS5DefaultPageSize = 4050;
+static constexpr const int FTS5BulkBuildCrisisMerge = 64;
+static constexpr const int FTS5BulkBuildMaxTokenizeWorkers = 4;
+static constexpr const int FTS5BulkBuildRowsPerTokenizeSlice = 256;
+WCDBLiteralStringDefine(FTS5BulkBuildRecordTable, "wcdb_builtin_fts5_bulk_build_record");
 #pragma mark - Config - Basic
 WCDBLiteralStringDefine(BasicConfigName, "com.Tencent.WCDB.Config.Basic");
 static constexpr const int BasicConfigBusyRetryMaxAllowedNumberOfTimes = 3;
@@ -78,6 +93,10 @@ WCDBLiteralStringDefine(BusyRetryConfigName, "com.Tencent.WCDB.Config.BusyRetry"
 static constexpr const double BusyRetryTimeOut = 10.0;
 #pragma mark - Config - Cipher
 WCDBLiteralStringDefine(CipherConfigName, "com.Tencent.WCDB.Config.Cipher");
+#pragma mark - Config - Mmap
+WCDBLiteralStringDefine(MmapConfigName, "com.Tencent.WCDB.Config.Mmap");
+// Memory-mapped I/O is not used by new handles for a while after memory pressure.
+static constexpr const double MmapConfigSuspendingTimeAfterMemoryPressure = 30.0;
 #pragma mark - Config - Global SQL Trace
 WCDBLiteralStringDefine(GlobalSQLTraceConfigName, "com.Tencent.WCDB.Config.GlobalSQLTrace");
 #pragma mark - Config - Global Performance Trace
@@ -91,6 +110,9 @@ WCDBLiteralStringDefine(SQLTraceConfigName, "com.Tencent.WCDB.Config.SQLTrace");
 WCDBLiteralStringDefine(TokenizeConfigPrefix, "com.Tencent.WCDB.Config.Tokenize.");
 #pragma mark - Config - ScalarFunction
 WCDBLiteralStringDefine(ScalarFunctionConfigPrefix, "com.Tencent.WCDB.Config.ScalarFunction.");
+#pragma mark - Config - AggregateFunction
+WCDBLiteralStringDefine(AggregateFunctionConfigPrefix,
+                        "com.Tencent.WCDB.Config.AggregateFunction.");
 #pragma mark - Config - AuxiliaryFunction
 WCDBLiteralStringDefine(AuxiliaryFunctionConfigPrefix,
                         "com.Tencent.WCDB.Config.AuxiliaryFunction.");
@@ -102,6 +124,31 @@ WCDBLiteralStringDefine(NotifierLoggerName, "com.Tencent.WCDB.Notifier.Log");
 #pragma mark - Handle Pool
 static constexpr const int HandlePoolMaxAllowedNumberOfHandles = 32;
 static constexpr const int HandlePoolMaxAllowedNumberOfWriters = 4;
+// A waiting thread is promoted by one priority level for every interval it has waited.
+static constexpr const double HandlePoolPriorityAgingInterval = 0.5;
+// Spare handles are opened in background once the ratio of handles in use reaches it.
+static constexpr const double HandlePoolElasticGrowthThreshold = 0.75;
+// Idle handles beyond the minimum are closed after being idle for it.
+static constexpr const double HandlePoolElasticIdleTimeout = 30.0;
+// The rate of statement allocations is measured in windows of it.
+static constexpr const double HandlePoolStatementRateWindow = 1.0;
+
+#pragma mark - Memory Governor
+// The default page cache size of sqlite in KiB.
+static constexpr const int HandleDefaultCacheSize = 2000;
+// The page cache of a governed handle never shrinks below it in KiB.
+static constexpr const int MemoryGovernorMinCacheSize = 128;
+static constexpr const double MemoryGovernorTimeIntervalForRebalance = 10.0;
+// The hits and misses are decayed by it in each rebalance, so the share follows the recent accesses.
+static constexpr const double MemoryGovernorDecayRate = 0.5;
+
+#pragma mark - Statement Warmup
+// Number of the most frequently prepared statements that are prepared ahead in a new handle.
+static constexpr const int StatementWarmupCount = 8;
+// Statements prepared less than this are not worth warming up.
+static constexpr const int StatementWarmupMinPreparedCount = 2;
+// All counts are halved once the number of recorded statements exceeds it, so that the stale ones fade out.
+static constexpr const int StatementWarmupMaxRecordCount = 128;
 
 enum HandleSlot : unsigned char {
     HandleSlotNormal = 0,
@@ -140,6 +187,7 @@ enum class HandleType : unsigned int {
     AssembleBackupWrite = (HandleCategoryBackupWrite << 8) | HandleSlotAssemble,
     Vacuum = (HandleCategoryNormal << 8) | HandleSlotVacuum,
     MergeIndex = (HandleCategoryMergeIndex << 8) | HandleSlotAutoTask,
+    BackupDestination = (HandleCategoryBackupWrite << 8) | HandleSlotVacuum,
 };
 static constexpr HandleSlot slotOfHandleType(HandleType type)
 {
@@ -154,10 +202,20 @@ static constexpr bool handleShouldWaitWhenFull(HandleType type)
     return type == HandleType::Normal;
 }
 
+enum HandlePriority : unsigned char {
+    HandlePriorityInteractive = 0,
+    HandlePriorityNormal,
+    HandlePriorityBackground,
+    HandlePriorityCount,
+};
+
 #pragma mark - Backup
 static constexpr const int BackupMaxIncrementalTimes = 1000;
 static constexpr const int BackupMaxIncrementalPageCount = 1000;
 static constexpr const int BackupMaxAllowIncrementalPageCount = 1000000;
+static constexpr const int BackupBusyRetryMaxTimes = 200;
+static constexpr const int BackupBusyRetryMinSleepMS = 1;
+static constexpr const int BackupBusyRetryMaxSleepMS = 50;
 
 #pragma mark - Migrate
 static constexpr const double MigrateMaxExpectingDuration = 0.01;
@@ -166,10 +224,25 @@ static constexpr const double MigrateMaxInitializeDuration = 0.005;
 #pragma mark - Compression
 static constexpr const int CompressionBatchCount = 100;
 static constexpr const int CompressionUpdateRecordBatchCount = 1000;
+static constexpr const int CompressionLevelSampleCount = 32;
+static constexpr const double CompressionLevelMinGain = 0.01;
+static constexpr const int CompressionBulkDecompressionBatchCount = 256;
+static constexpr const int CompressionParallelDecompressionSize = 4 * 1024 * 1024;
+static constexpr const int CompressionMaxDecompressionWorkers = 4;
 
 #pragma mark - Vacuum
 static constexpr const int VacuumBatchCount = 1000;
 
+#pragma mark - Decorated Statement
+static constexpr const int RewrittenStatementCacheCapacity = 64;
+// Max number of returned statements kept by a handle for reusing.
+static constexpr const int HandleStatementFreeListCapacity = 16;
+// Max number of encoded statements mapped to the prepared statements of a handle.
+static constexpr const int HandleEncodedStatementCacheCapacity = 64;
+
+#pragma mark - Blob
+static constexpr const int BlobStreamChunkSize = 64 * 1024;
+
 WCDBLiteralStringDefine(ErrorStringKeyType, "Type");
 WCDBLiteralStringDefine(ErrorStringKeySource, "Source")
 
@@ -28,66 +28,169 @@
 
 namespace WCDB {
 
-HandleCounter::HandleCounter() : m_writerCount(0), m_totalCount(0)
+HandleCounter::HandleCounter()
+: m_maxAllowedNumberOfHandles(HandlePoolMaxAllowedNumberOfHandles)
+, m_maxAllowedNumberOfWriters(HandlePoolMaxAllowedNumberOfWriters)
+, m_writerCount(0)
+, m_totalCount(0)
 {
 }
 
-HandleCounter::~HandleCounter() = default;
+HandleCounter::~HandleCounter()
+{
+    WCTRemedialAssert(m_waiters.empty(), "Handle counter is released with pending waiters.", ;);
+}
 
-bool HandleCounter::tryIncreaseHandleCount(HandleType type, bool writeHint)
+bool HandleCounter::tryIncreaseHandleCount(HandleType type,
+                                           bool writeHint,
+                                           HandlePriority priority,
+                                           double timeout)
 {
+    WCTAssert(priority < HandlePriorityCount);
     std::unique_lock<std::mutex> lockGuard(m_lock);
-    while (m_totalCount >= HandlePoolMaxAllowedNumberOfHandles
-           || (writeHint && m_writerCount >= HandlePoolMaxAllowedNumberOfWriters)) {
-        while (m_totalCount >= HandlePoolMaxAllowedNumberOfHandles) {
-            if (!handleShouldWaitWhenFull(type)) {
-                return false;
+    // Waiters are always granted as soon as quota is available, so there is no one to queue behind here.
+    if (isAvailable(writeHint)) {
+        increaseHandleCount(writeHint);
+        ++m_statistics[priority].acquiredCount;
+        return true;
+    }
+    if (!handleShouldWaitWhenFull(type)) {
+        return false;
+    }
+
+    Waiter waiter(priority, writeHint);
+    m_waiters.push_back(&waiter);
+    if (timeout > 0) {
+        SteadyClock deadline = waiter.enqueueTime.steadyClockByAddingTimeInterval(timeout);
+        while (!waiter.granted) {
+            double remaining = deadline.timeIntervalSinceNow();
+            if (remaining <= 0 || !waiter.conditional.wait_for(lockGuard, remaining)) {
+                break;
             }
-            m_pendingNormals.emplace(Thread::current());
-            m_conditionalNormals.wait(lockGuard);
-            m_pendingNormals.pop();
         }
-        while (writeHint && m_writerCount >= HandlePoolMaxAllowedNumberOfWriters) {
-            if (!handleShouldWaitWhenFull(type)) {
-                return false;
-            }
-            m_pendingWriters.emplace(Thread::current());
-            m_conditionalWriters.wait(lockGuard);
-            m_pendingWriters.pop();
+    } else {
+        while (!waiter.granted) {
+            waiter.conditional.wait(lockGuard);
         }
     }
-    if (writeHint) {
-        m_writerCount++;
+    if (!waiter.granted) {
+        // Timed out. The quota is only transferred along with the `granted` flag, so nothing to return here.
+        m_waiters.remove(&waiter);
     }
-    m_totalCount++;
-    return true;
+    recordWaiting(waiter, waiter.granted);
+    return waiter.granted;
 }
 
 void HandleCounter::decreaseHandleCount(bool writeHint)
 {
-    bool hasNotified = false;
     std::unique_lock<std::mutex> lockGuard(m_lock);
     if (writeHint) {
         m_writerCount--;
         WCTAssert(m_writerCount >= 0);
-        if (m_pendingWriters.size() > 0) {
-#ifdef __APPLE__
-            m_conditionalWriters.notify(m_pendingWriters.front());
-#else
-            m_conditionalWriters.notify_all();
-#endif
-            hasNotified = true;
-        }
     }
     m_totalCount--;
     WCTAssert(m_totalCount >= 0);
-    if (!hasNotified && m_pendingNormals.size() > 0) {
-#ifdef __APPLE__
-        m_conditionalNormals.notify(m_pendingNormals.front());
-#else
-        m_conditionalNormals.notify_all();
-#endif
+    grantWaiters();
+}
+
+void HandleCounter::setMaxAllowedNumberOfHandles(int maxAllowedNumberOfHandles,
+                                                 int maxAllowedNumberOfWriters)
+{
+    WCTRemedialAssert(maxAllowedNumberOfHandles > 0 && maxAllowedNumberOfWriters > 0,
+                      "Max allowed number of handles must be positive.",
+                      return;);
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    m_maxAllowedNumberOfHandles = maxAllowedNumberOfHandles;
+    m_maxAllowedNumberOfWriters = std::min(maxAllowedNumberOfWriters, maxAllowedNumberOfHandles);
+    grantWaiters();
+}
+
+int HandleCounter::getMaxAllowedNumberOfHandles() const
+{
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    return m_maxAllowedNumberOfHandles;
+}
+
+int HandleCounter::getMaxAllowedNumberOfWriters() const
+{
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    return m_maxAllowedNumberOfWriters;
+}
+
+HandleCounter::WaitingStatistic HandleCounter::getWaitingStatistic(HandlePriority priority) const
+{
+    WCTAssert(priority < HandlePriorityCount);
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    return m_statistics[priority];
+}
+
+bool HandleCounter::isAvailable(bool writeHint) const
+{
+    return m_totalCount < m_maxAllowedNumberOfHandles
+           && (!writeHint || m_writerCount < m_maxAllowedNumberOfWriters);
+}
+
+void HandleCounter::increaseHandleCount(bool writeHint)
+{
+    if (writeHint) {
+        m_writerCount++;
+    }
+    m_totalCount++;
+}
+
+void HandleCounter::grantWaiters()
+{
+    SteadyClock now = SteadyClock::now();
+    while (!m_waiters.empty()) {
+        auto chosen = m_waiters.end();
+        double chosenLevel = 0;
+        for (auto iter = m_waiters.begin(); iter != m_waiters.end(); ++iter) {
+            const Waiter *waiter = *iter;
+            if (!isAvailable(waiter->writeHint)) {
+                continue;
+            }
+            double level = (double) waiter->priority
+                           - now.timeIntervalSinceSteadyClock(waiter->enqueueTime)
+                             / HandlePoolPriorityAgingInterval;
+            // Strictly less keeps FIFO order for waiters of the same level.
+            if (chosen == m_waiters.end() || level < chosenLevel) {
+                chosen = iter;
+                chosenLevel = level;
+            }
+        }
+        if (chosen == m_waiters.end()) {
+            break;
+        }
+        Waiter *waiter = *chosen;
+        m_waiters.erase(chosen);
+        increaseHandleCount(waiter->writeHint);
+        waiter->granted = true;
+        waiter->conditional.notify_one();
+    }
+}
+
+void HandleCounter::recordWaiting(const Waiter &waiter, bool granted)
+{
+    double waitingTime = SteadyClock::timeIntervalSinceSteadyClockToNow(waiter.enqueueTime);
+    WaitingStatistic &statistic = m_statistics[waiter.priority];
+    if (granted) {
+        ++statistic.acquiredCount;
+    } else {
+        ++statistic.timeoutCount;
     }
+    ++statistic.waitedCount;
+    statistic.totalWaitingTime += waitingTime;
+    statistic.maxWaitingTime = std::max(statistic.maxWaitingTime, waitingTime);
+}
+
+HandleCounter::WaitingStatistic::WaitingStatistic()
+: acquiredCount(0), waitedCount(0), timeoutCount(0), totalWaitingTime(0), maxWaitingTime(0)
+{
+}
+
+HandleCounter::Waiter::Waiter(HandlePriority priority_, bool writeHint_)
+: priority(priority_), writeHint(writeHint_), enqueueTime(SteadyClock::now()), granted(false)
+{
 }
 
 } // namespace WCDB
@@ -22,9 +22,13 @@
  * limitations under the License.
  */
 
+#pragma once
+
 #include "CoreConst.h"
 #include "Lock.hpp"
-#include "Thread.hpp"
+#include "Time.hpp"
+#include <array>
+#include <list>
 
 namespace WCDB {
 
@@ -33,15 +37,20 @@ namespace WCDB {
  * this handle will be used to write new data to the database.
  *
  * The handle counter is used to limit the number of handles in two ways:
- * 1. Only 4 handles can exist for writing at the same time.
+ * 1. Only 4 handles can exist for writing at the same time by default.
  *    Because it is difficult to accurately distinguish whether the handle is used for writing,
  *    and there is still a little time between getting the handle and writing data,
  *    let the four handles fully compete.
- * 2. Only up to 32 handles can exist at the same time.
+ * 2. Only up to 32 handles can exist at the same time by default.
  *    Too many handles not only take up memory, but generally imply inappropriate usage.
  *
  * When the number limit is exceeded, the handle counter will let the thread
  * that acquires the handle wait in place until other handles are recycled.
+ *
+ * Waiting threads are served by priority. To prevent starvation, a waiting thread is
+ * promoted by one priority level every `HandlePoolPriorityAgingInterval` seconds,
+ * and threads of the same effective priority are served in FIFO order.
+ * The recycled quota is handed to the chosen thread directly so that newcomers can't barge in.
  */
 
 class HandleCounter {
@@ -51,15 +60,48 @@ public:
     HandleCounter(const HandleCounter &) = delete;
     HandleCounter &operator=(const HandleCounter &) = delete;
 
-    bool tryIncreaseHandleCount(HandleType type, bool writeHint);
+    // timeout <= 0 means waiting until a handle is available.
+    bool tryIncreaseHandleCount(HandleType type,
+                                bool writeHint,
+                                HandlePriority priority = HandlePriorityNormal,
+                                double timeout = 0);
     void decreaseHandleCount(bool writeHint);
 
+    void setMaxAllowedNumberOfHandles(int maxAllowedNumberOfHandles,
+                                      int maxAllowedNumberOfWriters);
+    int getMaxAllowedNumberOfHandles() const;
+    int getMaxAllowedNumberOfWriters() const;
+
+    struct WaitingStatistic {
+        WaitingStatistic();
+        uint64_t acquiredCount;
+        uint64_t waitedCount;
+        uint64_t timeoutCount;
+        double totalWaitingTime;
+        double maxWaitingTime;
+    };
+    WaitingStatistic getWaitingStatistic(HandlePriority priority) const;
+
 private:
+    struct Waiter {
+        Waiter(HandlePriority priority, bool writeHint);
+        const HandlePriority priority;
+        const bool writeHint;
+        const SteadyClock enqueueTime;
+        bool granted;
+        Conditional conditional;
+    };
+
+    bool isAvailable(bool writeHint) const;
+    void increaseHandleCount(bool writeHint);
+    void grantWaiters();
+    void recordWaiting(const Waiter &waiter, bool granted);
+
     mutable std::mutex m_lock;
-    Conditional m_conditionalNormals;
-    Conditional m_conditionalWriters;
-    std::queue<Thread> m_pendingNormals;
-    std::queue<Thread> m_pendingWriters;
+    std::list<Waiter *> m_waiters;
+    std::array<WaitingStatistic, HandlePriorityCount> m_statistics;
+    int m_maxAllowedNumberOfHandles;
+    int m_maxAllowedNumberOfWriters;
     int m_writerCount = 0;
     int m_totalCount = 0;
 };
@@ -51,7 +51,7 @@ bool HandlePool::isNumberOfHandlesAllowed() const
 {
     WCTAssert(m_concurrency.readSafety());
     WCTAssert(m_memory.readSafety());
-    return numberOfAliveHandles() <= HandlePoolMaxAllowedNumberOfHandles;
+    return numberOfAliveHandles() <= (size_t) m_counter.getMaxAllowedNumberOfHandles();
 }
 
 void HandlePool::blockade()
@@ -115,9 +115,9 @@ void HandlePool::purge()
     for (unsigned int i = 0; i < HandleSlotCount; ++i) {
         auto &handles = m_handles[i];
         auto &frees = m_frees[i];
-        for (const auto &handle : frees) {
-            handle->close();
-            handles.erase(handle);
+        for (const auto &idle : frees) {
+            idle.handle->close();
+            handles.erase(idle.handle);
         }
         frees.clear();
     }
@@ -167,7 +167,8 @@ size_t HandlePool::numberOfAliveHandlesInSlot(HandleSlot slot) const
     return m_handles[slot].size();
 }
 
-RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
+RecyclableHandle
+HandlePool::flowOut(HandleType type, bool writeHint, HandlePriority priority, double timeout)
 {
     HandleSlot slot = slotOfHandleType(type);
     WCTAssert(slot < HandleSlotCount);
@@ -188,11 +189,14 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
         }
     }
 
-    if (!m_counter.tryIncreaseHandleCount(type, writeHint)) {
+    if (!m_counter.tryIncreaseHandleCount(type, writeHint, priority, timeout)) {
         Error error(Error::Code::Exceed,
                     Error::Level::Error,
                     "The operating count of database exceeds the maximum allowed.");
-        error.infos.insert_or_assign("MaxAllowed", HandlePoolMaxAllowedNumberOfHandles);
+        error.infos.insert_or_assign("MaxAllowed", m_counter.getMaxAllowedNumberOfHandles());
+        if (timeout > 0 && handleShouldWaitWhenFull(type)) {
+            error.infos.insert_or_assign("Timeout", timeout);
+        }
         error.infos.insert_or_assign(ErrorStringKeyPath, path);
         Notifier::shared().notify(error);
         setThreadedError(std::move(error));
@@ -205,27 +209,50 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
         LockGuard memoryGuard(m_memory);
         auto &freeSlot = m_frees[slot];
         if (!freeSlot.empty()) {
-            handle = freeSlot.back();
+            handle = freeSlot.back().handle;
             WCTAssert(handle != nullptr);
             freeSlot.pop_back();
+            ++m_elastics[slot].statistic.hitCount;
+        } else {
+            ++m_elastics[slot].statistic.missCount;
         }
     }
 
     if (handle == nullptr) {
-        handle = generateSlotedHandle(type);
+        handle = generateSlotedHandleWithStatistic(type);
         if (handle == nullptr) {
             m_counter.decreaseHandleCount(writeHint);
             return nullptr;
         }
 
-        LockGuard memoryGuard(m_memory);
-        WCTAssert(m_handles[slot].find(handle) == m_handles[slot].end());
-        m_handles[slot].emplace(handle);
+        bool allowed = true;
+        {
+            LockGuard memoryGuard(m_memory);
+            WCTAssert(m_handles[slot].find(handle) == m_handles[slot].end());
+            m_handles[slot].emplace(handle);
 
-        // Clean free handles of the other slots.
-        if (!isNumberOfHandlesAllowed()) {
-            purge();
-            WCTAssert(isNumberOfHandlesAllowed());
+            // Clean free handles of the other slots.
+            if (!isNumberOfHandlesAllowed()) {
+                purge();
+                // The limit may be lowered below the number of handles in use, which can't be purged.
+                allowed = isNumberOfHandlesAllowed();
+                if (!allowed) {
+                    m_handles[slot].erase(handle);
+                }
+            }
+        }
+        if (!allowed) {
+            handle->close();
+            m_counter.decreaseHandleCount(writeHint);
+            Error error(Error::Code::Exceed,
+                        Error::Level::Error,
+                        "The number of alive handles exceeds the maximum allowed.");
+            error.infos.insert_or_assign("MaxAllowed",
+                                         m_counter.getMaxAllowedNumberOfHandles());
+            error.infos.insert_or_assign(ErrorStringKeyPath, path);
+            Notifier::shared().notify(error);
+            setThreadedError(std::move(error));
+            return nullptr;
         }
     } else {
         if (!willReuseSlotedHandle(type, handle.get())) {
@@ -248,6 +275,15 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
     WCTAssert(referencedHandle.handle == nullptr && referencedHandle.reference == 0);
     referencedHandle.handle = handle;
     referencedHandle.reference = 1;
+
+    bool shouldGrow = false;
+    {
+        SharedLockGuard memoryGuard(m_memory);
+        shouldGrow = numberOfSpareHandlesToOpen(slot) > 0;
+    }
+    if (shouldGrow) {
+        elasticSlotsShouldBeAdjusted(0);
+    }
     return RecyclableHandle(
     handle, std::bind(&HandlePool::flowBack, this, type, std::placeholders::_1));
 }
@@ -273,14 +309,247 @@ void HandlePool::flowBack(HandleType type, const std::shared_ptr<InnerHandle> &h
         !handle->isPrepared(), "Statement is not finalized.", handle->finalize(););
         handle->detachCancellationSignal();
         handle->finalizeStatements();
+        bool shouldShrink = false;
+        double idleTimeout = 0;
         {
             LockGuard memoryGuard(m_memory);
-            m_frees[slot].push_back(handle);
+            collectStatementCounts(slot, handle.get());
+            m_frees[slot].emplace_back(handle);
             handle->setWriteHint(false);
             handle->setActiveThreadId(0);
+            const ElasticPolicy &policy = m_elastics[slot].policy;
+            idleTimeout = policy.idleTimeout;
+            shouldShrink = policy.minIdleHandles > 0 && idleTimeout > 0
+                           && m_frees[slot].size() > (size_t) policy.minIdleHandles;
         }
         m_concurrency.unlockShared();
         m_counter.decreaseHandleCount(writeHint);
+        if (shouldShrink) {
+            elasticSlotsShouldBeAdjusted(idleTimeout);
+        }
+    }
+}
+
+HandlePool::IdleHandle::IdleHandle(const std::shared_ptr<InnerHandle> &handle_)
+: handle(handle_), idleSince(SteadyClock::now())
+{
+}
+
+#pragma mark - Limitation
+void HandlePool::setMaxAllowedNumberOfHandles(int maxAllowedNumberOfHandles,
+                                              int maxAllowedNumberOfWriters)
+{
+    m_counter.setMaxAllowedNumberOfHandles(maxAllowedNumberOfHandles, maxAllowedNumberOfWriters);
+}
+
+HandlePool::HandleWaitingStatistic
+HandlePool::getHandleWaitingStatistic(HandlePriority priority) const
+{
+    return m_counter.getWaitingStatistic(priority);
+}
+
+#pragma mark - Elastic
+HandlePool::ElasticPolicy::ElasticPolicy()
+: minIdleHandles(0)
+, growthThreshold(HandlePoolElasticGrowthThreshold)
+, idleTimeout(HandlePoolElasticIdleTimeout)
+{
+}
+
+HandlePool::ElasticStatistic::ElasticStatistic()
+: hitCount(0)
+, missCount(0)
+, preopenedCount(0)
+, shrunkCount(0)
+, openedCount(0)
+, totalOpeningTime(0)
+, maxOpeningTime(0)
+{
+}
+
+HandlePool::Elastic::Elastic() : type(HandleType::Normal)
+{
+}
+
+void HandlePool::setElasticPolicy(HandleType type, const ElasticPolicy &policy)
+{
+    WCTRemedialAssert(policy.growthThreshold > 0 && policy.growthThreshold <= 1,
+                      "Growth threshold must be in (0, 1].",
+                      return;);
+    HandleSlot slot = slotOfHandleType(type);
+    WCTAssert(slot < HandleSlotCount);
+    {
+        LockGuard memoryGuard(m_memory);
+        Elastic &elastic = m_elastics[slot];
+        elastic.type = type;
+        elastic.policy = policy;
+    }
+    elasticSlotsShouldBeAdjusted(0);
+}
+
+HandlePool::ElasticPolicy HandlePool::getElasticPolicy(HandleSlot slot) const
+{
+    WCTAssert(slot < HandleSlotCount);
+    SharedLockGuard memoryGuard(m_memory);
+    return m_elastics[slot].policy;
+}
+
+HandlePool::ElasticStatistic HandlePool::getElasticStatistic(HandleSlot slot) const
+{
+    WCTAssert(slot < HandleSlotCount);
+    SharedLockGuard memoryGuard(m_memory);
+    return m_elastics[slot].statistic;
+}
+
+void HandlePool::elasticSlotsShouldBeAdjusted(double delay)
+{
+    WCDB_UNUSED(delay);
+}
+
+void HandlePool::didPreopenSlotedHandle(HandleType type, InnerHandle *handle)
+{
+    WCDB_UNUSED(type);
+    WCDB_UNUSED(handle);
+}
+
+std::shared_ptr<InnerHandle> HandlePool::generateSlotedHandleWithStatistic(HandleType type)
+{
+    SteadyClock start = SteadyClock::now();
+    std::shared_ptr<InnerHandle> handle = generateSlotedHandle(type);
+    if (handle != nullptr) {
+        double cost = SteadyClock::timeIntervalSinceSteadyClockToNow(start);
+        LockGuard memoryGuard(m_memory);
+        ElasticStatistic &statistic = m_elastics[slotOfHandleType(type)].statistic;
+        ++statistic.openedCount;
+        statistic.totalOpeningTime += cost;
+        statistic.maxOpeningTime = std::max(statistic.maxOpeningTime, cost);
+    }
+    return handle;
+}
+
+size_t HandlePool::numberOfSpareHandlesToOpen(HandleSlot slot) const
+{
+    WCTAssert(m_memory.readSafety());
+    const ElasticPolicy &policy = m_elastics[slot].policy;
+    const auto &handles = m_handles[slot];
+    if (policy.minIdleHandles <= 0 || handles.empty()) {
+        // Handles are never opened for a slot not in use, or it will keep the closed database alive.
+        return 0;
+    }
+    size_t numberOfIdles = m_frees[slot].size();
+    size_t numberOfSpares = 0;
+    if (numberOfIdles < (size_t) policy.minIdleHandles) {
+        numberOfSpares = policy.minIdleHandles - numberOfIdles;
+    } else if (handles.size() - numberOfIdles >= policy.growthThreshold * handles.size()) {
+        numberOfSpares = 1;
+    }
+    size_t numberOfAlives = 0;
+    for (const auto &aliveHandles : m_handles) {
+        numberOfAlives += aliveHandles.size();
+    }
+    size_t maxAllowed = m_counter.getMaxAllowedNumberOfHandles();
+    return numberOfAlives < maxAllowed ? std::min(numberOfSpares, maxAllowed - numberOfAlives) : 0;
+}
+
+double HandlePool::shrinkElasticSlot(HandleSlot slot)
+{
+    WCTAssert(m_concurrency.readSafety());
+    LockGuard memoryGuard(m_memory);
+    const ElasticPolicy &policy = m_elastics[slot].policy;
+    if (policy.minIdleHandles <= 0 || policy.idleTimeout <= 0) {
+        return 0;
+    }
+    auto &frees = m_frees[slot];
+    while (frees.size() > (size_t) policy.minIdleHandles) {
+        // The least recently idle handle is at the front.
+        double remaining = policy.idleTimeout
+                           - SteadyClock::timeIntervalSinceSteadyClockToNow(frees.front().idleSince);
+        if (remaining > 0) {
+            return remaining;
+        }
+        std::shared_ptr<InnerHandle> handle = frees.front().handle;
+        frees.pop_front();
+        handle->close();
+        m_handles[slot].erase(handle);
+        ++m_elastics[slot].statistic.shrunkCount;
+    }
+    return 0;
+}
+
+void HandlePool::adjustElasticSlots()
+{
+    SharedLockGuard concurrencyGuard(m_concurrency);
+    double nextDelay = 0;
+    for (unsigned int i = 0; i < HandleSlotCount; ++i) {
+        HandleSlot slot = (HandleSlot) i;
+        HandleType type;
+        size_t numberOfSpares;
+        {
+            SharedLockGuard memoryGuard(m_memory);
+            type = m_elastics[slot].type;
+            numberOfSpares = numberOfSpareHandlesToOpen(slot);
+        }
+        for (size_t j = 0; j < numberOfSpares; ++j) {
+            std::shared_ptr<InnerHandle> handle = generateSlotedHandleWithStatistic(type);
+            if (handle == nullptr) {
+                break;
+            }
+            didPreopenSlotedHandle(type, handle.get());
+            LockGuard memoryGuard(m_memory);
+            m_handles[slot].emplace(handle);
+            if (!isNumberOfHandlesAllowed()) {
+                // Other handles are opened synchronously in the meantime.
+                m_handles[slot].erase(handle);
+                handle->close();
+                break;
+            }
+            m_frees[slot].emplace_back(handle);
+            ++m_elastics[slot].statistic.preopenedCount;
+        }
+        double delay = shrinkElasticSlot(slot);
+        if (delay > 0 && (nextDelay == 0 || delay < nextDelay)) {
+            nextDelay = delay;
+        }
+    }
+    if (nextDelay > 0) {
+        elasticSlotsShouldBeAdjusted(nextDelay);
+    }
+}
+
+#pragma mark - Statement Statistic
+HandlePool::StatementStatistic::StatementStatistic()
+: allocatedCount(0), reusedCount(0), allocationsPerSecond(0)
+{
+}
+
+HandlePool::StatementCounter::StatementCounter()
+: windowStart(SteadyClock::now()), windowCount(0)
+{
+}
+
+HandlePool::StatementStatistic HandlePool::getStatementStatistic(HandleSlot slot) const
+{
+    WCTAssert(slot < HandleSlotCount);
+    SharedLockGuard memoryGuard(m_memory);
+    return m_statementCounters[slot].statistic;
+}
+
+void HandlePool::collectStatementCounts(HandleSlot slot, InnerHandle *handle)
+{
+    WCTAssert(m_memory.writeSafety());
+    uint64_t allocatedCount = 0;
+    uint64_t reusedCount = 0;
+    handle->getAndResetStatementCounts(allocatedCount, reusedCount);
+    StatementCounter &counter = m_statementCounters[slot];
+    StatementStatistic &statistic = counter.statistic;
+    statistic.allocatedCount += allocatedCount;
+    statistic.reusedCount += reusedCount;
+    counter.windowCount += allocatedCount;
+    double elapsed = SteadyClock::timeIntervalSinceSteadyClockToNow(counter.windowStart);
+    if (elapsed >= HandlePoolStatementRateWindow) {
+        statistic.allocationsPerSecond = counter.windowCount / elapsed;
+        counter.windowStart = SteadyClock::now();
+        counter.windowCount = 0;
     }
 }
 
@@ -30,6 +30,7 @@
 #include "Lock.hpp"
 #include "RecyclableHandle.hpp"
 #include "ThreadedErrors.hpp"
+#include "Time.hpp"
 #include <array>
 #include <list>
 
@@ -77,7 +78,10 @@ private:
 #pragma mark - Handle
 public:
     typedef unsigned int Slot;
-    RecyclableHandle flowOut(HandleType type, bool writeHint = false);
+    RecyclableHandle flowOut(HandleType type,
+                             bool writeHint = false,
+                             HandlePriority priority = HandlePriorityNormal,
+                             double timeout = 0);
     void purge();
     size_t numberOfAliveHandles() const;
     size_t numberOfAliveHandlesInSlot(HandleSlot slot) const;
@@ -92,11 +96,107 @@ protected:
 
     std::array<std::set<std::shared_ptr<InnerHandle>>, HandleSlotCount> m_handles;
 
+#pragma mark - Limitation
+public:
+    void setMaxAllowedNumberOfHandles(int maxAllowedNumberOfHandles,
+                                      int maxAllowedNumberOfWriters);
+    typedef HandleCounter::WaitingStatistic HandleWaitingStatistic;
+    HandleWaitingStatistic getHandleWaitingStatistic(HandlePriority priority) const;
+
 private:
     void flowBack(HandleType type, const std::shared_ptr<InnerHandle> &handle);
-    std::array<std::list<std::shared_ptr<InnerHandle>>, HandleSlotCount> m_frees;
+    struct IdleHandle {
+        IdleHandle(const std::shared_ptr<InnerHandle> &handle);
+        std::shared_ptr<InnerHandle> handle;
+        SteadyClock idleSince;
+    };
+    typedef struct IdleHandle IdleHandle;
+    // The most recently idle handle is at the back.
+    std::array<std::list<IdleHandle>, HandleSlotCount> m_frees;
     HandleCounter m_counter;
 
+#pragma mark - Elastic
+public:
+    /*
+     * An elastic slot keeps some fully configured handles idle,
+     * so that the bursts of traffic don't pay for opening handles synchronously.
+     * Spare handles are opened in background and the long idle ones are closed.
+     */
+    struct ElasticPolicy {
+        ElasticPolicy();
+        // 0 means the slot is not elastic.
+        int minIdleHandles;
+        // One more spare handle is opened once the ratio of handles in use reaches it.
+        double growthThreshold;
+        // Idle handles beyond the minimum are closed after being idle for it. 0 means never.
+        double idleTimeout;
+    };
+    typedef struct ElasticPolicy ElasticPolicy;
+    void setElasticPolicy(HandleType type, const ElasticPolicy &policy);
+    ElasticPolicy getElasticPolicy(HandleSlot slot) const;
+
+    struct ElasticStatistic {
+        ElasticStatistic();
+        uint64_t hitCount;  // served by idle handles
+        uint64_t missCount; // opened synchronously
+        uint64_t preopenedCount;
+        uint64_t shrunkCount;
+        uint64_t openedCount;
+        double totalOpeningTime;
+        double maxOpeningTime;
+    };
+    typedef struct ElasticStatistic ElasticStatistic;
+    ElasticStatistic getElasticStatistic(HandleSlot slot) const;
+
+    // Open the spare handles and close the expired idle handles of all elastic slots.
+    void adjustElasticSlots();
+
+protected:
+    // Called when the elastic slots should be adjusted after delay, which is usually done in background.
+    virtual void elasticSlotsShouldBeAdjusted(double delay);
+    // Called in background before the spare handle is put into the idle ones.
+    virtual void didPreopenSlotedHandle(HandleType type, InnerHandle *handle);
+
+private:
+    std::shared_ptr<InnerHandle> generateSlotedHandleWithStatistic(HandleType type);
+    size_t numberOfSpareHandlesToOpen(HandleSlot slot) const;
+    double shrinkElasticSlot(HandleSlot slot);
+
+    struct Elastic {
+        Elastic();
+        HandleType type;
+        ElasticPolicy policy;
+        ElasticStatistic statistic;
+    };
+    typedef struct Elastic Elastic;
+    std::array<Elastic, HandleSlotCount> m_elastics;
+
+#pragma mark - Statement Statistic
+public:
+    struct StatementStatistic {
+        StatementStatistic();
+        // Decorated statements allocated newly and reused from the free lists of handles.
+        uint64_t allocatedCount;
+        uint64_t reusedCount;
+        // Measured in the last completed window.
+        double allocationsPerSecond;
+    };
+    typedef struct StatementStatistic StatementStatistic;
+    StatementStatistic getStatementStatistic(HandleSlot slot) const;
+
+private:
+    // Collect the counts of statements when the handle flows back.
+    void collectStatementCounts(HandleSlot slot, InnerHandle *handle);
+
+    struct StatementCounter {
+        StatementCounter();
+        StatementStatistic statistic;
+        SteadyClock windowStart;
+        uint64_t windowCount;
+    };
+    typedef struct StatementCounter StatementCounter;
+    std::array<StatementCounter, HandleSlotCount> m_statementCounters;
+
 #pragma mark - Threaded
 private:
     struct ReferencedHandle {
@@ -49,6 +49,8 @@
 #include "SQLite.h"
 
 #include <ctime>
+#include <random>
+#include <thread>
 
 namespace WCDB {
 
@@ -58,6 +60,7 @@ InnerDatabase::InnerDatabase(const UnsafeStringView &path)
 , m_initialized(false)
 , m_closing(0)
 , m_tag(Tag::invalid())
+, m_statementWarmup(path)
 , m_fullSQLTrace(false)
 , m_autoCheckpoint(true)
 , m_factory(path)
@@ -66,6 +69,8 @@ InnerDatabase::InnerDatabase(const UnsafeStringView &path)
 , m_migratedCallback(nullptr)
 , m_compression(this)
 , m_compressedCallback(nullptr)
+, m_liveSnapshots(std::make_shared<std::atomic<int>>(0))
+, m_postponedCheckpoints(0)
 , m_isInMemory(false)
 , m_sharedInMemoryHandle(nullptr)
 , m_mergeLogic(this)
@@ -107,6 +112,8 @@ void InnerDatabase::didDrain()
     WCTAssert(m_memory.writeSafety());
     WCTAssert(!isOpened());
     m_initialized = false;
+    m_schemaCache.purge();
+    MemoryGovernor::shared().removeDatabase(getPath());
 }
 
 bool InnerDatabase::checkShouldInterruptWhenClosing(const UnsafeStringView &sourceType)
@@ -136,6 +143,7 @@ void InnerDatabase::close(const ClosedCallback &onClosed)
         return;
     }
     ++m_closing;
+    m_statementWarmup.save();
     {
         SharedLockGuard concurrencyGuard(m_concurrency);
         SharedLockGuard memoryGuard(m_memory);
@@ -266,7 +274,8 @@ RecyclableHandle InnerDatabase::getHandle(bool writeHint)
     if (!initializedGuard.valid()) {
         return nullptr;
     }
-    handle = flowOut(type, writeHint);
+    const HandleAcquisition &acquisition = m_threadedAcquisitions.getOrCreate();
+    handle = flowOut(type, writeHint, acquisition.priority, acquisition.timeout);
     if (handle != nullptr) {
         handle->configTransactionEvent(this);
     }
@@ -375,6 +384,10 @@ bool InnerDatabase::setupHandle(HandleType type, InnerHandle *handle)
                               || slot == HandleSlotVacuum);
     handle->markAsCanBeSuspended(false);
     handle->markErrorAsUnignorable(99); //Clear all ignorable code
+    // Handles of other slots may work on the files other than this database.
+    handle->setSchemaCache(
+    slot == HandleSlotNormal || slot == HandleSlotAutoTask ? &m_schemaCache : nullptr);
+    handle->setStatementWarmup(type == HandleType::Normal ? &m_statementWarmup : nullptr);
 
     // Decoration
     if (slot == HandleSlotNormal || slot == HandleSlotAutoTask) {
@@ -417,6 +430,11 @@ bool InnerDatabase::setupHandle(HandleType type, InnerHandle *handle)
             setThreadedError(handle->getError());
             return false;
         }
+        if (!hasOpened && type == HandleType::Normal && m_statementWarmup.isEnabled()
+            && handle->hasCipher()) {
+            // The recorded SQLs should not be written in plaintext beside the encrypted database.
+            m_statementWarmup.disablePersistence();
+        }
         if (!hasOpened && slot == HandleSlotNormal) {
             std::time_t openTime
             = (Time::now().nanoseconds() - start.nanoseconds()) / 1000;
@@ -452,9 +470,136 @@ bool InnerDatabase::setupHandle(HandleType type, InnerHandle *handle)
         }
     }
 
+    if (slot == HandleSlotNormal) {
+        tryGovernPageCache(handle);
+    }
     return true;
 }
 
+#pragma mark - Schema Cache
+InnerDatabase::SchemaCacheStatistic InnerDatabase::getSchemaCacheStatistic() const
+{
+    return m_schemaCache.getStatistic();
+}
+
+#pragma mark - Statement Warmup
+void InnerDatabase::enableStatementWarmup(bool enable)
+{
+    if (m_isInMemory) {
+        return;
+    }
+    m_statementWarmup.setEnabled(enable);
+    if (enable && getElasticPolicy(HandleSlotNormal).minIdleHandles <= 0) {
+        // The handles opened synchronously are not warmed up, since the warmed statements would delay the current operation.
+        Error error(Error::Code::Misuse,
+                    Error::Level::Warning,
+                    "Statement warmup only works with the elastic handle pool, which is disabled.");
+        error.infos.insert_or_assign(ErrorStringKeyPath, getPath());
+        Notifier::shared().notify(error);
+    }
+}
+
+bool InnerDatabase::isStatementWarmupEnabled() const
+{
+    return m_statementWarmup.isEnabled();
+}
+
+void InnerDatabase::tryWarmUpStatements(HandleType type, InnerHandle *handle)
+{
+    // Statements are rewritten by the decorators of compression and migration, which can't be prepared from SQL directly.
+    if (type != HandleType::Normal || !m_statementWarmup.isEnabled()
+        || m_compression.shouldCompress() || m_migration.shouldMigrate()) {
+        return;
+    }
+    auto sqls = m_statementWarmup.getStatementsToWarmUp();
+    if (!sqls.empty()) {
+        handle->warmUpStatements(sqls);
+    }
+}
+
+#pragma mark - Memory Governor
+void InnerDatabase::tryGovernPageCache(InnerHandle *handle)
+{
+    MemoryGovernor &governor = MemoryGovernor::shared();
+    // The page cache of in-memory database is the database itself.
+    if (m_isInMemory || (!governor.isEnabled() && handle->getCacheSize() == 0)) {
+        return;
+    }
+    int hits = 0;
+    int misses = 0;
+    if (!handle->getAndResetCacheHitsAndMisses(hits, misses)) {
+        return;
+    }
+    // The handle is not in use, so its cache size can be changed safely.
+    int cacheSize = governor.reportAndGetCacheSize(
+    getPath(), hits, misses, numberOfAliveHandlesInSlot(HandleSlotNormal));
+    handle->setCacheSize(cacheSize);
+}
+
+InnerDatabase::PageCacheStatistic InnerDatabase::getPageCacheStatistic() const
+{
+    return MemoryGovernor::shared().getStatistic(getPath());
+}
+
+#pragma mark - Elastic Handle Pool
+void InnerDatabase::setHandleElasticPolicy(const HandleElasticPolicy &policy)
+{
+    if (m_isInMemory) {
+        return;
+    }
+    setElasticPolicy(HandleType::Normal, policy);
+}
+
+InnerDatabase::HandleElasticStatistic InnerDatabase::getHandleElasticStatistic() const
+{
+    return getElasticStatistic(HandleSlotNormal);
+}
+
+InnerDatabase::HandleStatementStatistic InnerDatabase::getHandleStatementStatistic() const
+{
+    return getStatementStatistic(HandleSlotNormal);
+}
+
+void InnerDatabase::elasticSlotsShouldBeAdjusted(double delay)
+{
+    if (m_isInMemory || m_closing > 0) {
+        return;
+    }
+    Core::shared().asyncAdjustHandlePool(getPath(), delay);
+}
+
+void InnerDatabase::didPreopenSlotedHandle(HandleType type, InnerHandle *handle)
+{
+    tryWarmUpStatements(type, handle);
+}
+
+void InnerDatabase::adjustHandlePool()
+{
+    // Closed database should not be opened by background.
+    if (m_isInMemory || m_closing > 0 || !isOpened()) {
+        return;
+    }
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return;
+    }
+    adjustElasticSlots();
+}
+
+#pragma mark - Handle Priority
+void InnerDatabase::setThreadedHandlePriority(HandlePriority priority, double timeout)
+{
+    WCTRemedialAssert(priority < HandlePriorityCount, "Invalid handle priority.", return;);
+    HandleAcquisition &acquisition = m_threadedAcquisitions.getOrCreate();
+    acquisition.priority = priority;
+    acquisition.timeout = timeout;
+}
+
+InnerDatabase::HandleAcquisition::HandleAcquisition()
+: priority(HandlePriorityNormal), timeout(0)
+{
+}
+
 #pragma mark - Threaded
 void InnerDatabase::markHandleAsTransactioned(InnerHandle *handle)
 {
@@ -607,11 +752,18 @@ std::list<StringView> InnerDatabase::pathsOfDatabase(const UnsafeStringView &dat
         Repair::Factory::firstMaterialPathForDatabase(database),
         Repair::Factory::lastMaterialPathForDatabase(database),
         Repair::Factory::factoryPathForDatabase(database),
+        StatementWarmup::warmupPathForDatabase(database),
         InnerHandle::journalPathOfDatabase(database),
         InnerHandle::shmPathOfDatabase(database),
     };
 }
 
+void InnerDatabase::purge()
+{
+    m_statementWarmup.save();
+    HandlePool::purge();
+}
+
 void InnerDatabase::setInMemory()
 {
     WCTAssert(!m_initialized);
@@ -951,6 +1103,94 @@ bool InnerDatabase::vacuum(const ProgressCallback &onProgressUpdated)
     return result;
 }
 
+bool InnerDatabase::backupTo(const UnsafeStringView &destination,
+                             int pagesPerStep,
+                             double maxBytesPerSecond,
+                             const ProgressCallback &onProgressUpdated)
+{
+    WCTRemedialAssert(
+    !m_isInMemory, "In-memory database can't be backed up online.", return false;);
+    WCTRemedialAssert(pagesPerStep > 0, "Invalid pages per step.", return false;);
+    WCTRemedialAssert(!destination.equal(path),
+                      "Destination of online backup can't be the database itself.",
+                      return false;);
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+    WCTRemedialAssert(
+    !isInTransaction(), "Online backup can't be run in transaction.", return false;);
+
+    RecyclableHandle sourceHandle = flowOut(HandleType::BackupRead);
+    if (sourceHandle == nullptr) {
+        return false;
+    }
+    RecyclableHandle destinationHandle = flowOut(HandleType::BackupDestination);
+    if (destinationHandle == nullptr) {
+        return false;
+    }
+    WCTAssert(sourceHandle.get() != destinationHandle.get());
+    sourceHandle->markAsCanBeSuspended(true);
+
+    Core::shared().setThreadedErrorPath(path);
+    destinationHandle->setPath(destination);
+    if (!destinationHandle->open()) {
+        setThreadedError(destinationHandle->getError());
+        Core::shared().setThreadedErrorPath("");
+        return false;
+    }
+
+    int pageSize = 0;
+    if (maxBytesPerSecond > 0
+        && sourceHandle->prepare(StatementPragma().pragma(Pragma::pageSize()))) {
+        if (sourceHandle->step()) {
+            pageSize = (int) sourceHandle->getInteger();
+        }
+        sourceHandle->finalize();
+    }
+
+    // The read transaction of backup pins the wal like a snapshot does, so auto checkpoint is postponed.
+    ++(*m_liveSnapshots);
+    SteadyClock start = SteadyClock::now();
+    int copiedPages = 0;
+    double lastProgress = 0;
+    bool cancelled = false;
+    bool succeed = sourceHandle->backupTo(
+    *destinationHandle.get(),
+    pagesPerStep,
+    [&](int remainingPages, int totalPages) -> bool {
+        if (checkShouldInterruptWhenClosing(ErrorTypeBackup)) {
+            cancelled = true;
+            return false;
+        }
+        copiedPages = totalPages - remainingPages;
+        if (onProgressUpdated != nullptr && totalPages > 0) {
+            double progress = (double) copiedPages / totalPages;
+            if (!onProgressUpdated(progress, progress - lastProgress)) {
+                cancelled = true;
+                return false;
+            }
+            lastProgress = progress;
+        }
+        if (pageSize > 0 && remainingPages > 0) {
+            double expectedSeconds = (double) copiedPages * pageSize / maxBytesPerSecond;
+            double elapsedSeconds = SteadyClock::timeIntervalSinceSteadyClockToNow(start);
+            if (expectedSeconds > elapsedSeconds) {
+                std::this_thread::sleep_for(
+                std::chrono::microseconds((long long) ((expectedSeconds - elapsedSeconds) * 1E6)));
+            }
+        }
+        return true;
+    });
+    --(*m_liveSnapshots);
+    if (!succeed && !cancelled) {
+        setThreadedError(sourceHandle->getError());
+    }
+    destinationHandle->close();
+    Core::shared().setThreadedErrorPath("");
+    return succeed;
+}
+
 bool InnerDatabase::removeMaterials()
 {
     bool result = false;
@@ -1116,6 +1356,58 @@ bool InnerDatabase::isCompressed() const
     return m_compression.isCompressed();
 }
 
+Optional<Data> InnerDatabase::retrainDict(const UnsafeStringView &table,
+                                          const Column &column,
+                                          DictId currentDictId,
+                                          DictId newDictId,
+                                          const DictRetrainingConfig &config)
+{
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return NullOpt;
+    }
+    WCTRemedialAssert(config.sampleCount > 0, "Sample count can't be zero.", return NullOpt;);
+    RecyclableHandle handle = flowOut(HandleType::Compress);
+    if (handle == nullptr) {
+        return NullOpt;
+    }
+    // Compressed content is decompressed by the decorator of compress handle.
+    if (!handle->prepare(StatementSelect().select(column).from(table))) {
+        setThreadedError(handle->getError());
+        return NullOpt;
+    }
+    std::vector<Data> reservoir;
+    reservoir.reserve(config.sampleCount);
+    std::mt19937_64 random(std::random_device{}());
+    uint64_t visited = 0;
+    bool succeed = false;
+    while ((succeed = handle->step()) && !handle->done()) {
+        if (handle->getColumnType(0) < ColumnType::Text) {
+            continue;
+        }
+        UnsafeData value = handle->getBLOB(0);
+        if (value.empty()) {
+            continue;
+        }
+        ++visited;
+        if (reservoir.size() < config.sampleCount) {
+            reservoir.emplace_back(value);
+        } else {
+            uint64_t index = random() % visited;
+            if (index < config.sampleCount) {
+                reservoir[index] = value;
+            }
+        }
+    }
+    handle->finalize();
+    if (!succeed) {
+        setThreadedError(handle->getError());
+        return NullOpt;
+    }
+    CompressionCenter::Samples samples(reservoir.begin(), reservoir.end());
+    return CompressionCenter::shared().retrainDict(currentDictId, newDictId, samples, config);
+}
+
 #pragma mark - Checkpoint
 bool InnerDatabase::checkpoint(bool interruptible, CheckPointMode mode)
 {
@@ -1123,6 +1415,26 @@ bool InnerDatabase::checkpoint(bool interruptible, CheckPointMode mode)
     if (!initializedGuard.valid()) {
         return false; // mark as succeed if it's not an auto initialize action.
     }
+    if (interruptible && hasLiveSnapshot()) {
+        int postponedTimes = ++m_postponedCheckpoints;
+        if (postponedTimes <= OperationQueueMaxPostponedTimesForCheckpoint) {
+            Error error(Error::Code::Busy, Error::Level::Ignore, "Checkpoint is postponed due to live snapshots.");
+            error.infos.insert_or_assign(ErrorStringKeyPath, path);
+            error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeCheckpoint);
+            Notifier::shared().notify(error);
+            setThreadedError(std::move(error));
+            return false;
+        }
+        // The snapshots may be leaked. Checkpoint anyway, which may invalidate them.
+        Error error(Error::Code::Warning,
+                    Error::Level::Warning,
+                    "Checkpoint is no longer postponed since snapshots live too long.");
+        error.infos.insert_or_assign(ErrorStringKeyPath, path);
+        error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeCheckpoint);
+        error.infos.insert_or_assign("PostponedTimes", postponedTimes - 1);
+        Notifier::shared().notify(error);
+    }
+    m_postponedCheckpoints = 0;
     bool succeed = false;
     RecyclableHandle handle = flowOut(HandleType::Checkpoint);
     if (handle != nullptr) {
@@ -1142,6 +1454,25 @@ bool InnerDatabase::checkpoint(bool interruptible, CheckPointMode mode)
     return succeed;
 }
 
+#pragma mark - Snapshot
+std::shared_ptr<WALSnapshot> InnerDatabase::captureSnapshot()
+{
+    RecyclableHandle handle = getHandle();
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<WALSnapshot> snapshot = handle->captureSnapshot();
+    if (snapshot != nullptr) {
+        snapshot->attachLiveCounter(m_liveSnapshots);
+    }
+    return snapshot;
+}
+
+bool InnerDatabase::hasLiveSnapshot() const
+{
+    return m_liveSnapshots->load() > 0;
+}
+
 #pragma mark - AutoMergeFTSIndex
 
 Optional<bool> InnerDatabase::mergeFTSIndex(TableArray newTables, TableArray modifiedTables)
@@ -1173,4 +1504,28 @@ RecyclableHandle InnerDatabase::getMergeIndexHandle()
     return flowOut(HandleType::MergeIndex);
 }
 
+bool InnerDatabase::beginFTSBulkBuild(const UnsafeStringView &table, const FTSBulkBuildConfig &config)
+{
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+    return m_mergeLogic.beginBulkBuild(table, config);
+}
+
+Optional<InnerDatabase::FTSBulkBuildConfig>
+InnerDatabase::getFTSBulkBuildConfig(const UnsafeStringView &table) const
+{
+    return m_mergeLogic.getBulkBuildConfig(table);
+}
+
+bool InnerDatabase::endFTSBulkBuild(const UnsafeStringView &table)
+{
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+    return m_mergeLogic.endBulkBuild(table);
+}
+
 } //namespace WCDB
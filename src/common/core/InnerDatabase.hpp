@@ -25,9 +25,11 @@
 #pragma once
 
 #include "Compression.hpp"
+#include "CompressionCenter.hpp"
 #include "Configs.hpp"
 #include "Factory.hpp"
 #include "HandlePool.hpp"
+#include "MemoryGovernor.hpp"
 #include "MergeFTSIndexLogic.hpp"
 #include "Migration.hpp"
 #include "Tag.hpp"
@@ -97,6 +99,68 @@ protected:
 private:
     bool setupHandle(HandleType type, InnerHandle *handle);
 
+#pragma mark - Schema Cache
+public:
+    typedef SchemaCache::Statistic SchemaCacheStatistic;
+    SchemaCacheStatistic getSchemaCacheStatistic() const;
+
+private:
+    // Shared by normal handles, and purged once all handles are closed since the files may be replaced.
+    SchemaCache m_schemaCache;
+
+#pragma mark - Statement Warmup
+public:
+    // The most frequently prepared statements are recorded, and prepared ahead in the spare normal handles opened in background.
+    void enableStatementWarmup(bool enable);
+    bool isStatementWarmupEnabled() const;
+
+private:
+    void tryWarmUpStatements(HandleType type, InnerHandle *handle);
+    StatementWarmup m_statementWarmup;
+
+#pragma mark - Memory Governor
+public:
+    typedef MemoryGovernor::Statistic PageCacheStatistic;
+    PageCacheStatistic getPageCacheStatistic() const;
+
+private:
+    // Report the accesses of normal handle and resize its page cache by the global memory governor.
+    void tryGovernPageCache(InnerHandle *handle);
+
+#pragma mark - Elastic Handle Pool
+public:
+    // It only affects the normal handles.
+    typedef HandlePool::ElasticPolicy HandleElasticPolicy;
+    void setHandleElasticPolicy(const HandleElasticPolicy &policy);
+    typedef HandlePool::ElasticStatistic HandleElasticStatistic;
+    HandleElasticStatistic getHandleElasticStatistic() const;
+    typedef HandlePool::StatementStatistic HandleStatementStatistic;
+    HandleStatementStatistic getHandleStatementStatistic() const;
+
+    // Called by the operation queue in background.
+    void adjustHandlePool();
+
+protected:
+    void elasticSlotsShouldBeAdjusted(double delay) override final;
+    // Statements are warmed up on the spare handles, so that it costs nothing for acquiring threads.
+    void didPreopenSlotedHandle(HandleType type, InnerHandle *handle) override final;
+
+#pragma mark - Handle Priority
+public:
+    // It only affects the handles acquired by current thread.
+    void setThreadedHandlePriority(HandlePriority priority, double timeout = 0);
+    using HandlePool::HandleWaitingStatistic;
+    using HandlePool::getHandleWaitingStatistic;
+    using HandlePool::setMaxAllowedNumberOfHandles;
+
+private:
+    struct HandleAcquisition {
+        HandleAcquisition();
+        HandlePriority priority;
+        double timeout;
+    };
+    ThreadLocal<HandleAcquisition> m_threadedAcquisitions;
+
 #pragma mark - Config
 public:
     void setConfigs(const Configs &configs);
@@ -158,6 +222,11 @@ public:
     typedef Repair::FactoryRetriever::ProgressUpdateCallback ProgressCallback;
     double retrieve(const ProgressCallback &onProgressUpdated);
     bool vacuum(const ProgressCallback &onProgressUpdated);
+    // Copy the database to destination page by page without blocking writers. 0 means no limit of bandwidth.
+    bool backupTo(const UnsafeStringView &destination,
+                  int pagesPerStep,
+                  double maxBytesPerSecond,
+                  const ProgressCallback &onProgressUpdated);
 
     void checkIntegrity(bool interruptible);
 
@@ -200,6 +269,16 @@ public:
 
     bool isCompressed() const;
 
+    typedef CompressionCenter::DictId DictId;
+    typedef CompressionCenter::DictRetrainingConfig DictRetrainingConfig;
+    // Reservoir-sample the content of column with a background handle to retrain its dict.
+    // See `CompressionCenter::retrainDict`.
+    Optional<Data> retrainDict(const UnsafeStringView &table,
+                               const Column &column,
+                               DictId currentDictId,
+                               DictId newDictId,
+                               const DictRetrainingConfig &config);
+
 protected:
     void didCompress(const CompressionTableBaseInfo *info) override final;
     Compression m_compression; // thread-safe
@@ -208,11 +287,24 @@ protected:
 #pragma mark - Checkpoint
 public:
     using CheckPointMode = AbstractHandle::CheckpointMode;
+    // An interruptible checkpoint fails with a busy error if it's postponed by live snapshots.
     bool checkpoint(bool interruptible = true, CheckPointMode mode = CheckPointMode::Passive);
 
+#pragma mark - Snapshot
+public:
+    std::shared_ptr<WALSnapshot> captureSnapshot();
+    // Auto checkpoint is postponed while any snapshot is alive, since restarting the WAL invalidates it.
+    // To keep the WAL from growing forever with a leaked snapshot, it's postponed at most `OperationQueueMaxPostponedTimesForCheckpoint` times in a row.
+    bool hasLiveSnapshot() const;
+
+private:
+    WALSnapshot::LiveCounter m_liveSnapshots;
+    // The number of auto checkpoints postponed in a row.
+    std::atomic<int> m_postponedCheckpoints;
+
 #pragma mark - Memory
 public:
-    using HandlePool::purge;
+    void purge();
     void setInMemory();
 
 private:
@@ -230,6 +322,11 @@ public:
     void proccessMerge();
     RecyclableHandle getMergeIndexHandle() override final;
 
+    typedef MergeFTSIndexLogic::BulkBuildConfig FTSBulkBuildConfig;
+    bool beginFTSBulkBuild(const UnsafeStringView &table, const FTSBulkBuildConfig &config);
+    Optional<FTSBulkBuildConfig> getFTSBulkBuildConfig(const UnsafeStringView &table) const;
+    bool endFTSBulkBuild(const UnsafeStringView &table);
+
 private:
     MergeFTSIndexLogic m_mergeLogic;
 };
@@ -56,6 +56,7 @@ void InnerHandle::setType(HandleType type)
     case HandleType::BackupRead:
     case HandleType::BackupWrite:
     case HandleType::BackupCipher:
+    case HandleType::BackupDestination:
         m_error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeBackup);
         break;
     case HandleType::Checkpoint:
@@ -0,0 +1,179 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MemoryGovernor.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include <algorithm>
+
+namespace WCDB {
+
+MemoryGovernor &MemoryGovernor::shared()
+{
+    static MemoryGovernor *s_governor = new MemoryGovernor;
+    return *s_governor;
+}
+
+MemoryGovernor::MemoryGovernor() : m_budget(0)
+{
+}
+
+MemoryGovernor::Statistic::Statistic() : hitCount(0), missCount(0), cacheSize(0)
+{
+}
+
+MemoryGovernor::Record::Record()
+: recentHits(0), recentMisses(0), decayedHits(0), decayedMisses(0), numberOfHandles(0)
+{
+}
+
+void MemoryGovernor::setBudget(int64_t budget)
+{
+    LockGuard lockGuard(m_lock);
+    m_budget = std::max<int64_t>(budget, 0);
+    for (auto &iter : m_records) {
+        iter.second.statistic.cacheSize = 0;
+    }
+}
+
+int64_t MemoryGovernor::getBudget() const
+{
+    SharedLockGuard lockGuard(m_lock);
+    return m_budget;
+}
+
+bool MemoryGovernor::isEnabled() const
+{
+    return getBudget() > 0;
+}
+
+int MemoryGovernor::initialCacheSize(size_t numberOfHandles) const
+{
+    WCTAssert(m_lock.readSafety());
+    // The new database starts with an even share until the next rebalance.
+    size_t totalNumberOfHandles = numberOfHandles;
+    for (const auto &iter : m_records) {
+        totalNumberOfHandles += iter.second.numberOfHandles;
+    }
+    int64_t cacheSize = m_budget / 1024 / std::max<size_t>(totalNumberOfHandles, 1);
+    return (int) std::min<int64_t>(
+    std::max<int64_t>(cacheSize, minCacheSize(totalNumberOfHandles)), HandleDefaultCacheSize);
+}
+
+int64_t MemoryGovernor::minCacheSize(size_t totalNumberOfHandles) const
+{
+    WCTAssert(m_lock.readSafety());
+    // The min cache size is lowered once the handles are too many to be reserved within the budget.
+    int64_t evenShare = m_budget / 1024 / std::max<size_t>(totalNumberOfHandles, 1);
+    return std::max<int64_t>(std::min<int64_t>(evenShare, MemoryGovernorMinCacheSize), 1);
+}
+
+int MemoryGovernor::reportAndGetCacheSize(const UnsafeStringView &path,
+                                          int hits,
+                                          int misses,
+                                          size_t numberOfHandles)
+{
+    WCTAssert(hits >= 0 && misses >= 0);
+    LockGuard lockGuard(m_lock);
+    if (m_budget <= 0) {
+        return 0;
+    }
+    auto iter = m_records.find(path);
+    if (iter == m_records.end()) {
+        int cacheSize = initialCacheSize(numberOfHandles);
+        iter = m_records.emplace(path, Record()).first;
+        iter->second.statistic.cacheSize = cacheSize;
+    }
+    Record &record = iter->second;
+    record.recentHits += hits;
+    record.recentMisses += misses;
+    record.statistic.hitCount += hits;
+    record.statistic.missCount += misses;
+    record.numberOfHandles = std::max<size_t>(numberOfHandles, 1);
+    if (record.statistic.cacheSize == 0) {
+        record.statistic.cacheSize = initialCacheSize(0);
+    }
+    return record.statistic.cacheSize;
+}
+
+void MemoryGovernor::removeDatabase(const UnsafeStringView &path)
+{
+    LockGuard lockGuard(m_lock);
+    m_records.erase(path);
+}
+
+double MemoryGovernor::weightOfRecord(const Record &record)
+{
+    // Misses are counted twice, since they would be saved by a larger cache.
+    return record.decayedHits + 2 * record.decayedMisses;
+}
+
+void MemoryGovernor::rebalance()
+{
+    LockGuard lockGuard(m_lock);
+    if (m_budget <= 0 || m_records.empty()) {
+        return;
+    }
+    double totalWeight = 0;
+    size_t totalNumberOfHandles = 0;
+    for (auto &iter : m_records) {
+        Record &record = iter.second;
+        record.decayedHits = record.decayedHits * MemoryGovernorDecayRate + record.recentHits;
+        record.decayedMisses
+        = record.decayedMisses * MemoryGovernorDecayRate + record.recentMisses;
+        record.recentHits = 0;
+        record.recentMisses = 0;
+        totalWeight += weightOfRecord(record);
+        totalNumberOfHandles += record.numberOfHandles;
+    }
+    // Each handle is reserved with the min cache size.
+    int64_t reserved = minCacheSize(totalNumberOfHandles);
+    int64_t distributable
+    = std::max<int64_t>(m_budget / 1024 - (int64_t) totalNumberOfHandles * reserved, 0);
+    for (auto &iter : m_records) {
+        Record &record = iter.second;
+        double share;
+        if (totalWeight > 0) {
+            share = distributable * weightOfRecord(record) / totalWeight;
+        } else {
+            share = (double) distributable * record.numberOfHandles / totalNumberOfHandles;
+        }
+        // The page cache beyond the default one is rarely hit, so it's not worth the memory.
+        record.statistic.cacheSize = (int) std::min<int64_t>(
+        reserved + (int64_t) (share / record.numberOfHandles), HandleDefaultCacheSize);
+    }
+}
+
+MemoryGovernor::Statistic MemoryGovernor::getStatistic(const UnsafeStringView &path) const
+{
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_records.find(path);
+    if (iter != m_records.end()) {
+        return iter->second.statistic;
+    }
+    return Statistic();
+}
+
+} //namespace WCDB
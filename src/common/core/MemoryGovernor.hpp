@@ -0,0 +1,92 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Lock.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+/*
+ * Memory governor splits a process-wide budget of page cache among the normal handles of all databases.
+ * Each database gets a minimum share for its handles, and the rest of budget is split by the decayed accesses,
+ * weighted by the miss ratio, since the databases with more misses benefit more from a larger cache.
+ * Handles pick up their new cache size once they are acquired, so it's never changed while they are in use.
+ */
+class MemoryGovernor final {
+public:
+    static MemoryGovernor &shared();
+
+    // In bytes. 0 means the page cache is not governed, which is the default.
+    void setBudget(int64_t budget);
+    int64_t getBudget() const;
+    bool isEnabled() const;
+
+    // Report the accesses of a handle since last report, and return the cache size for it in KiB.
+    // 0 means the default cache size.
+    int reportAndGetCacheSize(const UnsafeStringView &path,
+                              int hits,
+                              int misses,
+                              size_t numberOfHandles);
+    void removeDatabase(const UnsafeStringView &path);
+
+    void rebalance();
+
+    struct Statistic {
+        Statistic();
+        uint64_t hitCount;
+        uint64_t missCount;
+        int cacheSize; // KiB per handle
+    };
+    typedef struct Statistic Statistic;
+    Statistic getStatistic(const UnsafeStringView &path) const;
+
+protected:
+    MemoryGovernor();
+    MemoryGovernor(const MemoryGovernor &) = delete;
+    MemoryGovernor &operator=(const MemoryGovernor &) = delete;
+
+    struct Record {
+        Record();
+        Statistic statistic;
+        // Since last rebalance
+        uint64_t recentHits;
+        uint64_t recentMisses;
+        double decayedHits;
+        double decayedMisses;
+        size_t numberOfHandles;
+    };
+    typedef struct Record Record;
+    int initialCacheSize(size_t numberOfHandles) const;
+    int64_t minCacheSize(size_t totalNumberOfHandles) const;
+    static double weightOfRecord(const Record &record);
+
+    mutable SharedLock m_lock;
+    int64_t m_budget;
+    StringViewMap<Record> m_records;
+};
+
+} //namespace WCDB
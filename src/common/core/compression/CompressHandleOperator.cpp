@@ -45,6 +45,8 @@ CompressHandleOperator::CompressHandleOperator(InnerHandle* handle)
 , m_deleteRowStatement(handle->getStatement(DecoratorAllType))
 , m_insertNewRowStatement(handle->getStatement(DecoratorAllType))
 , m_updateRecordStatement(handle->getStatement(DecoratorAllType))
+, m_selectRecompressRowsStatement(handle->getStatement(DecoratorAllType))
+, m_updateRecompressRowStatement(handle->getStatement(DecoratorAllType))
 {
 }
 
@@ -59,6 +61,8 @@ CompressHandleOperator::~CompressHandleOperator()
     handle->returnStatement(m_deleteRowStatement);
     handle->returnStatement(m_insertNewRowStatement);
     handle->returnStatement(m_updateRecordStatement);
+    handle->returnStatement(m_selectRecompressRowsStatement);
+    handle->returnStatement(m_updateRecompressRowStatement);
 }
 
 #pragma mark - Stepper
@@ -132,7 +136,11 @@ bool CompressHandleOperator::filterComplessingTables(std::set<const CompressionT
         }
         if (recordIter->second.second <= 0) {
             (*iter)->setMinCompressedRowid(0);
-            iter = allTableInfos.erase(iter);
+            if ((*iter)->needRecompress()) {
+                iter++;
+            } else {
+                iter = allTableInfos.erase(iter);
+            }
         } else {
             (*iter)->setMinCompressedRowid(recordIter->second.second);
             iter++;
@@ -150,6 +158,13 @@ Optional<bool> CompressHandleOperator::compressRows(const CompressionTableInfo*
         m_compressedCount = 0;
         m_compressingTableInfo = info;
     }
+    if (m_compressingTableInfo->getMinCompressedRowid() <= 0) {
+        // All rows are compressed. Recompress them with background level.
+        Optional<bool> recompressionFinish = recompressRows();
+        m_performance.compressTime += Time::currentThreadCPUTimeInMicroseconds() - start;
+        tryReportPerformance();
+        return recompressionFinish;
+    }
     if (!prepareCompressionStatements()) {
         return NullOpt;
     }
@@ -182,7 +197,7 @@ Optional<bool> CompressHandleOperator::compressRows(const CompressionTableInfo*
     m_performance.compressTime += Time::currentThreadCPUTimeInMicroseconds() - start;
     tryReportPerformance();
 
-    return compressionFinish;
+    return compressionFinish && !m_compressingTableInfo->needRecompress();
 }
 
 Optional<bool> CompressHandleOperator::doCompressRows(const OneColumnValue& rowids)
@@ -290,16 +305,19 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
         } else {
             data = value.blobValue();
         }
+        if (data.size() < column.getPolicy().minCompressSize) {
+            m_performance.uncompressedCount++;
+            compressedType = WCDBMergeCompressionType(CompressedType::None, valueType);
+            continue;
+        }
 
         switch (column.getCompressionType()) {
         case CompressionType::Normal: {
             toCompressedType = CompressedType::ZSTDNormal;
-            compressedValue
-            = CompressionCenter::shared().compressContent(data, 0, getHandle());
+            compressedValue = compressInBackground(data, column, 0);
         } break;
         case CompressionType::Dict: {
-            compressedValue = CompressionCenter::shared().compressContent(
-            data, column.getDictId(), getHandle());
+            compressedValue = compressInBackground(data, column, column.getDictId());
         } break;
         case CompressionType::VariousDict: {
             if (column.getMatchColumnIndex() >= row.size()) {
@@ -312,8 +330,8 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
                 return false;
             }
             Value& matchValue = row[column.getMatchColumnIndex()];
-            compressedValue = CompressionCenter::shared().compressContent(
-            data, column.getMatchDictId(matchValue), getHandle());
+            compressedValue
+            = compressInBackground(data, column, column.getMatchDictId(matchValue));
         } break;
         }
 
@@ -342,6 +360,182 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
     return true;
 }
 
+Optional<UnsafeData>
+CompressHandleOperator::compressInBackground(const UnsafeData& data,
+                                             const CompressionColumnInfo& column,
+                                             CompressionColumnInfo::DictId dictId)
+{
+    int64_t start = Time::currentThreadCPUTimeInMicroseconds();
+    const std::vector<int>& levels = column.getPolicy().backgroundLevels;
+    WCTAssert(!levels.empty());
+    int level = column.getBackgroundLevel();
+    Optional<UnsafeData> compressedValue;
+    if (level > 0) {
+        compressedValue
+        = CompressionCenter::shared().compressContent(data, dictId, getHandle(), level);
+    } else {
+        // Compress samples with all candidate levels, from low to high.
+        // The result of the highest level is kept for current content.
+        LevelSample& sample = m_levelSamples[&column];
+        sample.compressedSizes.resize(levels.size(), 0);
+        for (size_t i = 0; i < levels.size(); i++) {
+            compressedValue = CompressionCenter::shared().compressContent(
+            data, dictId, getHandle(), levels[i]);
+            if (compressedValue.failed()) {
+                return NullOpt;
+            }
+            sample.compressedSizes[i] += compressedValue.value().size();
+        }
+        level = levels.back();
+        if (++sample.count >= CompressionLevelSampleCount) {
+            // Stop at the level that does not gain enough compared to the lower one.
+            size_t selected = 0;
+            for (size_t i = 1; i < levels.size(); i++) {
+                if (sample.compressedSizes[i]
+                    > sample.compressedSizes[selected] * (1 - CompressionLevelMinGain)) {
+                    break;
+                }
+                selected = i;
+            }
+            column.setBackgroundLevel(levels[selected]);
+            m_levelSamples.erase(&column);
+        }
+    }
+    if (compressedValue.succeed()) {
+        WCTAssert(m_compressingTableInfo != nullptr);
+        ColumnPerformance& performance
+        = m_performance.columns[m_compressingTableInfo->getTable()][column.getColumn().syntax().name];
+        performance.level = level;
+        performance.originalSize += data.size();
+        performance.compressedSize += std::min(compressedValue.value().size(), data.size());
+        performance.compressTime += Time::currentThreadCPUTimeInMicroseconds() - start;
+    }
+    return compressedValue;
+}
+
+#pragma mark - Recompress
+Optional<bool> CompressHandleOperator::recompressRows()
+{
+    if (!m_selectRecompressRowsStatement->isPrepared()) {
+        m_recompressingColumns.clear();
+        for (const auto& column : m_compressingTableInfo->getColumnInfos()) {
+            if (column.getPolicy().recompress) {
+                m_recompressingColumns.push_back(&column);
+            }
+        }
+        if (!m_selectRecompressRowsStatement->prepare(
+            m_compressingTableInfo->getSelectRecompressRowsStatement(&m_recompressingColumns))) {
+            return NullOpt;
+        }
+    }
+    m_selectRecompressRowsStatement->bindInteger(
+    m_compressingTableInfo->getMaxRecompressedRowid());
+    auto rows = m_selectRecompressRowsStatement->getAllRows();
+    m_selectRecompressRowsStatement->reset();
+    if (rows.failed()) {
+        return NullOpt;
+    }
+    if (!m_updateRecompressRowStatement->isPrepared()
+        && !m_updateRecompressRowStatement->prepare(
+        m_compressingTableInfo->getUpdateUncompressRowStatement(&m_recompressingColumns))) {
+        return NullOpt;
+    }
+    bool interrupted = false;
+    bool ret = getHandle()->runTransaction([&](InnerHandle* handle) {
+        for (auto& row : rows.value()) {
+            if (handle->checkHasBusyRetry()) {
+                interrupted = true;
+                handle->notifyError(Error::Code::Notice, "", "Interrupt recompression due to busy");
+                return false;
+            }
+            Optional<bool> recompressed = recompressRow(row);
+            if (recompressed.failed()) {
+                return false;
+            }
+            if (!recompressed.value()) {
+                continue;
+            }
+            m_updateRecompressRowStatement->reset();
+            for (size_t i = 0; i < row.size(); i++) {
+                m_updateRecompressRowStatement->bindValue(row[i], (int) i + 1);
+            }
+            if (!m_updateRecompressRowStatement->step()) {
+                return false;
+            }
+        }
+        return true;
+    });
+    m_updateRecompressRowStatement->reset();
+    if (!ret) {
+        if (interrupted) {
+            return false;
+        }
+        return NullOpt;
+    }
+    if (rows.value().size() < CompressionBatchCount) {
+        m_compressingTableInfo->setMaxRecompressedRowid(0);
+        m_selectRecompressRowsStatement->finalize();
+        m_updateRecompressRowStatement->finalize();
+        return true;
+    }
+    m_compressingTableInfo->setMaxRecompressedRowid(rows.value().back()[0].intValue());
+    return false;
+}
+
+Optional<bool> CompressHandleOperator::recompressRow(OneRowValue& row)
+{
+    // The row is in the form of: rowid, column, type column, [match column], ...
+    // It's converted to the form of update statement: rowid, column, type column, ...
+    OneRowValue updatedRow = { row[0] };
+    bool recompressed = false;
+    int index = 1;
+    for (const CompressionColumnInfo* column : m_recompressingColumns) {
+        Value& value = row[index];
+        Value& type = row[index + 1];
+        CompressionColumnInfo::DictId dictId = 0;
+        switch (column->getCompressionType()) {
+        case CompressionType::Normal:
+            break;
+        case CompressionType::Dict:
+            dictId = column->getDictId();
+            break;
+        case CompressionType::VariousDict:
+            dictId = column->getMatchDictId(row[index + 2].intValue());
+            break;
+        }
+        index += column->getCompressionType() == CompressionType::VariousDict ? 3 : 2;
+
+        CompressedType compressedType = type.isNull() ?
+                                        CompressedType::None :
+                                        WCDBGetCompressedType(type.intValue());
+        if (compressedType != CompressedType::None && value.getType() == ColumnType::BLOB) {
+            // Copy it out since the decompressed content will be overwritten by compression.
+            Optional<UnsafeData> decompressed = CompressionCenter::shared().decompressContent(
+            value.blobValue(), compressedType == CompressedType::ZSTDDict, getHandle());
+            if (decompressed.failed()) {
+                return NullOpt;
+            }
+            Data original(decompressed.value());
+            Optional<UnsafeData> compressedValue = compressInBackground(original, *column, dictId);
+            if (compressedValue.failed()) {
+                return NullOpt;
+            }
+            if (compressedValue.value().size() < value.blobValue().size()) {
+                value = compressedValue.value();
+                type = WCDBMergeCompressionType(dictId > 0 ? CompressedType::ZSTDDict :
+                                                             CompressedType::ZSTDNormal,
+                                                WCDBGetOriginType(type.intValue()));
+                recompressed = true;
+                m_performance.recompressedCount++;
+            }
+        }
+        updatedRow.push_back(std::move(value));
+        updatedRow.push_back(std::move(type));
+    }
+    row = std::move(updatedRow);
+    return recompressed;
+}
+
 bool CompressHandleOperator::prepareCompressionStatements()
 {
     if (!m_selectRowidStatement->isPrepared()
@@ -383,6 +577,8 @@ void CompressHandleOperator::finalizeCompressionStatements()
     m_selectRowStatement->finalize();
     m_deleteRowStatement->finalize();
     m_insertNewRowStatement->finalize();
+    m_selectRecompressRowsStatement->finalize();
+    m_updateRecompressRowStatement->finalize();
 }
 
 bool CompressHandleOperator::updateCompressionRecord()
@@ -425,6 +621,7 @@ bool CompressHandleOperator::updateCompressionRecord()
 void CompressHandleOperator::tryReportPerformance()
 {
     if (m_performance.compressedCount + m_performance.uncompressedCount
+        + m_performance.recompressedCount
         < CompressionUpdateRecordBatchCount) {
         return;
     }
@@ -438,6 +635,21 @@ void CompressHandleOperator::tryReportPerformance()
     error.infos.insert_or_assign("OriginalSize", m_performance.originalSize);
     error.infos.insert_or_assign("CompressedSize", m_performance.compressedSize);
     error.infos.insert_or_assign("TotalSize", m_performance.totalSize);
+    error.infos.insert_or_assign("RecompressedCount", m_performance.recompressedCount);
+    for (const auto& tableIter : m_performance.columns) {
+        for (const auto& iter : tableIter.second) {
+            const ColumnPerformance& column = iter.second;
+            const char* table = tableIter.first.data();
+            const char* name = iter.first.data();
+            error.infos.insert_or_assign(StringView::formatted("%s.%sLevel", table, name),
+                                         column.level);
+            error.infos.insert_or_assign(
+            StringView::formatted("%s.%sSavedSize", table, name),
+            column.originalSize - column.compressedSize);
+            error.infos.insert_or_assign(
+            StringView::formatted("%s.%sCompressTime", table, name), column.compressTime);
+        }
+    }
 
     Notifier::shared().notify(error);
 
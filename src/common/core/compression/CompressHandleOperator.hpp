@@ -27,7 +27,10 @@
 #include "Compression.hpp"
 #include "HandleOperator.hpp"
 #include <array>
+#include <list>
+#include <map>
 #include <set>
+#include <vector>
 
 namespace WCDB {
 
@@ -42,18 +45,42 @@ public:
     Optional<bool> compressRows(const CompressionTableInfo* info) override final;
 
 private:
+    typedef struct ColumnPerformance {
+        int level = 0;
+        size_t originalSize = 0;
+        size_t compressedSize = 0;
+        int64_t compressTime = 0;
+    } ColumnPerformance;
+
     typedef struct CompressionPerformance {
         int compressedCount = 0;
         int uncompressedCount = 0;
+        int recompressedCount = 0;
         size_t compressedSize = 0;
         size_t originalSize = 0;
         int64_t compressTime = 0;
         size_t totalSize = 0;
+        // Keyed by table and then column, since the columns of different tables may have the same name.
+        StringViewMap<StringViewMap<ColumnPerformance>> columns;
     } CompressionPerformance;
 
     Optional<bool> doCompressRows(const OneColumnValue& rowids);
     bool compressRow(OneRowValue& row);
 
+    // Compress with the background level of column, which is selected by sampling first.
+    Optional<UnsafeData> compressInBackground(const UnsafeData& data,
+                                              const CompressionColumnInfo& column,
+                                              CompressionColumnInfo::DictId dictId);
+    typedef struct LevelSample {
+        int count = 0;
+        std::vector<size_t> compressedSizes;
+    } LevelSample;
+    std::map<const CompressionColumnInfo*, LevelSample> m_levelSamples;
+
+    Optional<bool> recompressRows();
+    Optional<bool> recompressRow(OneRowValue& row);
+    std::list<const CompressionColumnInfo*> m_recompressingColumns;
+
     bool prepareCompressionStatements();
     void resetCompressionStatements();
     void finalizeCompressionStatements();
@@ -66,6 +93,8 @@ private:
     HandleStatement* m_deleteRowStatement;
     HandleStatement* m_insertNewRowStatement;
     HandleStatement* m_updateRecordStatement;
+    HandleStatement* m_selectRecompressRowsStatement;
+    HandleStatement* m_updateRecompressRowStatement;
 
     CompressionPerformance m_performance;
     void tryReportPerformance();
@@ -55,7 +55,7 @@ CompressingHandleDecorator::getStatement(const UnsafeStringView& skipDecorator)
         && !skipDecorator.equal(DecoratorCompressingHandleStatement)
         && !skipDecorator.equal(DecoratorAllType)) {
         statement->tryAddDecorator<CompressingStatementDecorator>(
-        DecoratorCompressingHandleStatement, this);
+        DecoratorCompressingHandleStatement, this, &m_statementCache);
     }
     return statement;
 }
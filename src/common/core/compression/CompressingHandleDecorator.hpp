@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "CompressingStatementDecorator.hpp"
 #include "Compression.hpp"
 #include "DecorativeHandle.hpp"
 
@@ -48,6 +49,9 @@ public:
 public:
     DecorativeHandleStatement *
     getStatement(const UnsafeStringView &skipDecorator) override final;
+
+private:
+    CompressingStatementDecorator::Cache m_statementCache;
 };
 
 } // namespace WCDB
@@ -32,28 +32,40 @@
 #include "StringView.hpp"
 #include "WINQ.h"
 #include <algorithm>
+#include <map>
+#include <vector>
 
 namespace WCDB {
 
 #pragma mark - Basic
-CompressingStatementDecorator::CompressingStatementDecorator(Compression::Binder* binder)
+CompressingStatementDecorator::CompressingStatementDecorator(Compression::Binder* binder, Cache* cache)
 : HandleStatementDecorator()
 , m_compressionBinder(binder)
+, m_statementCache(cache)
 , m_currentStatementType(StatementType::Invalid)
 , m_processing(false)
 , m_compressFail(false)
 , m_compressionTableInfo(nullptr)
+, m_recording(false)
+, m_scanBindingsRecorded(true)
+, m_stepped(false)
 {
 }
 
 CompressingStatementDecorator::CompressingStatementDecorator(CompressingStatementDecorator&& other)
 : Super(std::move(other))
 , m_compressionBinder(other.m_compressionBinder)
+, m_statementCache(other.m_statementCache)
 , m_currentStatementType(other.m_currentStatementType)
 , m_processing(other.m_processing)
 , m_additionalStatements(std::move(other.m_additionalStatements))
+, m_recording(false)
+, m_scanHandleStatement(std::move(other.m_scanHandleStatement))
+, m_scanBindingsRecorded(true)
+, m_stepped(false)
 {
     other.m_compressionBinder = nullptr;
+    other.m_statementCache = nullptr;
     other.m_processing = false;
     other.m_currentStatementType = StatementType::Invalid;
     other.m_additionalStatements.clear();
@@ -76,6 +88,7 @@ void CompressingStatementDecorator::decorate(Decorative* handleStatement)
     WCDBSwizzleDecorativeFunction(handleStatement, CompressingStatementDecorator, bindBLOB);
     WCDBSwizzleDecorativeFunction(handleStatement, CompressingStatementDecorator, bindNull);
     WCDBSwizzleDecorativeFunction(handleStatement, CompressingStatementDecorator, bindPointer);
+    WCDBSwizzleDecorativeFunction(handleStatement, CompressingStatementDecorator, getAllRows);
 }
 
 #pragma mark - Override
@@ -89,6 +102,22 @@ bool CompressingStatementDecorator::prepare(const Statement& statement)
     resetCompressionStatus();
     bool ret = true;
     m_currentStatementType = statement.getType();
+    StringView sql;
+    if (m_statementCache != nullptr && isCacheable(m_currentStatementType)) {
+        sql = statement.getDescription();
+        Optional<ProcessedStatements> cached;
+        if (!tryLoadCachedStatements(sql, cached)) {
+            m_processing = false;
+            return false;
+        }
+        if (cached.succeed()) {
+            ret = prepareProcessedStatements(cached.value());
+            m_processing = false;
+            return ret;
+        }
+        m_recording = true;
+        m_processed = ProcessedStatements();
+    }
     switch (m_currentStatementType) {
     case StatementType::InsertSTMT:
         ret = processInsert(static_cast<const StatementInsert&>(statement));
@@ -118,6 +147,15 @@ bool CompressingStatementDecorator::prepare(const Statement& statement)
         ret = Super::prepare(statement);
         break;
     }
+    if (m_recording) {
+        m_recording = false;
+        if (ret) {
+            recordProcessedStatements();
+            m_statementCache->validate(m_compressionBinder->getInfoVersion());
+            m_statementCache->insert(sql, m_processed);
+        }
+        m_processed = ProcessedStatements();
+    }
     m_processing = false;
     return ret;
 }
@@ -134,6 +172,7 @@ void CompressingStatementDecorator::finalize()
 
 bool CompressingStatementDecorator::step()
 {
+    m_stepped = true;
     if (m_compressFail) {
         return false;
     }
@@ -152,11 +191,14 @@ void CompressingStatementDecorator::reset()
         handleStatement.reset();
     }
     m_compressFail = false;
+    m_stepped = false;
 }
 
 void CompressingStatementDecorator::clearBindings()
 {
     Super::clearBindings();
+    m_scanBindings.clear();
+    m_scanBindingsRecorded = true;
     for (auto& handleStatement : m_additionalStatements) {
         handleStatement.clearBindings();
     }
@@ -165,6 +207,9 @@ void CompressingStatementDecorator::clearBindings()
 
 void CompressingStatementDecorator::bindInteger(const Integer& value, int index)
 {
+    if (m_scanStatement.hasValue()) {
+        recordScanBinding(value, index);
+    }
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindInteger(value, index);
     }
@@ -189,6 +234,9 @@ void CompressingStatementDecorator::bindInteger(const Integer& value, int index)
 
 void CompressingStatementDecorator::bindDouble(const Float& value, int index)
 {
+    if (m_scanStatement.hasValue()) {
+        recordScanBinding(value, index);
+    }
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindDouble(value, index);
     }
@@ -215,6 +263,9 @@ void CompressingStatementDecorator::bindDouble(const Float& value, int index)
 
 void CompressingStatementDecorator::bindText(const Text& value, int index)
 {
+    if (m_scanStatement.hasValue()) {
+        recordScanBinding(value, index);
+    }
     BindInfo* info = m_bindInfoMap[index];
     if (info != nullptr) {
         WCTAssert(index == info->columnBindIndex);
@@ -231,15 +282,10 @@ void CompressingStatementDecorator::bindText(const Text& value, int index)
         UnsafeData data((unsigned char*) value.data(), value.size());
         if (info->matchColumnBindIndex > 0) {
             if (!info->bindedValue.isNull()) {
-                Optional<UnsafeData> compressedValue;
-                if (m_compressionBinder->canCompressNewData()) {
-                    compressedValue = CompressionCenter::shared().compressContent(
-                    data,
-                    info->columnInfo->getMatchDictId(info->bindedValue.intValue()),
-                    static_cast<InnerHandle*>(getHandle()));
-                } else {
-                    compressedValue = data;
-                }
+                Optional<UnsafeData> compressedValue = compressBindingContent(
+                data,
+                info->columnInfo,
+                info->columnInfo->getMatchDictId(info->bindedValue.intValue()));
                 if (compressedValue.failed()) {
                     m_compressFail = true;
                     return;
@@ -265,15 +311,8 @@ void CompressingStatementDecorator::bindText(const Text& value, int index)
         } else {
             bool usingDict
             = info->columnInfo->getCompressionType() == CompressionType::Dict;
-            Optional<UnsafeData> compressedValue;
-            if (m_compressionBinder->canCompressNewData()) {
-                compressedValue = CompressionCenter::shared().compressContent(
-                data,
-                usingDict ? info->columnInfo->getDictId() : 0,
-                static_cast<InnerHandle*>(getHandle()));
-            } else {
-                compressedValue = data;
-            }
+            Optional<UnsafeData> compressedValue = compressBindingContent(
+            data, info->columnInfo, usingDict ? info->columnInfo->getDictId() : 0);
             if (compressedValue.failed()) {
                 m_compressFail = true;
                 return;
@@ -312,6 +351,9 @@ void CompressingStatementDecorator::bindText16(const char16_t* value, size_t val
 {
     BindInfo* info = m_bindInfoMap[index];
     if (info == nullptr) {
+        if (m_scanStatement.hasValue()) {
+            recordScanBinding(StringView::createFromUTF16(value, valueLength), index);
+        }
         if (getHandleStatement()->getBindParameterCount() >= index) {
             Super::bindText16(value, valueLength, index);
         }
@@ -327,6 +369,9 @@ void CompressingStatementDecorator::bindText16(const char16_t* value, size_t val
 
 void CompressingStatementDecorator::bindBLOB(const BLOB& value, int index)
 {
+    if (m_scanStatement.hasValue()) {
+        recordScanBinding(value, index);
+    }
     BindInfo* info = m_bindInfoMap[index];
     if (m_bindInfoMap[index] != nullptr) {
         WCTAssert(index == info->columnBindIndex);
@@ -342,15 +387,10 @@ void CompressingStatementDecorator::bindBLOB(const BLOB& value, int index)
         }
         if (info->matchColumnBindIndex > 0) {
             if (!info->bindedValue.isNull()) {
-                Optional<UnsafeData> compressedValue;
-                if (m_compressionBinder->canCompressNewData()) {
-                    compressedValue = CompressionCenter::shared().compressContent(
-                    value,
-                    info->columnInfo->getMatchDictId(info->bindedValue.intValue()),
-                    static_cast<InnerHandle*>(getHandle()));
-                } else {
-                    compressedValue = value;
-                }
+                Optional<UnsafeData> compressedValue = compressBindingContent(
+                value,
+                info->columnInfo,
+                info->columnInfo->getMatchDictId(info->bindedValue.intValue()));
                 if (compressedValue.failed()) {
                     m_compressFail = true;
                     return;
@@ -376,15 +416,8 @@ void CompressingStatementDecorator::bindBLOB(const BLOB& value, int index)
         } else {
             bool usingDict
             = info->columnInfo->getCompressionType() == CompressionType::Dict;
-            Optional<UnsafeData> compressedValue;
-            if (m_compressionBinder->canCompressNewData()) {
-                compressedValue = CompressionCenter::shared().compressContent(
-                value,
-                usingDict ? info->columnInfo->getDictId() : 0,
-                static_cast<InnerHandle*>(getHandle()));
-            } else {
-                compressedValue = value;
-            }
+            Optional<UnsafeData> compressedValue = compressBindingContent(
+            value, info->columnInfo, usingDict ? info->columnInfo->getDictId() : 0);
             if (compressedValue.failed()) {
                 m_compressFail = true;
                 return;
@@ -421,6 +454,9 @@ void CompressingStatementDecorator::bindBLOB(const BLOB& value, int index)
 
 void CompressingStatementDecorator::bindNull(int index)
 {
+    if (m_scanStatement.hasValue()) {
+        recordScanBinding(nullptr, index);
+    }
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindNull(index);
     }
@@ -450,6 +486,8 @@ void CompressingStatementDecorator::bindPointer(void* ptr,
                                                 const Text& type,
                                                 void (*destructor)(void*))
 {
+    // Pointers can't be rebound to the scan statement since they may be released once bound.
+    m_scanBindingsRecorded = false;
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindPointer(ptr, index, type, destructor);
     }
@@ -466,7 +504,7 @@ bool CompressingStatementDecorator::processInsert(const StatementInsert& insert)
 {
     const Syntax::InsertSTMT& insertSTMT = insert.syntax();
     if (insertSTMT.switcher == Syntax::InsertSTMT::Switch::Default) {
-        return Super::prepare(insert);
+        return prepareMainStatement(insert);
     }
 
     // Get compression info
@@ -514,7 +552,7 @@ bool CompressingStatementDecorator::processInsert(const StatementInsert& insert)
     if (!needCompress && insertSTMT.switcher == Syntax::InsertSTMT::Switch::Values
         && !insertSTMT.upsertClause.hasValue()
         && insertSTMT.commonTableExpressions.empty()) {
-        return Super::prepare(insert);
+        return prepareMainStatement(insert);
     }
 
     StatementInsert newInsert = insert;
@@ -553,7 +591,7 @@ bool CompressingStatementDecorator::processInsert(const StatementInsert& insert)
             WCTAssert(m_bindInfoMap.find(maxBindIndex) == m_bindInfoMap.end());
             m_bindInfoMap.emplace(maxBindIndex, &bindInfo);
         }
-        if (!Super::prepare(newInsert)) {
+        if (!prepareMainStatement(newInsert)) {
             return false;
         }
     } else {
@@ -573,17 +611,15 @@ bool CompressingStatementDecorator::processInsert(const StatementInsert& insert)
                 }
             }
         }
-        if (!Super::prepare(newInsert)) {
+        if (!prepareMainStatement(newInsert)) {
             return false;
         }
         if (needCompress) {
-            HandleStatement& selectUncompressRow = addNewHandleStatement();
-            if (!selectUncompressRow.prepare(
+            if (!prepareAdditionalStatement(
                 m_compressionTableInfo->getSelectUncompressRowStatement())) {
                 return false;
             }
-            HandleStatement& updateUncompressRow = addNewHandleStatement();
-            if (!updateUncompressRow.prepare(
+            if (!prepareAdditionalStatement(
                 m_compressionTableInfo->getUpdateUncompressRowStatement())) {
                 return false;
             }
@@ -663,12 +699,12 @@ bool CompressingStatementDecorator::processUpdate(const StatementUpdate& update)
             WCTAssert(m_bindInfoMap.find(maxBindIndex) == m_bindInfoMap.end());
             m_bindInfoMap.emplace(maxBindIndex, &bindInfo);
         }
-        if (!Super::prepare(newUpdate)) {
+        if (!prepareMainStatement(newUpdate)) {
             return false;
         }
     } else {
         if (m_bindInfoList.empty()) {
-            if (!Super::prepare(newUpdate)) {
+            if (!prepareMainStatement(newUpdate)) {
                 return false;
             }
         } else {
@@ -736,24 +772,21 @@ bool CompressingStatementDecorator::processUpdate(const StatementUpdate& update)
             //Rowid must be binded to the largest index
             newUpdate.where(Column::rowid() == BindParameter(++maxBindIndex));
 
-            HandleStatement& selectRowidSTMT = addNewHandleStatement();
-            if (!selectRowidSTMT.prepare(selectRowid)) {
+            if (!prepareAdditionalStatement(selectRowid)) {
                 return false;
             }
 
-            if (!Super::prepare(newUpdate)) {
+            if (!prepareMainStatement(newUpdate)) {
                 return false;
             }
 
             if (!selectMatchType) {
-                HandleStatement& selectUncompressRow = addNewHandleStatement();
-                if (!selectUncompressRow.prepare(m_compressionTableInfo->getSelectUncompressRowStatement(
+                if (!prepareAdditionalStatement(m_compressionTableInfo->getSelectUncompressRowStatement(
                     &m_compressingUpdateColumns))) {
                     return false;
                 }
 
-                HandleStatement& updateUncompressRow = addNewHandleStatement();
-                if (!updateUncompressRow.prepare(m_compressionTableInfo->getUpdateUncompressRowStatement(
+                if (!prepareAdditionalStatement(m_compressionTableInfo->getUpdateUncompressRowStatement(
                     &m_compressingUpdateColumns))) {
                     return false;
                 }
@@ -823,13 +856,40 @@ HandleStatement& CompressingStatementDecorator::addNewHandleStatement()
     return m_additionalStatements.back();
 }
 
+bool CompressingStatementDecorator::prepareMainStatement(const Statement& statement)
+{
+    if (m_recording) {
+        m_processed.mainStatement = statement;
+    }
+    return Super::prepare(statement);
+}
+
+bool CompressingStatementDecorator::prepareAdditionalStatement(const Statement& statement)
+{
+    if (m_recording) {
+        m_processed.additionalStatements.push_back(statement);
+    }
+    return addNewHandleStatement().prepare(statement);
+}
+
+Optional<const CompressionTableInfo*>
+CompressingStatementDecorator::getCompressionInfo(const UnsafeStringView& table)
+{
+    auto optionalTableInfo = m_compressionBinder->tryGetCompressionInfo(table);
+    if (m_recording && optionalTableInfo.hasValue()) {
+        m_processed.referencedTables.emplace_back(table, optionalTableInfo.value());
+    }
+    return optionalTableInfo;
+}
+
 bool CompressingStatementDecorator::processSelect(const StatementSelect& select)
 {
     StatementSelect newSelect = select;
     if (!adaptCompressingColumn(newSelect)) {
         return false;
     }
-    return Super::prepare(newSelect);
+    generateScanStatement(newSelect);
+    return prepareMainStatement(newSelect);
 }
 
 bool CompressingStatementDecorator::processDelete(const StatementDelete& delete_)
@@ -844,7 +904,7 @@ bool CompressingStatementDecorator::processDelete(const StatementDelete& delete_
     if (!adaptCompressingColumn(newDelete, nullptr, m_compressionTableInfo)) {
         return false;
     }
-    return Super::prepare(newDelete);
+    return prepareMainStatement(newDelete);
 }
 
 bool CompressingStatementDecorator::processCreateTable(const StatementCreateTable& createTable)
@@ -930,7 +990,7 @@ bool CompressingStatementDecorator::initCompressionTableInfo(const Syntax::Schem
                                                              const UnsafeStringView& table)
 {
     if (schema.isMain()) {
-        auto optionalTableInfo = m_compressionBinder->tryGetCompressionInfo(table);
+        auto optionalTableInfo = getCompressionInfo(table);
         if (optionalTableInfo.failed()) {
             return false;
         }
@@ -1099,8 +1159,7 @@ bool CompressingStatementDecorator::parseTable(const std::list<Syntax::TableOrSu
             if (!table.schema.isMain()) {
                 return true;
             }
-            auto tableInfo
-            = m_compressionBinder->tryGetCompressionInfo(table.tableOrFunction);
+            auto tableInfo = getCompressionInfo(table.tableOrFunction);
             if (!tableInfo.hasValue()) {
                 return false;
             }
@@ -1127,6 +1186,7 @@ void CompressingStatementDecorator::resetCompressionStatus()
     m_compressingUpdateColumns.clear();
     m_bindInfoMap.clear();
     m_bindInfoList.clear();
+    resetScanStatus();
 }
 
 void CompressingStatementDecorator::bindValueInInfo(const BindInfo* info, const Integer& matchValue)
@@ -1140,15 +1200,8 @@ void CompressingStatementDecorator::bindValueInInfo(const BindInfo* info, const
     } else {
         data = info->bindedValue.blobValue();
     }
-    Optional<UnsafeData> compressedValue;
-    if (m_compressionBinder->canCompressNewData()) {
-        compressedValue = CompressionCenter::shared().compressContent(
-        data,
-        info->columnInfo->getMatchDictId(matchValue),
-        static_cast<InnerHandle*>(getHandle()));
-    } else {
-        compressedValue = data;
-    }
+    Optional<UnsafeData> compressedValue = compressBindingContent(
+    data, info->columnInfo, info->columnInfo->getMatchDictId(matchValue));
     if (compressedValue.failed()) {
         m_compressFail = true;
         return;
@@ -1172,6 +1225,119 @@ void CompressingStatementDecorator::bindValueInInfo(const BindInfo* info, const
     }
 }
 
+Optional<UnsafeData>
+CompressingStatementDecorator::compressBindingContent(const UnsafeData& data,
+                                                     const CompressionColumnInfo* columnInfo,
+                                                     CompressionColumnInfo::DictId dictId)
+{
+    const CompressionPolicy& policy = columnInfo->getPolicy();
+    if (!m_compressionBinder->canCompressNewData() || data.size() < policy.minCompressSize) {
+        return data;
+    }
+    // Compress with a fast level to keep writing fast. It can be recompressed in background.
+    return CompressionCenter::shared().compressContent(
+    data, dictId, static_cast<InnerHandle*>(getHandle()), policy.writeLevel);
+}
+
+#pragma mark - Cache Statement
+bool CompressingStatementDecorator::isCacheable(StatementType type)
+{
+    // Schema changes run rarely and may hint new tables, so they are always processed.
+    switch (type) {
+    case StatementType::InsertSTMT:
+    case StatementType::UpdateSTMT:
+    case StatementType::SelectSTMT:
+    case StatementType::DeleteSTMT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool CompressingStatementDecorator::tryLoadCachedStatements(const StringView& sql,
+                                                            Optional<ProcessedStatements>& cached)
+{
+    WCTAssert(m_statementCache != nullptr);
+    const ProcessedStatements* entry = m_statementCache->find(sql);
+    if (entry == nullptr) {
+        return true;
+    }
+    // Copy it out since looking up infos may run other statements which touch the cache.
+    cached = *entry;
+    bool matched = true;
+    for (const auto& referencedTable : cached.value().referencedTables) {
+        auto optionalTableInfo
+        = m_compressionBinder->tryGetCompressionInfo(referencedTable.first);
+        if (!optionalTableInfo.hasValue()) {
+            cached = NullOpt;
+            return false;
+        }
+        if (optionalTableInfo.value() != referencedTable.second) {
+            matched = false;
+        }
+    }
+    if (!m_statementCache->validate(m_compressionBinder->getInfoVersion()) || !matched) {
+        cached = NullOpt;
+    }
+    return true;
+}
+
+bool CompressingStatementDecorator::prepareProcessedStatements(const ProcessedStatements& processed)
+{
+    WCTAssert(processed.mainStatement.hasValue());
+    WCTAssert(m_additionalStatements.empty());
+    m_currentStatementType = processed.type;
+    m_compressionTableInfo = processed.compressionTableInfo;
+    m_compressingUpdateColumns = processed.compressingUpdateColumns;
+    m_bindInfoList = processed.bindInfoList;
+    std::vector<BindInfo*> bindInfos;
+    bindInfos.reserve(m_bindInfoList.size());
+    for (auto& bindInfo : m_bindInfoList) {
+        bindInfos.push_back(&bindInfo);
+    }
+    for (const auto& position : processed.bindInfoPositions) {
+        WCTAssert(position.second < bindInfos.size());
+        m_bindInfoMap.emplace(position.first, bindInfos[position.second]);
+    }
+    m_scanStatement = processed.scanStatement;
+    m_scanColumns = processed.scanColumns;
+    if (!Super::prepare(processed.mainStatement.value())) {
+        return false;
+    }
+    for (const auto& statement : processed.additionalStatements) {
+        if (!addNewHandleStatement().prepare(statement)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompressingStatementDecorator::recordProcessedStatements()
+{
+    WCTAssert(m_processed.mainStatement.hasValue());
+    m_processed.type = m_currentStatementType;
+    m_processed.compressionTableInfo = m_compressionTableInfo;
+    m_processed.compressingUpdateColumns = m_compressingUpdateColumns;
+    m_processed.bindInfoList = m_bindInfoList;
+    m_processed.scanStatement = m_scanStatement;
+    m_processed.scanColumns = m_scanColumns;
+    std::map<const BindInfo*, size_t> positions;
+    size_t position = 0;
+    for (const auto& bindInfo : m_bindInfoList) {
+        positions.emplace(&bindInfo, position++);
+    }
+    for (const auto& iter : m_bindInfoMap) {
+        if (iter.second == nullptr) {
+            continue;
+        }
+        auto positionIter = positions.find(iter.second);
+        WCTAssert(positionIter != positions.end());
+        if (positionIter != positions.end()) {
+            m_processed.bindInfoPositions.emplace_back(iter.first, positionIter->second);
+        }
+    }
+}
+
 #pragma mark - Step Statement
 
 bool CompressingStatementDecorator::realStep()
@@ -1273,4 +1439,178 @@ bool CompressingStatementDecorator::stepUpdate()
     return true;
 }
 
+#pragma mark - Bulk Decompression
+/*
+ The select whose decompressing columns are all top-level result columns will be scanned in batch by getAllRows. Eg:
+    SELECT wcdb_decompress(compresssingColumnA, WCDB_CT_compresssingColumnA) AS compresssingColumnA FROM compressingTable
+ will be scanned with
+    SELECT compresssingColumnA AS compresssingColumnA, WCDB_CT_compresssingColumnA FROM compressingTable
+ Type columns are appended to the end so that the positions of other result columns are not changed.
+ */
+void CompressingStatementDecorator::generateScanStatement(const StatementSelect& select)
+{
+    const Syntax::SelectSTMT& selectSTMT = select.syntax();
+    if (!selectSTMT.select.hasValue() || !selectSTMT.cores.empty()) {
+        return;
+    }
+    const Syntax::SelectCore& selectCore = selectSTMT.select.value();
+    if (selectCore.switcher != Syntax::SelectCore::Switch::Select || selectCore.distinct) {
+        return;
+    }
+    // Result columns may be referred by position.
+    for (const auto& orderingTerm : selectSTMT.orderingTerms) {
+        if (orderingTerm.expression.hasValue()
+            && orderingTerm.expression.value().switcher == Syntax::Expression::Switch::LiteralValue) {
+            return;
+        }
+    }
+    for (const auto& group : selectCore.groups) {
+        if (group.switcher == Syntax::Expression::Switch::LiteralValue) {
+            return;
+        }
+    }
+
+    StatementSelect scanSelect = select;
+    Syntax::SelectCore& scanCore = scanSelect.syntax().select.value();
+    std::vector<ScanColumn> scanColumns;
+    std::list<Syntax::ResultColumn> typeColumns;
+    int index = 0;
+    for (auto& resultColumn : scanCore.resultColumns) {
+        if (!resultColumn.expression.hasValue()) {
+            return;
+        }
+        Syntax::Expression& expression = resultColumn.expression.value();
+        if (expression.switcher == Syntax::Expression::Switch::Column
+            && expression.column().wildcard) {
+            return;
+        }
+        if (expression.switcher == Syntax::Expression::Switch::Function
+            && expression.function().equal(DecompressFunctionName)
+            && expression.expressions.size() == 2) {
+            typeColumns.emplace_back();
+            typeColumns.back().expression = expression.expressions.back();
+            Syntax::Expression valueExpression = expression.expressions.front();
+            expression = valueExpression;
+            scanColumns.emplace_back();
+            scanColumns.back().valueIndex = index;
+        }
+        index++;
+    }
+    if (scanColumns.empty()) {
+        return;
+    }
+    for (auto& scanColumn : scanColumns) {
+        scanColumn.typeIndex = index++;
+    }
+    scanCore.resultColumns.splice(scanCore.resultColumns.end(), typeColumns);
+    m_scanStatement = scanSelect;
+    m_scanColumns = std::move(scanColumns);
+}
+
+OptionalMultiRows CompressingStatementDecorator::getAllRows()
+{
+    if (!m_scanStatement.hasValue() || m_stepped || m_compressFail || !m_scanBindingsRecorded) {
+        return Super::getAllRows();
+    }
+    if (m_scanHandleStatement == nullptr) {
+        m_scanHandleStatement.reset(new HandleStatement(getHandle()));
+    }
+    HandleStatement& scanStatement = *m_scanHandleStatement;
+    if (!scanStatement.isPrepared() && !scanStatement.prepare(m_scanStatement.value())) {
+        return NullOpt;
+    }
+    scanStatement.reset();
+    scanStatement.clearBindings();
+    int numberOfParameters = scanStatement.getBindParameterCount();
+    for (int i = 0; i < numberOfParameters && i < (int) m_scanBindings.size(); i++) {
+        scanStatement.bindValue(m_scanBindings[i], i + 1);
+    }
+
+    int numberOfColumns = getHandleStatement()->getNumberOfColumns();
+    MultiRowsValue rows;
+    CompressionCenter::DecompressingContents contents;
+    std::vector<std::pair<size_t, int>> positions;
+    bool succeed = false;
+    while ((succeed = scanStatement.step()) && !scanStatement.done()) {
+        rows.emplace_back();
+        OneRowValue& row = rows.back();
+        row.reserve(numberOfColumns);
+        for (int i = 0; i < numberOfColumns; i++) {
+            row.push_back(scanStatement.getValue(i));
+        }
+        for (const auto& scanColumn : m_scanColumns) {
+            if (scanStatement.getType(scanColumn.valueIndex) != ColumnType::BLOB) {
+                continue;
+            }
+            int type = (int) scanStatement.getInteger(scanColumn.typeIndex);
+            CompressedType compressedType = WCDBGetCompressedType(type);
+            if (compressedType <= CompressedType::None
+                || compressedType > CompressedType::ZSTDNormal
+                || scanStatement.getColumnSize(scanColumn.valueIndex) == 0) {
+                continue;
+            }
+            contents.emplace_back();
+            contents.back().data = row[scanColumn.valueIndex].blobValue();
+            contents.back().usingDict = compressedType == CompressedType::ZSTDDict;
+            contents.back().originType = WCDBGetOriginType(type);
+            positions.emplace_back(rows.size() - 1, scanColumn.valueIndex);
+        }
+        if (contents.size() >= CompressionBulkDecompressionBatchCount
+            && !decompressScannedRows(rows, contents, positions)) {
+            succeed = false;
+            break;
+        }
+    }
+    if (succeed && !decompressScannedRows(rows, contents, positions)) {
+        succeed = false;
+    }
+    scanStatement.reset();
+    if (!succeed) {
+        return NullOpt;
+    }
+    return rows;
+}
+
+bool CompressingStatementDecorator::decompressScannedRows(MultiRowsValue& rows,
+                                                          CompressionCenter::DecompressingContents& contents,
+                                                          std::vector<std::pair<size_t, int>>& positions)
+{
+    if (contents.empty()) {
+        return true;
+    }
+    WCTAssert(dynamic_cast<InnerHandle*>(getHandle()) != nullptr);
+    InnerHandle* handle = static_cast<InnerHandle*>(getHandle());
+    if (!CompressionCenter::shared().decompressContents(contents, handle)) {
+        return false;
+    }
+    WCTAssert(contents.size() == positions.size());
+    for (size_t i = 0; i < contents.size(); i++) {
+        rows[positions[i].first][positions[i].second] = std::move(contents[i].result);
+    }
+    contents.clear();
+    positions.clear();
+    return true;
+}
+
+void CompressingStatementDecorator::resetScanStatus()
+{
+    if (m_scanHandleStatement != nullptr) {
+        m_scanHandleStatement->finalize();
+    }
+    m_scanStatement = NullOpt;
+    m_scanColumns.clear();
+    m_scanBindings.clear();
+    m_scanBindingsRecorded = true;
+    m_stepped = false;
+}
+
+void CompressingStatementDecorator::recordScanBinding(const Value& value, int index)
+{
+    WCTRemedialAssert(index > 0, "Invalid bind index.", return;);
+    if (m_scanBindings.size() < (size_t) index) {
+        m_scanBindings.resize(index);
+    }
+    m_scanBindings[index - 1] = value;
+}
+
 } //namespace WCDB
@@ -25,9 +25,13 @@
 #pragma once
 
 #include "Compression.hpp"
+#include "CompressionCenter.hpp"
 #include "DecorativeHandleStatement.hpp"
+#include "RewrittenStatementCache.hpp"
 #include <limits.h>
 #include <list>
+#include <map>
+#include <memory>
 #include <unordered_map>
 
 namespace WCDB {
@@ -35,7 +39,10 @@ namespace WCDB {
 class CompressingStatementDecorator final : public HandleStatementDecorator {
 #pragma mark - Basic
 public:
-    CompressingStatementDecorator(Compression::Binder *binder);
+    struct ProcessedStatements;
+    typedef RewrittenStatementCache<ProcessedStatements> Cache;
+
+    CompressingStatementDecorator(Compression::Binder *binder, Cache *cache = nullptr);
     CompressingStatementDecorator(CompressingStatementDecorator &&other);
     ~CompressingStatementDecorator() override;
 
@@ -50,6 +57,7 @@ protected:
 
 private:
     Compression::Binder *m_compressionBinder;
+    Cache *m_statementCache;
 
 #pragma mark - Decorated functions
 public:
@@ -67,6 +75,8 @@ public:
     void bindNull(int index) override final;
     void bindPointer(void *ptr, int index, const Text &type, void (*destructor)(void *)) override final;
 
+    OptionalMultiRows getAllRows() override final;
+
 #pragma mark - Process Statement
 protected:
     bool processInsert(const StatementInsert &insert);
@@ -88,7 +98,10 @@ protected:
     bool checkBindParametersExist(std::list<Syntax::Expression> &exps);
     Optional<int>
     getBindParameter(std::list<Syntax::Expression> &exps, std::pair<int, int> &index);
+    Optional<const CompressionTableInfo *> getCompressionInfo(const UnsafeStringView &table);
     HandleStatement &addNewHandleStatement();
+    bool prepareMainStatement(const Statement &statement);
+    bool prepareAdditionalStatement(const Statement &statement);
 
     void resetCompressionStatus();
 
@@ -102,8 +115,17 @@ protected:
         const CompressionColumnInfo *columnInfo = nullptr;
     } BindInfo;
 
+    // A decompressing result column of select, which is fetched raw by the scan statement with its type column.
+    typedef struct ScanColumn {
+        int valueIndex = 0;
+        int typeIndex = 0;
+    } ScanColumn;
+
     static const int SelectedMatchValueBindIndex = INT_MAX;
     void bindValueInInfo(const BindInfo *bindInfo, const Integer &matchValue);
+    Optional<UnsafeData> compressBindingContent(const UnsafeData &data,
+                                                const CompressionColumnInfo *columnInfo,
+                                                CompressionColumnInfo::DictId dictId);
 
     using StatementType = Syntax::Identifier::Type;
     StatementType m_currentStatementType;
@@ -115,11 +137,56 @@ protected:
     std::unordered_map<int, BindInfo *> m_bindInfoMap;
     std::list<HandleStatement> m_additionalStatements;
 
+#pragma mark - Cache Statement
+public:
+    struct ProcessedStatements {
+        Syntax::Identifier::Type type = Syntax::Identifier::Type::Invalid;
+        Optional<Statement> mainStatement;
+        std::list<Statement> additionalStatements;
+        // Tables looked up during processing and their infos, which must be looked up again before reusing.
+        std::list<std::pair<StringView, const CompressionTableInfo *>> referencedTables;
+        const CompressionTableInfo *compressionTableInfo = nullptr;
+        std::list<const CompressionColumnInfo *> compressingUpdateColumns;
+        std::list<BindInfo> bindInfoList;
+        // bind index -> position in bindInfoList
+        std::list<std::pair<int, size_t>> bindInfoPositions;
+        Optional<Statement> scanStatement;
+        std::vector<ScanColumn> scanColumns;
+    };
+
+protected:
+    static bool isCacheable(StatementType type);
+    bool tryLoadCachedStatements(const StringView &sql, Optional<ProcessedStatements> &cached);
+    bool prepareProcessedStatements(const ProcessedStatements &processed);
+    void recordProcessedStatements();
+
+    bool m_recording;
+    ProcessedStatements m_processed;
+
 #pragma mark - Step Statement
 protected:
     bool realStep();
     bool stepInsert();
     bool stepUpdate();
+
+#pragma mark - Bulk Decompression
+protected:
+    void generateScanStatement(const StatementSelect &select);
+    bool decompressScannedRows(MultiRowsValue &rows,
+                               CompressionCenter::DecompressingContents &contents,
+                               std::vector<std::pair<size_t, int>> &positions);
+    void resetScanStatus();
+    void recordScanBinding(const Value &value, int index);
+
+    // The statement fetching rows of select with its decompressing result columns left compressed,
+    // so that getAllRows can decompress them in batch.
+    Optional<Statement> m_scanStatement;
+    std::vector<ScanColumn> m_scanColumns;
+    std::unique_ptr<HandleStatement> m_scanHandleStatement;
+    // The bindings of the select, which are bound to the scan statement again before scanning.
+    std::vector<Value> m_scanBindings;
+    bool m_scanBindingsRecorded;
+    bool m_stepped;
 };
 
 } // namespace WCDB
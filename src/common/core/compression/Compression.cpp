@@ -377,6 +377,11 @@ bool Compression::Binder::canCompressNewData() const
     return m_compression.canCompressNewData();
 }
 
+int Compression::Binder::getInfoVersion() const
+{
+    return m_compression.m_dataVersion;
+}
+
 bool Compression::canCompressNewData() const
 {
     return m_canCompressNewData;
@@ -116,6 +116,8 @@ public:
         bool hintThatTableWillBeCreated(const UnsafeStringView& table);
         void notifyTransactionCommitted(bool committed);
         bool canCompressNewData() const;
+        // It changes whenever all the infos are purged.
+        int getInfoVersion() const;
 
     private:
         Compression& m_compression;
@@ -24,10 +24,13 @@
 
 #include "CompressionCenter.hpp"
 #include "Assertion.hpp"
+#include "CoreConst.h"
 #include "InnerHandle.hpp"
 #include "Notifier.hpp"
 #include "ScalarFunctionModule.hpp"
+#include "Time.hpp"
 #include "WCDBError.hpp"
+#include "WorkerPool.hpp"
 #include <string.h>
 #if defined(WCDB_ZSTD) && WCDB_ZSTD
 #include <zstd/zdict.h>
@@ -40,11 +43,16 @@ CompressionCenter::CompressionCenter()
 {
     m_dicts = (ZSTDDict**) calloc(MaxDictId, sizeof(ZSTDDict*));
     WCTAssert(m_dicts != nullptr);
+    m_replacedDicts = new std::atomic<DictId>[MaxDictId];
+    for (DictId i = 0; i < MaxDictId; i++) {
+        m_replacedDicts[i].store(0, std::memory_order_relaxed);
+    }
 }
 
 CompressionCenter::~CompressionCenter()
 {
     free(m_dicts);
+    delete[] m_replacedDicts;
 }
 
 CompressionCenter& CompressionCenter::shared()
@@ -86,6 +94,11 @@ bool CompressionCenter::registerDict(DictId dictId, const UnsafeData& data)
         return false;
     }
     if (m_dicts[dict->getDictId()] != nullptr) {
+        // Registering the same dict again is allowed, which happens when a retrained dict is restored.
+        if (m_dicts[dict->getDictId()]->getData() == dict->getData()) {
+            delete dict;
+            return true;
+        }
         Error error(Error::Code::ZstdError, Error::Level::Error, "Duplicate dictid!");
         error.infos.insert_or_assign("DictId", dict->getDictId());
         Notifier::shared().notify(error);
@@ -97,21 +110,174 @@ bool CompressionCenter::registerDict(DictId dictId, const UnsafeData& data)
     return true;
 }
 
-#if defined(WCDB_ZSTD) && WCDB_ZSTD
-
-Optional<Data> CompressionCenter::trainDict(DictId dictId, TrainDataEnumerator dataEnummerator)
+bool CompressionCenter::checkDictId(DictId dictId)
 {
     if (dictId == 0 || dictId >= MaxDictId) {
         Error error(Error::Code::ZstdError, Error::Level::Error, "DictId must be an integer between 1 and 999");
         error.infos.insert_or_assign("CurrendDictId", dictId);
         Notifier::shared().notify(error);
         SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return false;
+    }
+    return true;
+}
+
+#pragma mark - Replacement
+bool CompressionCenter::replaceDict(DictId dictId, DictId newDictId)
+{
+    if (!checkDictId(dictId) || !checkDictId(newDictId)) {
+        return false;
+    }
+    if (getDict(dictId) == nullptr || getDict(newDictId) == nullptr) {
+        Error error(Error::Code::ZstdError, Error::Level::Error, "Dict must be registered before replacing!");
+        error.infos.insert_or_assign("DictId", dictId);
+        error.infos.insert_or_assign("NewDictId", newDictId);
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return false;
+    }
+    std::unique_lock<std::mutex> lockGuard(m_replacementLock);
+    for (DictId id = newDictId; id != 0; id = m_replacedDicts[id].load()) {
+        if (id == dictId) {
+            Error error(Error::Code::ZstdError, Error::Level::Error, "Circular dict replacement!");
+            error.infos.insert_or_assign("DictId", dictId);
+            error.infos.insert_or_assign("NewDictId", newDictId);
+            Notifier::shared().notify(error);
+            SharedThreadedErrorProne::setThreadedError(std::move(error));
+            return false;
+        }
+    }
+    m_replacedDicts[dictId].store(newDictId);
+    return true;
+}
+
+CompressionCenter::DictId CompressionCenter::getCurrentDictId(DictId dictId) const
+{
+    if (dictId == 0 || dictId >= MaxDictId) {
+        return dictId;
+    }
+    DictId replacedDictId = 0;
+    while ((replacedDictId = m_replacedDicts[dictId].load()) != 0) {
+        dictId = replacedDictId;
+    }
+    return dictId;
+}
+
+#pragma mark - Retraining
+Optional<CompressionCenter::DictEvaluation>
+CompressionCenter::evaluateDict(DictId dictId, const Samples& samples)
+{
+    ZSTDDict* dict = getDict(dictId);
+    if (dict == nullptr) {
+        Error error(Error::Code::ZstdError, Error::Level::Error, "Can not find dict to evaluate!");
+        error.infos.insert_or_assign("DictId", dictId);
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return NullOpt;
+    }
+    return evaluateDict(*dict, samples);
+}
+
+Optional<CompressionCenter::DictEvaluation>
+CompressionCenter::evaluateDict(const UnsafeData& data, const Samples& samples)
+{
+    ZSTDDict dict;
+    if (!dict.loadData(data)) {
+        return NullOpt;
+    }
+    return evaluateDict(dict, samples);
+}
+
+Optional<Data> CompressionCenter::retrainDict(DictId currentDictId,
+                                              DictId newDictId,
+                                              const Samples& samples,
+                                              const DictRetrainingConfig& config)
+{
+    WCTRemedialAssert(config.holdOutInterval > 1 && !config.candidateDictSizes.empty(),
+                      "Invalid dict retraining config.",
+                      return NullOpt;);
+    if (!checkDictId(currentDictId) || !checkDictId(newDictId)) {
+        return NullOpt;
+    }
+    Samples trainingSamples;
+    Samples holdOutSamples;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (i % config.holdOutInterval == config.holdOutInterval - 1) {
+            holdOutSamples.push_back(samples[i]);
+        } else {
+            trainingSamples.push_back(samples[i]);
+        }
+    }
+    if (holdOutSamples.empty()) {
+        Error error(Error::Code::ZstdError, Error::Level::Error, "Too few samples to retrain dict!");
+        error.infos.insert_or_assign("SampleCount", samples.size());
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return NullOpt;
+    }
+
+    // Compare with the dict currently used instead of the original one.
+    currentDictId = getCurrentDictId(currentDictId);
+    Optional<DictEvaluation> current = evaluateDict(currentDictId, holdOutSamples);
+    if (current.failed()) {
+        return NullOpt;
+    }
+    double minRatio = current.value().compressionRatio * (1 + config.minRatioGain);
+    double minSpeed = current.value().decompressSpeed * config.minSpeedRatio;
+
+    bool trained = false;
+    Optional<Data> winner;
+    double winnerRatio = 0;
+    for (size_t dictSize : config.candidateDictSizes) {
+        size_t index = 0;
+        Optional<Data> candidate = trainDict(
+        newDictId,
+        [&]() -> Optional<UnsafeData> {
+            if (index < trainingSamples.size()) {
+                return trainingSamples[index++];
+            }
+            return NullOpt;
+        },
+        dictSize);
+        if (candidate.failed()) {
+            // Training may fail for some sizes if the samples are not enough.
+            continue;
+        }
+        trained = true;
+        Optional<DictEvaluation> evaluation = evaluateDict(candidate.value(), holdOutSamples);
+        if (evaluation.failed()) {
+            return NullOpt;
+        }
+        double ratio = evaluation.value().compressionRatio;
+        if (ratio >= minRatio && ratio > winnerRatio
+            && evaluation.value().decompressSpeed >= minSpeed) {
+            winnerRatio = ratio;
+            winner = std::move(candidate.value());
+        }
+    }
+    if (!trained) {
+        return NullOpt;
+    }
+    if (!winner.hasValue()) {
+        return Data();
+    }
+    if (!registerDict(newDictId, winner.value()) || !replaceDict(currentDictId, newDictId)) {
+        return NullOpt;
+    }
+    return winner;
+}
+
+#if defined(WCDB_ZSTD) && WCDB_ZSTD
+
+Optional<Data>
+CompressionCenter::trainDict(DictId dictId, TrainDataEnumerator dataEnummerator, size_t dictSize)
+{
+    if (!checkDictId(dictId)) {
         return NullOpt;
     }
     size_t totalSize = 0;
     std::vector<size_t> dataSizes;
 
-    size_t dictSize = 100 * 1024;
     Data dict(dictSize);
     if (dict.empty()) {
         return NullOpt;
@@ -170,8 +336,10 @@ Optional<Data> CompressionCenter::trainDict(DictId dictId, TrainDataEnumerator d
     return dict;
 }
 
-Optional<UnsafeData>
-CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerHandle* errorReportHandle)
+Optional<UnsafeData> CompressionCenter::compressContent(const UnsafeData& data,
+                                                        DictId dictId,
+                                                        InnerHandle* errorReportHandle,
+                                                        int level)
 {
     if (data.size() == 0) {
         return data;
@@ -194,7 +362,7 @@ CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerH
     }
     int64_t compressSize = 0;
     if (dictId > 0) {
-        ZSTDDict* dict = getDict(dictId);
+        ZSTDDict* dict = getDict(getCurrentDictId(dictId));
         if (dict == nullptr) {
             errorReportHandle->notifyError(
             Error::Code::ZstdError,
@@ -202,13 +370,19 @@ CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerH
             StringView::formatted("Can not find compress dict with id: %d", dictId));
             return NullOpt;
         }
-        compressSize = ZSTD_compress_usingCDict((ZSTD_CCtx*) ctx.getOrCreateCCtx(),
-                                                buffer,
-                                                boundSize,
-                                                data.buffer(),
-                                                data.size(),
-                                                (ZSTD_CDict*) dict->getCDict());
+        ZSTD_CDict* cDict = (ZSTD_CDict*) dict->getCDict(level);
+        if (cDict == nullptr) {
+            errorReportHandle->notifyError(
+            Error::Code::ZstdError,
+            nullptr,
+            StringView::formatted("Can not create compress dict of level %d with id: %d", level, dictId));
+            return NullOpt;
+        }
+        compressSize = ZSTD_compress_usingCDict(
+        (ZSTD_CCtx*) ctx.getOrCreateCCtx(), buffer, boundSize, data.buffer(), data.size(), cDict);
     } else {
+        // The level is a sticky parameter of context, so it's set every time.
+        ZSTD_CCtx_setParameter((ZSTD_CCtx*) ctx.getOrCreateCCtx(), ZSTD_c_compressionLevel, level);
         compressSize = ZSTD_compress2((ZSTD_CCtx*) ctx.getOrCreateCCtx(),
                                       buffer,
                                       boundSize,
@@ -228,6 +402,78 @@ CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerH
     return UnsafeData((unsigned char*) buffer, compressSize);
 }
 
+Optional<CompressionCenter::DictEvaluation>
+CompressionCenter::evaluateDict(const ZSTDDict& dict, const Samples& samples)
+{
+    size_t totalSize = 0;
+    size_t maxSize = 0;
+    size_t boundSize = 0;
+    for (const UnsafeData& sample : samples) {
+        totalSize += sample.size();
+        maxSize = std::max(maxSize, sample.size());
+        boundSize += ZSTD_compressBound(sample.size());
+    }
+    if (totalSize == 0) {
+        Error error(Error::Code::ZstdError, Error::Level::Error, "No content to evaluate dict!");
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return NullOpt;
+    }
+    Data compressed(boundSize);
+    Data decompressed(maxSize);
+    if (compressed.empty() || decompressed.empty()) {
+        return NullOpt;
+    }
+    ZSTDContext& ctx = m_ctxes.getOrCreate();
+    std::vector<size_t> compressedSizes;
+    compressedSizes.reserve(samples.size());
+    size_t offset = 0;
+    for (const UnsafeData& sample : samples) {
+        size_t ret = ZSTD_compress_usingCDict((ZSTD_CCtx*) ctx.getOrCreateCCtx(),
+                                              compressed.buffer() + offset,
+                                              compressed.size() - offset,
+                                              sample.buffer(),
+                                              sample.size(),
+                                              (ZSTD_CDict*) dict.getCDict());
+        if (ZSTD_isError(ret)) {
+            Error error(Error::Code::ZstdError, Error::Level::Error, "Compress fail when evaluating dict");
+            error.infos.insert_or_assign("ZSTDErrorCode", ret);
+            error.infos.insert_or_assign("ZSTDErrorName", ZSTD_getErrorName(ret));
+            Notifier::shared().notify(error);
+            SharedThreadedErrorProne::setThreadedError(std::move(error));
+            return NullOpt;
+        }
+        compressedSizes.push_back(ret);
+        offset += ret;
+    }
+
+    SteadyClock start = SteadyClock::now();
+    offset = 0;
+    for (size_t compressedSize : compressedSizes) {
+        size_t ret = ZSTD_decompress_usingDDict((ZSTD_DCtx*) ctx.getOrCreateDCtx(),
+                                                decompressed.buffer(),
+                                                decompressed.size(),
+                                                compressed.buffer() + offset,
+                                                compressedSize,
+                                                (ZSTD_DDict*) dict.getDDict());
+        if (ZSTD_isError(ret)) {
+            Error error(Error::Code::ZstdError, Error::Level::Error, "Decompress fail when evaluating dict");
+            error.infos.insert_or_assign("ZSTDErrorCode", ret);
+            error.infos.insert_or_assign("ZSTDErrorName", ZSTD_getErrorName(ret));
+            Notifier::shared().notify(error);
+            SharedThreadedErrorProne::setThreadedError(std::move(error));
+            return NullOpt;
+        }
+        offset += compressedSize;
+    }
+    double cost = std::max(SteadyClock::timeIntervalSinceSteadyClockToNow(start), 1e-9);
+
+    DictEvaluation evaluation;
+    evaluation.compressionRatio = (double) totalSize / offset;
+    evaluation.decompressSpeed = totalSize / cost;
+    return evaluation;
+}
+
 void CompressionCenter::decompressContent(const UnsafeData& data,
                                           bool usingDict,
                                           ColumnType originType,
@@ -290,6 +536,12 @@ void CompressionCenter::decompressContent(const UnsafeData& data,
 bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
                                                      bool usingDict,
                                                      InnerHandle* errorReportHandle)
+{
+    return decompressContent(data, usingDict, errorReportHandle).succeed();
+}
+
+Optional<UnsafeData>
+CompressionCenter::decompressContent(const UnsafeData& data, bool usingDict, InnerHandle* errorReportHandle)
 {
     int64_t frameSize = ZSTD_getFrameContentSize(data.buffer(), data.size());
     if (ZSTD_isError(frameSize)) {
@@ -297,21 +549,21 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
         Error::Code::ZstdError,
         StringView::formatted("Get compress content frame size fail: %s",
                               ZSTD_getErrorName(frameSize)));
-        return false;
+        return NullOpt;
     }
     ZSTDContext& ctx = m_ctxes.getOrCreate();
     void* buffer = ctx.getOrCreateBuffer(frameSize);
     if (buffer == nullptr) {
         errorReportHandle->notifyError(
         Error::Code::NoMemory, "", "Decompress fail due to no memory");
-        return false;
+        return NullOpt;
     }
     int64_t decompressSize = 0;
     if (usingDict) {
         DictId dictId = ZSTD_getDictID_fromFrame(data.buffer(), data.size());
         if (dictId == 0) {
             errorReportHandle->notifyError(Error::Code::ZstdError, "", "Can not decode dictid");
-            return false;
+            return NullOpt;
         }
         ZSTDDict* dict = getDict(dictId);
         if (dict == nullptr) {
@@ -319,7 +571,7 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
             Error::Code::ZstdError,
             "",
             StringView::formatted("Can not find decompress dict with id: %d", dictId));
-            return false;
+            return NullOpt;
         }
         decompressSize = ZSTD_decompress_usingDDict((ZSTD_DCtx*) ctx.getOrCreateDCtx(),
                                                     buffer,
@@ -340,6 +592,210 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
         Error::Code::ZstdError,
         "",
         StringView::formatted("Decompress fail: %s", ZSTD_getErrorName(decompressSize)));
+        return NullOpt;
+    }
+    return UnsafeData((unsigned char*) buffer, decompressSize);
+}
+
+bool CompressionCenter::decompressContents(DecompressingContents& contents,
+                                           InnerHandle* errorReportHandle)
+{
+    // Resolve the dicts of the whole batch once instead of once per content.
+    ResolvedDicts dicts;
+    size_t totalSize = 0;
+    for (const auto& content : contents) {
+        totalSize += content.data.size();
+        if (!content.usingDict) {
+            continue;
+        }
+        DictId dictId = ZSTD_getDictID_fromFrame(content.data.buffer(), content.data.size());
+        if (dictId == 0) {
+            errorReportHandle->notifyError(Error::Code::ZstdError, "", "Can not decode dictid");
+            return false;
+        }
+        if (dicts.find(dictId) != dicts.end()) {
+            continue;
+        }
+        ZSTDDict* dict = getDict(dictId);
+        if (dict == nullptr) {
+            errorReportHandle->notifyError(
+            Error::Code::ZstdError,
+            "",
+            StringView::formatted("Can not find decompress dict with id: %d", dictId));
+            return false;
+        }
+        dicts.emplace(dictId, dict);
+    }
+
+    size_t numberOfWorkers
+    = std::min<size_t>(std::min<size_t>(totalSize / CompressionParallelDecompressionSize,
+                                        contents.size()),
+                       CompressionMaxDecompressionWorkers);
+    Error error;
+    if (numberOfWorkers <= 1) {
+        if (!decompressContents(contents.begin(), contents.end(), dicts, error)) {
+            errorReportHandle->notifyError(error.code(), "", error.getMessage());
+            return false;
+        }
+        return true;
+    }
+
+    // Each slice is decompressed with the context of the thread running it, which is reused across batches by the long-lived workers.
+    size_t sliceSize = (contents.size() + numberOfWorkers - 1) / numberOfWorkers;
+    std::vector<Error> errors(numberOfWorkers);
+    std::vector<char> results(numberOfWorkers, false);
+    WorkerPool::shared().parallelFor(
+    numberOfWorkers, numberOfWorkers, [this, &contents, sliceSize, &dicts, &errors, &results](size_t index) {
+        auto sliceBegin = contents.begin() + std::min(index * sliceSize, contents.size());
+        auto sliceEnd = contents.begin() + std::min((index + 1) * sliceSize, contents.size());
+        results[index] = decompressContents(sliceBegin, sliceEnd, dicts, errors[index]);
+    });
+    bool succeed = true;
+    for (size_t i = 0; i < numberOfWorkers; i++) {
+        if (!results[i]) {
+            succeed = false;
+            error = errors[i];
+            break;
+        }
+    }
+    if (!succeed) {
+        errorReportHandle->notifyError(error.code(), "", error.getMessage());
+    }
+    return succeed;
+}
+
+bool CompressionCenter::decompressContents(DecompressingContents::iterator begin,
+                                           DecompressingContents::iterator end,
+                                           const ResolvedDicts& dicts,
+                                           Error& error)
+{
+    ZSTDContext& ctx = m_ctxes.getOrCreate();
+    ZSTD_DCtx* dctx = (ZSTD_DCtx*) ctx.getOrCreateDCtx();
+    if (dctx == nullptr) {
+        error = Error(Error::Code::NoMemory, Error::Level::Error, "Decompress fail due to no memory");
+        return false;
+    }
+    for (auto iter = begin; iter != end; iter++) {
+        const UnsafeData& data = iter->data;
+        int64_t frameSize = ZSTD_getFrameContentSize(data.buffer(), data.size());
+        if (ZSTD_isError(frameSize)) {
+            error = Error(Error::Code::ZstdError,
+                          Error::Level::Error,
+                          StringView::formatted("Get compress content frame size fail: %s",
+                                                ZSTD_getErrorName(frameSize)));
+            return false;
+        }
+        // BLOB is decompressed into its result directly, while text is copied from the context buffer.
+        Data blob;
+        void* buffer = nullptr;
+        if (iter->originType == ColumnType::Text) {
+            buffer = ctx.getOrCreateBuffer(frameSize);
+        } else if (frameSize > 0 && blob.resize(frameSize)) {
+            buffer = blob.buffer();
+        }
+        if (buffer == nullptr && frameSize > 0) {
+            error = Error(Error::Code::NoMemory, Error::Level::Error, "Decompress fail due to no memory");
+            return false;
+        }
+        int64_t decompressSize = 0;
+        if (iter->usingDict) {
+            auto dictIter = dicts.find(ZSTD_getDictID_fromFrame(data.buffer(), data.size()));
+            WCTAssert(dictIter != dicts.end());
+            decompressSize = ZSTD_decompress_usingDDict(dctx,
+                                                        buffer,
+                                                        frameSize,
+                                                        data.buffer(),
+                                                        data.size(),
+                                                        (ZSTD_DDict*) dictIter->second->getDDict());
+        } else {
+            decompressSize
+            = ZSTD_decompressDCtx(dctx, buffer, frameSize, data.buffer(), data.size());
+        }
+        if (ZSTD_isError(decompressSize)) {
+            error = Error(
+            Error::Code::ZstdError,
+            Error::Level::Error,
+            StringView::formatted("Decompress fail: %s", ZSTD_getErrorName(decompressSize)));
+            return false;
+        }
+        if (iter->originType == ColumnType::Text) {
+            iter->result = UnsafeStringView((const char*) buffer, decompressSize);
+        } else {
+            WCTAssert(decompressSize == frameSize);
+            iter->result = blob;
+        }
+    }
+    return true;
+}
+
+bool CompressionCenter::decompressStream(const StreamInput& input,
+                                         bool usingDict,
+                                         const StreamOutput& output,
+                                         AbstractHandle* errorReportHandle)
+{
+    Optional<UnsafeData> chunk = input();
+    if (!chunk.succeed()) {
+        return false;
+    }
+    ZSTDContext& ctx = m_ctxes.getOrCreate();
+    ZSTD_DCtx* dctx = (ZSTD_DCtx*) ctx.getOrCreateDCtx();
+    if (dctx == nullptr) {
+        errorReportHandle->notifyError(
+        Error::Code::NoMemory, "", "Decompress fail due to no memory");
+        return false;
+    }
+    ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+    if (usingDict) {
+        DictId dictId = ZSTD_getDictID_fromFrame(chunk->buffer(), chunk->size());
+        if (dictId == 0) {
+            errorReportHandle->notifyError(Error::Code::ZstdError, "", "Can not decode dictid");
+            return false;
+        }
+        ZSTDDict* dict = getDict(dictId);
+        if (dict == nullptr) {
+            errorReportHandle->notifyError(
+            Error::Code::ZstdError,
+            "",
+            StringView::formatted("Can not find decompress dict with id: %d", dictId));
+            return false;
+        }
+        ZSTD_DCtx_refDDict(dctx, (ZSTD_DDict*) dict->getDDict());
+    }
+    size_t outputSize = ZSTD_DStreamOutSize();
+    void* buffer = ctx.getOrCreateBuffer(outputSize);
+    if (buffer == nullptr) {
+        errorReportHandle->notifyError(
+        Error::Code::NoMemory, "", "Decompress fail due to no memory");
+        return false;
+    }
+    size_t ret = 0;
+    while (chunk->size() > 0) {
+        ZSTD_inBuffer inBuffer = { chunk->buffer(), chunk->size(), 0 };
+        ZSTD_outBuffer outBuffer;
+        do {
+            outBuffer = { buffer, outputSize, 0 };
+            ret = ZSTD_decompressStream(dctx, &outBuffer, &inBuffer);
+            if (ZSTD_isError(ret)) {
+                errorReportHandle->notifyError(
+                Error::Code::ZstdError,
+                "",
+                StringView::formatted("Decompress fail: %s", ZSTD_getErrorName(ret)));
+                return false;
+            }
+            if (outBuffer.pos > 0
+                && !output(UnsafeData::immutable((const unsigned char*) buffer, outBuffer.pos))) {
+                return true;
+            }
+            // Output buffer is full means that there might be more flushable content.
+        } while (inBuffer.pos < inBuffer.size || outBuffer.pos == outBuffer.size);
+        chunk = input();
+        if (!chunk.succeed()) {
+            return false;
+        }
+    }
+    if (ret != 0) {
+        errorReportHandle->notifyError(
+        Error::Code::ZstdError, "", "Decompress fail: incomplete frame");
         return false;
     }
     return true;
@@ -347,7 +803,16 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
 
 #else
 
-Optional<Data> CompressionCenter::trainDict(DictId, TrainDataEnumerator)
+Optional<Data> CompressionCenter::trainDict(DictId, TrainDataEnumerator, size_t)
+{
+    Error error(Error::Code::ZstdError, Error::Level::Error, "You need to build WCDB with WCDB_ZSTD macro");
+    Notifier::shared().notify(error);
+    SharedThreadedErrorProne::setThreadedError(std::move(error));
+    return NullOpt;
+}
+
+Optional<CompressionCenter::DictEvaluation>
+CompressionCenter::evaluateDict(const ZSTDDict&, const Samples&)
 {
     Error error(Error::Code::ZstdError, Error::Level::Error, "You need to build WCDB with WCDB_ZSTD macro");
     Notifier::shared().notify(error);
@@ -356,7 +821,7 @@ Optional<Data> CompressionCenter::trainDict(DictId, TrainDataEnumerator)
 }
 
 Optional<UnsafeData>
-CompressionCenter::compressContent(const UnsafeData&, DictId, InnerHandle* errorReportHandle)
+CompressionCenter::compressContent(const UnsafeData&, DictId, InnerHandle* errorReportHandle, int)
 {
     errorReportHandle->notifyError(
     Error::Code::ZstdError, nullptr, "You need to build WCDB with WCDB_ZSTD macro");
@@ -376,6 +841,39 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData&, bool, In
     return false;
 }
 
+Optional<UnsafeData>
+CompressionCenter::decompressContent(const UnsafeData&, bool, InnerHandle* errorReportHandle)
+{
+    errorReportHandle->notifyError(
+    Error::Code::ZstdError, "", "You need to build WCDB with WCDB_ZSTD macro");
+    return NullOpt;
+}
+
+bool CompressionCenter::decompressContents(DecompressingContents&, InnerHandle* errorReportHandle)
+{
+    errorReportHandle->notifyError(
+    Error::Code::ZstdError, "", "You need to build WCDB with WCDB_ZSTD macro");
+    return false;
+}
+
+bool CompressionCenter::decompressContents(DecompressingContents::iterator,
+                                           DecompressingContents::iterator,
+                                           const ResolvedDicts&,
+                                           Error&)
+{
+    return false;
+}
+
+bool CompressionCenter::decompressStream(const StreamInput&,
+                                         bool,
+                                         const StreamOutput&,
+                                         AbstractHandle* errorReportHandle)
+{
+    errorReportHandle->notifyError(
+    Error::Code::ZstdError, "", "You need to build WCDB with WCDB_ZSTD macro");
+    return false;
+}
+
 #endif
 
 } // namespace WCDB
@@ -27,14 +27,21 @@
 #include "ColumnType.hpp"
 #include "CompressionConst.hpp"
 #include "ThreadLocal.hpp"
+#include "Value.hpp"
 #include "ZSTDContext.hpp"
 #include "ZSTDDict.hpp"
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace WCDB {
 
 class ScalarFunctionAPI;
 class InnerHandle;
+class Error;
+class AbstractHandle;
 
 class CompressionCenter : public SharedThreadedErrorProne {
 public:
@@ -49,23 +56,93 @@ public:
     static constexpr const DictId MaxDictId = 1000;
 
     bool registerDict(DictId dictId, const UnsafeData& data);
+    static constexpr const size_t DefaultDictSize = 100 * 1024;
     typedef std::function<Optional<UnsafeData>()> TrainDataEnumerator;
-    Optional<Data> trainDict(DictId dictId, TrainDataEnumerator dataEnummerator);
+    Optional<Data> trainDict(DictId dictId,
+                             TrainDataEnumerator dataEnummerator,
+                             size_t dictSize = DefaultDictSize);
 
-    Optional<UnsafeData>
-    compressContent(const UnsafeData& data, DictId dictId, InnerHandle* errorReportHandle);
+    // Content compressed with `dictId` afterward uses `newDictId` instead.
+    // Content compressed before is still decompressed with the dict recorded in its frame.
+    bool replaceDict(DictId dictId, DictId newDictId);
+    DictId getCurrentDictId(DictId dictId) const;
+
+    typedef std::vector<UnsafeData> Samples;
+    struct DictEvaluation {
+        double compressionRatio = 0; // total size of samples / total size of compressed samples
+        double decompressSpeed = 0;  // bytes of decompressed content per second
+    };
+    Optional<DictEvaluation> evaluateDict(DictId dictId, const Samples& samples);
+    Optional<DictEvaluation> evaluateDict(const UnsafeData& dict, const Samples& samples);
+
+    struct DictRetrainingConfig {
+        size_t sampleCount = 4000;
+        // One out of every `holdOutInterval` samples is used to evaluate instead of training.
+        size_t holdOutInterval = 10;
+        std::vector<size_t> candidateDictSizes = { 16 * 1024, 64 * 1024, DefaultDictSize };
+        // Minimum gain of compression ratio for a candidate to replace the current dict.
+        double minRatioGain = 0.02;
+        // Minimum decompression speed of a candidate relative to the current dict.
+        double minSpeedRatio = 0.8;
+    };
+    // Train candidates from samples and evaluate them against the current dict on the hold-out samples.
+    // The best candidate is registered as `newDictId` and replaces `currentDictId` if it wins.
+    // Returns the data of the new dict, or an empty data if the current dict is kept.
+    // The registration and replacement only live in memory, so the new dict must be persisted by caller,
+    // and registered and replaced again at launch before any content compressed with it is read.
+    Optional<Data> retrainDict(DictId currentDictId,
+                               DictId newDictId,
+                               const Samples& samples,
+                               const DictRetrainingConfig& config);
+
+    Optional<UnsafeData> compressContent(const UnsafeData& data,
+                                         DictId dictId,
+                                         InnerHandle* errorReportHandle,
+                                         int level = CompressionDefaultLevel);
     void decompressContent(const UnsafeData& data,
                            bool usingDict,
                            ColumnType originType,
                            ScalarFunctionAPI& resultAPI);
+    // The result is only valid until the next compression or decompression in current thread.
+    Optional<UnsafeData>
+    decompressContent(const UnsafeData& data, bool usingDict, InnerHandle* errorReportHandle);
+
+    struct DecompressingContent {
+        UnsafeData data;
+        bool usingDict = false;
+        ColumnType originType = ColumnType::BLOB;
+        Value result;
+    };
+    typedef std::vector<DecompressingContent> DecompressingContents;
+    // Decompress a batch of contents into their results at once.
+    // Dicts are resolved once per distinct dict id, and a large batch is split across worker threads.
+    bool decompressContents(DecompressingContents& contents, InnerHandle* errorReportHandle);
 
     bool testContentCanBeDecompressed(const UnsafeData& data,
                                       bool usingDict,
                                       InnerHandle* errorReportHandle);
 
+    // Input returns an empty data when there is no more content.
+    typedef std::function<Optional<UnsafeData>()> StreamInput;
+    typedef std::function<bool(const UnsafeData&)> StreamOutput;
+    // Decompress the frame chunk by chunk with constant memory.
+    bool decompressStream(const StreamInput& input,
+                          bool usingDict,
+                          const StreamOutput& output,
+                          AbstractHandle* errorReportHandle);
+
 private:
     ZSTDDict* getDict(DictId id) const;
     ZSTDDict** m_dicts;
+    std::atomic<DictId>* m_replacedDicts;
+    std::mutex m_replacementLock;
+    bool checkDictId(DictId dictId);
+    Optional<DictEvaluation> evaluateDict(const ZSTDDict& dict, const Samples& samples);
+    typedef std::map<DictId, const ZSTDDict*> ResolvedDicts;
+    bool decompressContents(DecompressingContents::iterator begin,
+                            DecompressingContents::iterator end,
+                            const ResolvedDicts& dicts,
+                            Error& error);
     ThreadLocal<ZSTDContext> m_ctxes;
 };
 
@@ -42,6 +42,8 @@ enum class CompressedType {
 #define WCDBGetOriginType(mergeType)                                           \
     ((((mergeType) &0x1) > 0) ? WCDB::ColumnType::BLOB : WCDB::ColumnType::Text)
 
+static constexpr const int CompressionDefaultLevel = 3;
+
 WCDBLiteralStringDefine(DecompressFunctionName, "wcdb_decompress");
 
 WCDBLiteralStringDefine(CompressionRecordTable, "wcdb_builtin_compression_record");
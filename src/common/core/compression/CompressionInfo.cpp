@@ -41,6 +41,7 @@ CompressionColumnInfo::CompressionColumnInfo(const Column &column, CompressionTy
 , m_matchColumnIndex(UINT16_MAX)
 , m_compressionType(type)
 , m_commonDictID(-1)
+, m_backgroundLevel(0)
 {
     std::ostringstream stringStream;
     stringStream << CompressionColumnTypePrefix << column.syntax().name;
@@ -56,6 +57,7 @@ CompressionColumnInfo::CompressionColumnInfo(const Column &column, const Column
 , m_matchColumnIndex(UINT16_MAX)
 , m_compressionType(CompressionType::VariousDict)
 , m_commonDictID(-1)
+, m_backgroundLevel(0)
 {
     std::ostringstream stringStream;
     stringStream << CompressionColumnTypePrefix << column.syntax().name;
@@ -73,6 +75,8 @@ CompressionColumnInfo::CompressionColumnInfo(const CompressionColumnInfo &other)
 , m_compressionType(other.m_compressionType)
 , m_commonDictID(other.m_commonDictID)
 , m_matchDicts(other.m_matchDicts)
+, m_policy(other.m_policy)
+, m_backgroundLevel(other.m_backgroundLevel.load())
 {
 }
 
@@ -86,6 +90,8 @@ CompressionColumnInfo::CompressionColumnInfo(CompressionColumnInfo &&other)
 , m_compressionType(other.m_compressionType)
 , m_commonDictID(other.m_commonDictID)
 , m_matchDicts(std::move(other.m_matchDicts))
+, m_policy(std::move(other.m_policy))
+, m_backgroundLevel(other.m_backgroundLevel.load())
 {
 }
 
@@ -171,6 +177,27 @@ void CompressionColumnInfo::addMatchDict(const Integer &matchValue, DictId dictI
     m_matchDicts[matchValue] = dictId;
 }
 
+const CompressionPolicy &CompressionColumnInfo::getPolicy() const
+{
+    return m_policy;
+}
+
+void CompressionColumnInfo::setPolicy(const CompressionPolicy &policy)
+{
+    m_policy = policy;
+    m_backgroundLevel = policy.backgroundLevels.size() == 1 ? policy.backgroundLevels.front() : 0;
+}
+
+int CompressionColumnInfo::getBackgroundLevel() const
+{
+    return m_backgroundLevel;
+}
+
+void CompressionColumnInfo::setBackgroundLevel(int level) const
+{
+    m_backgroundLevel = level;
+}
+
 #pragma mark - CompressionTableBaseInfo
 CompressionTableBaseInfo::CompressionTableBaseInfo(const UnsafeStringView &table)
 : m_table(table)
@@ -205,11 +232,27 @@ void CompressionTableUserInfo::addCompressingColumn(const CompressionColumnInfo
     m_compressingColumns.push_back(info);
 }
 
+void CompressionTableUserInfo::setCompressionPolicy(const Column &column,
+                                                    const CompressionPolicy &policy)
+{
+    WCTRemedialAssert(!policy.backgroundLevels.empty(),
+                      "Background levels can't be empty.",
+                      return;);
+    for (auto &compressingColumn : m_compressingColumns) {
+        if (compressingColumn.getColumn().syntax().name.equal(column.syntax().name)) {
+            compressingColumn.setPolicy(policy);
+            return;
+        }
+    }
+    WCTRemedialAssert(false, "Column must be configured to compress before setting policy.", return;);
+}
+
 #pragma mark - CompressionTableInfo
 CompressionTableInfo::CompressionTableInfo(const CompressionTableUserInfo &userInfo)
 : CompressionTableBaseInfo(userInfo)
 , m_minCompressedRowid(INT64_MAX)
 , m_needCheckColumn(true)
+, m_maxRecompressedRowid(INT64_MAX)
 {
 }
 
@@ -238,6 +281,29 @@ void CompressionTableInfo::setNeedCheckColumns(bool needCheck) const
     m_needCheckColumn = needCheck;
 }
 
+bool CompressionTableInfo::needRecompress() const
+{
+    if (m_maxRecompressedRowid <= 0) {
+        return false;
+    }
+    for (const auto &column : m_compressingColumns) {
+        if (column.getPolicy().recompress) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CompressionTableInfo::setMaxRecompressedRowid(int64_t rowid) const
+{
+    m_maxRecompressedRowid = rowid;
+}
+
+int64_t CompressionTableInfo::getMaxRecompressedRowid() const
+{
+    return m_maxRecompressedRowid;
+}
+
 #pragma mark - Compress Statements
 
 StatementSelect CompressionTableInfo::getSelectUncompressRowIdStatement() const
@@ -305,6 +371,27 @@ CompressionTableInfo::getUpdateUncompressRowStatement(ColumnInfoPtrList *columnL
     return update;
 }
 
+StatementSelect
+CompressionTableInfo::getSelectRecompressRowsStatement(ColumnInfoPtrList *columnList) const
+{
+    ResultColumns resultColumns = { Column::rowid() };
+    ColumnInfoIter columnIter(&m_compressingColumns, columnList);
+    const CompressionColumnInfo *column = nullptr;
+    while ((column = columnIter.nextInfo()) != nullptr) {
+        resultColumns.push_back(column->getColumn());
+        resultColumns.push_back(column->getTypeColumn());
+        if (column->getCompressionType() == CompressionType::VariousDict) {
+            resultColumns.push_back(column->getMatchColumn());
+        }
+    }
+    return StatementSelect()
+    .select(resultColumns)
+    .from(m_table)
+    .where(Column::rowid() < BindParameter())
+    .order(Column::rowid().asOrder(Order::DESC))
+    .limit(CompressionBatchCount);
+}
+
 bool CompressionTableInfo::stepSelectAndUpdateUncompressRowStatement(
 HandleStatement *select, HandleStatement *update, int64_t rowid, ColumnInfoPtrList *columnList) const
 {
@@ -331,27 +418,27 @@ HandleStatement *select, HandleStatement *update, int64_t rowid, ColumnInfoPtrLi
 
         if (valueType >= ColumnType::Text && isUncompressed) {
             UnsafeData value = select->getBLOB(selectIndex);
-            Optional<UnsafeData> compressedValue;
             CompressedType compressedType = CompressedType::ZSTDDict;
+            CompressionColumnInfo::DictId dictId = 0;
             switch (column->getCompressionType()) {
             case CompressionType::Normal: {
                 compressedType = CompressedType::ZSTDNormal;
-                compressedValue = CompressionCenter::shared().compressContent(
-                value, 0, static_cast<InnerHandle *>(select->getHandle()));
             } break;
             case CompressionType::Dict: {
-                compressedValue = CompressionCenter::shared().compressContent(
-                value, column->getDictId(), static_cast<InnerHandle *>(select->getHandle()));
+                dictId = column->getDictId();
             } break;
             case CompressionType::VariousDict: {
                 int64_t matchValue = select->getInteger(selectIndex + 2);
                 preOffset++;
-                compressedValue = CompressionCenter::shared().compressContent(
-                value,
-                column->getMatchDictId(matchValue),
-                static_cast<InnerHandle *>(select->getHandle()));
+                dictId = column->getMatchDictId(matchValue);
             } break;
             }
+            const CompressionPolicy &policy = column->getPolicy();
+            Optional<UnsafeData> compressedValue = value;
+            if (value.size() >= policy.minCompressSize) {
+                compressedValue = CompressionCenter::shared().compressContent(
+                value, dictId, static_cast<InnerHandle *>(select->getHandle()), policy.writeLevel);
+            }
             if (compressedValue.failed()) {
                 return false;
             }
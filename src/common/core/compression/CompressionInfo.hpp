@@ -26,12 +26,14 @@
 
 #include "Column.hpp"
 #include "ColumnType.hpp"
+#include "CompressionConst.hpp"
 #include "StringView.hpp"
 #include "ZSTDDict.hpp"
 #include <atomic>
 #include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace WCDB {
 
@@ -43,6 +45,19 @@ enum class CompressionType {
     VariousDict,
 };
 
+struct CompressionPolicy {
+    // Content smaller than it is stored without compression.
+    size_t minCompressSize = 0;
+    // Level used when content is compressed while writing, including the rows compressed after being updated.
+    // A faster level is only used when the caller opts in.
+    int writeLevel = CompressionDefaultLevel;
+    // Candidate levels used when content is compressed in background, from low to high.
+    // The level is selected by sampling the content of column.
+    std::vector<int> backgroundLevels = { CompressionDefaultLevel, 6, 9 };
+    // Whether to recompress the content written at `writeLevel` in background.
+    bool recompress = false;
+};
+
 class CompressionColumnInfo {
 public:
     using DictId = ZSTDDict::DictId;
@@ -72,6 +87,12 @@ public:
     void setCommonDict(DictId dictId);
     void addMatchDict(const Integer &matchValue, DictId dictId);
 
+    const CompressionPolicy &getPolicy() const;
+    void setPolicy(const CompressionPolicy &policy);
+    // 0 if the background level is not selected yet.
+    int getBackgroundLevel() const;
+    void setBackgroundLevel(int level) const;
+
 private:
     Column m_column;
     mutable std::atomic_ushort m_columnIndex;
@@ -83,6 +104,9 @@ private:
     CompressionType m_compressionType;
     DictId m_commonDictID;
     std::unordered_map<Integer, DictId> m_matchDicts;
+
+    CompressionPolicy m_policy;
+    mutable std::atomic_int m_backgroundLevel;
 };
 
 class CompressionTableBaseInfo {
@@ -100,6 +124,7 @@ class CompressionTableUserInfo : public CompressionTableBaseInfo {
 public:
     CompressionTableUserInfo(const UnsafeStringView &table);
     void addCompressingColumn(const CompressionColumnInfo &info);
+    void setCompressionPolicy(const Column &column, const CompressionPolicy &policy);
 };
 
 class CompressionTableInfo : public CompressionTableBaseInfo {
@@ -119,9 +144,14 @@ public:
     bool needCheckColumns() const;
     void setNeedCheckColumns(bool needCheck) const;
 
+    bool needRecompress() const;
+    void setMaxRecompressedRowid(int64_t rowid) const;
+    int64_t getMaxRecompressedRowid() const;
+
 private:
     mutable int64_t m_minCompressedRowid;
     mutable bool m_needCheckColumn;
+    mutable int64_t m_maxRecompressedRowid;
 
 #pragma mark - Compress Statements
 public:
@@ -167,6 +197,16 @@ public:
     StatementUpdate
     getUpdateUncompressRowStatement(ColumnInfoPtrList *columnList = nullptr) const;
 
+    /*
+     SELECT rowid, compressingColumnA, WCDB_CT_compressingColumnA,
+     compressingColumnB, WCDB_CT_compressingColumnB ...
+     FROM compressingTable
+     WHERE rowid < ?
+     ORDER BY rowid DESC
+     LIMIT 100
+     */
+    StatementSelect getSelectRecompressRowsStatement(ColumnInfoPtrList *columnList) const;
+
     bool stepSelectAndUpdateUncompressRowStatement(HandleStatement *select,
                                                    HandleStatement *update,
                                                    int64_t rowid,
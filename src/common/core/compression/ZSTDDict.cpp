@@ -38,11 +38,16 @@ ZSTDDict::ZSTDDict() : m_dictId(0), m_cDict(nullptr), m_dDict(nullptr)
 }
 
 ZSTDDict::ZSTDDict(ZSTDDict&& dict)
-: m_dictId(dict.m_dictId), m_cDict(dict.m_cDict), m_dDict(dict.m_dDict)
+: m_dictId(dict.m_dictId)
+, m_cDict(dict.m_cDict)
+, m_dDict(dict.m_dDict)
+, m_data(std::move(dict.m_data))
+, m_levelCDicts(std::move(dict.m_levelCDicts))
 {
     dict.m_dictId = 0;
     dict.m_cDict = nullptr;
     dict.m_dDict = nullptr;
+    dict.m_levelCDicts.clear();
 }
 
 ZSTDDict& ZSTDDict::operator=(ZSTDDict&& other)
@@ -51,10 +56,13 @@ ZSTDDict& ZSTDDict::operator=(ZSTDDict&& other)
     m_dictId = other.m_dictId;
     m_cDict = other.m_cDict;
     m_dDict = other.m_dDict;
+    m_data = std::move(other.m_data);
+    m_levelCDicts = std::move(other.m_levelCDicts);
 
     other.m_dictId = 0;
     other.m_cDict = nullptr;
     other.m_dDict = nullptr;
+    other.m_levelCDicts.clear();
 
     return *this;
 }
@@ -70,6 +78,34 @@ void ZSTDDict::clearDict()
 {
     ZSTD_freeCDict((ZSTD_CDict*) m_cDict);
     ZSTD_freeDDict((ZSTD_DDict*) m_dDict);
+    for (auto& iter : m_levelCDicts) {
+        ZSTD_freeCDict((ZSTD_CDict*) iter.second);
+    }
+    m_levelCDicts.clear();
+}
+
+ZCDict* ZSTDDict::getCDict(int level)
+{
+    if (level == ZSTD_CLEVEL_DEFAULT || m_cDict == nullptr) {
+        return m_cDict;
+    }
+    std::unique_lock<std::mutex> lockGuard(m_levelLock);
+    auto iter = m_levelCDicts.find(level);
+    if (iter != m_levelCDicts.end()) {
+        return iter->second;
+    }
+    ZCDict* cDict
+    = (ZCDict*) ZSTD_createCDict(m_data.buffer(), m_data.size(), level);
+    if (cDict == nullptr) {
+        Error error(Error::Code::ZstdError, Error::Level::Error, "Create compress dict failed!");
+        error.infos.insert_or_assign("DictSize", m_data.size());
+        error.infos.insert_or_assign("Level", level);
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return nullptr;
+    }
+    m_levelCDicts.emplace(level, cDict);
+    return cDict;
 }
 
 bool ZSTDDict::loadData(const UnsafeData& data)
@@ -107,7 +143,9 @@ bool ZSTDDict::loadData(const UnsafeData& data)
         SharedThreadedErrorProne::setThreadedError(std::move(error));
         return false;
     }
-    return true;
+    // Keep the content to create compress dicts of other levels.
+    m_data = Data(data.buffer(), data.size());
+    return m_data.size() == data.size();
 }
 
 #else
@@ -116,6 +154,11 @@ void ZSTDDict::clearDict()
 {
 }
 
+ZCDict* ZSTDDict::getCDict(int)
+{
+    return m_cDict;
+}
+
 bool ZSTDDict::loadData(const UnsafeData& data)
 {
     Error error(Error::Code::ZstdError, Error::Level::Error, "You need to build WCDB with WCDB_ZSTD macro");
@@ -132,6 +175,11 @@ ZSTDDict::DictId ZSTDDict::getDictId() const
     return m_dictId;
 }
 
+const UnsafeData& ZSTDDict::getData() const
+{
+    return m_data;
+}
+
 ZCDict* ZSTDDict::getCDict() const
 {
     return m_cDict;
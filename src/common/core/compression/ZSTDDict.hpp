@@ -29,6 +29,8 @@
 #include "StringView.hpp"
 #include "UnsafeData.hpp"
 #include "WCDBOptional.hpp"
+#include <map>
+#include <mutex>
 
 namespace WCDB {
 
@@ -49,7 +51,10 @@ public:
 
     typedef uint32_t DictId;
     DictId getDictId() const;
+    const UnsafeData& getData() const;
     ZCDict* getCDict() const;
+    // Compress dicts of levels other than the default one are created lazily.
+    ZCDict* getCDict(int level);
     ZDDcit* getDDict() const;
 
 private:
@@ -57,6 +62,9 @@ private:
     DictId m_dictId;
     ZCDict* m_cDict;
     ZDDcit* m_dDict;
+    Data m_data;
+    std::mutex m_levelLock;
+    std::map<int, ZCDict*> m_levelCDicts;
 };
 
 } //namespace WCDB
@@ -0,0 +1,102 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MmapConfig.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "FileManager.hpp"
+#include "InnerHandle.hpp"
+#include "Time.hpp"
+
+namespace WCDB {
+
+MmapConfig::MmapConfig(int64_t maxSize)
+: Config(), m_maxSize(maxSize), m_disableMmap(StatementPragma().pragma(Pragma::mmapSize()).to(0))
+{
+    WCTAssert(m_maxSize > 0);
+    ++numberOfAliveConfigs();
+}
+
+MmapConfig::~MmapConfig()
+{
+    --numberOfAliveConfigs();
+}
+
+bool MmapConfig::invoke(InnerHandle* handle)
+{
+    int64_t mmapSize = mmapSizeForHandle(handle);
+    if (mmapSize == 0) {
+        return true;
+    }
+    return handle->execute(StatementPragma().pragma(Pragma::mmapSize()).to(mmapSize));
+}
+
+bool MmapConfig::uninvoke(InnerHandle* handle)
+{
+    return handle->execute(m_disableMmap);
+}
+
+int64_t MmapConfig::mmapSizeForHandle(InnerHandle* handle) const
+{
+    if (handle->hasCipher() || isSuspended()) {
+        return 0;
+    }
+    auto fileSize = FileManager::getFileSize(handle->getPath());
+    if (!fileSize.succeed() || fileSize.value() > (size_t) m_maxSize) {
+        return 0;
+    }
+    return m_maxSize;
+}
+
+#pragma mark - Memory Pressure
+std::atomic<int>& MmapConfig::numberOfAliveConfigs()
+{
+    static std::atomic<int>* s_numberOfAliveConfigs = new std::atomic<int>(0);
+    return *s_numberOfAliveConfigs;
+}
+
+std::atomic<int64_t>& MmapConfig::suspendedUntil()
+{
+    static std::atomic<int64_t>* s_suspendedUntil = new std::atomic<int64_t>(0);
+    return *s_suspendedUntil;
+}
+
+bool MmapConfig::suspendForMemoryPressure()
+{
+    if (numberOfAliveConfigs().load() == 0) {
+        return false;
+    }
+    SteadyClock until = SteadyClock::now().steadyClockByAddingTimeInterval(
+    MmapConfigSuspendingTimeAfterMemoryPressure);
+    suspendedUntil().store(until.time_since_epoch().count());
+    return true;
+}
+
+bool MmapConfig::isSuspended()
+{
+    return SteadyClock::now().time_since_epoch().count() < suspendedUntil().load();
+}
+
+} //namespace WCDB
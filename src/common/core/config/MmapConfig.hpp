@@ -0,0 +1,62 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Config.hpp"
+#include "WINQ.h"
+#include <atomic>
+
+namespace WCDB {
+
+/*
+ * Memory-mapped I/O saves the copy from page cache for read-dominated databases.
+ * It's disabled automatically for the cipher database, whose pages must be decrypted,
+ * and for the database file larger than the max size, which can only be mapped partially.
+ */
+class MmapConfig final : public Config {
+public:
+    MmapConfig(int64_t maxSize);
+    ~MmapConfig() override;
+
+    bool invoke(InnerHandle* handle) override final;
+    bool uninvoke(InnerHandle* handle) override final;
+
+    // New handles don't map the database file for a while after it.
+    // Return false if there is no mmap config alive.
+    static bool suspendForMemoryPressure();
+
+protected:
+    int64_t mmapSizeForHandle(InnerHandle* handle) const;
+    static bool isSuspended();
+
+    const int64_t m_maxSize;
+    const StatementPragma m_disableMmap;
+
+    static std::atomic<int>& numberOfAliveConfigs();
+    static std::atomic<int64_t>& suspendedUntil();
+};
+
+} //namespace WCDB
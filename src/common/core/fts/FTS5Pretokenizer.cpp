@@ -0,0 +1,181 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "FTS5Pretokenizer.hpp"
+#include "Assertion.hpp"
+#include "Core.hpp"
+#include <cctype>
+#include <cstring>
+
+namespace WCDB {
+
+FTS5Pretokenizer::FTS5Pretokenizer(const UnsafeStringView& tokenizer,
+                                   const std::vector<StringView>& parameters)
+: m_module(nullptr), m_parameters(parameters)
+{
+    if (!tokenizer.empty()) {
+        const TokenizerModule* module = Core::shared().getTokenizer(tokenizer);
+        if (module != nullptr) {
+            m_module = module->getFts5Module();
+        }
+    }
+}
+
+bool FTS5Pretokenizer::isAvailable() const
+{
+    return m_module != nullptr;
+}
+
+// Read a bareword or a quoted string from `sql` at `pos`, which stops at any of `terminators` for bareword.
+static bool readFTS5Argument(const UnsafeStringView& sql, size_t& pos, const char* terminators, std::string& argument)
+{
+    argument.clear();
+    if (pos >= sql.length()) {
+        return false;
+    }
+    char quote = sql.at(pos);
+    if (quote == '[') {
+        quote = ']';
+    } else if (quote != '\'' && quote != '"' && quote != '`') {
+        while (pos < sql.length() && strchr(terminators, sql.at(pos)) == nullptr) {
+            argument.push_back(sql.at(pos++));
+        }
+        return !argument.empty();
+    }
+    ++pos;
+    while (pos < sql.length()) {
+        char c = sql.at(pos++);
+        if (c == quote) {
+            // Doubled quote is an escaped one.
+            if (pos < sql.length() && sql.at(pos) == quote && quote != ']') {
+                ++pos;
+            } else {
+                return true;
+            }
+        }
+        argument.push_back(c);
+    }
+    return false;
+}
+
+bool FTS5Pretokenizer::parseTokenizer(const UnsafeStringView& createTableSQL,
+                                      StringView& tokenizer,
+                                      std::vector<StringView>& parameters)
+{
+    tokenizer = StringView();
+    parameters.clear();
+    const UnsafeStringView& sql = createTableSQL;
+    size_t pos = 0;
+    // Skip to the arguments of module.
+    while (pos < sql.length() && sql.at(pos) != '(') {
+        ++pos;
+    }
+    std::string argument;
+    while (pos < sql.length() && sql.at(pos) != ')') {
+        ++pos;
+        while (pos < sql.length() && isspace((unsigned char) sql.at(pos))) {
+            ++pos;
+        }
+        // key or column name
+        if (!readFTS5Argument(sql, pos, " \t\n=,)", argument)) {
+            return false;
+        }
+        std::string key = argument;
+        while (pos < sql.length() && isspace((unsigned char) sql.at(pos))) {
+            ++pos;
+        }
+        if (pos < sql.length() && sql.at(pos) == '=') {
+            ++pos;
+            while (pos < sql.length() && isspace((unsigned char) sql.at(pos))) {
+                ++pos;
+            }
+            if (!readFTS5Argument(sql, pos, " \t\n,)", argument)) {
+                return false;
+            }
+            if (UnsafeStringView(key.c_str()).caseInsensitiveEqual("tokenize")) {
+                // The value is a list of barewords or quoted strings.
+                UnsafeStringView value(argument.c_str(), argument.size());
+                size_t valuePos = 0;
+                std::string word;
+                while (valuePos < value.length()) {
+                    if (isspace((unsigned char) value.at(valuePos))) {
+                        ++valuePos;
+                        continue;
+                    }
+                    if (!readFTS5Argument(value, valuePos, " \t\n", word)) {
+                        return false;
+                    }
+                    if (tokenizer.empty()) {
+                        tokenizer = StringView(word.c_str(), word.size());
+                    } else {
+                        parameters.emplace_back(word.c_str(), word.size());
+                    }
+                }
+                return true;
+            }
+        }
+        // Skip the rest of column definition.
+        while (pos < sql.length() && sql.at(pos) != ',' && sql.at(pos) != ')') {
+            ++pos;
+        }
+    }
+    return true;
+}
+
+void FTS5Pretokenizer::tokenize(const MultiRowsValue& rows,
+                                size_t begin,
+                                size_t end,
+                                PretokenizedRows& results) const
+{
+    WCTAssert(isAvailable());
+    WCTAssert(begin <= end && end <= rows.size() && results.size() == rows.size());
+    std::vector<const char*> arguments;
+    arguments.reserve(m_parameters.size());
+    for (const StringView& parameter : m_parameters) {
+        arguments.push_back(parameter.data());
+    }
+    AbstractFTSTokenizer* tokenizer = nullptr;
+    if (!FTSError::isOK(m_module->createTokenizer(
+        arguments.data(), (int) arguments.size(), &tokenizer))
+        || tokenizer == nullptr) {
+        return;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        PretokenizedFTS5Texts& texts = results[i];
+        for (const Value& value : rows[i]) {
+            if (value.getType() != ColumnType::Text) {
+                continue;
+            }
+            StringView text = value.textValue();
+            if (!texts.add(*m_module, tokenizer, text.data(), (int) text.length())) {
+                texts.clear();
+                break;
+            }
+        }
+    }
+    m_module->destroyTokenizer(tokenizer);
+}
+
+} // namespace WCDB
@@ -0,0 +1,63 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "StringView.hpp"
+#include "TokenizerModule.hpp"
+#include "Value.hpp"
+#include <memory>
+#include <vector>
+
+namespace WCDB {
+
+// Tokenize the texts of rows ahead of inserting them into fts5 table, so that it can be run by multiple workers.
+class FTS5Pretokenizer final {
+public:
+    FTS5Pretokenizer(const UnsafeStringView& tokenizer, const std::vector<StringView>& parameters);
+    FTS5Pretokenizer() = delete;
+    FTS5Pretokenizer(const FTS5Pretokenizer&) = delete;
+    FTS5Pretokenizer& operator=(const FTS5Pretokenizer&) = delete;
+
+    // Only the fts5 tokenizers registered to WCDB can be run ahead.
+    bool isAvailable() const;
+
+    // Parse the `tokenize` option from the sql of fts5 table in sqlite_master.
+    // Tokenizer is left empty if it's not specified, which means the builtin one of fts5.
+    static bool parseTokenizer(const UnsafeStringView& createTableSQL,
+                               StringView& tokenizer,
+                               std::vector<StringView>& parameters);
+
+    typedef std::vector<PretokenizedFTS5Texts> PretokenizedRows;
+    // Tokenize the text values of rows in [begin, end) with a tokenizer created by current thread.
+    // The row that fails to be tokenized is left empty, which will be tokenized while inserting as usual.
+    void tokenize(const MultiRowsValue& rows, size_t begin, size_t end, PretokenizedRows& results) const;
+
+private:
+    std::shared_ptr<FTS5TokenizerModule> m_module;
+    std::vector<StringView> m_parameters;
+};
+
+} // namespace WCDB
@@ -26,6 +26,7 @@
 #include "Assertion.hpp"
 #include "Core.hpp"
 #include "CoreConst.h"
+#include "FTS5Pretokenizer.hpp"
 #include "Notifier.hpp"
 #include "WCDBError.hpp"
 #include <cmath>
@@ -73,6 +74,9 @@ bool MergeFTSIndexLogic::tryInit(InnerHandle &handle)
             return false;
         }
     }
+    if (!restoreUnendedBulkBuilds(handle)) {
+        return false;
+    }
 
     m_hasInit = true;
     return true;
@@ -149,19 +153,35 @@ MergeFTSIndexLogic::triggerMerge(InnerHandle &handle, TableArray newTables, Tabl
         increaseErrorCount();
         return NullOpt;
     }
-    if (m_mergingTables.size() == 0) {
+    if (getTableToMerge().empty()) {
         return true;
     }
     if (m_processing) {
         return false;
     }
-    OperationQueue::shared().async(handle.getPath(), [](const UnsafeStringView &path) {
+    asyncMerge(handle.getPath());
+    return false;
+}
+
+void MergeFTSIndexLogic::asyncMerge(const UnsafeStringView &path)
+{
+    OperationQueue::shared().async(path, [](const UnsafeStringView &path) {
         RecyclableDatabase database = Core::shared().getOrCreateDatabase(path);
         if (database != nullptr) {
             database->proccessMerge();
         }
     });
-    return false;
+}
+
+StringView MergeFTSIndexLogic::getTableToMerge() const
+{
+    // Tables in bulk building are merged after the building is ended.
+    for (const StringView &table : m_mergingTables) {
+        if (m_bulkBuildings.find(table) == m_bulkBuildings.end()) {
+            return table;
+        }
+    }
+    return StringView();
 }
 
 void MergeFTSIndexLogic::proccessMerge()
@@ -172,10 +192,10 @@ void MergeFTSIndexLogic::proccessMerge()
         if (m_errorCount > 5) {
             return;
         }
-        if (m_mergingTables.size() == 0) {
+        table = getTableToMerge();
+        if (table.empty()) {
             return;
         }
-        table = *m_mergingTables.begin();
     }
     RecyclableHandle recyclableHandle = m_handleProvider->getMergeIndexHandle();
     if (recyclableHandle == nullptr) {
@@ -197,14 +217,10 @@ void MergeFTSIndexLogic::proccessMerge()
             }
             break;
         }
-        SharedLockGuard lockGuard(m_lock);
+        LockGuard lockGuard(m_lock);
         m_mergingTables.erase(table);
         m_mergedTables.emplace(table);
-        if (m_mergingTables.size() > 0) {
-            table = *m_mergingTables.begin();
-        } else {
-            break;
-        }
+        table = getTableToMerge();
     }
     handle->setTableMonitorEnable(true);
 }
@@ -323,6 +339,281 @@ void MergeFTSIndexLogic::increaseErrorCount()
     }
 }
 
+#pragma mark - Bulk Build
+RecyclableHandle MergeFTSIndexLogic::getBulkBuildHandle()
+{
+    RecyclableHandle recyclableHandle = m_handleProvider->getMergeIndexHandle();
+    if (recyclableHandle == nullptr) {
+        return nullptr;
+    }
+    WCTRemedialAssert(!recyclableHandle->isInTransaction(),
+                      "FTS5 bulk build can't be began or ended in transaction.",
+                      return nullptr;);
+    return recyclableHandle;
+}
+
+bool MergeFTSIndexLogic::beginBulkBuild(const UnsafeStringView &table,
+                                        const BulkBuildConfig &config)
+{
+    RecyclableHandle recyclableHandle = getBulkBuildHandle();
+    if (recyclableHandle == nullptr) {
+        return false;
+    }
+    InnerHandle *handle = recyclableHandle.get();
+
+    LockGuard lockGuard(m_lock);
+    WCTRemedialAssert(m_bulkBuildings.find(table) == m_bulkBuildings.end(),
+                      "FTS5 bulk build of this table is already began.",
+                      return false;);
+    BulkBuildConfig bulkBuildConfig = config;
+    if (!getTokenizerOfTable(*handle, table, bulkBuildConfig)) {
+        return false;
+    }
+    BulkBuildRecord record;
+    Optional<bool> recorded = getBulkBuildRecord(*handle, table, record);
+    if (recorded.failed()) {
+        return false;
+    }
+    // The options of an unended bulk building are the tuned ones, so the recorded ones are kept.
+    if (!recorded.value()
+        && (!getFTS5Option(*handle, table, "automerge", record.autoMerge)
+            || !getFTS5Option(*handle, table, "crisismerge", record.crisisMerge)
+            || !getFTS5Option(*handle, table, "pgsz", record.pageSize))) {
+        return false;
+    }
+    auto optionalValue = [](const Optional<int> &value) {
+        return value.hasValue() ? Expression(value.value()) : Expression(LiteralValue(nullptr));
+    };
+    if (!handle->runTransaction([&](InnerHandle *handle) {
+            StatementCreateTable createRecordTable
+            = StatementCreateTable().createTable(FTS5BulkBuildRecordTable).ifNotExists();
+            createRecordTable
+            .define(ColumnDef("tableName", ColumnType::Text).constraint(ColumnConstraint().primaryKey()))
+            .define(ColumnDef("automerge", ColumnType::Integer))
+            .define(ColumnDef("crisismerge", ColumnType::Integer))
+            .define(ColumnDef("pgsz", ColumnType::Integer))
+            .withoutRowID();
+            return handle->execute(createRecordTable)
+                   && handle->execute(
+                   StatementInsert()
+                   .insertIntoTable(FTS5BulkBuildRecordTable)
+                   .orReplace()
+                   .columns({ Column("tableName"), Column("automerge"), Column("crisismerge"), Column("pgsz") })
+                   .values({ table,
+                             optionalValue(record.autoMerge),
+                             optionalValue(record.crisisMerge),
+                             optionalValue(record.pageSize) }))
+                   && setFTS5Option(*handle, table, "automerge", 0)
+                   && setFTS5Option(*handle, table, "crisismerge", config.crisisMerge)
+                   && (config.pageSize <= 0
+                       || setFTS5Option(*handle, table, "pgsz", config.pageSize));
+        })) {
+        return false;
+    }
+    m_bulkBuildings.emplace(StringView(table), std::move(bulkBuildConfig));
+    return true;
+}
+
+Optional<MergeFTSIndexLogic::BulkBuildConfig>
+MergeFTSIndexLogic::getBulkBuildConfig(const UnsafeStringView &table) const
+{
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_bulkBuildings.find(table);
+    if (iter == m_bulkBuildings.end()) {
+        return NullOpt;
+    }
+    return iter->second;
+}
+
+bool MergeFTSIndexLogic::endBulkBuild(const UnsafeStringView &table)
+{
+    RecyclableHandle recyclableHandle = getBulkBuildHandle();
+    if (recyclableHandle == nullptr) {
+        return false;
+    }
+    InnerHandle *handle = recyclableHandle.get();
+
+    LockGuard lockGuard(m_lock);
+    BulkBuildRecord record;
+    Optional<bool> recorded = getBulkBuildRecord(*handle, table, record);
+    if (recorded.failed()) {
+        return false;
+    }
+    // The bulk building that is not ended by the previous launch can also be ended.
+    WCTRemedialAssert(recorded.value(), "FTS5 bulk build of this table is not began.", return false;);
+    if (!handle->runTransaction([&](InnerHandle *handle) {
+            return restoreBulkBuild(*handle, table, record);
+        })) {
+        return false;
+    }
+    m_bulkBuildings.erase(table);
+
+    // Merge the segments written during bulk building in background.
+    m_mergedTables.erase(table);
+    m_mergingTables.emplace(table);
+    if (m_errorCount.load() <= 5 && !m_processing) {
+        asyncMerge(handle->getPath());
+    }
+    return true;
+}
+
+bool MergeFTSIndexLogic::getTokenizerOfTable(InnerHandle &handle,
+                                             const UnsafeStringView &table,
+                                             BulkBuildConfig &config)
+{
+    if (!handle.prepare(StatementSelect()
+                        .select(Column("sql"))
+                        .from(Syntax::masterTable)
+                        .where(Column("type") == "table" && Column("name") == table))) {
+        return false;
+    }
+    if (!handle.step()) {
+        handle.finalize();
+        return false;
+    }
+    bool succeed = true;
+    if (!handle.done()) {
+        succeed = FTS5Pretokenizer::parseTokenizer(
+        handle.getText(0), config.tokenizer, config.tokenizerParameters);
+    }
+    handle.finalize();
+    if (!succeed) {
+        // Tokenize while inserting as usual.
+        config.tokenizer = StringView();
+        config.tokenizerParameters.clear();
+    }
+    return true;
+}
+
+Optional<bool> MergeFTSIndexLogic::getBulkBuildRecord(InnerHandle &handle,
+                                                      const UnsafeStringView &table,
+                                                      BulkBuildRecord &record)
+{
+    Optional<bool> exists = handle.tableExists(FTS5BulkBuildRecordTable);
+    if (exists.failed() || !exists.value()) {
+        return exists;
+    }
+    if (!handle.prepare(StatementSelect()
+                        .select({ Column("automerge"), Column("crisismerge"), Column("pgsz") })
+                        .from(FTS5BulkBuildRecordTable)
+                        .where(Column("tableName") == table))) {
+        return NullOpt;
+    }
+    if (!handle.step()) {
+        handle.finalize();
+        return NullOpt;
+    }
+    bool recorded = !handle.done();
+    if (recorded) {
+        Optional<int> *values[] = { &record.autoMerge, &record.crisisMerge, &record.pageSize };
+        for (int i = 0; i < 3; ++i) {
+            *values[i] = NullOpt;
+            if (handle.getColumnType(i) != ColumnType::Null) {
+                *values[i] = (int) handle.getInteger(i);
+            }
+        }
+    }
+    handle.finalize();
+    return recorded;
+}
+
+bool MergeFTSIndexLogic::restoreBulkBuild(InnerHandle &handle,
+                                          const UnsafeStringView &table,
+                                          const BulkBuildRecord &record)
+{
+    WCTAssert(handle.isInTransaction());
+    return setFTS5Option(
+           handle,
+           table,
+           "automerge",
+           record.autoMerge.hasValue() ? record.autoMerge.value() : FTS5DefaultAutoMerge)
+           && setFTS5Option(
+           handle,
+           table,
+           "crisismerge",
+           record.crisisMerge.hasValue() ? record.crisisMerge.value() : FTS5DefaultCrisisMerge)
+           && setFTS5Option(
+           handle,
+           table,
+           "pgsz",
+           record.pageSize.hasValue() ? record.pageSize.value() : FTS5DefaultPageSize)
+           && handle.execute(StatementDelete()
+                             .deleteFrom(FTS5BulkBuildRecordTable)
+                             .where(Column("tableName") == table));
+}
+
+bool MergeFTSIndexLogic::restoreUnendedBulkBuilds(InnerHandle &handle)
+{
+    Optional<bool> exists = handle.tableExists(FTS5BulkBuildRecordTable);
+    if (exists.failed() || !exists.value()) {
+        return exists.succeed();
+    }
+    if (!handle.prepare(StatementSelect().select(Column("tableName")).from(FTS5BulkBuildRecordTable))) {
+        return false;
+    }
+    StringViewSet tables;
+    bool succeed = false;
+    while ((succeed = handle.step()) && !handle.done()) {
+        UnsafeStringView table = handle.getText(0);
+        if (m_bulkBuildings.find(table) == m_bulkBuildings.end()) {
+            tables.emplace(table);
+        }
+    }
+    handle.finalize();
+    if (!succeed) {
+        return false;
+    }
+    for (const StringView &table : tables) {
+        BulkBuildRecord record;
+        Optional<bool> recorded = getBulkBuildRecord(handle, table, record);
+        if (recorded.failed()) {
+            return false;
+        }
+        if (recorded.value()
+            && !handle.runTransaction([&](InnerHandle *handle) {
+                   return restoreBulkBuild(*handle, table, record);
+               })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MergeFTSIndexLogic::getFTS5Option(InnerHandle &handle,
+                                       const UnsafeStringView &table,
+                                       const UnsafeStringView &key,
+                                       Optional<int> &value)
+{
+    Statement selectConfig = StatementSelect()
+                             .select(Column("v"))
+                             .from(StringView().formatted("%s_config", table.data()))
+                             .where(Column("k") == key);
+    if (!handle.prepare(selectConfig)) {
+        return false;
+    }
+    if (!handle.step()) {
+        handle.finalize();
+        return false;
+    }
+    value = NullOpt;
+    if (!handle.done()) {
+        value = (int) handle.getInteger(0);
+    }
+    handle.finalize();
+    return true;
+}
+
+bool MergeFTSIndexLogic::setFTS5Option(InnerHandle &handle,
+                                       const UnsafeStringView &table,
+                                       const UnsafeStringView &key,
+                                       int value)
+{
+    return handle.execute(StatementInsert()
+                          .insertIntoTable(table)
+                          .columns({ Column(table), Column("rank") })
+                          .values({ key, value }));
+}
+
 #pragma mark - OperationQueue
 
 MergeFTSIndexLogic::OperationQueue &MergeFTSIndexLogic::OperationQueue::shared()
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "AsyncQueue.hpp"
+#include "CoreConst.h"
 #include "InnerHandle.hpp"
 #include "Lock.hpp"
 #include "RecyclableHandle.hpp"
@@ -52,6 +53,52 @@ public:
     Optional<bool> triggerMerge(TableArray newTables, TableArray modifiedTables);
     void proccessMerge();
 
+#pragma mark - Bulk Build
+    struct BulkBuildConfig {
+        // 0 means keeping the current page size of fts5 index.
+        int pageSize = 0;
+        int crisisMerge = FTS5BulkBuildCrisisMerge;
+        int numberOfTokenizeWorkers = FTS5BulkBuildMaxTokenizeWorkers;
+        // Read from the schema of table while beginning. Texts are tokenized ahead by the workers only if the tokenizer is registered to WCDB.
+        StringView tokenizer;
+        std::vector<StringView> tokenizerParameters;
+    };
+    // Auto merge of the table is suspended and the fts5 options are tuned for bulk inserting until `endBulkBuild`.
+    // The original options are saved in a builtin table, so that they can still be restored if it's not ended before exiting.
+    bool beginBulkBuild(const UnsafeStringView& table, const BulkBuildConfig& config);
+    Optional<BulkBuildConfig> getBulkBuildConfig(const UnsafeStringView& table) const;
+    // The fts5 options are restored and the table is merged in background.
+    bool endBulkBuild(const UnsafeStringView& table);
+
+private:
+    StringViewMap<BulkBuildConfig> m_bulkBuildings;
+
+    // Original options of fts5. NullOpt means it's not set.
+    struct BulkBuildRecord {
+        Optional<int> autoMerge;
+        Optional<int> crisisMerge;
+        Optional<int> pageSize;
+    };
+    RecyclableHandle getBulkBuildHandle();
+    bool getTokenizerOfTable(InnerHandle& handle, const UnsafeStringView& table, BulkBuildConfig& config);
+    // False if the bulk building of table is not recorded.
+    Optional<bool>
+    getBulkBuildRecord(InnerHandle& handle, const UnsafeStringView& table, BulkBuildRecord& record);
+    // Restore the options and remove the record, which should be run in transaction.
+    bool restoreBulkBuild(InnerHandle& handle, const UnsafeStringView& table, const BulkBuildRecord& record);
+    // Restore the bulk buildings that are not ended by the previous launch.
+    bool restoreUnendedBulkBuilds(InnerHandle& handle);
+    bool getFTS5Option(InnerHandle& handle,
+                       const UnsafeStringView& table,
+                       const UnsafeStringView& key,
+                       Optional<int>& value);
+    bool setFTS5Option(InnerHandle& handle,
+                       const UnsafeStringView& table,
+                       const UnsafeStringView& key,
+                       int value);
+    StringView getTableToMerge() const;
+    void asyncMerge(const UnsafeStringView& path);
+
 private:
     bool tryInit(InnerHandle& handle);
     Optional<bool>
@@ -70,7 +117,7 @@ private:
     std::atomic<bool> m_processing;
     std::atomic<int> m_errorCount;
 
-    SharedLock m_lock;
+    mutable SharedLock m_lock;
 
     Statement m_getTableStatement;
     StringViewSet m_mergingTables;
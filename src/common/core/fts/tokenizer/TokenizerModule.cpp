@@ -26,6 +26,7 @@
 #include "Assertion.hpp"
 #include "SQLite.h"
 #include "SQLiteFTS3Tokenizer.h"
+#include "StringView.hpp"
 #include <cstring>
 #include <memory>
 
@@ -193,6 +194,96 @@ void *FTS5TokenizerModule::getContext()
     return m_pCtx;
 }
 
+int FTS5TokenizerModule::createTokenizer(const char *const *azArg,
+                                         int nArg,
+                                         AbstractFTSTokenizer **ppTokenizer)
+{
+    WCTAssert(m_create != nullptr);
+    return m_create(m_pCtx, azArg, nArg, ppTokenizer);
+}
+
+int FTS5TokenizerModule::destroyTokenizer(AbstractFTSTokenizer *pTokenizer)
+{
+    WCTAssert(m_destroy != nullptr);
+    return m_destroy(pTokenizer);
+}
+
+int FTS5TokenizerModule::tokenize(AbstractFTSTokenizer *pTokenizer,
+                                  void *pCtx,
+                                  int flags,
+                                  const char *pText,
+                                  int nText,
+                                  TokenCallback callback)
+{
+    WCTAssert(m_tokenize != nullptr);
+    return m_tokenize(pTokenizer, pCtx, flags, pText, nText, callback);
+}
+
+#pragma mark - PretokenizedFTS5Texts
+static thread_local const PretokenizedFTS5Texts *t_threadedPretokenizedTexts = nullptr;
+
+bool PretokenizedFTS5Texts::add(FTS5TokenizerModule &module,
+                                AbstractFTSTokenizer *pTokenizer,
+                                const char *pText,
+                                int nText)
+{
+    Tokens tokens;
+    int rc = module.tokenize(
+    pTokenizer, &tokens, FTS5_TOKENIZE_DOCUMENT, pText, nText, PretokenizedFTS5Texts::onToken);
+    if (!FTSError::isOK(rc)) {
+        return false;
+    }
+    m_indexes.emplace(UnsafeStringView(pText, nText).hash(), m_texts.size());
+    m_texts.emplace_back(std::string(pText, nText), std::move(tokens));
+    return true;
+}
+
+int PretokenizedFTS5Texts::onToken(
+void *pCtx, int tflags, const char *pToken, int nToken, int iStart, int iEnd)
+{
+    Tokens *tokens = static_cast<Tokens *>(pCtx);
+    tokens->push_back({ std::string(pToken, nToken), tflags, iStart, iEnd });
+    return FTSError::OK();
+}
+
+const PretokenizedFTS5Texts::Tokens *PretokenizedFTS5Texts::find(const char *pText, int nText) const
+{
+    auto range = m_indexes.equal_range(UnsafeStringView(pText, nText).hash());
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        const auto &text = m_texts[iter->second];
+        if (text.first.size() == (size_t) nText
+            && memcmp(text.first.data(), pText, nText) == 0) {
+            return &text.second;
+        }
+    }
+    return nullptr;
+}
+
+bool PretokenizedFTS5Texts::empty() const
+{
+    return m_texts.empty();
+}
+
+void PretokenizedFTS5Texts::clear()
+{
+    m_texts.clear();
+    m_texts.shrink_to_fit();
+    m_indexes.clear();
+}
+
+void PretokenizedFTS5Texts::setThreaded(const PretokenizedFTS5Texts *texts)
+{
+    t_threadedPretokenizedTexts = texts;
+}
+
+const PretokenizedFTS5Texts *PretokenizedFTS5Texts::getThreaded(int flags)
+{
+    if ((flags & FTS5_TOKENIZE_DOCUMENT) == 0) {
+        return nullptr;
+    }
+    return t_threadedPretokenizedTexts;
+}
+
 #pragma mark - TokenizerModule
 
 TokenizerModule::TokenizerModule(std::shared_ptr<FTS3TokenizerModule> fts3Module)
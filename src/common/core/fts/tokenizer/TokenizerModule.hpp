@@ -25,6 +25,9 @@
 #pragma once
 #include "FTSError.hpp"
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace WCDB {
 
@@ -135,6 +138,15 @@ public:
                         void *pCtx);
     void *getContext();
 
+    int createTokenizer(const char *const *azArg, int nArg, AbstractFTSTokenizer **ppTokenizer);
+    int destroyTokenizer(AbstractFTSTokenizer *pTokenizer);
+    int tokenize(AbstractFTSTokenizer *pTokenizer,
+                 void *pCtx,
+                 int flags,
+                 const char *pText,
+                 int nText,
+                 TokenCallback callback);
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-private-field"
 private:
@@ -145,6 +157,41 @@ private:
 #pragma GCC diagnostic pop
 };
 
+#pragma mark - pretokenized fts5 texts
+
+/*
+ The tokens of texts that are tokenized ahead in other threads.
+ While it's set as the threaded one, the document tokenization of the same text in current thread replays these tokens instead of running the tokenizer again.
+ */
+class WCDB_API PretokenizedFTS5Texts final {
+public:
+    struct Token {
+        std::string token;
+        int tflags;
+        int iStart;
+        int iEnd;
+    };
+    typedef std::vector<Token> Tokens;
+
+    bool add(FTS5TokenizerModule &module,
+             AbstractFTSTokenizer *pTokenizer,
+             const char *pText,
+             int nText);
+    const Tokens *find(const char *pText, int nText) const;
+    bool empty() const;
+    void clear();
+
+    static void setThreaded(const PretokenizedFTS5Texts *texts);
+    // Only the document tokenization can be replayed.
+    static const PretokenizedFTS5Texts *getThreaded(int flags);
+
+private:
+    static int onToken(void *pCtx, int tflags, const char *pToken, int nToken, int iStart, int iEnd);
+    std::vector<std::pair<std::string, Tokens>> m_texts;
+    // Hash of text -> index of m_texts
+    std::unordered_multimap<uint32_t, size_t> m_indexes;
+};
+
 #pragma mark - fts module wrapper
 
 class WCDB_API TokenizerModule {
@@ -155,6 +155,23 @@ public:
         } else if (nText <= 0) {
             nText = (int) strlen(pText);
         }
+        const PretokenizedFTS5Texts *pretokenized = PretokenizedFTS5Texts::getThreaded(flags);
+        const PretokenizedFTS5Texts::Tokens *tokens
+        = pretokenized != nullptr ? pretokenized->find(pText, nText) : nullptr;
+        if (tokens != nullptr) {
+            for (const auto &token : *tokens) {
+                rc = xToken(pCtx,
+                            token.tflags,
+                            token.token.data(),
+                            (int) token.token.size(),
+                            token.iStart,
+                            token.iEnd);
+                if (!FTSError::isOK(rc)) {
+                    return rc;
+                }
+            }
+            return FTSError::OK();
+        }
         pTokenizer->loadInput(pText, nText, flags);
         while (FTSError::isOK(rc = pTokenizer->nextToken(
                               &pToken, &nToken, &iStart, &iEnd, &tflags, nullptr))) {
@@ -0,0 +1,112 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "AggregateFunctionModule.hpp"
+#include "Assertion.hpp"
+#include "SQLite.h"
+
+namespace WCDB {
+
+AggregateFunctionAPI::AggregateFunctionAPI(SQLiteContext *ctx, SQLiteValue **values, int valueNum)
+: ScalarFunctionAPI(ctx, values, valueNum)
+{
+}
+
+void *AggregateFunctionAPI::getAggregateContext(int size)
+{
+    if (!m_sqliteContext) {
+        return nullptr;
+    }
+    return sqlite3_aggregate_context((sqlite3_context *) m_sqliteContext, size);
+}
+
+AbstractAggregateFunctionObject::AbstractAggregateFunctionObject(void *userContext)
+{
+    WCDB_UNUSED(userContext);
+}
+
+AbstractAggregateFunctionObject::~AbstractAggregateFunctionObject() = default;
+
+AbstractWindowFunctionObject::AbstractWindowFunctionObject(void *userContext)
+: AbstractAggregateFunctionObject(userContext)
+{
+}
+
+AbstractWindowFunctionObject::~AbstractWindowFunctionObject() = default;
+
+AggregateFunctionModule::AggregateFunctionModule(const StepFunction &step,
+                                                 const FinalFunction &final,
+                                                 const FinalFunction &value,
+                                                 const StepFunction &inverse,
+                                                 int parameterNum,
+                                                 bool deterministic,
+                                                 void *userCtx)
+: m_step(step)
+, m_final(final)
+, m_value(value)
+, m_inverse(inverse)
+, m_parameterNum(parameterNum)
+, m_deterministic(deterministic)
+, m_userCtx(userCtx)
+{
+    WCTAssert((m_value == nullptr) == (m_inverse == nullptr));
+}
+
+AggregateFunctionModule::StepFunction AggregateFunctionModule::getStep() const
+{
+    return m_step;
+}
+
+AggregateFunctionModule::FinalFunction AggregateFunctionModule::getFinal() const
+{
+    return m_final;
+}
+
+AggregateFunctionModule::FinalFunction AggregateFunctionModule::getValue() const
+{
+    return m_value;
+}
+
+AggregateFunctionModule::StepFunction AggregateFunctionModule::getInverse() const
+{
+    return m_inverse;
+}
+
+void *AggregateFunctionModule::getUserCtx() const
+{
+    return m_userCtx;
+}
+
+int AggregateFunctionModule::getParameterNum() const
+{
+    return m_parameterNum;
+}
+
+bool AggregateFunctionModule::isDeterminisic() const
+{
+    return m_deterministic;
+}
+
+} // namespace WCDB
@@ -0,0 +1,103 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "ScalarFunctionModule.hpp"
+
+namespace WCDB {
+
+template<typename AggregateFunctionObject>
+class AggregateFunctionTemplate;
+
+template<typename WindowFunctionObject>
+class WindowFunctionTemplate;
+
+class WCDB_API AggregateFunctionAPI final : public ScalarFunctionAPI {
+    template<typename AggregateFunctionObject>
+    friend class AggregateFunctionTemplate;
+    template<typename WindowFunctionObject>
+    friend class WindowFunctionTemplate;
+
+private:
+    AggregateFunctionAPI(SQLiteContext* ctx, SQLiteValue** values, int valueNum);
+
+    // Memory of current group, which is zeroed when it's allocated for the first time and freed by sqlite after the final call.
+    // If size is 0, it returns nullptr when there is no memory allocated for current group.
+    void* getAggregateContext(int size);
+};
+
+class WCDB_API AbstractAggregateFunctionObject {
+public:
+    AbstractAggregateFunctionObject(void* userContext);
+    virtual ~AbstractAggregateFunctionObject() = 0;
+    // Called for each row of current group.
+    virtual void step(AggregateFunctionAPI& apiObj) = 0;
+    // Called once after all rows of current group are stepped. The result of group should be set here.
+    virtual void finalize(AggregateFunctionAPI& apiObj) = 0;
+};
+
+class WCDB_API AbstractWindowFunctionObject : public AbstractAggregateFunctionObject {
+public:
+    AbstractWindowFunctionObject(void* userContext);
+    virtual ~AbstractWindowFunctionObject() override = 0;
+    // Called for each row that is removed from current window.
+    virtual void inverse(AggregateFunctionAPI& apiObj) = 0;
+    // Called to get the result of current window without finishing it.
+    virtual void value(AggregateFunctionAPI& apiObj) = 0;
+};
+
+class WCDB_API AggregateFunctionModule final {
+public:
+    typedef void (*StepFunction)(SQLiteContext* pCtx, int nVal, SQLiteValue** apVal);
+    typedef void (*FinalFunction)(SQLiteContext* pCtx);
+    AggregateFunctionModule() = delete;
+    AggregateFunctionModule(const StepFunction& step,
+                            const FinalFunction& final,
+                            const FinalFunction& value,
+                            const StepFunction& inverse,
+                            int parameterNum,
+                            bool deterministic,
+                            void* userCtx);
+    StepFunction getStep() const;
+    FinalFunction getFinal() const;
+    // Value and inverse are null for aggregate functions that can't be used as window functions.
+    FinalFunction getValue() const;
+    StepFunction getInverse() const;
+    int getParameterNum() const;
+    bool isDeterminisic() const;
+    void* getUserCtx() const;
+
+private:
+    StepFunction m_step;
+    FinalFunction m_final;
+    FinalFunction m_value;
+    StepFunction m_inverse;
+    int m_parameterNum;
+    bool m_deterministic;
+    void* m_userCtx;
+};
+
+}; // namespace WCDB
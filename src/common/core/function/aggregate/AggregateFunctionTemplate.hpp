@@ -0,0 +1,129 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "AggregateFunctionModule.hpp"
+#include <new>
+#include <type_traits>
+
+namespace WCDB {
+
+template<typename AggregateFunctionObject>
+class AggregateFunctionTemplate {
+public:
+    static_assert(std::is_base_of<AbstractAggregateFunctionObject, AggregateFunctionObject>::value, "");
+    // Memory allocated by sqlite is 8-byte aligned.
+    static_assert(alignof(AggregateFunctionObject) <= 8, "");
+
+    static AggregateFunctionModule
+    specialize(int parameterNum, bool deterministic = true, void* userContext = nullptr)
+    {
+        return AggregateFunctionModule(
+        step, finalize, nullptr, nullptr, parameterNum, deterministic, userContext);
+    }
+
+    static void step(SQLiteContext* pCtx, int nVal, SQLiteValue** apVal)
+    {
+        AggregateFunctionAPI apiObj = AggregateFunctionAPI(pCtx, apVal, nVal);
+        AggregateFunctionObject* functionObject = getOrCreateObject(apiObj);
+        if (functionObject != nullptr) {
+            functionObject->step(apiObj);
+        }
+    }
+
+    static void finalize(SQLiteContext* pCtx)
+    {
+        AggregateFunctionAPI apiObj = AggregateFunctionAPI(pCtx, nullptr, 0);
+        Storage* storage = static_cast<Storage*>(apiObj.getAggregateContext(0));
+        if (storage != nullptr && storage->constructed) {
+            AggregateFunctionObject* functionObject
+            = reinterpret_cast<AggregateFunctionObject*>(&storage->object);
+            functionObject->finalize(apiObj);
+            functionObject->~AggregateFunctionObject();
+            storage->constructed = false;
+        } else {
+            // There is no row in current group.
+            AggregateFunctionObject functionObject(apiObj.getUserData());
+            functionObject.finalize(apiObj);
+        }
+    }
+
+protected:
+    // The state of each group lives in the aggregate context of sqlite, which is zeroed at the first allocation.
+    struct Storage {
+        bool constructed;
+        typename std::aligned_storage<sizeof(AggregateFunctionObject), alignof(AggregateFunctionObject)>::type object;
+    };
+
+    static AggregateFunctionObject* getOrCreateObject(AggregateFunctionAPI& apiObj)
+    {
+        Storage* storage = static_cast<Storage*>(apiObj.getAggregateContext(sizeof(Storage)));
+        if (storage == nullptr) {
+            // sqlite has already set the error of no memory.
+            return nullptr;
+        }
+        if (!storage->constructed) {
+            new (&storage->object) AggregateFunctionObject(apiObj.getUserData());
+            storage->constructed = true;
+        }
+        return reinterpret_cast<AggregateFunctionObject*>(&storage->object);
+    }
+};
+
+template<typename WindowFunctionObject>
+class WindowFunctionTemplate : public AggregateFunctionTemplate<WindowFunctionObject> {
+    using Super = AggregateFunctionTemplate<WindowFunctionObject>;
+
+public:
+    static_assert(std::is_base_of<AbstractWindowFunctionObject, WindowFunctionObject>::value, "");
+
+    static AggregateFunctionModule
+    specialize(int parameterNum, bool deterministic = true, void* userContext = nullptr)
+    {
+        return AggregateFunctionModule(
+        Super::step, Super::finalize, value, inverse, parameterNum, deterministic, userContext);
+    }
+
+    static void value(SQLiteContext* pCtx)
+    {
+        AggregateFunctionAPI apiObj = AggregateFunctionAPI(pCtx, nullptr, 0);
+        WindowFunctionObject* functionObject = Super::getOrCreateObject(apiObj);
+        if (functionObject != nullptr) {
+            functionObject->value(apiObj);
+        }
+    }
+
+    static void inverse(SQLiteContext* pCtx, int nVal, SQLiteValue** apVal)
+    {
+        AggregateFunctionAPI apiObj = AggregateFunctionAPI(pCtx, apVal, nVal);
+        WindowFunctionObject* functionObject = Super::getOrCreateObject(apiObj);
+        if (functionObject != nullptr) {
+            functionObject->inverse(apiObj);
+        }
+    }
+};
+
+} // namespace WCDB
@@ -172,6 +172,25 @@ void *ScalarFunctionAPI::getUserData() const
     return sqlite3_user_data((sqlite3_context *) m_sqliteContext);
 }
 
+void *ScalarFunctionAPI::getAuxData(int index) const
+{
+    WCTAssert(index < m_valueNum);
+    if (!m_sqliteContext || index >= m_valueNum) {
+        return nullptr;
+    }
+    return sqlite3_get_auxdata((sqlite3_context *) m_sqliteContext, index);
+}
+
+void ScalarFunctionAPI::setAuxData(int index, void *data, void (*destructor)(void *))
+{
+    WCTAssert(index < m_valueNum);
+    if (!m_sqliteContext || index >= m_valueNum) {
+        destructor(data);
+        return;
+    }
+    sqlite3_set_auxdata((sqlite3_context *) m_sqliteContext, index, data, destructor);
+}
+
 AbstractScalarFunctionObject::AbstractScalarFunctionObject(void *userContext,
                                                            ScalarFunctionAPI &apiObj)
 {
@@ -63,6 +63,8 @@ protected:
     ScalarFunctionAPI(SQLiteContext* ctx, SQLiteValue** values, int valueNum);
 
     void* getUserData() const;
+    void* getAuxData(int index) const;
+    void setAuxData(int index, void* data, void (*destructor)(void*));
 
 private:
     SQLiteContext* m_sqliteContext;
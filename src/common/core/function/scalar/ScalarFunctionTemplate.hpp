@@ -31,10 +31,22 @@ class ScalarFunctionTemplate {
 public:
     static_assert(std::is_base_of<AbstractScalarFunctionObject, ScalarFunctionObject>::value, "");
 
-    static ScalarFunctionModule
-    specialize(int parameterNum, bool deterministic = true, void* userContext = nullptr)
+    /*
+     If reuseObject is true, the function object is kept as the auxiliary data of the first argument and reused
+     for all rows of the same statement, instead of being constructed for every row.
+     SQLite only keeps it while the first argument is a constant, such as a literal or a bound parameter.
+     It is destroyed when the statement is reset or finalized.
+     Once an object is discarded right after its first row, the first argument of that call site is considered varying,
+     and the following rows fall back to construct the object for every row, as reuseObject is false.
+     So it only helps the functions whose first argument is constant.
+     */
+    static ScalarFunctionModule specialize(int parameterNum,
+                                           bool deterministic = true,
+                                           void* userContext = nullptr,
+                                           bool reuseObject = false)
     {
-        return ScalarFunctionModule(run, parameterNum, deterministic, userContext);
+        return ScalarFunctionModule(
+        reuseObject ? runWithReusedObject : run, parameterNum, deterministic, userContext);
     }
 
     static void run(SQLiteContext* pCtx, int nVal, SQLiteValue** apVal)
@@ -43,6 +55,54 @@ public:
         ScalarFunctionObject functionObject(apiObj.getUserData(), apiObj);
         functionObject.process(apiObj);
     }
+
+    static void runWithReusedObject(SQLiteContext* pCtx, int nVal, SQLiteValue** apVal)
+    {
+        if (nVal <= 0 || pCtx == varyingContext()) {
+            run(pCtx, nVal, apVal);
+            return;
+        }
+        ScalarFunctionAPI apiObj = ScalarFunctionAPI(pCtx, apVal, nVal);
+        ReusedObject* reusedObject = static_cast<ReusedObject*>(apiObj.getAuxData(0));
+        if (reusedObject != nullptr) {
+            ++reusedObject->numberOfRows;
+            reusedObject->functionObject.process(apiObj);
+            return;
+        }
+        reusedObject = new ReusedObject(apiObj, pCtx);
+        reusedObject->functionObject.process(apiObj);
+        // SQLite may destroy the object during this call, so it must not be used afterwards.
+        apiObj.setAuxData(0, reusedObject, destroyReusedObject);
+    }
+
+private:
+    struct ReusedObject {
+        ReusedObject(ScalarFunctionAPI& apiObj, const SQLiteContext* context_)
+        : functionObject(apiObj.getUserData(), apiObj), context(context_), numberOfRows(1)
+        {
+        }
+        ScalarFunctionObject functionObject;
+        // The context of a call site stays the same for all rows of the statement.
+        const SQLiteContext* context;
+        int numberOfRows;
+    };
+
+    static void destroyReusedObject(void* object)
+    {
+        ReusedObject* reusedObject = static_cast<ReusedObject*>(object);
+        if (reusedObject->numberOfRows == 1) {
+            // SQLite discards the auxiliary data of a varying argument right after the row.
+            varyingContext() = reusedObject->context;
+        }
+        delete reusedObject;
+    }
+
+    // Only the last varying call site of each thread is remembered, which is enough for the common case.
+    static const SQLiteContext*& varyingContext()
+    {
+        static thread_local const SQLiteContext* s_varyingContext = nullptr;
+        return s_varyingContext;
+    }
 };
 
 } // namespace WCDB
@@ -180,8 +180,11 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
     double timeIntervalWithinTransaction = calculateTimeIntervalWithinTransaction();
     SteadyClock beforeTransaction = SteadyClock::now();
     Optional<bool> migrated;
+    Optional<int64_t> maxPrimaryKeyOfSourceTable;
+    bool routable = m_migratingInfo->isRoutable();
     if (getHandle()->runTransaction(
-        [&migrated, &beforeTransaction, &timeIntervalWithinTransaction, this](InnerHandle*) -> bool {
+        [&migrated, &beforeTransaction, &timeIntervalWithinTransaction, &maxPrimaryKeyOfSourceTable, routable, this](
+        InnerHandle*) -> bool {
             double cost = 0;
             do {
                 migrated = migrateRow();
@@ -189,12 +192,22 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
             } while (migrated.succeed() && !migrated.value()
                      && cost < timeIntervalWithinTransaction);
             timeIntervalWithinTransaction = cost;
+            if (migrated.succeed() && routable) {
+                // Selected within the transaction so that no other writer can change it before committing.
+                if (!selectMaxPrimaryKeyOfSourceTable(maxPrimaryKeyOfSourceTable)) {
+                    return false;
+                }
+            }
             return migrated.succeed();
         })) {
         // update only if succeed
         double timeIntervalWholeTranscation
         = SteadyClock::timeIntervalSinceSteadyClockToNow(beforeTransaction);
         addSample(timeIntervalWithinTransaction, timeIntervalWholeTranscation);
+        if (routable) {
+            // Published after committing, so the boundary is never less than the committed one.
+            m_migratingInfo->setMaxPrimaryKeyOfSourceTable(maxPrimaryKeyOfSourceTable);
+        }
 
         WCTAssert(migrated.succeed());
         return migrated;
@@ -221,6 +234,25 @@ Optional<bool> MigrateHandleOperator::migrateRow()
     return migrated;
 }
 
+bool MigrateHandleOperator::selectMaxPrimaryKeyOfSourceTable(Optional<int64_t>& maxPrimaryKey)
+{
+    WCTAssert(m_migratingInfo != nullptr && m_migratingInfo->isRoutable());
+    InnerHandle* handle = getHandle();
+    if (!handle->prepare(m_migratingInfo->getStatementForSelectingMaxPrimaryKeyOfSourceTable())) {
+        return false;
+    }
+    if (!handle->step()) {
+        handle->finalize();
+        return false;
+    }
+    maxPrimaryKey = NullOpt;
+    if (!handle->done() && handle->getColumnType(0) != ColumnType::Null) {
+        maxPrimaryKey = handle->getInteger(0);
+    }
+    handle->finalize();
+    return true;
+}
+
 void MigrateHandleOperator::finalizeMigrationStatement()
 {
     m_migrateStatement->finalize();
@@ -57,6 +57,8 @@ protected:
     bool dropSourceTable(const MigrationInfo* info) override final;
     Optional<bool> migrateRows(const MigrationInfo* info) override final;
     Optional<bool> migrateRow();
+    // Null means the source table is empty.
+    bool selectMaxPrimaryKeyOfSourceTable(Optional<int64_t>& maxPrimaryKey);
 
     bool reAttachMigrationInfo(const MigrationInfo* info);
     void finalizeMigrationStatement();
@@ -156,6 +156,9 @@ bool MigratingHandleDecorator::rebindUnionView(const UnsafeStringView& table,
         = info.value()->getStatementForCreatingUnionedView(columns);
         succeed = handleStatement.prepare(createView) && handleStatement.step();
         handleStatement.finalize();
+        if (succeed) {
+            info.value()->setUnionedColumns(columns);
+        }
         return succeed;
     });
 }
@@ -381,7 +384,7 @@ MigratingHandleDecorator::getStatement(const UnsafeStringView& skipDecorator)
         && !skipDecorator.equal(DecoratorMigratingHandleStatement)
         && !skipDecorator.equal(DecoratorAllType)) {
         statement->tryAddDecorator<MigratingStatementDecorator>(
-        DecoratorMigratingHandleStatement, this);
+        DecoratorMigratingHandleStatement, this, &m_statementCache);
     }
     return statement;
 }
@@ -23,6 +23,7 @@
  */
 
 #include "DecorativeHandle.hpp"
+#include "MigratingStatementDecorator.hpp"
 #include "Migration.hpp"
 
 namespace WCDB {
@@ -76,6 +77,9 @@ public:
     DecorativeHandleStatement *
     getStatement(const UnsafeStringView &skipDecorator) override final;
     void finalizeStatements() override final;
+
+private:
+    MigratingStatementDecorator::Cache m_statementCache;
 };
 
 } // namespace WCDB
@@ -32,20 +32,24 @@
 namespace WCDB {
 
 #pragma mark - Basic
-MigratingStatementDecorator::MigratingStatementDecorator(Migration::Binder* binder)
+MigratingStatementDecorator::MigratingStatementDecorator(Migration::Binder* binder, Cache* cache)
 : HandleStatementDecorator()
 , m_migrationBinder(binder)
+, m_statementCache(cache)
 , m_processing(false)
 , m_currentStatementType(StatementType::Invalid)
 , m_migratingInfo(nullptr)
 , m_primaryKeyIndex(0)
 , m_rowidBindIndex(0)
+, m_routingInfo(nullptr)
+, m_routingNeedsBinding(false)
 {
 }
 
 MigratingStatementDecorator::MigratingStatementDecorator(MigratingStatementDecorator&& other)
 : Super(std::move(other))
 , m_migrationBinder(other.m_migrationBinder)
+, m_statementCache(other.m_statementCache)
 , m_processing(other.m_processing)
 , m_currentStatementType(other.m_currentStatementType)
 , m_additionalStatements(std::move(other.m_additionalStatements))
@@ -53,8 +57,12 @@ MigratingStatementDecorator::MigratingStatementDecorator(MigratingStatementDecor
 , m_assignedPrimaryKey(std::move(other.m_assignedPrimaryKey))
 , m_primaryKeyIndex(other.m_primaryKeyIndex)
 , m_rowidBindIndex(other.m_rowidBindIndex)
+, m_routingInfo(other.m_routingInfo)
+, m_routingTerms(std::move(other.m_routingTerms))
+, m_routingNeedsBinding(other.m_routingNeedsBinding)
 {
     other.m_migrationBinder = nullptr;
+    other.m_statementCache = nullptr;
     other.m_processing = false;
     other.m_currentStatementType = StatementType::Invalid;
     other.m_additionalStatements.clear();
@@ -62,6 +70,9 @@ MigratingStatementDecorator::MigratingStatementDecorator(MigratingStatementDecor
     other.m_assignedPrimaryKey = NullOpt;
     other.m_primaryKeyIndex = 0;
     other.m_rowidBindIndex = 0;
+    other.m_routingInfo = nullptr;
+    other.m_routingTerms.clear();
+    other.m_routingNeedsBinding = false;
 }
 
 MigratingStatementDecorator::~MigratingStatementDecorator() = default;
@@ -84,19 +95,21 @@ void MigratingStatementDecorator::decorate(Decorative* handleStatement)
 }
 
 #pragma mark - Migration
-Optional<std::list<Statement>>
+Optional<MigratingStatementDecorator::ProcessedStatements>
 MigratingStatementDecorator::process(const Statement& originStatement)
 {
     m_processing = true;
     bool succeed = true;
-    std::list<Statement> statements;
+    ProcessedStatements processed;
+    std::list<Statement>& statements = processed.statements;
     do {
+        m_boundTables.clear();
         m_migrationBinder->startBinding();
 
         // It's dangerous to use origin statement after tampering since all the tokens are not fit.
         Statement falledBackStatement = originStatement;
         // fallback
-        falledBackStatement.iterate([&succeed, this, &originStatement](
+        falledBackStatement.iterate([&succeed, &processed, this, &originStatement](
                                     Syntax::Identifier& identifier, bool isBegin, bool& stop) {
             if (!isBegin) {
                 return;
@@ -149,6 +162,7 @@ MigratingStatementDecorator::process(const Statement& originStatement)
             } break;
             case Syntax::Identifier::Type::CreateTableSTMT: {
                 Syntax::CreateTableSTMT& syntax = (Syntax::CreateTableSTMT&) identifier;
+                processed.cacheable = false;
                 if (!m_migrationBinder->hintThatTableWillBeCreated(syntax.table)) {
                     succeed = false;
                 }
@@ -208,7 +222,7 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 m_migratingInfo = info;
                 info->generateStatementsForInsertMigrating(
                 falledBackStatement, statements, m_primaryKeyIndex, m_rowidBindIndex, m_assignedPrimaryKey);
-                sqlite3_revertCommitOrder(getHandleStatement()->getRawHandle());
+                processed.revertCommitOrder = true;
             }
         } break;
         case Syntax::Identifier::Type::UpdateSTMT: {
@@ -224,6 +238,10 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 const MigrationInfo* info
                 = m_migrationBinder->getBoundInfo(migratedTableName);
                 WCTAssert(info != nullptr);
+                if (isModifyingPrimaryKey(
+                    static_cast<const Syntax::UpdateSTMT&>(originStatement.syntax()), info)) {
+                    info->disableRouting();
+                }
                 info->generateStatementsForUpdateMigrating(
                 falledBackStatement, statements, m_rowidBindIndex);
             }
@@ -275,6 +293,10 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 stmt.schema = Schema::main();
             }
         } break;
+        case Syntax::Identifier::Type::SelectSTMT: {
+            tryRouteSelect(falledBackStatement, processed);
+            statements.push_back(falledBackStatement);
+        } break;
         default:
             statements.push_back(falledBackStatement);
             break;
@@ -282,18 +304,99 @@ MigratingStatementDecorator::process(const Statement& originStatement)
     } while (false);
     m_processing = false;
     if (succeed) {
-        m_currentStatementType = originStatement.getType();
-        return std::move(statements);
+        processed.type = originStatement.getType();
+        processed.boundTables = std::move(m_boundTables);
+        processed.migratingInfo = m_migratingInfo;
+        processed.assignedPrimaryKey = m_assignedPrimaryKey;
+        processed.primaryKeyIndex = m_primaryKeyIndex;
+        processed.rowidBindIndex = m_rowidBindIndex;
+        return std::move(processed);
     } else {
         return NullOpt;
     }
 }
 
+bool MigratingStatementDecorator::tryLoadCachedStatements(const StringView& sql,
+                                                          Optional<ProcessedStatements>& cached)
+{
+    if (m_statementCache == nullptr) {
+        return true;
+    }
+    const ProcessedStatements* entry = m_statementCache->find(sql);
+    if (entry == nullptr) {
+        return true;
+    }
+    // Copy it out since binding may run other statements which touch the cache.
+    cached = *entry;
+    // Bind the tables again so that the views and the schemas are kept.
+    bool matched = true;
+    bool succeed = true;
+    m_migrationBinder->startBinding();
+    for (const auto& boundTable : cached.value().boundTables) {
+        auto optionalInfo = m_migrationBinder->bindTable(boundTable.first);
+        if (!optionalInfo.succeed()) {
+            succeed = false;
+            break;
+        }
+        if (optionalInfo.value() != boundTable.second) {
+            matched = false;
+        }
+    }
+    if (!m_migrationBinder->stopBinding(succeed)) {
+        cached = NullOpt;
+        return false;
+    }
+    if (!m_statementCache->validate(m_migrationBinder->getBoundVersion()) || !matched) {
+        cached = NullOpt;
+    }
+    return true;
+}
+
+bool MigratingStatementDecorator::prepareProcessedStatements(const ProcessedStatements& processed)
+{
+    WCTAssert(!processed.statements.empty());
+    WCTAssert(m_additionalStatements.empty());
+    m_currentStatementType = processed.type;
+    m_migratingInfo = processed.migratingInfo;
+    m_assignedPrimaryKey = processed.assignedPrimaryKey;
+    m_primaryKeyIndex = processed.primaryKeyIndex;
+    m_rowidBindIndex = processed.rowidBindIndex;
+    m_routingInfo = processed.routingInfo;
+    m_routingTerms = processed.routingTerms;
+    m_routingNeedsBinding = m_routingInfo != nullptr;
+    if (processed.revertCommitOrder) {
+        sqlite3_revertCommitOrder(getHandleStatement()->getRawHandle());
+    }
+    // The last statement must be targeted at the main scheme
+    if (!Super::prepare(processed.statements.back())) {
+        return false;
+    }
+    auto last = std::prev(processed.statements.end());
+    for (auto iter = processed.statements.begin(); iter != last; ++iter) {
+        m_additionalStatements.emplace_back(getHandle());
+        m_additionalStatements.back().enableAutoAddColumn();
+        if (!m_additionalStatements.back().prepare(*iter)) {
+            getHandleStatement()->finalize();
+            return false;
+        }
+    }
+    return true;
+}
+
+Optional<const MigrationInfo*> MigratingStatementDecorator::bindTable(const UnsafeStringView& table)
+{
+    auto optionalInfo = m_migrationBinder->bindTable(table);
+    if (optionalInfo.succeed()) {
+        m_boundTables.emplace_back(table, optionalInfo.value());
+    }
+    return optionalInfo;
+}
+
 bool MigratingStatementDecorator::tryFallbackToUnionedView(Syntax::Schema& schema,
                                                            StringView& table)
 {
     if (schema.isMain()) {
-        auto optionalInfo = m_migrationBinder->bindTable(table);
+        auto optionalInfo = bindTable(table);
         if (!optionalInfo.succeed()) {
             return false;
         }
@@ -310,7 +413,7 @@ bool MigratingStatementDecorator::tryFallbackToSourceTable(Syntax::Schema& schem
                                                            StringView& table)
 {
     if (schema.isMain()) {
-        auto optionalInfo = m_migrationBinder->bindTable(table);
+        auto optionalInfo = bindTable(table);
         if (!optionalInfo.succeed()) {
             return false;
         }
@@ -330,27 +433,24 @@ bool MigratingStatementDecorator::prepare(const Statement& statement)
                       "Last statement is not finalized.",
                       finalize(););
     WCTAssert(!m_processing);
-    auto optionalStatements = process(statement);
-    if (!optionalStatements.succeed()) {
+    StringView sql = statement.getDescription();
+    Optional<ProcessedStatements> cached;
+    if (!tryLoadCachedStatements(sql, cached)) {
         return false;
     }
-    auto& statements = optionalStatements.value();
-    WCTAssert(!statements.empty());
-    WCTAssert(m_additionalStatements.empty());
-    // The last statement must be targeted at the main scheme
-    if (!Super::prepare(statements.back())) {
+    if (cached.succeed()) {
+        return prepareProcessedStatements(cached.value());
+    }
+    auto optionalProcessed = process(statement);
+    if (!optionalProcessed.succeed()) {
         return false;
     }
-    statements.pop_back();
-    for (const auto& stmt : statements) {
-        m_additionalStatements.emplace_back(getHandle());
-        m_additionalStatements.back().enableAutoAddColumn();
-        if (!m_additionalStatements.back().prepare(stmt)) {
-            getHandleStatement()->finalize();
-            return false;
-        }
+    const ProcessedStatements& processed = optionalProcessed.value();
+    if (m_statementCache != nullptr && processed.cacheable) {
+        m_statementCache->validate(m_migrationBinder->getBoundVersion());
+        m_statementCache->insert(sql, processed);
     }
-    return true;
+    return prepareProcessedStatements(processed);
 }
 
 void MigratingStatementDecorator::finalize()
@@ -363,10 +463,16 @@ void MigratingStatementDecorator::finalize()
     m_currentStatementType = StatementType::Invalid;
     m_rowidBindIndex = 0;
     clearMigrateStatus();
+    m_routingInfo = nullptr;
+    m_routingTerms.clear();
+    m_routingNeedsBinding = false;
 }
 
 bool MigratingStatementDecorator::step()
 {
+    if (m_routingNeedsBinding) {
+        bindRouting();
+    }
     if (m_additionalStatements.size() > 0) {
         WCTAssert(dynamic_cast<InnerHandle*>(getHandle()) != nullptr);
         InnerHandle* handle = static_cast<InnerHandle*>(getHandle());
@@ -405,6 +511,7 @@ void MigratingStatementDecorator::reset()
     if (m_primaryKeyIndex > 0) {
         m_assignedPrimaryKey = NullOpt;
     }
+    m_routingNeedsBinding = m_routingInfo != nullptr;
 }
 
 void MigratingStatementDecorator::clearBindings()
@@ -416,6 +523,12 @@ void MigratingStatementDecorator::clearBindings()
     if (m_primaryKeyIndex > 0) {
         m_assignedPrimaryKey = NullOpt;
     }
+    for (auto& term : m_routingTerms) {
+        if (term.bindIndex > 0) {
+            term.value = NullOpt;
+        }
+    }
+    m_routingNeedsBinding = m_routingInfo != nullptr;
 }
 
 void MigratingStatementDecorator::bindInteger(const Integer& value, int index)
@@ -433,6 +546,7 @@ void MigratingStatementDecorator::bindInteger(const Integer& value, int index)
         && m_primaryKeyIndex > 0 && index == m_primaryKeyIndex) {
         m_assignedPrimaryKey = value;
     }
+    setRoutingValue(index, value);
 }
 
 void MigratingStatementDecorator::bindDouble(const Float& value, int index)
@@ -446,6 +560,7 @@ void MigratingStatementDecorator::bindDouble(const Float& value, int index)
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindDouble(value, index);
     }
+    setRoutingValue(index, NullOpt);
 }
 
 void MigratingStatementDecorator::bindText(const Text& value, int index)
@@ -459,6 +574,7 @@ void MigratingStatementDecorator::bindText(const Text& value, int index)
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindText(value, index);
     }
+    setRoutingValue(index, NullOpt);
 }
 
 void MigratingStatementDecorator::bindText16(const char16_t* value, size_t valueLength, int index)
@@ -472,6 +588,7 @@ void MigratingStatementDecorator::bindText16(const char16_t* value, size_t value
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindText16(value, valueLength, index);
     }
+    setRoutingValue(index, NullOpt);
 }
 
 void MigratingStatementDecorator::bindBLOB(const BLOB& value, int index)
@@ -485,6 +602,7 @@ void MigratingStatementDecorator::bindBLOB(const BLOB& value, int index)
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindBLOB(value, index);
     }
+    setRoutingValue(index, NullOpt);
 }
 
 void MigratingStatementDecorator::bindNull(int index)
@@ -502,6 +620,7 @@ void MigratingStatementDecorator::bindNull(int index)
         && m_primaryKeyIndex > 0 && index == m_primaryKeyIndex) {
         m_assignedPrimaryKey = NullOpt;
     }
+    setRoutingValue(index, NullOpt);
 }
 
 void MigratingStatementDecorator::bindPointer(void* ptr,
@@ -518,6 +637,7 @@ void MigratingStatementDecorator::bindPointer(void* ptr,
     if (getHandleStatement()->getBindParameterCount() >= index) {
         Super::bindPointer(ptr, index, type, destructor);
     }
+    setRoutingValue(index, NullOpt);
 }
 
 #pragma mark - Insert
@@ -624,4 +744,239 @@ bool MigratingStatementDecorator::stepUpdateOrDelete()
     return true;
 }
 
+bool MigratingStatementDecorator::isModifyingPrimaryKey(const Syntax::UpdateSTMT& stmt,
+                                                        const MigrationInfo* info) const
+{
+    if (!info->isRoutable()) {
+        return false;
+    }
+    for (const auto& columns : stmt.columnsList) {
+        for (const auto& column : columns) {
+            if (isPrimaryKeyColumn(column, info->getIntegerPrimaryKey(), UnsafeStringView())) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#pragma mark - Route
+void MigratingStatementDecorator::tryRouteSelect(Statement& falledBackStatement,
+                                                 ProcessedStatements& processed)
+{
+    const MigrationInfo* info = nullptr;
+    for (const auto& boundTable : m_boundTables) {
+        if (boundTable.second == nullptr) {
+            continue;
+        }
+        if (info != nullptr && info != boundTable.second) {
+            // Multiple migrating tables
+            return;
+        }
+        info = boundTable.second;
+    }
+    if (info == nullptr || !info->isRoutable()) {
+        return;
+    }
+
+    // Only the simple select like `SELECT ... FROM table WHERE primaryKey == ? ...` is routed.
+    Syntax::SelectSTMT& stmt = static_cast<Syntax::SelectSTMT&>(falledBackStatement.syntax());
+    if (!stmt.commonTableExpressions.empty() || !stmt.cores.empty()
+        || !stmt.select.hasValue()) {
+        return;
+    }
+    Syntax::SelectCore& core = stmt.select.value();
+    if (core.switcher != Syntax::SelectCore::Switch::Select
+        || core.tableOrSubqueries.size() != 1 || !core.condition.hasValue()) {
+        return;
+    }
+    Syntax::TableOrSubquery& from = core.tableOrSubqueries.front();
+    const StringView& unionedView = info->getUnionedView();
+    if (from.switcher != Syntax::TableOrSubquery::Switch::Table || !from.schema.isTemp()
+        || from.tableOrFunction != unionedView) {
+        return;
+    }
+    StringView alias = from.alias.empty() ? unionedView : from.alias;
+
+    // The unioned view should be referenced only once and its columns should be listed explicitly.
+    int numberOfReferences = 0;
+    bool wildcard = false;
+    falledBackStatement.iterate(
+    [&numberOfReferences, &wildcard, &unionedView](Syntax::Identifier& identifier, bool isBegin, bool&) {
+        if (!isBegin) {
+            return;
+        }
+        switch (identifier.getType()) {
+        case Syntax::Identifier::Type::TableOrSubquery: {
+            Syntax::TableOrSubquery& syntax = (Syntax::TableOrSubquery&) identifier;
+            if (syntax.switcher == Syntax::TableOrSubquery::Switch::Table
+                && syntax.tableOrFunction == unionedView) {
+                ++numberOfReferences;
+            }
+        } break;
+        case Syntax::Identifier::Type::Expression: {
+            Syntax::Expression& syntax = (Syntax::Expression&) identifier;
+            if (syntax.switcher == Syntax::Expression::Switch::In
+                && syntax.inSwitcher == Syntax::Expression::SwitchIn::Table
+                && syntax.table() == unionedView) {
+                ++numberOfReferences;
+            }
+        } break;
+        case Syntax::Identifier::Type::Column: {
+            if (((Syntax::Column&) identifier).wildcard) {
+                wildcard = true;
+            }
+        } break;
+        default:
+            break;
+        }
+    });
+    if (numberOfReferences != 1 || wildcard) {
+        return;
+    }
+
+    std::list<RoutingTerm> terms;
+    collectRoutingTerms(core.condition.value(), info->getIntegerPrimaryKey(), alias, terms);
+    if (terms.empty()) {
+        return;
+    }
+
+    // temp.unionedView -> (SELECT ... UNION ALL SELECT ... WHERE ?routingBindIndex) AS alias
+    from = info->getRoutedUnionedView(alias, m_rowidBindIndex).syntax();
+    if (alias == unionedView) {
+        falledBackStatement.iterate(
+        [&unionedView](Syntax::Identifier& identifier, bool isBegin, bool&) {
+            if (!isBegin || identifier.getType() != Syntax::Identifier::Type::Column) {
+                return;
+            }
+            // temp.unionedView.column -> unionedView.column
+            Syntax::Column& column = (Syntax::Column&) identifier;
+            if (column.schema.isTemp() && column.table == unionedView) {
+                column.schema = Syntax::Schema();
+            }
+        });
+    }
+    processed.routingInfo = info;
+    processed.routingTerms = std::move(terms);
+}
+
+bool MigratingStatementDecorator::isPrimaryKeyColumn(const Syntax::Column& column,
+                                                     const UnsafeStringView& primaryKey,
+                                                     const UnsafeStringView& table)
+{
+    if (column.wildcard) {
+        return false;
+    }
+    if (!table.empty() && !column.table.empty() && column.table != table) {
+        return false;
+    }
+    return column.name.caseInsensitiveEqual(primaryKey)
+           || column.name.caseInsensitiveEqual(Column::rowid().syntax().name);
+}
+
+void MigratingStatementDecorator::collectRoutingTerms(const Syntax::Expression& condition,
+                                                      const UnsafeStringView& primaryKey,
+                                                      const UnsafeStringView& table,
+                                                      std::list<RoutingTerm>& terms)
+{
+    if (condition.switcher != Syntax::Expression::Switch::BinaryOperation
+        || condition.expressions.size() != 2) {
+        return;
+    }
+    using Operator = Syntax::Expression::BinaryOperator;
+    const Syntax::Expression& left = condition.expressions.front();
+    const Syntax::Expression& right = condition.expressions.back();
+    if (condition.binaryOperator == Operator::And) {
+        collectRoutingTerms(left, primaryKey, table, terms);
+        collectRoutingTerms(right, primaryKey, table, terms);
+        return;
+    }
+
+    // Normalize to `primaryKey [operator] value`
+    const Syntax::Expression* value = nullptr;
+    Operator bound = condition.binaryOperator;
+    if (left.switcher == Syntax::Expression::Switch::Column
+        && isPrimaryKeyColumn(left.column(), primaryKey, table)) {
+        value = &right;
+    } else if (right.switcher == Syntax::Expression::Switch::Column
+               && isPrimaryKeyColumn(right.column(), primaryKey, table)) {
+        value = &left;
+        switch (bound) {
+        case Operator::Less:
+            bound = Operator::Greater;
+            break;
+        case Operator::LessOrEqual:
+            bound = Operator::GreaterOrEqual;
+            break;
+        case Operator::Greater:
+        case Operator::GreaterOrEqual:
+            // It's an upper bound, which can't be routed.
+            return;
+        default:
+            break;
+        }
+    } else {
+        return;
+    }
+    if (bound != Operator::Equal && bound != Operator::Greater
+        && bound != Operator::GreaterOrEqual) {
+        return;
+    }
+
+    RoutingTerm term;
+    term.bound = bound;
+    if (value->switcher == Syntax::Expression::Switch::BindParameter) {
+        const Syntax::BindParameter& bindParameter = value->bindParameter();
+        if (bindParameter.switcher != Syntax::BindParameter::Switch::QuestionSign
+            || bindParameter.n <= 0) {
+            return;
+        }
+        term.bindIndex = bindParameter.n;
+    } else if (value->switcher == Syntax::Expression::Switch::LiteralValue
+               && value->literalValue().switcher == Syntax::LiteralValue::Switch::Integer) {
+        term.value = value->literalValue().integerValue;
+    } else {
+        return;
+    }
+    terms.push_back(std::move(term));
+}
+
+void MigratingStatementDecorator::setRoutingValue(int index, const Optional<int64_t>& value)
+{
+    for (auto& term : m_routingTerms) {
+        if (term.bindIndex == index) {
+            term.value = value;
+            m_routingNeedsBinding = true;
+        }
+    }
+}
+
+void MigratingStatementDecorator::bindRouting()
+{
+    WCTAssert(m_routingInfo != nullptr);
+    m_routingNeedsBinding = false;
+    bool sourceReadable = true;
+    AbstractHandle* handle = getHandle();
+    // The boundary is only reliable for the snapshot that starts after it is read.
+    if (!handle->isInTransaction() && !handle->hasSteppingStatement()) {
+        auto boundary = m_routingInfo->getMaxPrimaryKeyOfSourceTable();
+        if (boundary.succeed()) {
+            int64_t maxPrimaryKey = boundary.value();
+            for (const auto& term : m_routingTerms) {
+                if (!term.value.hasValue()) {
+                    continue;
+                }
+                int64_t value = term.value.value();
+                if (value > maxPrimaryKey
+                    || (value == maxPrimaryKey
+                        && term.bound == Syntax::Expression::BinaryOperator::Greater)) {
+                    sourceReadable = false;
+                    break;
+                }
+            }
+        }
+    }
+    Super::bindInteger(sourceReadable ? 1 : 0, m_rowidBindIndex);
+}
+
 } //namespace WCDB
@@ -22,8 +22,11 @@
  * limitations under the License.
  */
 
+#pragma once
+
 #include "DecorativeHandleStatement.hpp"
 #include "Migration.hpp"
+#include "RewrittenStatementCache.hpp"
 #include <list>
 
 namespace WCDB {
@@ -31,7 +34,33 @@ namespace WCDB {
 class MigratingStatementDecorator final : public HandleStatementDecorator {
 #pragma mark - Basic
 public:
-    MigratingStatementDecorator(Migration::Binder *binder);
+    // The primary key is equal to/greater than/greater than or equal to the value.
+    struct RoutingTerm {
+        Syntax::Expression::BinaryOperator bound = Syntax::Expression::BinaryOperator::Equal;
+        // 0 for the literal value.
+        int bindIndex = 0;
+        Optional<int64_t> value;
+    };
+
+    struct ProcessedStatements {
+        Syntax::Identifier::Type type = Syntax::Identifier::Type::Invalid;
+        // The last one is the statement targeted at the main schema.
+        std::list<Statement> statements;
+        // Tables bound during processing and their infos, which must be bound again before reusing.
+        std::list<std::pair<StringView, const MigrationInfo *>> boundTables;
+        const MigrationInfo *migratingInfo = nullptr;
+        Optional<int64_t> assignedPrimaryKey;
+        int primaryKeyIndex = 0;
+        int rowidBindIndex = 0;
+        bool revertCommitOrder = false;
+        bool cacheable = true;
+        // The select is routed by its primary key terms. See MigrationInfo::isRoutable.
+        const MigrationInfo *routingInfo = nullptr;
+        std::list<RoutingTerm> routingTerms;
+    };
+    typedef RewrittenStatementCache<ProcessedStatements> Cache;
+
+    MigratingStatementDecorator(Migration::Binder *binder, Cache *cache = nullptr);
     MigratingStatementDecorator(MigratingStatementDecorator &&other);
     ~MigratingStatementDecorator() override;
 
@@ -46,6 +75,7 @@ protected:
 
 private:
     Migration::Binder *m_migrationBinder;
+    Cache *m_statementCache;
 
 #pragma mark - Decorated functions
 public:
@@ -66,10 +96,14 @@ public:
 #pragma mark - Migration
 protected:
     bool realStep();
-    Optional<std::list<Statement>> process(const Statement &statement);
+    Optional<ProcessedStatements> process(const Statement &statement);
+    bool tryLoadCachedStatements(const StringView &sql, Optional<ProcessedStatements> &cached);
+    bool prepareProcessedStatements(const ProcessedStatements &processed);
+    Optional<const MigrationInfo *> bindTable(const UnsafeStringView &table);
     bool tryFallbackToUnionedView(Syntax::Schema &schema, StringView &table);
     bool tryFallbackToSourceTable(Syntax::Schema &schema, StringView &table);
     bool m_processing;
+    std::list<std::pair<StringView, const MigrationInfo *>> m_boundTables;
 
     using StatementType = Syntax::Identifier::Type;
     StatementType m_currentStatementType;
@@ -89,6 +123,25 @@ private:
 #pragma mark - Update/Delete
 protected:
     bool stepUpdateOrDelete();
+    bool isModifyingPrimaryKey(const Syntax::UpdateSTMT &stmt, const MigrationInfo *info) const;
+
+#pragma mark - Route
+protected:
+    void tryRouteSelect(Statement &falledBackStatement, ProcessedStatements &processed);
+    static bool isPrimaryKeyColumn(const Syntax::Column &column,
+                                   const UnsafeStringView &primaryKey,
+                                   const UnsafeStringView &table);
+    static void collectRoutingTerms(const Syntax::Expression &condition,
+                                    const UnsafeStringView &primaryKey,
+                                    const UnsafeStringView &table,
+                                    std::list<RoutingTerm> &terms);
+    void setRoutingValue(int index, const Optional<int64_t> &value);
+    void bindRouting();
+
+private:
+    const MigrationInfo *m_routingInfo;
+    std::list<RoutingTerm> m_routingTerms;
+    bool m_routingNeedsBinding;
 };
 
 } // namespace WCDB
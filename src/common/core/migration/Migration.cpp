@@ -430,7 +430,7 @@ Optional<bool> Migration::InfoInitializer::tryUpdateSequence(const MigrationInfo
 
 #pragma mark - Bind
 Migration::Binder::Binder(Migration& migration)
-: m_migration(migration), m_binding(false), m_rebind(false)
+: m_migration(migration), m_binding(false), m_rebind(false), m_boundVersion(0)
 {
 }
 
@@ -458,6 +458,7 @@ bool Migration::Binder::stopBinding(bool succeed)
             if (succeed) {
                 m_rebind = false;
                 m_bounds = m_bindings;
+                ++m_boundVersion;
             } else {
                 m_rebind = true;
             }
@@ -473,6 +474,7 @@ void Migration::Binder::setNeedRebind()
 {
     m_bounds.clear();
     m_rebind = true;
+    ++m_boundVersion;
 }
 
 void Migration::Binder::stopReferenced()
@@ -511,6 +513,11 @@ const MigrationInfo* Migration::Binder::getBoundInfo(const UnsafeStringView& tab
     return info;
 }
 
+uint64_t Migration::Binder::getBoundVersion() const
+{
+    return m_boundVersion;
+}
+
 void Migration::Binder::setTableInfoCommitted(bool committed)
 {
     m_migration.setTableInfoCommitted(committed);
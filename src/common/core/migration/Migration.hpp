@@ -150,6 +150,8 @@ public:
         Optional<const MigrationInfo*> bindTable(const UnsafeStringView& table);
         bool hintThatTableWillBeCreated(const UnsafeStringView& table);
         const MigrationInfo* getBoundInfo(const UnsafeStringView& table);
+        // It changes whenever the bound infos change.
+        uint64_t getBoundVersion() const;
 
         virtual bool bindInfos(const StringViewMap<const MigrationInfo*>& infos) = 0;
 
@@ -162,6 +164,7 @@ public:
         StringViewMap<const MigrationInfo*> m_bindings;
         StringViewMap<const MigrationInfo*> m_bounds;
         bool m_rebind;
+        uint64_t m_boundVersion;
     };
 
 protected:
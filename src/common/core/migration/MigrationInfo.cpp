@@ -25,6 +25,7 @@
 #include "MigrationInfo.hpp"
 #include "Assertion.hpp"
 #include "StringView.hpp"
+#include <limits>
 
 namespace WCDB {
 
@@ -322,6 +323,19 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
         m_statementForDroppingSourceTable
         = StatementDropTable().dropTable(getSourceTable()).schema(sourceSchema).ifExists();
     }
+
+    // Route
+    {
+        m_routingState = std::make_shared<RoutingState>();
+        m_routingState->unionedColumns = columns;
+        if (!m_integerPrimaryKey.empty()) {
+            m_statementForSelectingMaxPrimaryKeyOfSourceTable
+            = StatementSelect()
+              .select(Column(m_integerPrimaryKey).max())
+              .from(sourceTableQuery)
+              .where(m_filterCondition);
+        }
+    }
 }
 
 MigrationInfo::~MigrationInfo() = default;
@@ -602,4 +616,79 @@ const StatementDropTable& MigrationInfo::getStatementForDroppingSourceTable() co
     return m_statementForDroppingSourceTable;
 }
 
+#pragma mark - Route
+MigrationInfo::RoutingState::RoutingState()
+: disabled(false), boundaryKnown(false), maxPrimaryKeyOfSourceTable(0)
+{
+}
+
+bool MigrationInfo::isRoutable() const
+{
+    return !m_integerPrimaryKey.empty();
+}
+
+const StatementSelect& MigrationInfo::getStatementForSelectingMaxPrimaryKeyOfSourceTable() const
+{
+    WCTAssert(isRoutable());
+    return m_statementForSelectingMaxPrimaryKeyOfSourceTable;
+}
+
+void MigrationInfo::setMaxPrimaryKeyOfSourceTable(const Optional<int64_t>& maxPrimaryKey) const
+{
+    LockGuard lockGuard(m_routingState->lock);
+    m_routingState->boundaryKnown = true;
+    // Empty source table
+    m_routingState->maxPrimaryKeyOfSourceTable
+    = maxPrimaryKey.hasValue() ? maxPrimaryKey.value() : std::numeric_limits<int64_t>::min();
+}
+
+Optional<int64_t> MigrationInfo::getMaxPrimaryKeyOfSourceTable() const
+{
+    SharedLockGuard lockGuard(m_routingState->lock);
+    if (m_routingState->disabled || !m_routingState->boundaryKnown) {
+        return NullOpt;
+    }
+    return m_routingState->maxPrimaryKeyOfSourceTable;
+}
+
+void MigrationInfo::disableRouting() const
+{
+    LockGuard lockGuard(m_routingState->lock);
+    m_routingState->disabled = true;
+}
+
+void MigrationInfo::setUnionedColumns(const Columns& columns) const
+{
+    Columns unionedColumns;
+    unionedColumns.push_back(Column::rowid());
+    unionedColumns.insert(unionedColumns.end(), columns.begin(), columns.end());
+    LockGuard lockGuard(m_routingState->lock);
+    m_routingState->unionedColumns = unionedColumns;
+}
+
+TableOrSubquery
+MigrationInfo::getRoutedUnionedView(const UnsafeStringView& alias, int routingBindIndex) const
+{
+    ResultColumns resultColumns;
+    {
+        SharedLockGuard lockGuard(m_routingState->lock);
+        resultColumns.insert(resultColumns.begin(),
+                             m_routingState->unionedColumns.begin(),
+                             m_routingState->unionedColumns.end());
+    }
+    Expression condition = BindParameter(routingBindIndex);
+    if (m_filterCondition.syntax().isValid()) {
+        condition = m_filterCondition && condition;
+    }
+    return TableOrSubquery(
+           StatementSelect()
+           .select(resultColumns)
+           .from(TableOrSubquery(getTable()).schema(Schema::main()))
+           .unionAll()
+           .select(resultColumns)
+           .from(TableOrSubquery(getSourceTable()).schema(getSchemaForSourceDatabase()))
+           .where(condition))
+    .as(alias);
+}
+
 } // namespace WCDB
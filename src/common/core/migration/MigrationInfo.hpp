@@ -27,6 +27,7 @@
 #include "Lock.hpp"
 #include "StringView.hpp"
 #include "WINQ.h"
+#include <memory>
 #include <set>
 
 namespace WCDB {
@@ -280,6 +281,58 @@ protected:
     StatementDelete m_statementForDeletingMigratedOneRow;
     StatementDropTable m_statementForDroppingSourceTable;
     StatementSelect m_statementForSelectingAnyRowFromSourceTable;
+
+#pragma mark - Route
+public:
+    /*
+     Rows are migrated in descending order of integer primary key and the new rows never stay in the source table.
+     So all the rows in the source table have the primary key not greater than a boundary,
+     and the lookups beyond it only need to read the target table.
+     
+     It's only available for the tables with integer primary key.
+     */
+    bool isRoutable() const;
+
+    /*
+     SELECT max([primary key])
+     FROM [schemaForSourceDatabase].[sourceTable]
+     */
+    const StatementSelect& getStatementForSelectingMaxPrimaryKeyOfSourceTable() const;
+
+    // It should be called after the migrated rows are committed.
+    void setMaxPrimaryKeyOfSourceTable(const Optional<int64_t>& maxPrimaryKey) const;
+    // Null means it's unknown, e.g. before the first step of migration or the primary keys are modified.
+    Optional<int64_t> getMaxPrimaryKeyOfSourceTable() const;
+    // The primary keys of source table may be increased by user, so the boundary is not reliable anymore.
+    void disableRouting() const;
+
+    void setUnionedColumns(const Columns& columns) const;
+
+    /*
+     (SELECT rowid, [columns]
+     FROM main.[table]
+     UNION ALL
+     SELECT rowid, [columns]
+     FROM [schemaForSourceDatabase].[sourceTable]
+     WHERE [filter] AND ?[routingBindIndex]) AS [alias]
+     
+     The source table is skipped when 0 is bound to the routing parameter.
+     */
+    TableOrSubquery getRoutedUnionedView(const UnsafeStringView& alias, int routingBindIndex) const;
+
+protected:
+    StatementSelect m_statementForSelectingMaxPrimaryKeyOfSourceTable;
+
+    // Shared by the copies of info.
+    struct RoutingState {
+        RoutingState();
+        SharedLock lock;
+        bool disabled;
+        bool boundaryKnown;
+        int64_t maxPrimaryKeyOfSourceTable;
+        Columns unionedColumns;
+    };
+    std::shared_ptr<RoutingState> m_routingState;
 };
 
 } // namespace WCDB
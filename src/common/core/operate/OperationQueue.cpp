@@ -85,6 +85,9 @@ void OperationQueue::stopAllDatabaseEvent(const UnsafeStringView& path)
 
     Operation mergeIndex(Operation::Type::MergeIndex, path);
     m_timedQueue.remove(mergeIndex);
+
+    Operation adjustHandlePool(Operation::Type::AdjustHandlePool, path);
+    m_timedQueue.remove(adjustHandlePool);
 }
 
 void OperationQueue::stop()
@@ -187,7 +190,7 @@ bool OperationQueue::Operation::operator==(const Operation& other) const
 {
     bool equal = false;
     if (type == other.type) {
-        if (type == Type::Purge) {
+        if (type == Type::Purge || type == Type::RebalanceMemory) {
             equal = true;
         } else {
             equal = (path == other.path);
@@ -196,6 +199,17 @@ bool OperationQueue::Operation::operator==(const Operation& other) const
     return equal;
 }
 
+size_t OperationQueue::OperationHasher::operator()(const Operation& operation) const
+{
+    // Keep consistent with Operation::operator==, which ignores the path of purge and memory rebalance.
+    size_t hash = std::hash<int>()((int) operation.type);
+    if (operation.type != Operation::Type::Purge
+        && operation.type != Operation::Type::RebalanceMemory) {
+        hash ^= operation.path.hash() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
 OperationQueue::Parameter::Parameter()
 : source(Source::Other), numberOfFailures(0), identifier(0), numberOfFileDescriptors(0)
 {
@@ -233,6 +247,13 @@ void OperationQueue::onTimed(const Operation& operation, const Parameter& parame
         case Operation::Type::Backup:
             doBackup(operation.path);
             break;
+        case Operation::Type::AdjustHandlePool:
+            doAdjustHandlePool(operation.path);
+            break;
+        case Operation::Type::RebalanceMemory:
+            WCTAssert(operation.path.empty());
+            doRebalanceMemory();
+            break;
         }
         if (operation.type != Operation::Type::NotifyCorruption) {
             Core::shared().setThreadedErrorIgnorable(false);
@@ -540,6 +561,38 @@ void OperationQueue::doCheckpoint(const UnsafeStringView& path)
     m_event->checkpointShouldBeOperated(path);
 }
 
+#pragma mark - Handle Pool
+void OperationQueue::asyncAdjustHandlePool(const UnsafeStringView& path, double delay)
+{
+    WCTAssert(!path.empty());
+
+    Operation operation(Operation::Type::AdjustHandlePool, path);
+    Parameter parameter;
+    async(operation, delay, parameter, AsyncMode::ForwardOnly);
+}
+
+void OperationQueue::doAdjustHandlePool(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    m_event->handlePoolShouldBeAdjusted(path);
+}
+
+#pragma mark - Memory Governor
+void OperationQueue::asyncRebalanceMemory()
+{
+    Operation operation(Operation::Type::RebalanceMemory);
+    Parameter parameter;
+    async(operation, MemoryGovernorTimeIntervalForRebalance, parameter, AsyncMode::ForwardOnly);
+}
+
+void OperationQueue::doRebalanceMemory()
+{
+    if (m_event->memoryShouldBeRebalanced()) {
+        asyncRebalanceMemory();
+    }
+}
+
 #pragma mark - Purge
 #ifndef _WIN32
 int OperationQueue::maxAllowedNumberOfFileDescriptors()
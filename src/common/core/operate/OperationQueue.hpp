@@ -53,6 +53,9 @@ protected:
     virtual void checkpointShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual void integrityShouldBeChecked(const UnsafeStringView& path) = 0;
     virtual void purgeShouldBeOperated() = 0;
+    virtual void handlePoolShouldBeAdjusted(const UnsafeStringView& path) = 0;
+    // Return false if it should not be operated anymore.
+    virtual bool memoryShouldBeRebalanced() = 0;
 
     using TableArray = AutoMergeFTSIndexOperator::TableArray;
     virtual Optional<bool>
@@ -100,6 +103,8 @@ protected:
             Migrate,
             Compress,
             MergeIndex,
+            AdjustHandlePool,
+            RebalanceMemory,
         };
 
         const Type type;
@@ -112,6 +117,10 @@ protected:
     };
     typedef struct Operation Operation;
 
+    struct OperationHasher {
+        size_t operator()(const Operation& operation) const;
+    };
+
     struct Parameter {
         Parameter();
         enum class Source {
@@ -132,12 +141,12 @@ protected:
 
     void onTimed(const Operation& operation, const Parameter& parameter);
 
-    typedef TimedQueue<Operation, Parameter>::Mode AsyncMode;
+    typedef TimedQueue<Operation, Parameter, OperationHasher>::Mode AsyncMode;
     void async(const Operation& operation,
                double delay,
                const Parameter& parameter,
                AsyncMode mode = AsyncMode::ForwardOnly);
-    TimedQueue<Operation, Parameter> m_timedQueue;
+    TimedQueue<Operation, Parameter, OperationHasher> m_timedQueue;
 
 #pragma mark - Record
 protected:
@@ -208,6 +217,20 @@ public:
 protected:
     void doCheckpoint(const UnsafeStringView& path);
 
+#pragma mark - Handle Pool
+public:
+    void asyncAdjustHandlePool(const UnsafeStringView& path, double delay);
+
+protected:
+    void doAdjustHandlePool(const UnsafeStringView& path);
+
+#pragma mark - Memory Governor
+public:
+    void asyncRebalanceMemory();
+
+protected:
+    void doRebalanceMemory();
+
 #pragma mark - Purge
 protected:
     void asyncPurge(const Parameter& parameter);
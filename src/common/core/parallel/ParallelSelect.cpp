@@ -0,0 +1,310 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ParallelSelect.hpp"
+#include "Assertion.hpp"
+#include <cstring>
+
+namespace WCDB {
+
+ParallelSelect::ParallelSelect(const StatementSelect &select, const Expression &rangeExpression)
+: m_select(select), m_rangeExpression(rangeExpression), m_parallelizable(false)
+{
+    m_parallelizable = analyze();
+}
+
+bool ParallelSelect::isParallelizable() const
+{
+    return m_parallelizable;
+}
+
+bool ParallelSelect::analyze()
+{
+    const Syntax::SelectSTMT &stmt = m_select.syntax();
+    if (!stmt.isValid() || !stmt.select.hasValue() || !stmt.cores.empty()
+        || !stmt.commonTableExpressions.empty() || !stmt.orderingTerms.empty()
+        || stmt.limit.hasValue()) {
+        return false;
+    }
+    const Syntax::SelectCore &core = stmt.select.value();
+    if (core.switcher != Syntax::SelectCore::Switch::Select || core.distinct
+        || core.joinClause.hasValue() || !core.groups.empty() || core.having.hasValue()
+        || !core.windows.empty() || core.tableOrSubqueries.size() != 1
+        || core.tableOrSubqueries.front().switcher != Syntax::TableOrSubquery::Switch::Table) {
+        return false;
+    }
+    if (containsAggregateFunction(m_rangeExpression.syntax())) {
+        return false;
+    }
+    bool hasAggregation = false;
+    bool hasConcatenation = false;
+    for (const auto &resultColumn : core.resultColumns) {
+        MergeMethod method = mergeMethodOfResultColumn(resultColumn);
+        if (method == MergeMethod::Concatenate) {
+            if (resultColumn.expression.hasValue()
+                && containsAggregateFunction(resultColumn.expression.value())) {
+                return false;
+            }
+            hasConcatenation = true;
+        } else {
+            hasAggregation = true;
+        }
+        m_methods.push_back(method);
+    }
+    // Aggregate result columns can not be mixed with plain ones.
+    return !m_methods.empty() && !(hasAggregation && hasConcatenation);
+}
+
+ParallelSelect::MergeMethod
+ParallelSelect::mergeMethodOfResultColumn(const Syntax::ResultColumn &resultColumn)
+{
+    if (!resultColumn.expression.hasValue()) {
+        return MergeMethod::Concatenate;
+    }
+    const Syntax::Expression &expression = resultColumn.expression.value();
+    if (expression.switcher != Syntax::Expression::Switch::Function || expression.distinct) {
+        return MergeMethod::Concatenate;
+    }
+    const StringView &function = expression.function();
+    size_t numberOfArguments = expression.expressions.size();
+    if (function.caseInsensitiveEqual("count")
+        && (expression.useWildcard || numberOfArguments == 1)) {
+        return MergeMethod::Count;
+    }
+    if (numberOfArguments != 1) {
+        // min() and max() with multiple arguments are scalar functions.
+        return MergeMethod::Concatenate;
+    }
+    if (function.caseInsensitiveEqual("sum")) {
+        return MergeMethod::Sum;
+    } else if (function.caseInsensitiveEqual("total")) {
+        return MergeMethod::Total;
+    } else if (function.caseInsensitiveEqual("min")) {
+        return MergeMethod::Min;
+    } else if (function.caseInsensitiveEqual("max")) {
+        return MergeMethod::Max;
+    }
+    return MergeMethod::Concatenate;
+}
+
+bool ParallelSelect::containsAggregateFunction(const Syntax::Expression &expression)
+{
+    static const char *s_aggregateFunctions[] = {
+        "count", "sum", "total", "min", "max", "avg", "group_concat",
+    };
+    bool found = false;
+    Syntax::Identifier::ConstIterator iterator
+    = [&found](const Syntax::Identifier &identifier, bool isBegin, bool &stop) {
+        if (!isBegin || identifier.getType() != Syntax::Identifier::Type::Expression) {
+            return;
+        }
+        const Syntax::Expression &child = static_cast<const Syntax::Expression &>(identifier);
+        if (child.switcher == Syntax::Expression::Switch::Window) {
+            found = true;
+        } else if (child.switcher == Syntax::Expression::Switch::Function) {
+            for (const char *aggregateFunction : s_aggregateFunctions) {
+                if (child.function().caseInsensitiveEqual(aggregateFunction)) {
+                    // min() and max() with multiple arguments are scalar functions.
+                    found = child.expressions.size() <= 1
+                            || (!child.function().caseInsensitiveEqual("min")
+                                && !child.function().caseInsensitiveEqual("max"));
+                    break;
+                }
+            }
+        }
+        stop = found;
+    };
+    static_cast<const Syntax::Identifier &>(expression).iterate(iterator);
+    return found;
+}
+
+StatementSelect ParallelSelect::getStatementForSelectingRange() const
+{
+    WCTAssert(m_parallelizable);
+    StatementSelect select = m_select;
+    Syntax::SelectCore &core = select.syntax().select.getOrCreate();
+    core.resultColumns.clear();
+    core.resultColumns.push_back(ResultColumn(m_rangeExpression.min()).syntax());
+    core.resultColumns.push_back(ResultColumn(m_rangeExpression.max()).syntax());
+    return select;
+}
+
+std::vector<StatementSelect>
+ParallelSelect::getPartitionedStatements(int64_t minimum, int64_t maximum, int numberOfPartitions) const
+{
+    WCTAssert(m_parallelizable);
+    std::vector<StatementSelect> statements;
+    if (minimum > maximum || numberOfPartitions <= 0) {
+        return statements;
+    }
+    // Unsigned arithmetic avoids overflow when the range crosses zero.
+    uint64_t span = (uint64_t) maximum - (uint64_t) minimum;
+    uint64_t step = span / (uint64_t) numberOfPartitions + 1;
+    uint64_t offset = 0;
+    do {
+        int64_t lower = (int64_t) ((uint64_t) minimum + offset);
+        int64_t upper = (int64_t) ((uint64_t) minimum + std::min(offset + step - 1, span));
+        Expression range = m_rangeExpression.between(lower, upper);
+
+        StatementSelect statement = m_select;
+        Syntax::SelectCore &core = statement.syntax().select.getOrCreate();
+        if (core.condition.hasValue()) {
+            Expression condition = Expression(Expressions(Expression(core.condition.value())));
+            core.condition = (condition && range).syntax();
+        } else {
+            core.condition = range.syntax();
+        }
+        statements.push_back(std::move(statement));
+        offset += step;
+    } while (offset <= span && offset >= step);
+    return statements;
+}
+
+MultiRowsValue ParallelSelect::mergeResults(std::vector<MultiRowsValue> &&results) const
+{
+    WCTAssert(m_parallelizable);
+    MultiRowsValue merged;
+    if (m_methods.empty() || m_methods.front() == MergeMethod::Concatenate) {
+        size_t count = 0;
+        for (const auto &result : results) {
+            count += result.size();
+        }
+        merged.reserve(count);
+        for (auto &result : results) {
+            for (auto &row : result) {
+                merged.push_back(std::move(row));
+            }
+        }
+        return merged;
+    }
+
+    OneRowValue row(m_methods.size(), nullptr);
+    for (size_t i = 0; i < m_methods.size(); ++i) {
+        if (m_methods[i] == MergeMethod::Count) {
+            row[i] = 0;
+        } else if (m_methods[i] == MergeMethod::Total) {
+            row[i] = 0.0;
+        }
+    }
+    for (const auto &result : results) {
+        if (result.empty()) {
+            continue;
+        }
+        const OneRowValue &partial = result.front();
+        WCTAssert(partial.size() == m_methods.size());
+        for (size_t i = 0; i < m_methods.size() && i < partial.size(); ++i) {
+            row[i] = mergeValue(m_methods[i], row[i], partial[i]);
+        }
+    }
+    merged.push_back(std::move(row));
+    return merged;
+}
+
+Value ParallelSelect::mergeValue(MergeMethod method, const Value &merged, const Value &partial)
+{
+    if (partial.isNull()) {
+        return merged;
+    }
+    switch (method) {
+    case MergeMethod::Count:
+        return merged.intValue() + partial.intValue();
+    case MergeMethod::Total:
+        return merged.floatValue() + partial.floatValue();
+    case MergeMethod::Sum:
+        if (merged.isNull()) {
+            return partial;
+        }
+        if (merged.getType() == ColumnType::Integer && partial.getType() == ColumnType::Integer) {
+            return merged.intValue() + partial.intValue();
+        }
+        return merged.floatValue() + partial.floatValue();
+    case MergeMethod::Min:
+        return merged.isNull() || compareValue(partial, merged) < 0 ? partial : merged;
+    case MergeMethod::Max:
+        return merged.isNull() || compareValue(partial, merged) > 0 ? partial : merged;
+    default:
+        WCTAssert(false);
+        return merged;
+    }
+}
+
+// Compare as SQLite does with BINARY collation: numeric values < text < blob.
+int ParallelSelect::compareValue(const Value &left, const Value &right)
+{
+    auto classOfType = [](ColumnType type) -> int {
+        switch (type) {
+        case ColumnType::Integer:
+        case ColumnType::Float:
+            return 1;
+        case ColumnType::Text:
+            return 2;
+        case ColumnType::BLOB:
+            return 3;
+        default:
+            return 0;
+        }
+    };
+    int leftClass = classOfType(left.getType());
+    int rightClass = classOfType(right.getType());
+    if (leftClass != rightClass) {
+        return leftClass < rightClass ? -1 : 1;
+    }
+    switch (leftClass) {
+    case 1:
+        if (left.getType() == ColumnType::Integer && right.getType() == ColumnType::Integer) {
+            int64_t leftValue = left.intValue();
+            int64_t rightValue = right.intValue();
+            return leftValue < rightValue ? -1 : (leftValue > rightValue ? 1 : 0);
+        } else {
+            double leftValue = left.floatValue();
+            double rightValue = right.floatValue();
+            return leftValue < rightValue ? -1 : (leftValue > rightValue ? 1 : 0);
+        }
+    case 2: {
+        StringView leftValue = left.textValue();
+        StringView rightValue = right.textValue();
+        size_t length = std::min(leftValue.length(), rightValue.length());
+        int result = length > 0 ? memcmp(leftValue.data(), rightValue.data(), length) : 0;
+        if (result == 0 && leftValue.length() != rightValue.length()) {
+            result = leftValue.length() < rightValue.length() ? -1 : 1;
+        }
+        return result;
+    }
+    case 3: {
+        Data leftValue = left.blobValue();
+        Data rightValue = right.blobValue();
+        size_t length = std::min(leftValue.size(), rightValue.size());
+        int result = length > 0 ? memcmp(leftValue.buffer(), rightValue.buffer(), length) : 0;
+        if (result == 0 && leftValue.size() != rightValue.size()) {
+            result = leftValue.size() < rightValue.size() ? -1 : 1;
+        }
+        return result;
+    }
+    default:
+        return 0;
+    }
+}
+
+} // namespace WCDB
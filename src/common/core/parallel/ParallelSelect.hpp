@@ -0,0 +1,80 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "WINQ.h"
+#include <vector>
+
+namespace WCDB {
+
+/*
+ * ParallelSelect splits a select statement on a single table into several statements
+ * on disjoint ranges of an integer column, which is rowid by default,
+ * so that they can be run concurrently on different handles.
+ *
+ * Only the statements whose results can be merged without extra information are supported:
+ * 1. Plain selection without DISTINCT, GROUP BY, HAVING, window, ORDER BY and LIMIT.
+ *    The results of partitions are concatenated in range order.
+ * 2. Selection with only COUNT/SUM/TOTAL/MIN/MAX as result columns.
+ *    The partial results of partitions are combined.
+ */
+class ParallelSelect final {
+public:
+    ParallelSelect(const StatementSelect &select, const Expression &rangeExpression);
+
+    bool isParallelizable() const;
+
+    // Select the minimum and maximum of range expression with the original condition.
+    StatementSelect getStatementForSelectingRange() const;
+    std::vector<StatementSelect>
+    getPartitionedStatements(int64_t minimum, int64_t maximum, int numberOfPartitions) const;
+
+    // Results must be in the same order as partitioned statements.
+    MultiRowsValue mergeResults(std::vector<MultiRowsValue> &&results) const;
+
+private:
+    enum class MergeMethod {
+        Concatenate,
+        Count,
+        Sum,
+        Total,
+        Min,
+        Max,
+    };
+    static MergeMethod mergeMethodOfResultColumn(const Syntax::ResultColumn &resultColumn);
+    static bool containsAggregateFunction(const Syntax::Expression &expression);
+    bool analyze();
+
+    static Value mergeValue(MergeMethod method, const Value &merged, const Value &partial);
+    static int compareValue(const Value &left, const Value &right);
+
+    StatementSelect m_select;
+    Expression m_rangeExpression;
+    std::vector<MergeMethod> m_methods;
+    bool m_parallelizable;
+};
+
+} // namespace WCDB
@@ -37,9 +37,17 @@ AbstractHandle::AbstractHandle()
 : m_handle(nullptr)
 , m_customOpenFlag(0)
 , m_tag(Tag::invalid())
+, m_statementWarmup(nullptr)
+, m_statementGeneration(0)
+, m_allocatedStatementCount(0)
+, m_reusedStatementCount(0)
+, m_schemaCache(nullptr)
+, m_schemaCookieStatement(nullptr)
+, m_cacheSize(0)
 , m_transactionLevel(0)
 , m_transactionError(TransactionError::Allowed)
 , m_cacheTransactionError(TransactionError::Allowed)
+, m_transactionLevelBeforeRead(-1)
 , m_notification(this)
 , m_tableMonitorForbidden(false)
 , m_fullSQLTrace(false)
@@ -127,8 +135,14 @@ void AbstractHandle::close()
         if (m_cancelSignal != nullptr) {
             sqlite3_progress_handler(m_handle, 0, nullptr, nullptr);
         }
+        closeBlobs();
         finalizeStatements();
+        if (m_schemaCookieStatement != nullptr) {
+            sqlite3_finalize(m_schemaCookieStatement);
+            m_schemaCookieStatement = nullptr;
+        }
         m_transactionLevel = 0;
+        m_cacheSize = 0;
         m_notification.purge();
         APIExit(sqlite3_close_v2(m_handle));
         m_handle = nullptr;
@@ -215,20 +229,54 @@ bool AbstractHandle::isInTransaction()
     return sqlite3_get_autocommit(m_handle) == 0;
 }
 
+bool AbstractHandle::hasSteppingStatement()
+{
+    WCTAssert(isOpened());
+    sqlite3_stmt *stmt = nullptr;
+    while ((stmt = sqlite3_next_stmt(m_handle, stmt)) != nullptr) {
+        if (sqlite3_stmt_busy(stmt)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 #pragma mark - Statement
-DecorativeHandleStatement *AbstractHandle::getStatement(const UnsafeStringView &)
+AbstractHandle::PooledStatement::PooledStatement(AbstractHandle *handle,
+                                                 const UnsafeStringView &skipDecorator_,
+                                                 uint32_t generation_)
+: statement(handle), skipDecorator(skipDecorator_), generation(generation_)
+{
+}
+
+DecorativeHandleStatement *AbstractHandle::getStatement(const UnsafeStringView &skipDecorator)
 {
-    m_handleStatements.push_back(DecorativeHandleStatement(this));
-    m_handleStatements.back().enableAutoAddColumn();
-    return &m_handleStatements.back();
+    for (auto iter = m_freeStatements.begin(); iter != m_freeStatements.end(); ++iter) {
+        WCTAssert(iter->generation == m_statementGeneration);
+        if (iter->skipDecorator.equal(skipDecorator)) {
+            m_handleStatements.splice(m_handleStatements.end(), m_freeStatements, iter);
+            ++m_reusedStatementCount;
+            return &m_handleStatements.back().statement;
+        }
+    }
+    m_handleStatements.emplace_back(this, skipDecorator, m_statementGeneration);
+    m_handleStatements.back().statement.enableAutoAddColumn();
+    ++m_allocatedStatementCount;
+    return &m_handleStatements.back().statement;
 }
 
 void AbstractHandle::returnStatement(HandleStatement *handleStatement)
 {
     if (handleStatement != nullptr) {
         for (auto iter = m_handleStatements.begin(); iter != m_handleStatements.end(); ++iter) {
-            if (&(*iter) == handleStatement) {
-                m_handleStatements.erase(iter);
+            if (&iter->statement == handleStatement) {
+                // The prepared one is released to finalize it with its decorators.
+                if (iter->generation == m_statementGeneration && !iter->statement.isPrepared()
+                    && m_freeStatements.size() < HandleStatementFreeListCapacity) {
+                    m_freeStatements.splice(m_freeStatements.end(), m_handleStatements, iter);
+                } else {
+                    m_handleStatements.erase(iter);
+                }
                 return;
             }
         }
@@ -236,11 +284,25 @@ void AbstractHandle::returnStatement(HandleStatement *handleStatement)
     }
 }
 
+void AbstractHandle::purgeFreeStatements()
+{
+    m_freeStatements.clear();
+    ++m_statementGeneration;
+}
+
+void AbstractHandle::getAndResetStatementCounts(uint64_t &allocatedCount, uint64_t &reusedCount)
+{
+    allocatedCount = m_allocatedStatementCount;
+    reusedCount = m_reusedStatementCount;
+    m_allocatedStatementCount = 0;
+    m_reusedStatementCount = 0;
+}
+
 void AbstractHandle::resetAllStatements()
 {
     for (auto &handleStatement : m_handleStatements) {
-        if (!handleStatement.isPrepared()) continue;
-        handleStatement.reset();
+        if (!handleStatement.statement.isPrepared()) continue;
+        handleStatement.statement.reset();
     }
 }
 
@@ -251,8 +313,9 @@ void AbstractHandle::finalizeStatements()
         returnStatement(iter.second);
     }
     m_preparedStatements.clear();
+    m_encodedStatements.clear();
     for (auto &handleStatement : m_handleStatements) {
-        handleStatement.finalize();
+        handleStatement.statement.finalize();
     }
 }
 
@@ -279,6 +342,38 @@ HandleStatement *AbstractHandle::getOrCreatePreparedStatement(const UnsafeString
     return preparedStatement;
 }
 
+HandleStatement *
+AbstractHandle::getOrCreatePreparedEncodedStatement(const UnsafeData &encodedStatement)
+{
+    auto iter = m_encodedStatements.find(encodedStatement);
+    if (iter != m_encodedStatements.end() && iter->second->isPrepared()) {
+        return iter->second;
+    }
+    Optional<Statement> statement = StatementEncoding::decode(encodedStatement);
+    if (!statement.hasValue()) {
+        m_error.setCode(Error::Code::Error, "Invalid encoded statement");
+        m_error.infos.erase(ErrorStringKeySQL);
+        m_error.level = Error::Level::Error;
+        Notifier::shared().notify(m_error);
+        return nullptr;
+    }
+    HandleStatement *preparedStatement = getOrCreatePreparedStatement(statement.value());
+    if (preparedStatement == nullptr) {
+        return nullptr;
+    }
+    if (iter != m_encodedStatements.end()) {
+        // The statement of stale entry is finalized.
+        iter->second = preparedStatement;
+    } else {
+        if (m_encodedStatements.size() >= HandleEncodedStatementCacheCapacity) {
+            // The entries only refer to the prepared statements, so that it's cheap to rebuild them.
+            m_encodedStatements.clear();
+        }
+        m_encodedStatements.emplace(encodedStatement, preparedStatement);
+    }
+    return preparedStatement;
+}
+
 HandleStatement *AbstractHandle::getOrCreateStatement(const UnsafeStringView &sql)
 {
     if (sql.length() == 0) {
@@ -293,6 +388,9 @@ HandleStatement *AbstractHandle::getOrCreateStatement(const UnsafeStringView &sq
     if (iter == m_preparedStatements.end()) {
         handleStatement = getStatement();
         m_preparedStatements[sql] = handleStatement;
+        if (m_statementWarmup != nullptr) {
+            m_statementWarmup->recordPrepared(sql);
+        }
     } else {
         handleStatement = iter->second;
     }
@@ -300,6 +398,56 @@ HandleStatement *AbstractHandle::getOrCreateStatement(const UnsafeStringView &sq
     return handleStatement;
 }
 
+void AbstractHandle::setStatementWarmup(StatementWarmup *statementWarmup)
+{
+    m_statementWarmup = statementWarmup;
+}
+
+void AbstractHandle::warmUpStatements(const std::vector<StringView> &sqls)
+{
+    // The statements may be out of date, such as the table is dropped.
+    markErrorAsIgnorable(Error::Code::Error);
+    for (const auto &sql : sqls) {
+        if (m_preparedStatements.find(sql) != m_preparedStatements.end()) {
+            continue;
+        }
+        DecorativeHandleStatement *handleStatement = getStatement();
+        if (handleStatement->prepareSQL(sql)) {
+            m_preparedStatements[sql] = handleStatement;
+        } else {
+            returnStatement(handleStatement);
+        }
+    }
+    markErrorAsUnignorable();
+}
+
+#pragma mark - Blob
+HandleBlob *AbstractHandle::getBlob()
+{
+    m_handleBlobs.push_back(HandleBlob(this));
+    return &m_handleBlobs.back();
+}
+
+void AbstractHandle::returnBlob(HandleBlob *handleBlob)
+{
+    if (handleBlob != nullptr) {
+        for (auto iter = m_handleBlobs.begin(); iter != m_handleBlobs.end(); ++iter) {
+            if (&(*iter) == handleBlob) {
+                m_handleBlobs.erase(iter);
+                return;
+            }
+        }
+        WCTAssert(false);
+    }
+}
+
+void AbstractHandle::closeBlobs()
+{
+    for (auto &handleBlob : m_handleBlobs) {
+        handleBlob.close();
+    }
+}
+
 #pragma mark - Meta
 Optional<bool> AbstractHandle::ft3TokenizerExists(const UnsafeStringView &tokenizer)
 {
@@ -324,6 +472,14 @@ Optional<bool> AbstractHandle::tableExists(const UnsafeStringView &table)
 Optional<bool>
 AbstractHandle::tableExists(const Schema &schema, const UnsafeStringView &table)
 {
+    Optional<int> cookie = getSchemaCookie(schema);
+    if (cookie.succeed()) {
+        Optional<bool> cached = m_schemaCache->tableExists(cookie.value(), table);
+        if (cached.succeed()) {
+            return cached;
+        }
+    }
+
     StatementSelect statement
     = StatementSelect().select(1).from(TableOrSubquery(table).schema(schema)).limit(1);
 
@@ -338,6 +494,11 @@ AbstractHandle::tableExists(const Schema &schema, const UnsafeStringView &table)
         exists = false;
     }
     markErrorAsUnignorable();
+
+    bool committed;
+    if (exists.succeed() && cookie.succeed() && isSchemaUnchanged(cookie.value(), committed)) {
+        m_schemaCache->setTableExists(cookie.value(), committed, table, exists.value());
+    }
     return exists;
 }
 
@@ -367,6 +528,19 @@ bool AbstractHandle::addColumn(const Schema &schema,
 Optional<StringViewSet>
 AbstractHandle::getColumns(const Schema &schema, const UnsafeStringView &table)
 {
+    if (isSchemaCacheAvailable(schema)) {
+        // Column names are exactly the names in table meta, which is cached.
+        Optional<StringViewSet> columns;
+        auto metas = getTableMeta(schema, table);
+        if (metas.succeed()) {
+            StringViewSet names;
+            for (const auto &meta : metas.value()) {
+                names.emplace(meta.name);
+            }
+            columns = std::move(names);
+        }
+        return columns;
+    }
     WCDB::StatementPragma statement
     = StatementPragma().pragma(Pragma::tableInfo()).schema(schema).with(table);
     return getValues(statement, 1);
@@ -375,6 +549,14 @@ AbstractHandle::getColumns(const Schema &schema, const UnsafeStringView &table)
 Optional<std::vector<ColumnMeta>>
 AbstractHandle::getTableMeta(const Schema &schema, const UnsafeStringView &table)
 {
+    Optional<int> cookie = getSchemaCookie(schema);
+    if (cookie.succeed()) {
+        auto cached = m_schemaCache->getTableMeta(cookie.value(), table);
+        if (cached.succeed()) {
+            return cached;
+        }
+    }
+
     Optional<std::vector<ColumnMeta>> metas;
     HandleStatement handleStatement(this);
     if (handleStatement.prepare(
@@ -394,6 +576,11 @@ AbstractHandle::getTableMeta(const Schema &schema, const UnsafeStringView &table
             metas = rows;
         }
     }
+
+    bool committed;
+    if (metas.succeed() && cookie.succeed() && isSchemaUnchanged(cookie.value(), committed)) {
+        m_schemaCache->setTableMeta(cookie.value(), committed, table, metas.value());
+    }
     return metas;
 }
 
@@ -418,6 +605,14 @@ Optional<StringViewSet> AbstractHandle::getValues(const Statement &statement, in
 Optional<TableAttribute>
 AbstractHandle::getTableAttribute(const Schema &schema, const UnsafeStringView &tableName)
 {
+    Optional<int> cookie = getSchemaCookie(schema);
+    if (cookie.succeed()) {
+        auto cached = m_schemaCache->getTableAttribute(cookie.value(), tableName);
+        if (cached.succeed()) {
+            return cached;
+        }
+    }
+
     int isAutoincrement = 0;
     int isWithoutRowid = 0;
     int isVirtual = 0;
@@ -440,6 +635,11 @@ AbstractHandle::getTableAttribute(const Schema &schema, const UnsafeStringView &
     if (integerPrimaryKey != nullptr) {
         free((void *) integerPrimaryKey);
     }
+
+    bool committed;
+    if (cookie.succeed() && isSchemaUnchanged(cookie.value(), committed)) {
+        m_schemaCache->setTableAttribute(cookie.value(), committed, tableName, config);
+    }
     return config;
 }
 
@@ -456,6 +656,93 @@ bool AbstractHandle::getSchemaInfo(int &memoryUsed, int &tableCount, int &indexC
            && APIExit(sqlite3_schema_info(m_handle, &tableCount, &indexCount, &triggerCount));
 }
 
+#pragma mark - Schema Cache
+void AbstractHandle::setSchemaCache(SchemaCache *schemaCache)
+{
+    m_schemaCache = schemaCache;
+}
+
+bool AbstractHandle::isSchemaCookieStatement(const sqlite3_stmt *stmt) const
+{
+    return stmt != nullptr && stmt == m_schemaCookieStatement;
+}
+
+bool AbstractHandle::isSchemaCacheAvailable(const Schema &schema) const
+{
+    // Unqualified table may refer to the temp schema, which is private to the handle.
+    return m_schemaCache != nullptr && !schema.syntax().empty() && schema.syntax().isMain();
+}
+
+Optional<int> AbstractHandle::getSchemaCookie(const Schema &schema)
+{
+    if (!isSchemaCacheAvailable(schema) || !isOpened()) {
+        return NullOpt;
+    }
+    if (m_schemaCookieStatement == nullptr) {
+        StringView sql
+        = StatementPragma().pragma(Pragma::schemaVersion()).schema(Schema::main()).getDescription();
+        // Failure is not notified since it falls back to query the catalog directly.
+        if (sqlite3_prepare_v2(m_handle, sql.data(), -1, &m_schemaCookieStatement, nullptr)
+            != SQLITE_OK) {
+            sqlite3_finalize(m_schemaCookieStatement);
+            m_schemaCookieStatement = nullptr;
+            return NullOpt;
+        }
+    }
+    Optional<int> cookie;
+    if (sqlite3_step(m_schemaCookieStatement) == SQLITE_ROW) {
+        cookie = sqlite3_column_int(m_schemaCookieStatement, 0);
+    }
+    sqlite3_reset(m_schemaCookieStatement);
+    return cookie;
+}
+
+bool AbstractHandle::isSchemaUnchanged(int cookie, bool &committed)
+{
+    committed = !isInTransaction();
+    if (!committed) {
+        // The cookie and the catalog are read in the same snapshot of this transaction.
+        return true;
+    }
+    // Other handles may commit DDL between the two reads.
+    Optional<int> newCookie = getSchemaCookie(Schema::main());
+    return newCookie.succeed() && newCookie.value() == cookie;
+}
+
+#pragma mark - Page Cache
+bool AbstractHandle::setCacheSize(int cacheSize)
+{
+    WCTAssert(isOpened());
+    WCTAssert(cacheSize >= 0);
+    if (cacheSize == m_cacheSize) {
+        return true;
+    }
+    // Negative value of cache_size is in KiB.
+    HandleStatement handleStatement(this);
+    Statement statement = StatementPragma().pragma(Pragma::cacheSize()).to(
+    -(cacheSize > 0 ? cacheSize : HandleDefaultCacheSize));
+    bool succeed = handleStatement.prepare(statement) && handleStatement.step();
+    handleStatement.finalize();
+    if (succeed) {
+        m_cacheSize = cacheSize;
+    }
+    return succeed;
+}
+
+int AbstractHandle::getCacheSize() const
+{
+    return m_cacheSize;
+}
+
+bool AbstractHandle::getAndResetCacheHitsAndMisses(int &hits, int &misses)
+{
+    WCTAssert(isOpened());
+    int highWater;
+    return APIExit(sqlite3_db_status(m_handle, SQLITE_DBSTATUS_CACHE_HIT, &hits, &highWater, true))
+           && APIExit(sqlite3_db_status(
+           m_handle, SQLITE_DBSTATUS_CACHE_MISS, &misses, &highWater, true));
+}
+
 #pragma mark - Transaction
 void AbstractHandle::markErrorNotAllowedWithinTransaction()
 {
@@ -645,6 +932,163 @@ bool AbstractHandle::setCheckPointLock(bool enable)
     return APIExit(sqlite3_lock_checkpoint(m_handle, enable));
 }
 
+#pragma mark - Snapshot
+bool AbstractHandle::isSnapshotSupported()
+{
+#if defined(SQLITE_ENABLE_SNAPSHOT) && SQLITE_ENABLE_SNAPSHOT
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<WALSnapshot> AbstractHandle::captureSnapshot()
+{
+    WCTAssert(isOpened());
+#if defined(SQLITE_ENABLE_SNAPSHOT) && SQLITE_ENABLE_SNAPSHOT
+    bool startRead = !isInTransaction();
+    if (startRead && !beginDeferredRead()) {
+        return nullptr;
+    }
+    std::shared_ptr<WALSnapshot> snapshot;
+    sqlite3_snapshot *rawSnapshot = nullptr;
+    if (APIExit(sqlite3_snapshot_get(m_handle, Syntax::mainSchema.data(), &rawSnapshot))) {
+        snapshot = std::make_shared<WALSnapshot>(rawSnapshot);
+    }
+    if (startRead) {
+        endSnapshotRead();
+    }
+    return snapshot;
+#else
+    notifyError(Error::Code::Misuse,
+                "sqlite3_snapshot_get",
+                "You need to build WCDB and sqlcipher with SQLITE_ENABLE_SNAPSHOT macro");
+    return nullptr;
+#endif
+}
+
+bool AbstractHandle::beginSnapshotRead(const WALSnapshot &snapshot)
+{
+    WCTAssert(isOpened());
+    WCTRemedialAssert(
+    !isInTransaction(), "Snapshot can't be opened within transaction.", return false;);
+#if defined(SQLITE_ENABLE_SNAPSHOT) && SQLITE_ENABLE_SNAPSHOT
+    if (!beginRead()) {
+        return false;
+    }
+    if (!APIExit(sqlite3_snapshot_open(m_handle, Syntax::mainSchema.data(), snapshot.get()))) {
+        endSnapshotRead();
+        return false;
+    }
+    return true;
+#else
+    WCDB_UNUSED(snapshot);
+    notifyError(Error::Code::Misuse,
+                "sqlite3_snapshot_open",
+                "You need to build WCDB and sqlcipher with SQLITE_ENABLE_SNAPSHOT macro");
+    return false;
+#endif
+}
+
+void AbstractHandle::endSnapshotRead()
+{
+    if (m_transactionLevelBeforeRead < 0) {
+        return;
+    }
+    resetAllStatements();
+    if (isInTransaction()) {
+        static const StatementCommit *s_commit = new StatementCommit(StatementCommit().commit());
+        executeStatement(*s_commit);
+    }
+    m_transactionLevel = m_transactionLevelBeforeRead;
+    m_transactionLevelBeforeRead = -1;
+}
+
+bool AbstractHandle::beginRead()
+{
+    WCTAssert(m_transactionLevelBeforeRead < 0);
+    static const StatementBegin *s_beginDeferred
+    = new StatementBegin(StatementBegin().beginDeferred());
+    if (!executeStatement(*s_beginDeferred)) {
+        return false;
+    }
+    m_transactionLevelBeforeRead = m_transactionLevel;
+    return true;
+}
+
+bool AbstractHandle::beginDeferredRead()
+{
+    // A read transaction is not actually started until the first read.
+    static const StatementSelect *s_read = new StatementSelect(
+    StatementSelect().select(1).from(Syntax::masterTable).limit(1));
+    if (!beginRead()) {
+        return false;
+    }
+    if (!executeStatement(*s_read)) {
+        endSnapshotRead();
+        return false;
+    }
+    return true;
+}
+
+#pragma mark - Online Backup
+bool AbstractHandle::backupTo(AbstractHandle &destination,
+                              int pagesPerStep,
+                              const BackupStepCallback &onStepped)
+{
+    WCTAssert(isOpened());
+    WCTAssert(destination.isOpened());
+    WCTAssert(pagesPerStep > 0);
+    WCTRemedialAssert(
+    !isInTransaction(), "Online backup can't be run in transaction.", return false;);
+    // Without a read transaction held by source handle, sqlite will restart the backup whenever the source is modified by other handles.
+    if (!beginDeferredRead()) {
+        return false;
+    }
+    sqlite3_backup *backup = sqlite3_backup_init(
+    destination.m_handle, Syntax::mainSchema.data(), m_handle, Syntax::mainSchema.data());
+    if (backup == nullptr) {
+        notifyError(sqlite3_errcode(destination.m_handle),
+                    "sqlite3_backup_init",
+                    sqlite3_errmsg(destination.m_handle));
+        endSnapshotRead();
+        return false;
+    }
+    bool interrupted = false;
+    int busyTimes = 0;
+    int sleepMS = BackupBusyRetryMinSleepMS;
+    int rc;
+    do {
+        rc = sqlite3_backup_step(backup, pagesPerStep);
+        if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+            if (++busyTimes > BackupBusyRetryMaxTimes) {
+                break;
+            }
+            // Back off so that the handle holding the lock can make progress.
+            sqlite3_sleep(sleepMS);
+            sleepMS = std::min(sleepMS * 2, BackupBusyRetryMaxSleepMS);
+        } else if (rc != SQLITE_OK && rc != SQLITE_DONE) {
+            break;
+        } else {
+            busyTimes = 0;
+            sleepMS = BackupBusyRetryMinSleepMS;
+        }
+        if (onStepped != nullptr
+            && !onStepped(sqlite3_backup_remaining(backup), sqlite3_backup_pagecount(backup))) {
+            interrupted = rc != SQLITE_DONE;
+        }
+    } while (!interrupted && rc != SQLITE_DONE);
+    int finishRC = sqlite3_backup_finish(backup);
+    endSnapshotRead();
+    if (finishRC != SQLITE_OK || busyTimes > BackupBusyRetryMaxTimes) {
+        notifyError(finishRC != SQLITE_OK ? finishRC : rc,
+                    "sqlite3_backup_step",
+                    sqlite3_errmsg(destination.m_handle));
+        return false;
+    }
+    return !interrupted;
+}
+
 #pragma mark - Notification
 void AbstractHandle::setNotificationWhenSQLTraced(const UnsafeStringView &name,
                                                   const SQLNotification &onTraced)
@@ -27,10 +27,15 @@
 #include "ColumnMeta.hpp"
 #include "DecorativeHandleStatement.hpp"
 #include "ErrorProne.hpp"
+#include "HandleBlob.hpp"
 #include "HandleNotification.hpp"
+#include "SchemaCache.hpp"
+#include "StatementWarmup.hpp"
+#include "StatementEncoding.hpp"
 #include "StringView.hpp"
 #include "TableAttribute.hpp"
 #include "Tag.hpp"
+#include "WALSnapshot.hpp"
 #include "WCDBOptional.hpp"
 #include "WINQ.h"
 #include <set>
@@ -40,6 +45,7 @@
 namespace WCDB {
 
 class ScalarFunctionConfig;
+class AggregateFunctionConfig;
 
 class AbstractHandle : public ErrorProne {
 #pragma mark - Initialize
@@ -52,6 +58,7 @@ public:
 
 private:
     friend class ScalarFunctionConfig;
+    friend class AggregateFunctionConfig;
     friend class HandleRelated;
     sqlite3 *getRawHandle();
     sqlite3 *m_handle;
@@ -86,6 +93,8 @@ public:
     int getTotalChange();
     bool isReadonly();
     bool isInTransaction();
+    // Any statement that is stepped but not reset keeps the read snapshot of the handle.
+    bool hasSteppingStatement();
 
     void setTag(Tag tag);
     Tag getTag();
@@ -106,11 +115,48 @@ public:
     virtual void finalizeStatements();
     HandleStatement *getOrCreatePreparedStatement(const Statement &statement);
     HandleStatement *getOrCreatePreparedStatement(const UnsafeStringView &sql);
+    // The statement is encoded by StatementEncoding and it's decoded only if no statement is cached for the same bytes.
+    HandleStatement *getOrCreatePreparedEncodedStatement(const UnsafeData &encodedStatement);
+
+    // Statements newly created in the prepared statement cache are recorded by the warmup if it's set.
+    void setStatementWarmup(StatementWarmup *statementWarmup);
+    // Prepare the statements into the prepared statement cache ahead. Failures are ignored.
+    void warmUpStatements(const std::vector<StringView> &sqls);
+
+    // The statements in free list are decorated by the current decorators of handle, so they must be purged once the decorators are changed.
+    void purgeFreeStatements();
+    // The counters are reset once they are read.
+    void getAndResetStatementCounts(uint64_t &allocatedCount, uint64_t &reusedCount);
 
 private:
     HandleStatement *getOrCreateStatement(const UnsafeStringView &sql);
-    std::list<DecorativeHandleStatement> m_handleStatements;
+    StatementWarmup *m_statementWarmup;
+
+    struct PooledStatement {
+        PooledStatement(AbstractHandle *handle, const UnsafeStringView &skipDecorator, uint32_t generation);
+        DecorativeHandleStatement statement;
+        // The decorators are kept in free list, so it can only be reused for the same skipped decorator.
+        StringView skipDecorator;
+        uint32_t generation;
+    };
+    typedef struct PooledStatement PooledStatement;
+    std::list<PooledStatement> m_handleStatements;
+    // Returned statements are kept to be reused without allocating the node and its decorators again.
+    std::list<PooledStatement> m_freeStatements;
+    uint32_t m_statementGeneration;
+    uint64_t m_allocatedStatementCount;
+    uint64_t m_reusedStatementCount;
     StringViewMap<DecorativeHandleStatement *> m_preparedStatements;
+    std::map<Data, HandleStatement *, StatementEncoding::Comparator> m_encodedStatements;
+
+#pragma mark - Blob
+public:
+    HandleBlob *getBlob();
+    void returnBlob(HandleBlob *handleBlob);
+    void closeBlobs();
+
+private:
+    std::list<HandleBlob> m_handleBlobs;
 
 #pragma mark - Meta
 public:
@@ -134,6 +180,33 @@ public:
 
     bool getSchemaInfo(int &memoryUsed, int &tableCount, int &indexCount, int &triggerCount);
 
+#pragma mark - Schema Cache
+public:
+    // The catalog of main schema is looked up in the schema cache first if it's set.
+    void setSchemaCache(SchemaCache *schemaCache);
+    // The statement reading schema cookie is internal, so it's not traced.
+    bool isSchemaCookieStatement(const sqlite3_stmt *stmt) const;
+
+private:
+    bool isSchemaCacheAvailable(const Schema &schema) const;
+    Optional<int> getSchemaCookie(const Schema &schema);
+    // Check whether the result queried after reading the cookie can be put into the schema cache.
+    bool isSchemaUnchanged(int cookie, bool &committed);
+
+    SchemaCache *m_schemaCache;
+    sqlite3_stmt *m_schemaCookieStatement;
+
+#pragma mark - Page Cache
+public:
+    // In KiB. 0 means the default cache size of sqlite.
+    bool setCacheSize(int cacheSize);
+    int getCacheSize() const;
+    // The counters are reset once they are read.
+    bool getAndResetCacheHitsAndMisses(int &hits, int &misses);
+
+private:
+    int m_cacheSize;
+
 #pragma mark - Transaction
 public:
     virtual bool beginTransaction();
@@ -174,6 +247,32 @@ public:
     void setWALFilePersist(int persist);
     bool setCheckPointLock(bool enable);
 
+#pragma mark - Snapshot
+public:
+    // Whether WCDB is built with SQLITE_ENABLE_SNAPSHOT, which needs sqlcipher to be built with it too.
+    static bool isSnapshotSupported();
+    // Capture the snapshot of main schema. A read transaction will be started temporarily if it's not in transaction.
+    std::shared_ptr<WALSnapshot> captureSnapshot();
+    // Start a read transaction on the snapshot, which should be finished by `endSnapshotRead`.
+    // Both of them need WCDB and sqlcipher to be built with SQLITE_ENABLE_SNAPSHOT.
+    bool beginSnapshotRead(const WALSnapshot &snapshot);
+    // Finish the read transaction started by this handle only, and restore the transaction level before it.
+    void endSnapshotRead();
+
+private:
+    // Start a deferred transaction and read from main schema so that the read snapshot is actually held.
+    bool beginDeferredRead();
+    bool beginRead();
+    // -1 if no read transaction is started by `beginSnapshotRead` or `beginDeferredRead`.
+    int m_transactionLevelBeforeRead;
+
+#pragma mark - Online Backup
+public:
+    typedef std::function<bool /* continue flag */ (int remainingPages, int totalPages)> BackupStepCallback;
+    // Copy all pages of main schema to the main schema of destination, `pagesPerStep` pages per step.
+    // All steps read from the same snapshot, so that writes from other handles neither block nor restart the backup.
+    bool backupTo(AbstractHandle &destination, int pagesPerStep, const BackupStepCallback &onStepped);
+
 #pragma mark - Notification
 public:
     typedef HandleNotification::PerformanceInfo PerformanceInfo;
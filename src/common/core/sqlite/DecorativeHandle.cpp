@@ -71,6 +71,7 @@ void DecorativeHandle::onDecorationChange()
 {
     m_mainStatement->finalize();
     returnStatement(m_mainStatement);
+    purgeFreeStatements();
     m_mainStatement = getStatement();
     for (auto iter : m_operators) {
         iter.second->onDecorationChange();
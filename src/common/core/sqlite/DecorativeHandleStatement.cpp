@@ -100,6 +100,11 @@ void HandleStatementDecorator::bindPointer(void *ptr,
     WCDBCallDecoratedFunction(HandleStatement, bindPointer, ptr, index, type, destructor);
 }
 
+OptionalMultiRows HandleStatementDecorator::getAllRows()
+{
+    return WCDBCallDecoratedFunction(HandleStatement, getAllRows);
+}
+
 #pragma mark - DecorativeHandleStatement - Basic
 DecorativeHandleStatement::DecorativeHandleStatement(DecorativeHandleStatement &&other)
 : HandleStatement(std::move(other)), SuperDecorativeClass(std::move(other))
@@ -129,6 +134,7 @@ void DecorativeHandleStatement::initDecorativeFunctions()
     WCDBRegisterDecorativeFunction(HandleStatement, bindBLOB);
     WCDBRegisterDecorativeFunction(HandleStatement, bindNull);
     WCDBRegisterDecorativeFunction(HandleStatement, bindPointer);
+    WCDBRegisterDecorativeFunction(HandleStatement, getAllRows);
 }
 
 #pragma mark - DecorativeHandleStatement - Override
@@ -199,4 +205,9 @@ void DecorativeHandleStatement::bindPointer(void *ptr,
     WCDBCallDecorativeFunction(HandleStatement, bindPointer, ptr, index, type, destructor);
 }
 
+OptionalMultiRows DecorativeHandleStatement::getAllRows()
+{
+    return WCDBCallDecorativeFunction(HandleStatement, getAllRows);
+}
+
 } //namespace WCDB
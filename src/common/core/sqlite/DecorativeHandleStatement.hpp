@@ -42,6 +42,7 @@ enum class HandleStatementFuncType : unsigned char {
     bindBLOB,
     bindNull,
     bindPointer,
+    getAllRows,
     Count,
 };
 
@@ -94,6 +95,9 @@ public:
     virtual void
     bindPointer(void *ptr, int index, const Text &type, void (*destructor)(void *));
     WCDBAssertFunctionTypeConsistent(HandleStatementDecorator, HandleStatement, bindPointer);
+
+    virtual OptionalMultiRows getAllRows();
+    WCDBAssertFunctionTypeConsistent(HandleStatementDecorator, HandleStatement, getAllRows);
 };
 
 class DecorativeHandleStatement final
@@ -132,6 +136,8 @@ public:
     void bindBLOB(const BLOB &value, int index = 1) override final;
     void bindNull(int index) override final;
     void bindPointer(void *ptr, int index, const Text &type, void (*destructor)(void *)) override final;
+
+    OptionalMultiRows getAllRows() override final;
 };
 
 } //namespace WCDB
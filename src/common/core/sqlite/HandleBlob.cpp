@@ -0,0 +1,248 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "HandleBlob.hpp"
+#include "AbstractHandle.hpp"
+#include "Assertion.hpp"
+#include "CompressionCenter.hpp"
+#include "CompressionConst.hpp"
+#include "CoreConst.h"
+#include "HandleStatement.hpp"
+#include "SQLite.h"
+#include "WINQ.h"
+
+namespace WCDB {
+
+HandleBlob::HandleBlob(HandleBlob &&other)
+: HandleRelated(other.getHandle())
+, m_blob(other.m_blob)
+, m_schema(std::move(other.m_schema))
+, m_table(std::move(other.m_table))
+, m_column(std::move(other.m_column))
+, m_rowid(other.m_rowid)
+, m_typeColumnExists(other.m_typeColumnExists)
+, m_chunkBuffer(std::move(other.m_chunkBuffer))
+{
+    other.m_blob = nullptr;
+}
+
+HandleBlob::HandleBlob(AbstractHandle *handle)
+: HandleRelated(handle), m_blob(nullptr), m_rowid(0)
+{
+}
+
+HandleBlob::~HandleBlob()
+{
+    close();
+}
+
+bool HandleBlob::open(const Schema &schema,
+                      const UnsafeStringView &table,
+                      const UnsafeStringView &column,
+                      int64_t rowid,
+                      bool writable)
+{
+    close();
+    m_schema = schema.syntax().isMain() ? Schema::main() : schema;
+    m_table = table;
+    m_column = column;
+    m_rowid = rowid;
+    m_typeColumnExists = NullOpt;
+    if (!APIExit(sqlite3_blob_open(getRawHandle(),
+                                   m_schema.syntax().name.data(),
+                                   m_table.data(),
+                                   m_column.data(),
+                                   rowid,
+                                   writable ? 1 : 0,
+                                   &m_blob))) {
+        // sqlite3_blob_open may return a handle even if it fails.
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool HandleBlob::reopen(int64_t rowid)
+{
+    WCTRemedialAssert(isOpened(), "Blob is not opened.", return false;);
+    if (!APIExit(sqlite3_blob_reopen(m_blob, rowid))) {
+        // The blob is aborted after a failed reopen.
+        close();
+        return false;
+    }
+    m_rowid = rowid;
+    return true;
+}
+
+bool HandleBlob::isOpened() const
+{
+    return m_blob != nullptr;
+}
+
+void HandleBlob::close()
+{
+    if (m_blob != nullptr) {
+        // no need to call APIExit since the error is reported by the failed read/write.
+        sqlite3_blob_close(m_blob);
+        m_blob = nullptr;
+    }
+}
+
+int HandleBlob::getSize()
+{
+    WCTRemedialAssert(isOpened(), "Blob is not opened.", return 0;);
+    return sqlite3_blob_bytes(m_blob);
+}
+
+bool HandleBlob::read(unsigned char *buffer, int length, int offset)
+{
+    WCTRemedialAssert(isOpened(), "Blob is not opened.", return false;);
+    return APIExit(sqlite3_blob_read(m_blob, buffer, length, offset));
+}
+
+bool HandleBlob::write(const UnsafeData &data, int offset)
+{
+    WCTRemedialAssert(isOpened(), "Blob is not opened.", return false;);
+    Optional<bool> compressed = isCompressedColumn();
+    if (!compressed.succeed()) {
+        return false;
+    }
+    if (compressed.value()) {
+        // The compressed content can't be modified in place.
+        StringView msg = StringView::formatted(
+        "Does not support to write blob of compressed column: %s.%s",
+        m_table.data(),
+        m_column.data());
+        getHandle()->notifyError(Error::Code::Misuse, nullptr, msg);
+        return false;
+    }
+    return APIExit(sqlite3_blob_write(m_blob, data.buffer(), (int) data.size(), offset));
+}
+
+#pragma mark - Stream
+bool HandleBlob::readChunk(int offset, UnsafeData &chunk)
+{
+    int size = getSize();
+    WCTAssert(offset <= size);
+    int length = std::min(size - offset, BlobStreamChunkSize);
+    if (length <= 0) {
+        chunk = UnsafeData();
+        return true;
+    }
+    if (m_chunkBuffer.size() < BlobStreamChunkSize && !m_chunkBuffer.resize(BlobStreamChunkSize)) {
+        return false;
+    }
+    if (!read(m_chunkBuffer.buffer(), length, offset)) {
+        return false;
+    }
+    chunk = m_chunkBuffer.subdata(length);
+    return true;
+}
+
+bool HandleBlob::streamRead(const ChunkCallback &onChunk)
+{
+    WCTRemedialAssert(isOpened(), "Blob is not opened.", return false;);
+    int offset = 0;
+    UnsafeData chunk;
+    while (readChunk(offset, chunk)) {
+        if (chunk.size() == 0 || !onChunk(chunk)) {
+            return true;
+        }
+        offset += chunk.size();
+    }
+    return false;
+}
+
+bool HandleBlob::streamReadDecompressed(const ChunkCallback &onChunk)
+{
+    WCTRemedialAssert(isOpened(), "Blob is not opened.", return false;);
+    Optional<int> mergeType = getCompressionMergeType();
+    if (!mergeType.succeed()) {
+        return false;
+    }
+    CompressedType compressedType = WCDBGetCompressedType(mergeType.value());
+    if (compressedType == CompressedType::None) {
+        return streamRead(onChunk);
+    }
+    int offset = 0;
+    return CompressionCenter::shared().decompressStream(
+    [&]() -> Optional<UnsafeData> {
+        UnsafeData chunk;
+        if (!readChunk(offset, chunk)) {
+            return NullOpt;
+        }
+        offset += chunk.size();
+        return chunk;
+    },
+    compressedType == CompressedType::ZSTDDict,
+    onChunk,
+    getHandle());
+}
+
+StringView HandleBlob::getTypeColumn() const
+{
+    return StringView::formatted(
+    "%s%s", CompressionColumnTypePrefix.data(), m_column.data());
+}
+
+Optional<bool> HandleBlob::isCompressedColumn()
+{
+    if (!m_typeColumnExists.hasValue()) {
+        auto columns = getHandle()->getColumns(m_schema, m_table);
+        if (!columns.succeed()) {
+            return NullOpt;
+        }
+        m_typeColumnExists = columns->find(getTypeColumn()) != columns->end();
+    }
+    return m_typeColumnExists.value();
+}
+
+Optional<int> HandleBlob::getCompressionMergeType()
+{
+    Optional<bool> compressed = isCompressedColumn();
+    if (!compressed.succeed()) {
+        return NullOpt;
+    }
+    if (!compressed.value()) {
+        return (int) CompressedType::None;
+    }
+    // Read the type column directly since the compressing decorator is bypassed by sqlite3_blob.
+    HandleStatement *handleStatement = getHandle()->getStatement(DecoratorAllType);
+    Optional<int> result;
+    if (handleStatement->prepare(StatementSelect()
+                                 .select(Column(getTypeColumn()))
+                                 .from(TableOrSubquery(m_table).schema(m_schema))
+                                 .where(Column::rowid() == m_rowid))
+        && handleStatement->step()) {
+        result = handleStatement->done() || handleStatement->getType(0) == ColumnType::Null ?
+                 (int) CompressedType::None :
+                 (int) handleStatement->getInteger(0);
+    }
+    handleStatement->finalize();
+    getHandle()->returnStatement(handleStatement);
+    return result;
+}
+
+} //namespace WCDB
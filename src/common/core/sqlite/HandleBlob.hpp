@@ -0,0 +1,92 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Data.hpp"
+#include "HandleRelated.hpp"
+#include "Schema.hpp"
+#include "WCDBOptional.hpp"
+#include <functional>
+
+extern "C" {
+typedef struct sqlite3_blob sqlite3_blob;
+}
+
+namespace WCDB {
+
+/*
+ Incremental I/O of a single BLOB/TEXT value, which is the wrapper of `sqlite3_blob_*`.
+ The content is read and written in place, so a large value never needs to be loaded into memory at once.
+ */
+class HandleBlob final : public HandleRelated {
+public:
+    HandleBlob() = delete;
+    HandleBlob(const HandleBlob &) = delete;
+    HandleBlob &operator=(const HandleBlob &) = delete;
+
+    HandleBlob(HandleBlob &&other);
+    HandleBlob(AbstractHandle *handle);
+    ~HandleBlob() override;
+
+    bool open(const Schema &schema,
+              const UnsafeStringView &table,
+              const UnsafeStringView &column,
+              int64_t rowid,
+              bool writable);
+    // Move to another row of the same table and column, which is much cheaper than close and open.
+    bool reopen(int64_t rowid);
+    bool isOpened() const;
+    void close();
+
+    int getSize();
+    bool read(unsigned char *buffer, int length, int offset);
+    // Write can't change the size of blob, and the column compressed by WCDB can't be written.
+    bool write(const UnsafeData &data, int offset);
+
+#pragma mark - Stream
+public:
+    // The chunk is only valid inside the callback. Return false to stop streaming.
+    typedef std::function<bool(const UnsafeData &chunk)> ChunkCallback;
+    bool streamRead(const ChunkCallback &onChunk);
+    // Same as `streamRead`, except that the content compressed by WCDB compression will be decompressed frame by frame.
+    bool streamReadDecompressed(const ChunkCallback &onChunk);
+
+private:
+    bool readChunk(int offset, UnsafeData &chunk);
+    StringView getTypeColumn() const;
+    Optional<bool> isCompressedColumn();
+    Optional<int> getCompressionMergeType();
+
+    sqlite3_blob *m_blob;
+    Schema m_schema;
+    StringView m_table;
+    StringView m_column;
+    int64_t m_rowid;
+    Optional<bool> m_typeColumnExists;
+    Data m_chunkBuffer;
+};
+
+} //namespace WCDB
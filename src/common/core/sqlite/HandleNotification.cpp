@@ -70,6 +70,9 @@ int HandleNotification::traced(unsigned int T, void *C, void *P, void *X)
 void HandleNotification::postTraceNotification(unsigned int flag, void *P, void *X)
 {
     sqlite3_stmt *stmt = (sqlite3_stmt *) P;
+    if (getHandle()->isSchemaCookieStatement(stmt)) {
+        return;
+    }
     switch (flag) {
     case SQLITE_TRACE_STMT: {
         const char *sql = static_cast<const char *>(X);
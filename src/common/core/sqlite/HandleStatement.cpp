@@ -51,6 +51,7 @@ HandleStatement::HandleStatement(HandleStatement &&other)
 , m_fullTrace(other.m_fullTrace)
 , m_needReport(other.m_needReport)
 , m_stepCount(other.m_stepCount)
+, m_rowGeneration(std::move(other.m_rowGeneration))
 {
     other.m_done = false;
     other.m_stmt = nullptr;
@@ -396,6 +397,7 @@ void HandleStatement::reset()
 {
     WCTAssert(isPrepared());
     tryReportSQL();
+    expireRow();
     APIExit(sqlite3_reset(m_stmt));
 }
 
@@ -418,6 +420,7 @@ bool HandleStatement::step()
         setCurrentSQL(m_sql);
     }
 
+    expireRow();
     int rc = sqlite3_step(m_stmt);
     m_done = rc == SQLITE_DONE;
 
@@ -447,6 +450,7 @@ void HandleStatement::finalize()
 {
     if (m_stmt != nullptr) {
         tryReportSQL();
+        expireRow();
         // no need to call APIExit since it returns old code only.
         sqlite3_finalize(m_stmt);
         m_stmt = nullptr;
@@ -708,6 +712,33 @@ Value HandleStatement::getValue(int index)
     }
 }
 
+void HandleStatement::expireRow()
+{
+    if (m_rowGeneration != nullptr) {
+        ++*m_rowGeneration;
+    }
+}
+
+ValueView HandleStatement::getValueView(int index)
+{
+    // Created lazily since most statements never produce views.
+    if (m_rowGeneration == nullptr) {
+        m_rowGeneration = std::make_shared<uint64_t>(0);
+    }
+    switch (getType(index)) {
+    case ColumnType::Null:
+        return ValueView();
+    case ColumnType::Integer:
+        return ValueView(getInteger(index), m_rowGeneration);
+    case ColumnType::Float:
+        return ValueView(getDouble(index), m_rowGeneration);
+    case ColumnType::Text:
+        return ValueView(getText(index), m_rowGeneration);
+    case ColumnType::BLOB:
+        return ValueView(getBLOB(index), m_rowGeneration);
+    }
+}
+
 OptionalOneColumn HandleStatement::getOneColumn(int index)
 {
     OptionalOneColumn result;
@@ -734,6 +765,17 @@ OneRowValue HandleStatement::getOneRow()
     return result;
 }
 
+OneRowValueView HandleStatement::getOneRowView()
+{
+    OneRowValueView result;
+    int count = getNumberOfColumns();
+    result.reserve(count);
+    for (int i = 0; i < count; i++) {
+        result.push_back(getValueView(i));
+    }
+    return result;
+}
+
 OptionalMultiRows HandleStatement::getAllRows()
 {
     OptionalMultiRows result;
@@ -92,7 +92,11 @@ public:
     Value getValue(int index = 0);
     OptionalOneColumn getOneColumn(int index = 0);
     OneRowValue getOneRow();
-    OptionalMultiRows getAllRows();
+    virtual OptionalMultiRows getAllRows();
+
+    // Zero-copy access. The views are only valid until the next step/reset/finalize.
+    ValueView getValueView(int index = 0);
+    OneRowValueView getOneRowView();
 
     const UnsafeStringView getOriginColumnName(int index);
     const UnsafeStringView getColumnName(int index);
@@ -129,6 +133,13 @@ private:
     bool m_needReport;
     int m_stepCount;
     std::ostringstream m_stream;
+
+#pragma mark - Row Generation
+private:
+    void expireRow();
+    // Increased whenever the current row is gone, so that the expired ValueView can be detected.
+    // The views keep a weak reference, so that they can also detect the statement being released.
+    std::shared_ptr<uint64_t> m_rowGeneration;
 };
 
 } //namespace WCDB
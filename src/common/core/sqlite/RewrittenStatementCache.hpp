@@ -0,0 +1,98 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "CoreConst.h"
+#include "LRUCache.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+/*
+ Statement decorators rewrite the syntax tree of the original statement before preparing it.
+ This cache keeps the rewritten result of each handle, keyed by the SQL of the original statement.
+ All entries are dropped once the version of the infos that the rewriting depends on changes.
+ */
+template<typename Rewritten>
+class RewrittenStatementCache final : protected LRUCache<StringView, Rewritten> {
+private:
+    using Super = LRUCache<StringView, Rewritten>;
+
+public:
+    RewrittenStatementCache(size_t capacity = RewrittenStatementCacheCapacity)
+    : m_capacity(capacity), m_version(0)
+    {
+    }
+
+    // It returns false if the cache is purged due to the version changed.
+    bool validate(uint64_t version)
+    {
+        if (m_version == version) {
+            return true;
+        }
+        clear();
+        m_version = version;
+        return false;
+    }
+
+    // The returned entry is valid until next modification.
+    const Rewritten* find(const StringView& sql)
+    {
+        if (sql.empty() || !Super::exists(sql)) {
+            return nullptr;
+        }
+        return &Super::get(sql);
+    }
+
+    const Rewritten* insert(const StringView& sql, const Rewritten& rewritten)
+    {
+        if (sql.empty()) {
+            return nullptr;
+        }
+        Super::put(sql, rewritten);
+        return &Super::get(sql);
+    }
+
+    void clear()
+    {
+        this->m_map.clear();
+        this->m_list.clear();
+    }
+
+    using Super::size;
+
+protected:
+    bool shouldPurge() const override final
+    {
+        return Super::size() > m_capacity;
+    }
+
+private:
+    size_t m_capacity;
+    uint64_t m_version;
+};
+
+} // namespace WCDB
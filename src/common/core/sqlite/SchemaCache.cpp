@@ -0,0 +1,183 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SchemaCache.hpp"
+#include "Assertion.hpp"
+
+namespace WCDB {
+
+SchemaCache::SchemaCache()
+: m_valid(false), m_cookie(0), m_hitCount(0), m_missCount(0)
+{
+}
+
+SchemaCache::~SchemaCache() = default;
+
+SchemaCache::Table::Table() = default;
+
+SchemaCache::Statistic::Statistic() : hitCount(0), missCount(0)
+{
+}
+
+#pragma mark - Get
+const SchemaCache::Table *
+SchemaCache::tableForReading(int cookie, const UnsafeStringView &table) const
+{
+    if (!m_valid || m_cookie != cookie) {
+        return nullptr;
+    }
+    auto iter = m_tables.find(table);
+    if (iter == m_tables.end()) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+void SchemaCache::markAsHit(bool hit)
+{
+    if (hit) {
+        ++m_hitCount;
+    } else {
+        ++m_missCount;
+    }
+}
+
+Optional<bool> SchemaCache::tableExists(int cookie, const UnsafeStringView &table)
+{
+    Optional<bool> exists;
+    {
+        SharedLockGuard lockGuard(m_lock);
+        const Table *cached = tableForReading(cookie, table);
+        if (cached != nullptr) {
+            exists = cached->exists;
+        }
+    }
+    markAsHit(exists.hasValue());
+    return exists;
+}
+
+Optional<std::vector<ColumnMeta>>
+SchemaCache::getTableMeta(int cookie, const UnsafeStringView &table)
+{
+    Optional<std::vector<ColumnMeta>> metas;
+    {
+        SharedLockGuard lockGuard(m_lock);
+        const Table *cached = tableForReading(cookie, table);
+        if (cached != nullptr) {
+            metas = cached->metas;
+        }
+    }
+    markAsHit(metas.hasValue());
+    return metas;
+}
+
+Optional<TableAttribute> SchemaCache::getTableAttribute(int cookie, const UnsafeStringView &table)
+{
+    Optional<TableAttribute> attribute;
+    {
+        SharedLockGuard lockGuard(m_lock);
+        const Table *cached = tableForReading(cookie, table);
+        if (cached != nullptr) {
+            attribute = cached->attribute;
+        }
+    }
+    markAsHit(attribute.hasValue());
+    return attribute;
+}
+
+#pragma mark - Set
+SchemaCache::Table *
+SchemaCache::tableForUpdating(int cookie, bool committed, const UnsafeStringView &table)
+{
+    WCTAssert(m_lock.writeSafety());
+    if (!m_valid || m_cookie != cookie) {
+        // The cookie only increases in the committed history of the same file.
+        if (!committed || (m_valid && cookie < m_cookie)) {
+            return nullptr;
+        }
+        m_tables.clear();
+        m_cookie = cookie;
+        m_valid = true;
+    }
+    return &m_tables[table];
+}
+
+void SchemaCache::setTableExists(int cookie,
+                                 bool committed,
+                                 const UnsafeStringView &table,
+                                 bool exists)
+{
+    LockGuard lockGuard(m_lock);
+    Table *cached = tableForUpdating(cookie, committed, table);
+    if (cached != nullptr) {
+        cached->exists = exists;
+        if (!exists) {
+            cached->metas = NullOpt;
+            cached->attribute = NullOpt;
+        }
+    }
+}
+
+void SchemaCache::setTableMeta(int cookie,
+                               bool committed,
+                               const UnsafeStringView &table,
+                               const std::vector<ColumnMeta> &metas)
+{
+    LockGuard lockGuard(m_lock);
+    Table *cached = tableForUpdating(cookie, committed, table);
+    if (cached != nullptr) {
+        cached->metas = metas;
+    }
+}
+
+void SchemaCache::setTableAttribute(int cookie,
+                                    bool committed,
+                                    const UnsafeStringView &table,
+                                    const TableAttribute &attribute)
+{
+    LockGuard lockGuard(m_lock);
+    Table *cached = tableForUpdating(cookie, committed, table);
+    if (cached != nullptr) {
+        cached->attribute = attribute;
+    }
+}
+
+void SchemaCache::purge()
+{
+    LockGuard lockGuard(m_lock);
+    m_tables.clear();
+    m_valid = false;
+}
+
+#pragma mark - Statistic
+SchemaCache::Statistic SchemaCache::getStatistic() const
+{
+    Statistic statistic;
+    statistic.hitCount = m_hitCount.load();
+    statistic.missCount = m_missCount.load();
+    return statistic;
+}
+
+} //namespace WCDB
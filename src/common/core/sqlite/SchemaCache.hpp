@@ -0,0 +1,96 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "ColumnMeta.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "TableAttribute.hpp"
+#include "WCDBOptional.hpp"
+#include <atomic>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ The catalog of main schema shared by all handles of the same database, so that the same `PRAGMA table_info` and `sqlite_master` lookups are not repeated by each handle.
+ It's keyed by schema cookie, which is increased by any DDL, so the cached tables are dropped once a newer cookie is seen.
+ */
+class SchemaCache final {
+public:
+    SchemaCache();
+    ~SchemaCache();
+
+    SchemaCache(const SchemaCache &) = delete;
+    SchemaCache &operator=(const SchemaCache &) = delete;
+
+    // Hit only when the cookie is the same as the one the cache is built with.
+    Optional<bool> tableExists(int cookie, const UnsafeStringView &table);
+    Optional<std::vector<ColumnMeta>> getTableMeta(int cookie, const UnsafeStringView &table);
+    Optional<TableAttribute> getTableAttribute(int cookie, const UnsafeStringView &table);
+
+    // The cookie read inside a transaction may contain uncommitted DDL, so it's not allowed to renew the cache.
+    void setTableExists(int cookie, bool committed, const UnsafeStringView &table, bool exists);
+    void setTableMeta(int cookie,
+                      bool committed,
+                      const UnsafeStringView &table,
+                      const std::vector<ColumnMeta> &metas);
+    void setTableAttribute(int cookie,
+                           bool committed,
+                           const UnsafeStringView &table,
+                           const TableAttribute &attribute);
+
+    // It should be called when the database file may be replaced, since the cookie of a different file is meaningless.
+    void purge();
+
+    struct Statistic {
+        Statistic();
+        // Number of catalog queries avoided.
+        uint64_t hitCount;
+        uint64_t missCount;
+    };
+    Statistic getStatistic() const;
+
+private:
+    struct Table {
+        Table();
+        Optional<bool> exists;
+        Optional<std::vector<ColumnMeta>> metas;
+        Optional<TableAttribute> attribute;
+    };
+    const Table *tableForReading(int cookie, const UnsafeStringView &table) const;
+    Table *tableForUpdating(int cookie, bool committed, const UnsafeStringView &table);
+    void markAsHit(bool hit);
+
+    mutable SharedLock m_lock;
+    bool m_valid;
+    int m_cookie;
+    StringViewMap<Table> m_tables;
+    std::atomic<uint64_t> m_hitCount;
+    std::atomic<uint64_t> m_missCount;
+};
+
+} //namespace WCDB
@@ -0,0 +1,225 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "StatementWarmup.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "FileManager.hpp"
+#include "Notifier.hpp"
+#include "Path.hpp"
+#include <algorithm>
+
+namespace WCDB {
+
+StatementWarmup::StatementWarmup(const UnsafeStringView &database)
+: m_path(warmupPathForDatabase(database)), m_enabled(false), m_persistent(true), m_loaded(false), m_changed(false)
+{
+}
+
+StatementWarmup::~StatementWarmup() = default;
+
+StringView StatementWarmup::warmupPathForDatabase(const UnsafeStringView &database)
+{
+    return Path::addExtention(database, "-warmup");
+}
+
+void StatementWarmup::setEnabled(bool enabled)
+{
+    if (enabled) {
+        LockGuard lockGuard(m_lock);
+        if (!m_loaded && m_persistent.load()) {
+            m_loaded = true;
+            auto exists = FileManager::fileExistsAndNotEmpty(m_path);
+            if (exists.succeed() && exists.value() && !deserialize(m_path)) {
+                // Start over with the corrupted records.
+                m_preparedCounts.clear();
+            }
+        }
+    }
+    m_enabled = enabled;
+}
+
+bool StatementWarmup::isEnabled() const
+{
+    return m_enabled.load();
+}
+
+#pragma mark - Record
+void StatementWarmup::recordPrepared(const UnsafeStringView &sql)
+{
+    if (!m_enabled.load()) {
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    ++m_preparedCounts[sql];
+    m_changed = true;
+    if (m_preparedCounts.size() > StatementWarmupMaxRecordCount) {
+        for (auto iter = m_preparedCounts.begin(); iter != m_preparedCounts.end();) {
+            iter->second /= 2;
+            if (iter->second == 0) {
+                iter = m_preparedCounts.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
+std::vector<StringView> StatementWarmup::getStatementsToWarmUp() const
+{
+    std::vector<std::pair<uint64_t, StringView>> candidates;
+    if (m_enabled.load()) {
+        SharedLockGuard lockGuard(m_lock);
+        for (const auto &iter : m_preparedCounts) {
+            if (iter.second >= StatementWarmupMinPreparedCount) {
+                candidates.emplace_back(iter.second, iter.first);
+            }
+        }
+    }
+    size_t count = std::min<size_t>(candidates.size(), StatementWarmupCount);
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + count,
+                      candidates.end(),
+                      [](const std::pair<uint64_t, StringView> &left,
+                         const std::pair<uint64_t, StringView> &right) {
+                          return left.first > right.first;
+                      });
+    std::vector<StringView> sqls;
+    sqls.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        sqls.push_back(candidates[i].second);
+    }
+    return sqls;
+}
+
+bool StatementWarmup::save()
+{
+    if (!m_enabled.load() || !m_persistent.load()) {
+        return true;
+    }
+    LockGuard lockGuard(m_lock);
+    if (!m_changed) {
+        return true;
+    }
+    bool succeed = serialize(m_path);
+    if (succeed) {
+        m_changed = false;
+    }
+    return succeed;
+}
+
+void StatementWarmup::disablePersistence()
+{
+    if (!m_persistent.load()) {
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    m_persistent = false;
+    m_changed = false;
+    FileManager::removeItem(m_path);
+}
+
+#pragma mark - Serialization
+bool StatementWarmup::serialize(Serialization &serialization) const
+{
+    WCTAssert(m_lock.writeSafety());
+    //Header
+    if (!serialization.expand(headerSize)) {
+        return false;
+    }
+    serialization.put4BytesUInt(magic);
+    serialization.put4BytesUInt(version);
+
+    //Contents
+    Serialization encoder;
+    for (const auto &iter : m_preparedCounts) {
+        if (encoder.putVarint(iter.second) == 0 || !encoder.putSizedString(iter.first)) {
+            return false;
+        }
+    }
+    Data data = encoder.finalize();
+    uint32_t checksum = data.empty() ? 0 : data.hash();
+    return serialization.put4BytesUInt(checksum) && serialization.putSizedData(data);
+}
+
+bool StatementWarmup::deserialize(Deserialization &deserialization)
+{
+    WCTAssert(m_lock.writeSafety());
+    //Header
+    if (!deserialization.canAdvance(headerSize)) {
+        markAsCorrupt("Header");
+        return false;
+    }
+    if (deserialization.advance4BytesUInt() != magic) {
+        markAsCorrupt("Magic");
+        return false;
+    }
+    if (deserialization.advance4BytesUInt() != version) {
+        markAsCorrupt("Version");
+        return false;
+    }
+
+    //Contents
+    if (!deserialization.canAdvance(sizeof(uint32_t))) {
+        markAsCorrupt("Checksum");
+        return false;
+    }
+    uint32_t checksum = deserialization.advance4BytesUInt();
+    auto sizedData = deserialization.advanceSizedData();
+    if (sizedData.first == 0) {
+        markAsCorrupt("Data");
+        return false;
+    }
+    const UnsafeData &data = sizedData.second;
+    if (checksum != (data.empty() ? 0 : data.hash())) {
+        markAsCorrupt("Checksum");
+        return false;
+    }
+    Deserialization decoder(data);
+    while (!decoder.ended()) {
+        auto count = decoder.advanceVarint();
+        if (count.first == 0) {
+            markAsCorrupt("Count");
+            return false;
+        }
+        auto sql = decoder.advanceSizedString();
+        if (sql.first == 0 || sql.second.empty()) {
+            markAsCorrupt("SQL");
+            return false;
+        }
+        m_preparedCounts[sql.second] = count.second;
+    }
+    return true;
+}
+
+void StatementWarmup::markAsCorrupt(const UnsafeStringView &element)
+{
+    Error error(Error::Code::Corrupt, Error::Level::Notice, "Statement warmup is corrupted.");
+    error.infos.insert_or_assign("Element", element);
+    Notifier::shared().notify(error);
+    setThreadedError(std::move(error));
+}
+
+} //namespace WCDB
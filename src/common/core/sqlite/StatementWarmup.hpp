@@ -0,0 +1,89 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Lock.hpp"
+#include "Serialization.hpp"
+#include "StringView.hpp"
+#include <atomic>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ It records the statements prepared into the prepared statement cache of handles, and persists them in a side file of database.
+ So that the most frequently prepared ones can be prepared ahead when a new handle is generated, even after relaunch.
+ */
+class StatementWarmup final : public Serializable, public Deserializable {
+public:
+    StatementWarmup(const UnsafeStringView &database);
+    ~StatementWarmup() override;
+
+    StatementWarmup() = delete;
+    StatementWarmup(const StatementWarmup &) = delete;
+    StatementWarmup &operator=(const StatementWarmup &) = delete;
+
+    static StringView warmupPathForDatabase(const UnsafeStringView &database);
+
+    // The recorded statements are loaded from the side file when it's enabled the first time.
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void recordPrepared(const UnsafeStringView &sql);
+    // Sorted by the prepared count in descending order.
+    std::vector<StringView> getStatementsToWarmUp() const;
+
+    // It's skipped if nothing changes since last saving.
+    bool save();
+
+    // The records are kept in memory only and the side file is removed, which is used for the encrypted database.
+    void disablePersistence();
+
+protected:
+    const StringView m_path;
+    std::atomic<bool> m_enabled;
+    std::atomic<bool> m_persistent;
+    bool m_loaded;
+    bool m_changed;
+    StringViewMap<uint64_t> m_preparedCounts;
+    mutable SharedLock m_lock;
+
+#pragma mark - Serialization
+public:
+    bool serialize(Serialization &serialization) const override final;
+    using Serializable::serialize;
+    bool deserialize(Deserialization &deserialization) override final;
+    using Deserializable::deserialize;
+
+protected:
+    static void markAsCorrupt(const UnsafeStringView &element);
+
+    static constexpr const uint32_t magic = 0x57435357;
+    static constexpr const uint32_t version = 0x01000000; //1.0.0.0
+    static constexpr const int headerSize = sizeof(magic) + sizeof(version);
+};
+
+} //namespace WCDB
@@ -22,6 +22,8 @@
  * limitations under the License.
  */
 
+#pragma once
+
 #include "StringView.hpp"
 
 namespace WCDB {
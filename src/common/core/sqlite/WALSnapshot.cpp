@@ -0,0 +1,71 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "WALSnapshot.hpp"
+#include "Assertion.hpp"
+#include "SQLite.h"
+
+namespace WCDB {
+
+WALSnapshot::WALSnapshot(sqlite3_snapshot *snapshot) : m_snapshot(snapshot)
+{
+    WCTAssert(m_snapshot != nullptr);
+}
+
+WALSnapshot::~WALSnapshot()
+{
+    if (m_liveCounter != nullptr) {
+        --(*m_liveCounter);
+    }
+#if defined(SQLITE_ENABLE_SNAPSHOT) && SQLITE_ENABLE_SNAPSHOT
+    sqlite3_snapshot_free(m_snapshot);
+#endif
+}
+
+sqlite3_snapshot *WALSnapshot::get() const
+{
+    return m_snapshot;
+}
+
+int WALSnapshot::compare(const WALSnapshot &other) const
+{
+#if defined(SQLITE_ENABLE_SNAPSHOT) && SQLITE_ENABLE_SNAPSHOT
+    return sqlite3_snapshot_cmp(m_snapshot, other.m_snapshot);
+#else
+    WCDB_UNUSED(other);
+    return 0;
+#endif
+}
+
+void WALSnapshot::attachLiveCounter(const LiveCounter &counter)
+{
+    WCTAssert(m_liveCounter == nullptr);
+    m_liveCounter = counter;
+    if (m_liveCounter != nullptr) {
+        ++(*m_liveCounter);
+    }
+}
+
+} //namespace WCDB
@@ -0,0 +1,63 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+extern "C" {
+typedef struct sqlite3_snapshot sqlite3_snapshot;
+}
+
+namespace WCDB {
+
+/*
+ The wrapper of `sqlite3_snapshot`, which identifies a historical version of the database in WAL mode.
+ It's independent of the handle that captures it, so it can be opened by any other handle of the same database.
+ */
+class WALSnapshot final {
+public:
+    WALSnapshot(sqlite3_snapshot *snapshot);
+    ~WALSnapshot();
+
+    WALSnapshot(const WALSnapshot &) = delete;
+    WALSnapshot &operator=(const WALSnapshot &) = delete;
+
+    sqlite3_snapshot *get() const;
+
+    // Negative if this snapshot is older than the other one, positive if newer and zero if they are the same.
+    int compare(const WALSnapshot &other) const;
+
+    // The counter is increased during the lifetime of this snapshot.
+    typedef std::shared_ptr<std::atomic<int>> LiveCounter;
+    void attachLiveCounter(const LiveCounter &counter);
+
+private:
+    sqlite3_snapshot *m_snapshot;
+    LiveCounter m_liveCounter;
+};
+
+} //namespace WCDB
@@ -112,6 +112,17 @@ void Crawlable::safeCrawl(int rootpageno, std::set<int> &crawledInteriorPages, i
         return;
     }
     crawledInteriorPages.emplace(rootpageno);
+    if (rootpage.getType() == Page::Type::InteriorTable
+        || rootpage.getType() == Page::Type::InteriorIndex) {
+        // Hint all the subpages before descending so that their reading overlaps with the parsing.
+        std::vector<int> subpagenos;
+        int numberOfSubpages = rootpage.getNumberOfSubpages();
+        subpagenos.reserve(numberOfSubpages);
+        for (int i = 0; i < numberOfSubpages; ++i) {
+            subpagenos.push_back(rootpage.getSubpageno(i));
+        }
+        m_associatedPager->prefetchPages(subpagenos);
+    }
     switch (rootpage.getType()) {
     case Page::Type::InteriorTable:
         for (int i = 0; i < rootpage.getNumberOfSubpages(); ++i) {
@@ -51,6 +51,11 @@ void FullCrawler::setPageCount(int64_t pageCount)
     m_pageCount = pageCount;
 }
 
+void FullCrawler::setPagePrefetchEnabled(bool enabled)
+{
+    m_pager.setPrefetchEnabled(enabled);
+}
+
 #pragma mark - Repair
 bool FullCrawler::work()
 {
@@ -115,6 +120,7 @@ bool FullCrawler::work()
         }
         markAsAssembled();
     }
+    m_pager.reportPrefetch("FullCrawler");
 
     return exit();
 }
@@ -43,6 +43,7 @@ public:
     FullCrawler(const UnsafeStringView &source);
     ~FullCrawler() override;
     void setPageCount(int64_t pageCount);
+    void setPagePrefetchEnabled(bool enabled);
 
 private:
     int64_t m_pageCount;
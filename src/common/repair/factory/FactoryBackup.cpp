@@ -56,6 +56,13 @@ bool FactoryBackup::work(const UnsafeStringView& database, bool interruptible)
     return succeed;
 }
 
+bool FactoryBackup::isPagePrefetchEnabled()
+{
+    auto config = Core::shared().getABTestConfig("clicfg_wcdb_page_prefetch");
+    return !config.succeed() || config.value().length() == 0
+           || atoi(config.value().data()) != 0;
+}
+
 bool FactoryBackup::doBackUp(const UnsafeStringView& database, bool interruptible)
 {
     Optional<size_t> incrementalMaterialSize = 0;
@@ -82,6 +89,7 @@ bool FactoryBackup::doBackUp(const UnsafeStringView& database, bool interruptibl
     }
 
     Backup backup(database);
+    backup.setPagePrefetchEnabled(isPagePrefetchEnabled());
     backup.setCipherDelegate(m_cipherDelegate);
     backup.setBackupSharedDelegate(m_sharedDelegate);
     backup.setBackupExclusiveDelegate(m_exclusiveDelegate);
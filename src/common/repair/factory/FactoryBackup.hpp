@@ -40,6 +40,8 @@ public:
     using FactoryRelated::FactoryRelated;
     ~FactoryBackup() override;
     bool work(const UnsafeStringView& database, bool interruptible = false);
+    // Page prefetch can be disabled by setting the abtest config "clicfg_wcdb_page_prefetch" to 0.
+    static bool isPagePrefetchEnabled();
 
 protected:
     bool doBackUp(const UnsafeStringView& database, bool interruptible);
@@ -246,6 +246,7 @@ bool FactoryRetriever::restore(const UnsafeStringView &databasePath)
                                               std::placeholders::_2));
     fullCrawler.filter(factory.getFilter());
     fullCrawler.setCipherDelegate(m_cipherDelegate);
+    fullCrawler.setPagePrefetchEnabled(FactoryBackup::isPagePrefetchEnabled());
     if (!useMaterial) {
         auto salt = m_cipherDelegate->tryGetSaltFromDatabase(databasePath);
         if (!salt.succeed()) {
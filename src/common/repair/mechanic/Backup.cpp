@@ -116,10 +116,16 @@ bool Backup::work(SharedIncrementalMaterial incrementalMaterial)
     }
 
     updateMaterial(materialLoad.value());
+    m_pager.reportPrefetch("Backup");
 
     return true;
 }
 
+void Backup::setPagePrefetchEnabled(bool enabled)
+{
+    m_pager.setPrefetchEnabled(enabled);
+}
+
 Optional<bool> Backup::tryLoadLatestMaterial(SharedIncrementalMaterial incrementalMaterial)
 {
     if (incrementalMaterial == nullptr
@@ -97,6 +97,7 @@ protected:
 #pragma mark - Backup
 public:
     bool work(SharedIncrementalMaterial material);
+    void setPagePrefetchEnabled(bool enabled);
 
     const Material &getMaterial() const;
     SharedIncrementalMaterial getIncrementalMaterial();
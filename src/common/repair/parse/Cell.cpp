@@ -30,6 +30,7 @@
 #include "StringView.hpp"
 #include <cstring>
 #include <set>
+#include <vector>
 
 namespace WCDB {
 
@@ -290,6 +291,21 @@ bool Cell::doInitialize()
                localPayloadSize);
 
         int cursorOfPayload = localPayloadSize;
+        //overflow pages are usually allocated sequentially, so read them ahead speculatively
+        int usableSizeOfOverflow = m_pager->getUsableSize() - 4;
+        if (overflowPageno > 0 && usableSizeOfOverflow > 0) {
+            int numberOfOverflowPages
+            = (payloadSize - localPayloadSize + usableSizeOfOverflow - 1) / usableSizeOfOverflow;
+            if (numberOfOverflowPages > 1) {
+                int lastPageno = std::min(overflowPageno + numberOfOverflowPages - 1,
+                                          m_pager->getNumberOfPages());
+                std::vector<int> speculativePagenos;
+                for (int pageno = overflowPageno; pageno <= lastPageno; ++pageno) {
+                    speculativePagenos.push_back(pageno);
+                }
+                m_pager->prefetchPages(speculativePagenos);
+            }
+        }
         std::set<int> overflowPagenos;
         while (overflowPageno > 0 && cursorOfPayload < payloadSize) {
             if (overflowPagenos.find(overflowPageno) != overflowPagenos.end()) {
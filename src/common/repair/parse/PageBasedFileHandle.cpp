@@ -27,12 +27,17 @@
 #include "CoreConst.h"
 #include "Notifier.hpp"
 #include "WCDBError.hpp"
+#include <algorithm>
 
 namespace WCDB {
 
 #pragma mark - PageBasedFileHandle
 PageBasedFileHandle::PageBasedFileHandle(const UnsafeStringView& path)
-: FileHandle(path), m_pageSize(0), m_cache(maxAllowedCacheMemory), m_cachePageSize(0)
+: FileHandle(path)
+, m_pageSize(0)
+, m_cache(maxAllowedCacheMemory)
+, m_cachePageSize(0)
+, m_numberOfMappedPages(0)
 {
     static_assert(maxAllowedCacheMemory % cacheMemoryPerRange == 0, "");
     static_assert((maxAllowedCacheMemory & maxAllowedCacheMemory - 1) == 0, "");
@@ -67,6 +72,15 @@ MappedData PageBasedFileHandle::mapPage(int pageno,
     WCTAssert(sizeWithinPage <= m_pageSize && sizeWithinPage > 0);
     WCTAssert(m_cachePageSize >= m_pageSize);
 
+    if (!m_prefetchedPages.empty() && m_prefetchedPages.exists(pageno)) {
+        // The read right after the prefetch can't benefit from it.
+        if (m_prefetchedPages.get(pageno) < m_numberOfMappedPages) {
+            ++m_prefetchStatistic.hitPages;
+        }
+        m_prefetchedPages.erase(pageno);
+    }
+    ++m_numberOfMappedPages;
+
     offset_t offset = (pageno - 1) * m_pageSize + offsetWithinPage;
     offset_t cachePageno = offset / m_cachePageSize;
 
@@ -155,6 +169,7 @@ void PageBasedFileHandle::setPageSize(size_t pageSize)
 void PageBasedFileHandle::purgeAll()
 {
     m_cache.purge(m_cache.size());
+    m_prefetchedPages.clear();
 }
 
 bool PageBasedFileHandle::purgeOne()
@@ -238,6 +253,11 @@ void PageBasedFileHandle::Cache::insert(const Range& range, const MappedData& da
     put(range, data);
 }
 
+size_t PageBasedFileHandle::Cache::getUsedMemory() const
+{
+    return m_currentUsedMemery;
+}
+
 bool PageBasedFileHandle::Cache::shouldPurge() const
 {
     return m_currentUsedMemery > m_maxAllowedMemory;
@@ -258,4 +278,76 @@ PageBasedFileHandle::Cache::findIterator(Location location)
     });
 }
 
+#pragma mark - Prefetch
+void PageBasedFileHandle::prefetchPages(const std::vector<int>& pagenos)
+{
+    WCTAssert(m_pageSize > 0);
+    size_t usedMemory = m_cache.getUsedMemory();
+    if (usedMemory >= maxAllowedCacheMemory) {
+        return;
+    }
+    m_prefetchedPages.setMaxAllowedPages((maxAllowedCacheMemory - usedMemory) / m_pageSize);
+
+    std::vector<int> sortedPagenos;
+    sortedPagenos.reserve(pagenos.size());
+    for (int pageno : pagenos) {
+        if (pageno > 0 && !m_prefetchedPages.exists(pageno)) {
+            sortedPagenos.push_back(pageno);
+        }
+    }
+    std::sort(sortedPagenos.begin(), sortedPagenos.end());
+    sortedPagenos.erase(std::unique(sortedPagenos.begin(), sortedPagenos.end()),
+                        sortedPagenos.end());
+
+    // Adjacent pages are advised together.
+    size_t begin = 0;
+    while (begin < sortedPagenos.size()) {
+        size_t end = begin + 1;
+        while (end < sortedPagenos.size() && sortedPagenos[end] == sortedPagenos[end - 1] + 1) {
+            ++end;
+        }
+        adviseWillNeed((sortedPagenos[begin] - 1) * m_pageSize, (end - begin) * m_pageSize);
+        for (size_t i = begin; i < end; ++i) {
+            m_prefetchedPages.insert(sortedPagenos[i], m_numberOfMappedPages);
+        }
+        m_prefetchStatistic.prefetchedPages += end - begin;
+        begin = end;
+    }
+}
+
+const PageBasedFileHandle::PrefetchStatistic& PageBasedFileHandle::getPrefetchStatistic() const
+{
+    return m_prefetchStatistic;
+}
+
+PageBasedFileHandle::PrefetchedPages::PrefetchedPages()
+: LRUCache<int, size_t>(), m_maxAllowedPages(0)
+{
+}
+
+PageBasedFileHandle::PrefetchedPages::~PrefetchedPages() = default;
+
+void PageBasedFileHandle::PrefetchedPages::setMaxAllowedPages(size_t maxAllowedPages)
+{
+    m_maxAllowedPages = maxAllowedPages;
+    while (shouldPurge()) {
+        purge();
+    }
+}
+
+void PageBasedFileHandle::PrefetchedPages::insert(int pageno, size_t numberOfMappedPages)
+{
+    put(pageno, numberOfMappedPages);
+}
+
+void PageBasedFileHandle::PrefetchedPages::clear()
+{
+    purge(size());
+}
+
+bool PageBasedFileHandle::PrefetchedPages::shouldPurge() const
+{
+    return size() > m_maxAllowedPages;
+}
+
 } // namespace WCDB
@@ -28,6 +28,7 @@
 #include "LRUCache.hpp"
 #include "MappedData.hpp"
 #include "Range.hpp"
+#include <vector>
 
 namespace WCDB {
 
@@ -77,6 +78,7 @@ protected:
         void setRange(const Range& range);
         std::pair<Range, const MappedData*> find(Location location);
         void insert(const Range& range, const MappedData& data);
+        size_t getUsedMemory() const;
 
     protected:
         MapIterator findIterator(Location location);
@@ -90,6 +92,46 @@ protected:
 
     Cache m_cache;
     size_t m_cachePageSize;
+
+#pragma mark - Prefetch
+public:
+    // Read the pages ahead asynchronously.
+    // Pages being prefetched share the memory budget with the cache, and the stalest ones are dropped when it is exceeded.
+    void prefetchPages(const std::vector<int>& pagenos);
+
+    struct PrefetchStatistic {
+        size_t prefetchedPages = 0;
+        // Prefetched pages that are read after some other pages, which gives the read-ahead time to take effect.
+        size_t hitPages = 0;
+    };
+    const PrefetchStatistic& getPrefetchStatistic() const;
+
+protected:
+    // Pageno -> the number of mapped pages when it is prefetched.
+    class PrefetchedPages final : protected LRUCache<int, size_t> {
+    public:
+        PrefetchedPages();
+        ~PrefetchedPages() override;
+
+        using Super = LRUCache<int, size_t>;
+        using Super::exists;
+        using Super::get;
+        using Super::size;
+        using Super::empty;
+        using Super::erase;
+
+        void setMaxAllowedPages(size_t maxAllowedPages);
+        void insert(int pageno, size_t numberOfMappedPages);
+        void clear();
+
+    protected:
+        bool shouldPurge() const override final;
+        size_t m_maxAllowedPages;
+    };
+
+    PrefetchedPages m_prefetchedPages;
+    PrefetchStatistic m_prefetchStatistic;
+    size_t m_numberOfMappedPages;
 };
 
 } // namespace WCDB
@@ -49,6 +49,7 @@ Pager::Pager(const UnsafeStringView& path)
 , m_wal(this)
 , m_walImportance(true)
 , m_skipWal(false)
+, m_prefetchEnabled(true)
 , m_cache(maxAllowedCacheMemory)
 , m_highWater(std::make_shared<ShareableHighWater>())
 {
@@ -253,6 +254,55 @@ bool Pager::containPageInWal(uint32_t pageno)
     return m_wal.containsPage(pageno);
 }
 
+#pragma mark - Prefetch
+void Pager::prefetchPages(const std::vector<int>& pagenos)
+{
+    if (!m_prefetchEnabled || !isInitialized()) {
+        return;
+    }
+    std::vector<int> pagesToPrefetch;
+    pagesToPrefetch.reserve(pagenos.size());
+    for (int pageno : pagenos) {
+        if (pageno <= 0 || pageno > m_numberOfPages || m_cache.exists(pageno)
+            || m_wal.containsPage(pageno)) {
+            continue;
+        }
+        pagesToPrefetch.push_back(pageno);
+    }
+    if (!pagesToPrefetch.empty()) {
+        m_fileHandle.prefetchPages(pagesToPrefetch);
+    }
+}
+
+void Pager::setPrefetchEnabled(bool enabled)
+{
+    m_prefetchEnabled = enabled;
+}
+
+const Pager::PrefetchStatistic& Pager::getPrefetchStatistic() const
+{
+    return m_fileHandle.getPrefetchStatistic();
+}
+
+void Pager::reportPrefetch(const UnsafeStringView& mechanic) const
+{
+    const PrefetchStatistic& statistic = getPrefetchStatistic();
+    if (statistic.prefetchedPages == 0) {
+        return;
+    }
+    Error error(Error::Code::Notice, Error::Level::Notice, "Page Prefetch Report.");
+    error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceRepair);
+    error.infos.insert_or_assign(ErrorStringKeyAssociatePath, getPath());
+    error.infos.insert_or_assign("Mechanic", mechanic);
+    error.infos.insert_or_assign("PrefetchedPages", statistic.prefetchedPages);
+    error.infos.insert_or_assign("HitPages", statistic.hitPages);
+    error.infos.insert_or_assign(
+    "HitRate",
+    StringView::formatted(
+    "%f%%", (double) statistic.hitPages * 100.0f / statistic.prefetchedPages));
+    Notifier::shared().notify(error);
+}
+
 #pragma mark - Error
 void Pager::markAsCorrupted(int page, const UnsafeStringView& message)
 {
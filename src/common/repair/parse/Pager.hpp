@@ -98,6 +98,19 @@ protected:
     bool m_walImportance;
     bool m_skipWal;
 
+#pragma mark - Prefetch
+public:
+    // Hint the pages that will be read soon. Pages already cached or in wal are skipped.
+    void prefetchPages(const std::vector<int>& pagenos);
+    // Prefetch is enabled by default.
+    void setPrefetchEnabled(bool enabled);
+    typedef PageBasedFileHandle::PrefetchStatistic PrefetchStatistic;
+    const PrefetchStatistic& getPrefetchStatistic() const;
+    void reportPrefetch(const UnsafeStringView& mechanic) const;
+
+protected:
+    bool m_prefetchEnabled;
+
 #pragma mark - Error
 public:
     void markAsCorrupted(int page, const UnsafeStringView& message);
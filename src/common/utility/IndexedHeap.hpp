@@ -0,0 +1,257 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+/*
+ * Indexed heap is a data structure that
+ * 1. constrained by unique key.
+ * 2. the element with the smallest order is always on the top.
+ *    Elements with the same order pop in the order they are inserted.
+ *
+ * The performance is
+ * 1. find/exists is O(1)
+ * 2. insert/erase/pop is O(logN)
+ *
+ * Unlike the UniqueList, it's not iterable in order.
+ */
+
+#include "Assertion.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace WCDB {
+
+template<typename Value, typename Order>
+class IndexedHeapNode {
+public:
+    IndexedHeapNode(const Value& value, const Order& order, uint64_t sequence)
+    : m_value(value), m_order(order), m_sequence(sequence), m_index(0)
+    {
+    }
+
+    Value& value() { return m_value; }
+
+    const Value& value() const { return m_value; }
+
+    const Order& order() const { return m_order; }
+
+private:
+    template<typename, typename, typename, typename>
+    friend class IndexedHeap;
+
+    bool isPriorTo(const IndexedHeapNode& other) const
+    {
+        if (m_order < other.m_order) {
+            return true;
+        }
+        if (other.m_order < m_order) {
+            return false;
+        }
+        return m_sequence < other.m_sequence;
+    }
+
+    Value m_value;
+    Order m_order;
+    uint64_t m_sequence;
+    size_t m_index;
+};
+
+// Small order first
+template<typename Key, typename Value, typename Order = int, typename Hash = std::hash<Key>>
+class IndexedHeap final {
+#pragma mark - Declaration
+public:
+    typedef IndexedHeapNode<Value, Order> Node;
+
+private:
+    // Nodes never move inside the map so that the heap can refer to them by pointer.
+    typedef std::unordered_map<Key, Node, Hash> Map;
+    typedef typename Map::value_type Element;
+    Map m_nodes;
+    // 4-ary heap is shallower than the binary one and its children share the cache line.
+    static constexpr size_t Arity = 4;
+    std::vector<Element*> m_heap;
+    uint64_t m_sequence = 0;
+
+#pragma mark - Element Access
+public:
+    const Key& topKey() const
+    {
+        WCTAssert(!m_heap.empty());
+        return m_heap.front()->first;
+    }
+
+    const Node& top() const
+    {
+        WCTAssert(!m_heap.empty());
+        return m_heap.front()->second;
+    }
+
+    Node* find(const Key& key)
+    {
+        auto iter = m_nodes.find(key);
+        if (iter == m_nodes.end()) {
+            return nullptr;
+        }
+        return &iter->second;
+    }
+
+    bool exists(const Key& key) const { return m_nodes.find(key) != m_nodes.end(); }
+
+#pragma mark - Capacity
+public:
+    bool empty() const { return m_heap.empty(); }
+
+    size_t size() const { return m_heap.size(); }
+
+    void reserve(size_t count)
+    {
+        m_nodes.reserve(count);
+        m_heap.reserve(count);
+    }
+
+#pragma mark - Modifiers
+public:
+    // Insert the element or replace the existing one with the same key.
+    void insert(const Key& key, const Value& value, const Order& order)
+    {
+        auto iter = m_nodes.find(key);
+        if (iter != m_nodes.end()) {
+            Node& node = iter->second;
+            // The newer sequence always loses the tie.
+            bool prior = order < node.m_order;
+            node.m_value = value;
+            node.m_order = order;
+            node.m_sequence = m_sequence++;
+            if (prior) {
+                siftUp(node.m_index);
+            } else {
+                siftDown(node.m_index);
+            }
+        } else {
+            iter = m_nodes.emplace(key, Node(value, order, m_sequence++)).first;
+            iter->second.m_index = m_heap.size();
+            m_heap.push_back(&*iter);
+            siftUp(m_heap.size() - 1);
+        }
+    }
+
+    bool erase(const Key& key)
+    {
+        auto iter = m_nodes.find(key);
+        if (iter == m_nodes.end()) {
+            return false;
+        }
+        size_t index = iter->second.m_index;
+        size_t last = m_heap.size() - 1;
+        if (index != last) {
+            place(m_heap[last], index);
+            m_heap.pop_back();
+            if (index > 0 && isPriorTo(index, parentOf(index))) {
+                siftUp(index);
+            } else {
+                siftDown(index);
+            }
+        } else {
+            m_heap.pop_back();
+        }
+        m_nodes.erase(iter);
+        return true;
+    }
+
+    void pop()
+    {
+        WCTAssert(!m_heap.empty());
+        if (!m_heap.empty()) {
+            erase(m_heap.front()->first);
+        }
+    }
+
+    void clear()
+    {
+        m_heap.clear();
+        m_nodes.clear();
+    }
+
+#pragma mark - Heap
+private:
+    static size_t parentOf(size_t index) { return (index - 1) / Arity; }
+
+    bool isPriorTo(size_t lhs, size_t rhs) const
+    {
+        return m_heap[lhs]->second.isPriorTo(m_heap[rhs]->second);
+    }
+
+    void place(Element* element, size_t index)
+    {
+        m_heap[index] = element;
+        element->second.m_index = index;
+    }
+
+    void siftUp(size_t index)
+    {
+        Element* element = m_heap[index];
+        while (index > 0) {
+            size_t parent = parentOf(index);
+            if (!element->second.isPriorTo(m_heap[parent]->second)) {
+                break;
+            }
+            place(m_heap[parent], index);
+            index = parent;
+        }
+        place(element, index);
+    }
+
+    void siftDown(size_t index)
+    {
+        size_t count = m_heap.size();
+        Element* element = m_heap[index];
+        while (true) {
+            size_t firstChild = index * Arity + 1;
+            if (firstChild >= count) {
+                break;
+            }
+            size_t endChild = std::min(firstChild + Arity, count);
+            size_t prior = firstChild;
+            for (size_t child = firstChild + 1; child < endChild; ++child) {
+                if (isPriorTo(child, prior)) {
+                    prior = child;
+                }
+            }
+            if (!m_heap[prior]->second.isPriorTo(element->second)) {
+                break;
+            }
+            place(m_heap[prior], index);
+            index = prior;
+        }
+        place(element, index);
+    }
+};
+
+} // namespace WCDB
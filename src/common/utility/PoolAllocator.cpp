@@ -0,0 +1,155 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PoolAllocator.hpp"
+#include "Assertion.hpp"
+#include <array>
+
+namespace WCDB {
+
+namespace {
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+static constexpr const size_t PoolSizeClassCount
+= PoolMemory::maxPooledSize / PoolMemory::granularity;
+
+struct ThreadedPool {
+    ThreadedPool()
+    {
+        heads.fill(nullptr);
+        counts.fill(0);
+    }
+
+    ~ThreadedPool();
+
+    std::array<FreeBlock*, PoolSizeClassCount> heads;
+    std::array<size_t, PoolSizeClassCount> counts;
+    PoolMemory::Statistic statistic;
+};
+
+// Trivially destructible, so it is still readable while the thread is exiting.
+thread_local bool t_threadedPoolDestroyed = false;
+
+ThreadedPool::~ThreadedPool()
+{
+    t_threadedPoolDestroyed = true;
+    for (auto head : heads) {
+        while (head != nullptr) {
+            FreeBlock* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+}
+
+ThreadedPool* threadedPool()
+{
+    if (t_threadedPoolDestroyed) {
+        return nullptr;
+    }
+    thread_local ThreadedPool s_pool;
+    return &s_pool;
+}
+
+size_t sizeClassOfSize(size_t size)
+{
+    WCTAssert(size > 0 && size <= PoolMemory::maxPooledSize);
+    return (size - 1) / PoolMemory::granularity;
+}
+
+size_t maxPooledBlocksOfSizeClass(size_t sizeClass)
+{
+    size_t blocks = PoolMemory::maxPooledBytesPerSize / ((sizeClass + 1) * PoolMemory::granularity);
+    return blocks < PoolMemory::maxPooledBlocksPerSize ? blocks : PoolMemory::maxPooledBlocksPerSize;
+}
+
+} // namespace
+
+void* PoolMemory::allocate(size_t size)
+{
+    if (size == 0 || size > maxPooledSize) {
+        ThreadedPool* pool = threadedPool();
+        if (pool != nullptr) {
+            ++pool->statistic.oversized;
+        }
+        return ::operator new(size);
+    }
+    ThreadedPool* pool = threadedPool();
+    if (pool == nullptr) {
+        return ::operator new((sizeClassOfSize(size) + 1) * granularity);
+    }
+    size_t sizeClass = sizeClassOfSize(size);
+    FreeBlock*& head = pool->heads[sizeClass];
+    if (head != nullptr) {
+        FreeBlock* block = head;
+        head = block->next;
+        --pool->counts[sizeClass];
+        ++pool->statistic.reused;
+        return block;
+    }
+    ++pool->statistic.allocated;
+    return ::operator new((sizeClass + 1) * granularity);
+}
+
+void PoolMemory::deallocate(void* memory, size_t size)
+{
+    if (memory == nullptr) {
+        return;
+    }
+    if (size == 0 || size > maxPooledSize) {
+        ::operator delete(memory);
+        return;
+    }
+    ThreadedPool* pool = threadedPool();
+    size_t sizeClass = sizeClassOfSize(size);
+    if (pool == nullptr || pool->counts[sizeClass] >= maxPooledBlocksOfSizeClass(sizeClass)) {
+        ::operator delete(memory);
+        return;
+    }
+    // Blocks freed by another thread are adopted by the current one.
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = pool->heads[sizeClass];
+    pool->heads[sizeClass] = block;
+    ++pool->counts[sizeClass];
+}
+
+PoolMemory::Statistic PoolMemory::getThreadedStatistic()
+{
+    ThreadedPool* pool = threadedPool();
+    return pool != nullptr ? pool->statistic : Statistic();
+}
+
+void PoolMemory::resetThreadedStatistic()
+{
+    ThreadedPool* pool = threadedPool();
+    if (pool != nullptr) {
+        pool->statistic = Statistic();
+    }
+}
+
+} // namespace WCDB
@@ -0,0 +1,102 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Macro.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace WCDB {
+
+// Recycles small blocks in thread-local free lists, so that the roots cloned on every copy-on-write of syntax trees don't hit the global allocator again and again.
+// The children of a cloned tree are copied by their own containers, which still use the global allocator.
+class WCDB_API PoolMemory final {
+public:
+    PoolMemory() = delete;
+    PoolMemory(const PoolMemory&) = delete;
+    PoolMemory& operator=(const PoolMemory&) = delete;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* memory, size_t size);
+
+    struct Statistic {
+        uint64_t allocated = 0; // blocks fetched from the global allocator
+        uint64_t reused = 0;    // blocks served from the free lists
+        uint64_t oversized = 0; // blocks too large to be pooled, which always hit the global allocator
+    };
+    // Counters of the current thread.
+    static Statistic getThreadedStatistic();
+    static void resetThreadedStatistic();
+
+    static constexpr const size_t granularity = 16;
+    // Large enough for the roots of statements, such as InsertSTMT, which take up to 2KB with the control block of shared_ptr.
+    static constexpr const size_t maxPooledSize = 2048;
+    static constexpr const size_t maxPooledBlocksPerSize = 256;
+    // Bound the memory kept by each free list of large blocks.
+    static constexpr const size_t maxPooledBytesPerSize = 64 * 1024;
+};
+
+template<typename T>
+class PoolAllocator {
+public:
+    typedef T value_type;
+
+    PoolAllocator() noexcept = default;
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(PoolMemory::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        PoolMemory::deallocate(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    struct rebind {
+        typedef PoolAllocator<U> other;
+    };
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
+
+} // namespace WCDB
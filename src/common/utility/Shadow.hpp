@@ -98,7 +98,8 @@ public:
                 = std::shared_ptr<T>(newPayload, static_cast<T*>(newPayload.get()));
                 m_isPrivate = true;
             } else {
-                m_isPrivate = false;
+                // Sole owner. Keep it private so that following writes skip the check.
+                m_isPrivate = true;
             }
         }
         return m_payload.get();
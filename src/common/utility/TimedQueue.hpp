@@ -26,19 +26,19 @@
 
 #include "Assertion.hpp"
 #include "Exiting.hpp"
+#include "IndexedHeap.hpp"
 #include "Time.hpp"
-#include "UniqueList.hpp"
 #include <condition_variable>
 #include <list>
 #include <stdio.h>
 
 namespace WCDB {
 
-template<typename Key, typename Info>
+template<typename Key, typename Info, typename Hash = std::hash<Key>>
 class TimedQueue final {
 private:
-    typedef UniqueList<Key, Info, SteadyClock> List;
-    List m_list;
+    typedef IndexedHeap<Key, Info, SteadyClock, Hash> Heap;
+    Heap m_heap;
     Conditional m_conditional;
     std::mutex m_lock;
     bool m_stop;
@@ -76,12 +76,12 @@ public:
                 return;
             }
 
-            auto iter = m_list.find(key);
-            if (mode == Mode::ForwardOnly && iter != m_list.end() && iter->order() < expired) {
-                iter->value() = info;
+            auto node = m_heap.find(key);
+            if (mode == Mode::ForwardOnly && node != nullptr && node->order() < expired) {
+                node->value() = info;
             } else {
-                m_list.insert(key, info, expired);
-                notify = m_list.front().key() == key;
+                m_heap.insert(key, info, expired);
+                notify = m_heap.topKey() == key;
             }
         }
         if (notify) {
@@ -96,7 +96,7 @@ public:
             if (m_stop) {
                 return;
             }
-            m_list.erase(key);
+            m_heap.erase(key);
         }
         if (isExiting()) {
             stop();
@@ -108,7 +108,7 @@ public:
     {
         {
             std::lock_guard<std::mutex> lockGuard(m_lock);
-            m_list.clear();
+            m_heap.clear();
             m_stop = true;
         }
         m_conditional.notify_one();
@@ -130,22 +130,21 @@ public:
                 if (m_stop) {
                     break;
                 }
-                auto shortest = m_list.begin();
-                if (shortest == m_list.end()) {
+                if (m_heap.empty()) {
                     if (!isExiting()) {
                         m_conditional.wait(lockGuard);
                     }
                     continue;
                 }
-                double timeInterval = shortest->order().timeIntervalSinceNow();
+                double timeInterval = m_heap.top().order().timeIntervalSinceNow();
                 if (timeInterval > 0) {
                     if (!isExiting()) {
                         m_conditional.wait_for(lockGuard, timeInterval);
                     }
                     continue;
                 }
-                expireds.push_back(std::make_pair(shortest->key(), shortest->value()));
-                m_list.erase(shortest);
+                expireds.push_back(std::make_pair(m_heap.topKey(), m_heap.top().value()));
+                m_heap.pop();
             }
             if (!isExiting()) {
                 WCTAssert(expireds.size() == 1);
@@ -0,0 +1,114 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "WorkerPool.hpp"
+#include "CoreConst.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace WCDB {
+
+WorkerPool &WorkerPool::shared()
+{
+    static WorkerPool *s_shared = new WorkerPool;
+    return *s_shared;
+}
+
+WorkerPool::WorkerPool() : m_numberOfWorkers(0), m_numberOfIdleWorkers(0)
+{
+}
+
+void WorkerPool::async(const Job &job)
+{
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    m_jobs.push_back(job);
+    if (m_jobs.size() > m_numberOfIdleWorkers && m_numberOfWorkers < WorkerPoolMaxNumberOfWorkers) {
+        ++m_numberOfWorkers;
+        std::thread(&WorkerPool::loop, this).detach();
+    } else {
+        m_conditional.notify_one();
+    }
+}
+
+void WorkerPool::loop()
+{
+    Thread::setName(WorkerPoolName);
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    while (true) {
+        while (m_jobs.empty()) {
+            ++m_numberOfIdleWorkers;
+            m_conditional.wait(lockGuard);
+            --m_numberOfIdleWorkers;
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lockGuard.unlock();
+        job();
+        lockGuard.lock();
+    }
+}
+
+void WorkerPool::parallelFor(size_t count, size_t concurrency, const Task &task)
+{
+    struct Progress {
+        std::atomic<size_t> next;
+        std::mutex lock;
+        Conditional conditional;
+        size_t done;
+    };
+    std::shared_ptr<Progress> progress = std::make_shared<Progress>();
+    progress->next = 0;
+    progress->done = 0;
+    // The indexes are taken in order by whoever is free. Late workers find nothing to do and never touch `task`.
+    auto run = [progress, count, &task]() {
+        size_t index;
+        size_t done = 0;
+        while ((index = progress->next++) < count) {
+            task(index);
+            ++done;
+        }
+        if (done > 0) {
+            std::lock_guard<std::mutex> lockGuard(progress->lock);
+            progress->done += done;
+            if (progress->done == count) {
+                progress->conditional.notify_all();
+            }
+        }
+    };
+    size_t numberOfWorkers
+    = std::min<size_t>(std::min(count, concurrency), WorkerPoolMaxNumberOfWorkers + 1);
+    for (size_t i = 1; i < numberOfWorkers; ++i) {
+        async(run);
+    }
+    run();
+    std::unique_lock<std::mutex> lockGuard(progress->lock);
+    while (progress->done < count) {
+        progress->conditional.wait(lockGuard);
+    }
+}
+
+} // namespace WCDB
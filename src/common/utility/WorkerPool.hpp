@@ -0,0 +1,65 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Lock.hpp"
+#include <functional>
+#include <list>
+#include <mutex>
+
+namespace WCDB {
+
+/*
+ WorkerPool runs the CPU-bound jobs split from a single call, such as the partitions of a parallel query, on a bounded number of long-lived threads.
+ The threads are created on demand and never exit, so that their thread-local resources can be reused across calls.
+ */
+class WorkerPool final {
+public:
+    static WorkerPool &shared();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    typedef std::function<void(void)> Job;
+    // The job will be queued if all the workers are busy, so the caller should not wait for a job that it can't run by itself.
+    void async(const Job &job);
+
+    typedef std::function<void(size_t index)> Task;
+    // Run `task` with each index in [0, count) on current thread and at most `concurrency - 1` workers, and return after all of them are done.
+    void parallelFor(size_t count, size_t concurrency, const Task &task);
+
+private:
+    WorkerPool();
+    void loop();
+
+    std::mutex m_lock;
+    Conditional m_conditional;
+    std::list<Job> m_jobs;
+    size_t m_numberOfWorkers;
+    size_t m_numberOfIdleWorkers;
+};
+
+} // namespace WCDB
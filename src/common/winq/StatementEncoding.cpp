@@ -0,0 +1,1007 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "StatementEncoding.hpp"
+#include "Assertion.hpp"
+#include "Serialization.hpp"
+#include "Syntax.h"
+#include <cstring>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace WCDB {
+
+namespace {
+
+template<typename T>
+struct SyntaxCoding;
+
+// Each coding lists the fields of a syntax once. It's shared by encoder and decoder, where `syntax` is const for encoding.
+#define WCDBSyntaxCoding(Type)                                                 \
+    template<>                                                                 \
+    struct SyntaxCoding<Syntax::Type> {                                        \
+        template<typename Coder, typename Self>                                \
+        static void code(Coder& coder, Self& syntax);                          \
+    };                                                                         \
+    template<typename Coder, typename Self>                                    \
+    void SyntaxCoding<Syntax::Type>::code(Coder& coder, Self& syntax)
+
+#define WCDBForEachStatementSyntax(macro)                                      \
+    macro(AlterTableSTMT) macro(AnalyzeSTMT) macro(AttachSTMT) macro(BeginSTMT) \
+    macro(CommitSTMT) macro(RollbackSTMT) macro(SavepointSTMT)                 \
+    macro(ReleaseSTMT) macro(CreateIndexSTMT) macro(CreateTableSTMT)           \
+    macro(CreateTriggerSTMT) macro(SelectSTMT) macro(InsertSTMT)               \
+    macro(DeleteSTMT) macro(UpdateSTMT) macro(CreateViewSTMT)                  \
+    macro(CreateVirtualTableSTMT) macro(DetachSTMT) macro(DropIndexSTMT)       \
+    macro(DropTableSTMT) macro(DropTriggerSTMT) macro(DropViewSTMT)            \
+    macro(PragmaSTMT) macro(ReindexSTMT) macro(VacuumSTMT) macro(ExplainSTMT)
+
+// The max value of enum, which is checked before the decoded value is casted to it.
+template<typename T>
+struct SyntaxEnumMax;
+
+#define WCDBSyntaxEnumMax(Type, Last)                                          \
+    template<>                                                                 \
+    struct SyntaxEnumMax<Type> {                                               \
+        static constexpr const signed char value = (signed char) Type::Last;   \
+    };
+
+WCDBSyntaxEnumMax(Syntax::ColumnType, BLOB)
+WCDBSyntaxEnumMax(Syntax::CompoundOperator, Except)
+WCDBSyntaxEnumMax(Syntax::Conflict, Replace)
+WCDBSyntaxEnumMax(Syntax::JoinOperator, NaturalCrossJoin)
+WCDBSyntaxEnumMax(Syntax::Order, DESC)
+WCDBSyntaxEnumMax(Syntax::LimitParameterType, End)
+WCDBSyntaxEnumMax(Syntax::ConflictAction, Ignore)
+WCDBSyntaxEnumMax(Syntax::MatchType, Partial)
+WCDBSyntaxEnumMax(Syntax::AlterTableSTMT::Switch, AddColumn)
+WCDBSyntaxEnumMax(Syntax::AnalyzeSTMT::Switch, SchemaOrTableOrIndex)
+WCDBSyntaxEnumMax(Syntax::BeginSTMT::Switch, Exclusive)
+WCDBSyntaxEnumMax(Syntax::BindParameter::Switch, AtSign)
+WCDBSyntaxEnumMax(Syntax::ColumnConstraint::Switch, UnIndexed)
+WCDBSyntaxEnumMax(Syntax::CreateTableSTMT::Switch, Select)
+WCDBSyntaxEnumMax(Syntax::CreateTriggerSTMT::Timing, InsteadOf)
+WCDBSyntaxEnumMax(Syntax::CreateTriggerSTMT::Event, Update)
+WCDBSyntaxEnumMax(Syntax::CreateTriggerSTMT::STMT, Select)
+WCDBSyntaxEnumMax(Syntax::Expression::Switch, Select)
+WCDBSyntaxEnumMax(Syntax::Expression::UnaryOperator, Null)
+WCDBSyntaxEnumMax(Syntax::Expression::BinaryOperator, Match)
+WCDBSyntaxEnumMax(Syntax::Expression::SwitchIn, Function)
+WCDBSyntaxEnumMax(Syntax::ForeignKeyClause::Switch, OnUpdateNoAction)
+WCDBSyntaxEnumMax(Syntax::ForeignKeyClause::Deferrable, NotDeferrable)
+WCDBSyntaxEnumMax(Syntax::FrameSpec::Switch, Rows)
+WCDBSyntaxEnumMax(Syntax::FrameSpec::Event, Between)
+WCDBSyntaxEnumMax(Syntax::FrameSpec::FirstEvent, CurrentRow)
+WCDBSyntaxEnumMax(Syntax::FrameSpec::SecondEvent, CurrentRow)
+WCDBSyntaxEnumMax(Syntax::IndexedColumn::Switch, Expression)
+WCDBSyntaxEnumMax(Syntax::InsertSTMT::Switch, Default)
+WCDBSyntaxEnumMax(Syntax::LiteralValue::Switch, CurrentTimestamp)
+WCDBSyntaxEnumMax(Syntax::PragmaSTMT::Switch, With)
+WCDBSyntaxEnumMax(Syntax::QualifiedTableName::Switch, NotIndexed)
+WCDBSyntaxEnumMax(Syntax::RaiseFunction::Switch, Fail)
+WCDBSyntaxEnumMax(Syntax::ReindexSTMT::Switch, TableOrIndex)
+WCDBSyntaxEnumMax(Syntax::RollbackSTMT::Switch, Savepoint)
+WCDBSyntaxEnumMax(Syntax::SelectCore::Switch, Values)
+WCDBSyntaxEnumMax(Syntax::TableConstraint::Switch, ForeignKey)
+WCDBSyntaxEnumMax(Syntax::TableOrSubquery::Switch, Select)
+WCDBSyntaxEnumMax(Syntax::TableOrSubquery::IndexType, NotIndexed)
+WCDBSyntaxEnumMax(Syntax::UpsertClause::Switch, Update)
+WCDBSyntaxEnumMax(Syntax::VacuumSTMT::Switch, Schema)
+
+template<typename Coder, typename Self>
+bool codeStatementSyntax(Coder& coder, Self& syntax)
+{
+    switch (syntax.getType()) {
+#define WCDBCodeStatementSyntax(STMT)                                          \
+    case Syntax::Identifier::Type::STMT:                                       \
+        coder(static_cast<typename std::conditional<std::is_const<Self>::value, const Syntax::STMT, Syntax::STMT>::type&>( \
+        syntax));                                                              \
+        return true;
+        WCDBForEachStatementSyntax(WCDBCodeStatementSyntax)
+#undef WCDBCodeStatementSyntax
+    default:
+        return false;
+    }
+}
+
+std::shared_ptr<Syntax::Identifier> createStatementSyntax(Syntax::Identifier::Type type)
+{
+    switch (type) {
+#define WCDBCreateStatementSyntax(STMT)                                        \
+    case Syntax::Identifier::Type::STMT:                                       \
+        return std::make_shared<Syntax::STMT>();
+        WCDBForEachStatementSyntax(WCDBCreateStatementSyntax)
+#undef WCDBCreateStatementSyntax
+    default:
+        return nullptr;
+    }
+}
+
+#pragma mark - Encoder
+class SyntaxEncoder final {
+public:
+    SyntaxEncoder() : m_failed(false) {}
+
+    Data encode(const Syntax::Identifier& syntax)
+    {
+        encodeVarint(StatementEncoding::version);
+        encodeStatement(syntax);
+        return m_failed ? Data() : m_serialization.finalize();
+    }
+
+    void operator()(const bool& value) { encodeVarint(value ? 1 : 0); }
+
+    void operator()(const int& value) { encodeSigned(value); }
+
+    void operator()(const int64_t& value) { encodeSigned(value); }
+
+    void operator()(const uint64_t& value) { encodeVarint(value); }
+
+    void operator()(const double& value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if (!m_failed && !m_serialization.put8BytesUInt(bits)) {
+            m_failed = true;
+        }
+    }
+
+    void operator()(const StringView& value)
+    {
+        if (value.empty()) {
+            encodeVarint(0);
+            return;
+        }
+        auto iter = m_strings.find(value);
+        if (iter != m_strings.end()) {
+            encodeVarint(iter->second + 2);
+            return;
+        }
+        m_strings.emplace(value, m_strings.size());
+        encodeVarint(1);
+        if (!m_failed && !m_serialization.putSizedString(value)) {
+            m_failed = true;
+        }
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type operator()(const T& value)
+    {
+        static_assert(sizeof(T) == sizeof(unsigned char), "");
+        encodeVarint((unsigned char) (static_cast<signed char>(value) + 1));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_base_of<Syntax::Identifier, T>::value>::type
+    operator()(const T& syntax)
+    {
+        if (!m_failed) {
+            SyntaxCoding<T>::code(*this, syntax);
+        }
+    }
+
+    template<typename T>
+    void operator()(const std::list<T>& values)
+    {
+        encodeVarint(values.size());
+        for (const auto& value : values) {
+            (*this)(value);
+        }
+    }
+
+    template<typename T>
+    void operator()(const Optional<T>& value)
+    {
+        (*this)(value.hasValue());
+        if (value.hasValue()) {
+            (*this)(value.value());
+        }
+    }
+
+    template<typename T>
+    void operator()(const Shadow<T>& value)
+    {
+        (*this)(value != nullptr);
+        if (value != nullptr) {
+            (*this)(*value.get());
+        }
+    }
+
+    void operator()(const Shadow<Syntax::Identifier>& value)
+    {
+        (*this)(value != nullptr);
+        if (value != nullptr) {
+            encodeStatement(*value.get());
+        }
+    }
+
+private:
+    void encodeStatement(const Syntax::Identifier& syntax)
+    {
+        encodeVarint((uint64_t) syntax.getType());
+        if (!codeStatementSyntax(*this, syntax)) {
+            m_failed = true;
+        }
+    }
+
+    void encodeVarint(uint64_t value)
+    {
+        if (!m_failed && m_serialization.putVarint(value) == 0) {
+            m_failed = true;
+        }
+    }
+
+    void encodeSigned(int64_t value)
+    {
+        encodeVarint(((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+    }
+
+    struct StringComparator {
+        bool operator()(const UnsafeStringView& lhs, const UnsafeStringView& rhs) const
+        {
+            int result
+            = memcmp(lhs.data(), rhs.data(), std::min(lhs.length(), rhs.length()));
+            return result < 0 || (result == 0 && lhs.length() < rhs.length());
+        }
+    };
+
+    Serialization m_serialization;
+    // Strings in a syntax may contain '\0', so they are compared by bytes.
+    std::map<UnsafeStringView, uint64_t, StringComparator> m_strings;
+    bool m_failed;
+};
+
+#pragma mark - Decoder
+class SyntaxDecoder final {
+public:
+    SyntaxDecoder(const UnsafeData& data)
+    : m_deserialization(data), m_depth(0), m_failed(false)
+    {
+    }
+
+    std::shared_ptr<Syntax::Identifier> decode()
+    {
+        if (decodeVarint() != StatementEncoding::version) {
+            return nullptr;
+        }
+        std::shared_ptr<Syntax::Identifier> syntax = decodeStatement();
+        if (m_failed || !m_deserialization.ended()) {
+            return nullptr;
+        }
+        return syntax;
+    }
+
+    void operator()(bool& value) { value = decodeVarint() != 0; }
+
+    void operator()(int& value) { value = (int) decodeSigned(); }
+
+    void operator()(int64_t& value) { value = decodeSigned(); }
+
+    void operator()(uint64_t& value) { value = decodeVarint(); }
+
+    void operator()(double& value)
+    {
+        if (m_failed || !m_deserialization.canAdvance(sizeof(double))) {
+            m_failed = true;
+            return;
+        }
+        value = m_deserialization.advance8BytesDouble();
+    }
+
+    void operator()(StringView& value)
+    {
+        uint64_t tag = decodeVarint();
+        if (m_failed || tag == 0) {
+            value = StringView();
+        } else if (tag == 1) {
+            auto string = m_deserialization.advanceSizedString();
+            if (string.first == 0) {
+                m_failed = true;
+                return;
+            }
+            m_strings.push_back(string.second);
+            value = std::move(string.second);
+        } else if (tag - 2 < m_strings.size()) {
+            value = m_strings[(size_t) (tag - 2)];
+        } else {
+            m_failed = true;
+        }
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type operator()(T& value)
+    {
+        static_assert(sizeof(T) == sizeof(unsigned char), "");
+        uint64_t encoded = decodeVarint();
+        // -1 is the value of an enum not set in union, and 0 is the value of an enum not set at all.
+        if (m_failed || encoded > (uint64_t) (SyntaxEnumMax<T>::value + 1)) {
+            m_failed = true;
+            return;
+        }
+        value = static_cast<T>((signed char) (encoded - 1));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_base_of<Syntax::Identifier, T>::value>::type
+    operator()(T& syntax)
+    {
+        if (++m_depth > maxDepth) {
+            m_failed = true;
+        }
+        if (!m_failed) {
+            SyntaxCoding<T>::code(*this, syntax);
+        }
+        --m_depth;
+    }
+
+    template<typename T>
+    void operator()(std::list<T>& values)
+    {
+        values.clear();
+        uint64_t count = decodeVarint();
+        // Each element takes at least one byte.
+        if (m_failed || !m_deserialization.canAdvance((size_t) count)) {
+            m_failed = true;
+            return;
+        }
+        for (uint64_t i = 0; i < count && !m_failed; ++i) {
+            values.emplace_back();
+            (*this)(values.back());
+        }
+    }
+
+    template<typename T>
+    void operator()(Optional<T>& value)
+    {
+        bool hasValue = false;
+        (*this)(hasValue);
+        if (hasValue) {
+            (*this)(value.getOrCreate());
+        } else {
+            value = NullOpt;
+        }
+    }
+
+    template<typename T>
+    void operator()(Shadow<T>& value)
+    {
+        bool hasValue = false;
+        (*this)(hasValue);
+        if (hasValue) {
+            std::shared_ptr<T> syntax = std::make_shared<T>();
+            (*this)(*syntax);
+            value = Shadow<T>(std::move(syntax));
+        } else {
+            value = nullptr;
+        }
+    }
+
+    void operator()(Shadow<Syntax::Identifier>& value)
+    {
+        bool hasValue = false;
+        (*this)(hasValue);
+        if (hasValue) {
+            value = Shadow<Syntax::Identifier>(decodeStatement());
+        } else {
+            value = nullptr;
+        }
+    }
+
+private:
+    // Guard against the stack overflow caused by a malformed input.
+    static constexpr const int maxDepth = 1000;
+
+    std::shared_ptr<Syntax::Identifier> decodeStatement()
+    {
+        uint64_t type = decodeVarint();
+        std::shared_ptr<Syntax::Identifier> syntax;
+        if (!m_failed && type <= std::numeric_limits<signed char>::max()) {
+            syntax = createStatementSyntax((Syntax::Identifier::Type) type);
+        }
+        if (syntax == nullptr || !codeStatementSyntax(*this, *syntax)) {
+            m_failed = true;
+            return nullptr;
+        }
+        return syntax;
+    }
+
+    uint64_t decodeVarint()
+    {
+        if (m_failed) {
+            return 0;
+        }
+        auto varint = m_deserialization.advanceVarint();
+        if (varint.first == 0) {
+            m_failed = true;
+            return 0;
+        }
+        return varint.second;
+    }
+
+    int64_t decodeSigned()
+    {
+        uint64_t value = decodeVarint();
+        return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+    }
+
+    Deserialization m_deserialization;
+    std::vector<StringView> m_strings;
+    int m_depth;
+    bool m_failed;
+};
+
+#pragma mark - Identifier
+WCDBSyntaxCoding(BindParameter)
+{
+    coder(syntax.switcher);
+    if (syntax.switcher == Syntax::BindParameter::Switch::QuestionSign) {
+        coder(syntax.n);
+    } else {
+        coder(syntax.name);
+    }
+}
+
+WCDBSyntaxCoding(Schema)
+{
+    coder(syntax.name);
+}
+
+WCDBSyntaxCoding(Column)
+{
+    coder(syntax.schema);
+    coder(syntax.table);
+    coder(syntax.wildcard);
+    coder(syntax.name);
+}
+
+WCDBSyntaxCoding(LiteralValue)
+{
+    coder(syntax.switcher);
+    switch (syntax.switcher) {
+    case Syntax::LiteralValue::Switch::StringView:
+        coder(syntax.stringValue);
+        break;
+    case Syntax::LiteralValue::Switch::Float:
+        coder(syntax.floatValue);
+        break;
+    case Syntax::LiteralValue::Switch::Integer:
+        coder(syntax.integerValue);
+        break;
+    case Syntax::LiteralValue::Switch::UnsignedInteger:
+        coder(syntax.unsignedIntegerValue);
+        break;
+    case Syntax::LiteralValue::Switch::Bool:
+        coder(syntax.boolValue);
+        break;
+    default:
+        break;
+    }
+}
+
+WCDBSyntaxCoding(RaiseFunction)
+{
+    coder(syntax.switcher);
+    coder(syntax.errorMessage);
+}
+
+WCDBSyntaxCoding(Filter)
+{
+    coder(syntax.expression);
+}
+
+WCDBSyntaxCoding(FrameSpec)
+{
+    coder(syntax.switcher);
+    coder(syntax.event);
+    coder(syntax.firstEvent);
+    coder(syntax.secondEvent);
+    coder(syntax.between);
+    coder(syntax.expression1);
+    coder(syntax.expression2);
+}
+
+WCDBSyntaxCoding(OrderingTerm)
+{
+    coder(syntax.expression);
+    coder(syntax.collation);
+    coder(syntax.order);
+}
+
+WCDBSyntaxCoding(WindowDef)
+{
+    coder(syntax.expressions);
+    coder(syntax.orderingTerms);
+    coder(syntax.frameSpec);
+}
+
+WCDBSyntaxCoding(Expression)
+{
+    using Switch = Syntax::Expression::Switch;
+    using SwitchIn = Syntax::Expression::SwitchIn;
+    coder(syntax.switcher);
+    coder(syntax.expressions);
+    coder(syntax.isNot);
+    switch (syntax.switcher) {
+    case Switch::LiteralValue:
+        coder(syntax.literalValue());
+        break;
+    case Switch::BindParameter:
+        coder(syntax.bindParameter());
+        break;
+    case Switch::Column:
+        coder(syntax.column());
+        break;
+    case Switch::UnaryOperation:
+        coder(syntax.unaryOperator);
+        break;
+    case Switch::BinaryOperation:
+        coder(syntax.binaryOperator);
+        coder(syntax.escape);
+        break;
+    case Switch::Function:
+        coder(syntax.function());
+        coder(syntax.distinct);
+        coder(syntax.useWildcard);
+        break;
+    case Switch::Cast:
+        coder(syntax.castType);
+        break;
+    case Switch::Collate:
+        coder(syntax.collation());
+        break;
+    case Switch::In:
+        coder(syntax.inSwitcher);
+        switch (syntax.inSwitcher) {
+        case SwitchIn::Select:
+            coder(syntax.select());
+            break;
+        case SwitchIn::Table:
+            coder(syntax.schema());
+            coder(syntax.table());
+            break;
+        case SwitchIn::Function:
+            coder(syntax.schema());
+            coder(syntax.function());
+            break;
+        default:
+            break;
+        }
+        break;
+    case Switch::Exists:
+    case Switch::Select:
+        coder(syntax.select());
+        break;
+    case Switch::Case:
+        coder(syntax.hasCase);
+        coder(syntax.hasElse);
+        break;
+    case Switch::RaiseFunction:
+        coder(syntax.raiseFunction());
+        break;
+    case Switch::Window: {
+        coder(syntax.function());
+        coder(syntax.useWildcard);
+        coder(syntax.filter());
+        // 1 for window definition and 2 for window name.
+        int over = syntax.isWindowDefSet() ? 1 : (syntax.isWindowNameSet() ? 2 : 0);
+        coder(over);
+        if (over == 1) {
+            coder(syntax.windowDef());
+        } else if (over == 2) {
+            coder(syntax.windowName());
+        }
+    } break;
+    default:
+        break;
+    }
+}
+
+WCDBSyntaxCoding(ForeignKeyClause)
+{
+    coder(syntax.foreignTable);
+    coder(syntax.columns);
+    coder(syntax.switchers);
+    coder(syntax.matchType);
+    coder(syntax.deferrable);
+}
+
+WCDBSyntaxCoding(ColumnConstraint)
+{
+    coder(syntax.name);
+    coder(syntax.switcher);
+    coder(syntax.order);
+    coder(syntax.conflict);
+    coder(syntax.collation);
+    coder(syntax.autoIncrement);
+    coder(syntax.expression);
+    coder(syntax.foreignKeyClause);
+}
+
+WCDBSyntaxCoding(ColumnDef)
+{
+    coder(syntax.column);
+    coder(syntax.columnType);
+    coder(syntax.constraints);
+}
+
+WCDBSyntaxCoding(IndexedColumn)
+{
+    coder(syntax.switcher);
+    coder(syntax.column);
+    coder(syntax.expression);
+    coder(syntax.collation);
+    coder(syntax.order);
+}
+
+WCDBSyntaxCoding(TableConstraint)
+{
+    coder(syntax.name);
+    coder(syntax.switcher);
+    coder(syntax.indexedColumns);
+    coder(syntax.conflict);
+    coder(syntax.expression);
+    coder(syntax.columns);
+    coder(syntax.foreignKeyClause);
+}
+
+WCDBSyntaxCoding(CommonTableExpression)
+{
+    coder(syntax.table);
+    coder(syntax.columns);
+    coder(syntax.select);
+}
+
+WCDBSyntaxCoding(QualifiedTableName)
+{
+    coder(syntax.schema);
+    coder(syntax.table);
+    coder(syntax.alias);
+    coder(syntax.switcher);
+    coder(syntax.index);
+}
+
+WCDBSyntaxCoding(UpsertClause)
+{
+    coder(syntax.indexedColumns);
+    coder(syntax.condition);
+    coder(syntax.switcher);
+    coder(syntax.columnsList);
+    coder(syntax.expressions);
+    coder(syntax.updateCondition);
+}
+
+WCDBSyntaxCoding(Pragma)
+{
+    coder(syntax.name);
+}
+
+WCDBSyntaxCoding(JoinConstraint)
+{
+    coder(syntax.expression);
+    coder(syntax.columns);
+}
+
+WCDBSyntaxCoding(TableOrSubquery)
+{
+    coder(syntax.switcher);
+    coder(syntax.schema);
+    coder(syntax.tableOrFunction);
+    coder(syntax.alias);
+    coder(syntax.indexType);
+    coder(syntax.index);
+    coder(syntax.expressions);
+    coder(syntax.tableOrSubqueries);
+    coder(syntax.joinClause);
+    coder(syntax.select);
+}
+
+WCDBSyntaxCoding(JoinClause)
+{
+    coder(syntax.joinOperators);
+    coder(syntax.tableOrSubqueries);
+    coder(syntax.joinConstraints);
+}
+
+WCDBSyntaxCoding(ResultColumn)
+{
+    coder(syntax.expression);
+    coder(syntax.alias);
+}
+
+WCDBSyntaxCoding(SelectCore)
+{
+    coder(syntax.switcher);
+    coder(syntax.distinct);
+    coder(syntax.resultColumns);
+    coder(syntax.tableOrSubqueries);
+    coder(syntax.joinClause);
+    coder(syntax.condition);
+    coder(syntax.groups);
+    coder(syntax.having);
+    coder(syntax.windows);
+    coder(syntax.windowDefs);
+    coder(syntax.valuesList);
+}
+
+#pragma mark - Statement
+WCDBSyntaxCoding(AlterTableSTMT)
+{
+    coder(syntax.schema);
+    coder(syntax.table);
+    coder(syntax.switcher);
+    coder(syntax.newTable);
+    coder(syntax.column);
+    coder(syntax.newColumn);
+    coder(syntax.columnDef);
+}
+
+WCDBSyntaxCoding(AnalyzeSTMT)
+{
+    coder(syntax.switcher);
+    coder(syntax.schema);
+    coder(syntax.tableOrIndex);
+}
+
+WCDBSyntaxCoding(AttachSTMT)
+{
+    coder(syntax.expression);
+    coder(syntax.schema);
+    coder(syntax.key);
+}
+
+WCDBSyntaxCoding(BeginSTMT)
+{
+    coder(syntax.switcher);
+}
+
+WCDBSyntaxCoding(CommitSTMT)
+{
+    coder(syntax.inited);
+}
+
+WCDBSyntaxCoding(RollbackSTMT)
+{
+    coder(syntax.switcher);
+    coder(syntax.savepoint);
+}
+
+WCDBSyntaxCoding(SavepointSTMT)
+{
+    coder(syntax.savepoint);
+}
+
+WCDBSyntaxCoding(ReleaseSTMT)
+{
+    coder(syntax.savepoint);
+}
+
+WCDBSyntaxCoding(CreateIndexSTMT)
+{
+    coder(syntax.unique);
+    coder(syntax.ifNotExists);
+    coder(syntax.schema);
+    coder(syntax.index);
+    coder(syntax.table);
+    coder(syntax.indexedColumns);
+    coder(syntax.condition);
+}
+
+WCDBSyntaxCoding(CreateTableSTMT)
+{
+    coder(syntax.temp);
+    coder(syntax.ifNotExists);
+    coder(syntax.schema);
+    coder(syntax.table);
+    coder(syntax.switcher);
+    coder(syntax.columnDefs);
+    coder(syntax.tableConstraints);
+    coder(syntax.withoutRowid);
+    coder(syntax.select);
+}
+
+WCDBSyntaxCoding(SelectSTMT)
+{
+    coder(syntax.recursive);
+    coder(syntax.commonTableExpressions);
+    coder(syntax.select);
+    coder(syntax.cores);
+    coder(syntax.compoundOperators);
+    coder(syntax.orderingTerms);
+    coder(syntax.limit);
+    coder(syntax.limitParameterType);
+    coder(syntax.limitParameter);
+}
+
+WCDBSyntaxCoding(InsertSTMT)
+{
+    coder(syntax.recursive);
+    coder(syntax.commonTableExpressions);
+    coder(syntax.conflictAction);
+    coder(syntax.schema);
+    coder(syntax.table);
+    coder(syntax.alias);
+    coder(syntax.columns);
+    coder(syntax.switcher);
+    coder(syntax.expressionsValues);
+    coder(syntax.select);
+    coder(syntax.upsertClause);
+}
+
+WCDBSyntaxCoding(DeleteSTMT)
+{
+    coder(syntax.recursive);
+    coder(syntax.commonTableExpressions);
+    coder(syntax.table);
+    coder(syntax.condition);
+    coder(syntax.orderingTerms);
+    coder(syntax.limit);
+    coder(syntax.limitParameterType);
+    coder(syntax.limitParameter);
+}
+
+WCDBSyntaxCoding(UpdateSTMT)
+{
+    coder(syntax.recursive);
+    coder(syntax.commonTableExpressions);
+    coder(syntax.conflictAction);
+    coder(syntax.table);
+    coder(syntax.columnsList);
+    coder(syntax.expressions);
+    coder(syntax.condition);
+    coder(syntax.orderingTerms);
+    coder(syntax.limit);
+    coder(syntax.limitParameterType);
+    coder(syntax.limitParameter);
+}
+
+WCDBSyntaxCoding(CreateTriggerSTMT)
+{
+    coder(syntax.temp);
+    coder(syntax.ifNotExists);
+    coder(syntax.schema);
+    coder(syntax.trigger);
+    coder(syntax.timing);
+    coder(syntax.specifiedTiming);
+    coder(syntax.event);
+    coder(syntax.columns);
+    coder(syntax.table);
+    coder(syntax.forEachFow);
+    coder(syntax.condition);
+    coder(syntax.stmts);
+    coder(syntax.inserts);
+    coder(syntax.selects);
+    coder(syntax.updates);
+    coder(syntax.deletes);
+}
+
+WCDBSyntaxCoding(CreateViewSTMT)
+{
+    coder(syntax.temp);
+    coder(syntax.ifNotExists);
+    coder(syntax.schema);
+    coder(syntax.view);
+    coder(syntax.columns);
+    coder(syntax.select);
+}
+
+WCDBSyntaxCoding(CreateVirtualTableSTMT)
+{
+    coder(syntax.ifNotExists);
+    coder(syntax.schema);
+    coder(syntax.table);
+    coder(syntax.module);
+    coder(syntax.arguments);
+}
+
+WCDBSyntaxCoding(DetachSTMT)
+{
+    coder(syntax.schema);
+}
+
+WCDBSyntaxCoding(DropIndexSTMT)
+{
+    coder(syntax.ifExists);
+    coder(syntax.schema);
+    coder(syntax.index);
+}
+
+WCDBSyntaxCoding(DropTableSTMT)
+{
+    coder(syntax.ifExists);
+    coder(syntax.schema);
+    coder(syntax.table);
+}
+
+WCDBSyntaxCoding(DropTriggerSTMT)
+{
+    coder(syntax.ifExists);
+    coder(syntax.schema);
+    coder(syntax.trigger);
+}
+
+WCDBSyntaxCoding(DropViewSTMT)
+{
+    coder(syntax.ifExists);
+    coder(syntax.schema);
+    coder(syntax.view);
+}
+
+WCDBSyntaxCoding(PragmaSTMT)
+{
+    coder(syntax.schema);
+    coder(syntax.pragma);
+    coder(syntax.switcher);
+    coder(syntax.value);
+}
+
+WCDBSyntaxCoding(ReindexSTMT)
+{
+    coder(syntax.switcher);
+    coder(syntax.collationOrTableOrIndex);
+    coder(syntax.schema);
+}
+
+WCDBSyntaxCoding(VacuumSTMT)
+{
+    coder(syntax.switcher);
+    coder(syntax.schema);
+}
+
+WCDBSyntaxCoding(ExplainSTMT)
+{
+    coder(syntax.queryPlan);
+    coder(syntax.stmt);
+}
+
+#undef WCDBSyntaxCoding
+#undef WCDBForEachStatementSyntax
+
+} // namespace
+
+Data StatementEncoding::encode(const Statement& statement)
+{
+    SyntaxEncoder encoder;
+    return encoder.encode(statement.syntax());
+}
+
+Optional<Statement> StatementEncoding::decode(const UnsafeData& data)
+{
+    SyntaxDecoder decoder(data);
+    std::shared_ptr<Syntax::Identifier> syntax = decoder.decode();
+    if (syntax == nullptr) {
+        return NullOpt;
+    }
+    return Statement(std::move(syntax));
+}
+
+bool StatementEncoding::Comparator::operator()(const UnsafeData& lhs,
+                                               const UnsafeData& rhs) const
+{
+    int result = memcmp(lhs.buffer(), rhs.buffer(), std::min(lhs.size(), rhs.size()));
+    return result < 0 || (result == 0 && lhs.size() < rhs.size());
+}
+
+} // namespace WCDB
@@ -0,0 +1,64 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Data.hpp"
+#include "Statement.hpp"
+#include "WCDBOptional.hpp"
+
+namespace WCDB {
+
+/*
+ A compact binary form of statements, so that a language binding can build a whole statement into one buffer and hand it to the core in a single call.
+
+ Layout: varint version, varint `Syntax::Identifier::Type` of the statement, then the fields of the syntax in declaration order. Nested syntaxes are encoded inline without their types, except the statement of EXPLAIN, which is prefixed by its type.
+ - bool: varint 0 or 1.
+ - enum: varint of the byte `value + 1`, so that an unset enum, whose value is -1, is encoded as 0.
+ - signed integer: zigzag varint. unsigned integer: varint. double: 8 bytes big endian IEEE 754.
+ - string: varint 0 for an empty string, varint 1 followed by a sized string for the first occurrence of a string, or varint `n + 2` to refer to the n-th string that has occurred.
+ - list: varint count followed by the elements.
+ - optional or nullable field: bool followed by the value if it exists.
+ */
+class WCDB_API StatementEncoding final {
+public:
+    StatementEncoding() = delete;
+    StatementEncoding(const StatementEncoding&) = delete;
+    StatementEncoding& operator=(const StatementEncoding&) = delete;
+
+    static constexpr const uint32_t version = 1;
+
+    // Empty data is returned if the statement can't be encoded.
+    static Data encode(const Statement& statement);
+    static Optional<Statement> decode(const UnsafeData& data);
+
+    // Orders encoded statements by their bytes.
+    struct Comparator {
+        using is_transparent = std::true_type;
+        bool operator()(const UnsafeData& lhs, const UnsafeData& rhs) const;
+    };
+};
+
+} // namespace WCDB
@@ -27,6 +27,19 @@
 
 namespace WCDB {
 
+#pragma mark - Row-scoped View
+TextView::TextView() = default;
+
+TextView::TextView(const UnsafeStringView &text) : UnsafeStringView(text)
+{
+}
+
+BLOBView::BLOBView() = default;
+
+BLOBView::BLOBView(const UnsafeData &blob) : UnsafeData(blob)
+{
+}
+
 #pragma mark - Builtin Type
 //Text
 ColumnTypeInfo<ColumnType::Text>::UnderlyingType
@@ -95,6 +108,18 @@ StringView &target, const ColumnTypeInfo<ColumnType::Text>::UnderlyingType &t)
     target = t;
 }
 
+ColumnTypeInfo<ColumnType::Text>::UnderlyingType
+ColumnIsTextType<TextView>::asUnderlyingType(const TextView &text)
+{
+    return text;
+}
+
+void ColumnIsTextType<TextView>::setToUnderlyingType(
+TextView &target, const ColumnTypeInfo<ColumnType::Text>::UnderlyingType &t)
+{
+    target = t;
+}
+
 //BLOB
 ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType
 ColumnIsBLOBType<std::vector<unsigned char>>::asUnderlyingType(const std::vector<unsigned char> &blob)
@@ -133,4 +158,16 @@ Data &target, const ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType &t)
     target = t;
 }
 
+ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType
+ColumnIsBLOBType<BLOBView>::asUnderlyingType(const BLOBView &blob)
+{
+    return blob;
+}
+
+void ColumnIsBLOBType<BLOBView>::setToUnderlyingType(
+BLOBView &target, const ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType &t)
+{
+    target = t;
+}
+
 } //namespace WCDB
@@ -36,6 +36,39 @@ namespace WCDB {
 
 typedef Syntax::ColumnType ColumnType;
 
+#pragma mark - Row-scoped View
+/*
+ Text and BLOB members declared as TextView/BLOBView are extracted without copying.
+ They point to the column memory of the statement directly,
+ so they are only valid until the next step/reset/finalize of that statement.
+ */
+class WCDB_API TextView final : public UnsafeStringView {
+public:
+    using UnsafeStringView::UnsafeStringView;
+    TextView();
+    TextView(const UnsafeStringView &text);
+};
+
+class WCDB_API BLOBView final : public UnsafeData {
+public:
+    using UnsafeData::UnsafeData;
+    BLOBView();
+    BLOBView(const UnsafeData &blob);
+};
+
+// Objects with row-scoped members can only be extracted row by row.
+template<typename T>
+struct ColumnIsRowScopedType : public std::false_type {
+};
+
+template<>
+struct ColumnIsRowScopedType<TextView> : public std::true_type {
+};
+
+template<>
+struct ColumnIsRowScopedType<BLOBView> : public std::true_type {
+};
+
 #pragma mark - Column Type Info
 //Null
 template<ColumnType T = ColumnType::Null>
@@ -260,6 +293,16 @@ public:
                         const ColumnTypeInfo<ColumnType::Text>::UnderlyingType &t);
 };
 
+template<>
+struct WCDB_API ColumnIsTextType<TextView> : public std::true_type {
+public:
+    static ColumnTypeInfo<ColumnType::Text>::UnderlyingType
+    asUnderlyingType(const TextView &text);
+    static void
+    setToUnderlyingType(TextView &target,
+                        const ColumnTypeInfo<ColumnType::Text>::UnderlyingType &t);
+};
+
 //BLOB
 template<>
 struct WCDB_API ColumnIsBLOBType<std::vector<unsigned char>> : public std::true_type {
@@ -291,6 +334,16 @@ public:
                         const ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType &t);
 };
 
+template<>
+struct WCDB_API ColumnIsBLOBType<BLOBView> : public std::true_type {
+public:
+    static ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType
+    asUnderlyingType(const BLOBView &blob);
+    static void
+    setToUnderlyingType(BLOBView &target,
+                        const ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType &t);
+};
+
 template<int size>
 struct ColumnIsBLOBType<const unsigned char[size]> : public std::true_type {
 public:
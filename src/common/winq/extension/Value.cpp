@@ -22,6 +22,7 @@
  * limitations under the License.
  */
 
+#include "Assertion.hpp"
 #include "Value.hpp"
 #include <cstring>
 #include <math.h>
@@ -311,4 +312,148 @@ bool Value::isEmpty() const
     }
 }
 
+#pragma mark - ValueView
+ValueView::ValueView()
+: m_type(Type::Null)
+, m_intValue(0)
+, m_buffer(nullptr)
+, m_size(0)
+, m_rowScoped(false)
+, m_generation(0)
+{
+}
+
+ValueView::ValueView(int64_t value, const RowGeneration &rowGeneration)
+: m_type(Type::Integer)
+, m_intValue(value)
+, m_buffer(nullptr)
+, m_size(0)
+, m_rowScoped(rowGeneration != nullptr)
+, m_rowGeneration(rowGeneration)
+, m_generation(rowGeneration != nullptr ? *rowGeneration : 0)
+{
+}
+
+ValueView::ValueView(double value, const RowGeneration &rowGeneration)
+: m_type(Type::Float)
+, m_floatValue(value)
+, m_buffer(nullptr)
+, m_size(0)
+, m_rowScoped(rowGeneration != nullptr)
+, m_rowGeneration(rowGeneration)
+, m_generation(rowGeneration != nullptr ? *rowGeneration : 0)
+{
+}
+
+ValueView::ValueView(const UnsafeStringView &value, const RowGeneration &rowGeneration)
+: m_type(Type::Text)
+, m_intValue(0)
+, m_buffer(value.data())
+, m_size(value.length())
+, m_rowScoped(rowGeneration != nullptr)
+, m_rowGeneration(rowGeneration)
+, m_generation(rowGeneration != nullptr ? *rowGeneration : 0)
+{
+}
+
+ValueView::ValueView(const UnsafeData &value, const RowGeneration &rowGeneration)
+: m_type(Type::BLOB)
+, m_intValue(0)
+, m_buffer(value.buffer())
+, m_size(value.size())
+, m_rowScoped(rowGeneration != nullptr)
+, m_rowGeneration(rowGeneration)
+, m_generation(rowGeneration != nullptr ? *rowGeneration : 0)
+{
+}
+
+ValueView::Type ValueView::getType() const
+{
+    return m_type;
+}
+
+int64_t ValueView::intValue() const
+{
+    switch (m_type) {
+    case Type::Integer:
+        return m_intValue;
+    case Type::Float:
+        return (int64_t) m_floatValue;
+    case Type::Text:
+        WCTAssert(!isExpired());
+        return atoll((const char *) m_buffer);
+    default:
+        return 0;
+    }
+}
+
+double ValueView::floatValue() const
+{
+    switch (m_type) {
+    case Type::Integer:
+        return (double) m_intValue;
+    case Type::Float:
+        return m_floatValue;
+    case Type::Text:
+        WCTAssert(!isExpired());
+        return atof((const char *) m_buffer);
+    default:
+        return 0;
+    }
+}
+
+TextView ValueView::textValue() const
+{
+    switch (m_type) {
+    case Type::Text:
+    case Type::BLOB:
+        WCTAssert(!isExpired());
+        return TextView((const char *) m_buffer, m_size);
+    default:
+        return TextView();
+    }
+}
+
+BLOBView ValueView::blobValue() const
+{
+    switch (m_type) {
+    case Type::Text:
+    case Type::BLOB:
+        WCTAssert(!isExpired());
+        return UnsafeData::immutable((const unsigned char *) m_buffer, m_size);
+    default:
+        return BLOBView();
+    }
+}
+
+bool ValueView::isNull() const
+{
+    return m_type == Type::Null;
+}
+
+Value ValueView::toValue() const
+{
+    switch (m_type) {
+    case Type::Integer:
+        return Value(m_intValue);
+    case Type::Float:
+        return Value(m_floatValue);
+    case Type::Text:
+        return Value(textValue());
+    case Type::BLOB:
+        return Value(blobValue());
+    case Type::Null:
+        return Value(nullptr);
+    }
+}
+
+bool ValueView::isExpired() const
+{
+    if (!m_rowScoped) {
+        return false;
+    }
+    auto rowGeneration = m_rowGeneration.lock();
+    return rowGeneration == nullptr || *rowGeneration != m_generation;
+}
+
 } // namespace WCDB
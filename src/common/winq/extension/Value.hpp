@@ -304,6 +304,53 @@ typedef ValueArray<ValueArray<Value>> MultiRowsValue;
 template<typename ValueType>
 using OptionalValueArray = Optional<ValueArray<ValueType>>;
 
+/*
+ ValueView is the row-scoped and non-owning counterpart of Value.
+ Its text and BLOB point to the column memory of the statement directly,
+ so they are only valid until the next step/reset/finalize of that statement.
+ Copy it to Value with `toValue()` if it should be kept longer.
+ */
+class WCDB_API ValueView final {
+public:
+    ValueView();
+    // The row generation is owned by the statement, so that the view outliving the statement can be detected.
+    typedef std::shared_ptr<const uint64_t> RowGeneration;
+    ValueView(int64_t value, const RowGeneration& rowGeneration = nullptr);
+    ValueView(double value, const RowGeneration& rowGeneration = nullptr);
+    ValueView(const UnsafeStringView& value, const RowGeneration& rowGeneration = nullptr);
+    ValueView(const UnsafeData& value, const RowGeneration& rowGeneration = nullptr);
+
+    using Type = ColumnType;
+    Type getType() const;
+
+    int64_t intValue() const;
+    double floatValue() const;
+    TextView textValue() const;
+    BLOBView blobValue() const;
+    bool isNull() const;
+
+    Value toValue() const;
+
+    // Whether the row it comes from has been stepped over or the statement has been released.
+    // It's always false for the view not comes from a statement.
+    bool isExpired() const;
+
+private:
+    Type m_type;
+    union {
+        int64_t m_intValue;
+        double m_floatValue;
+    };
+    const void* m_buffer;
+    size_t m_size;
+
+    bool m_rowScoped;
+    std::weak_ptr<const uint64_t> m_rowGeneration;
+    uint64_t m_generation;
+};
+
+typedef std::vector<ValueView> OneRowValueView;
+
 typedef Optional<Value> OptionalValue;
 typedef OptionalValueArray<Value> OptionalOneRow;
 typedef OptionalValueArray<Value> OptionalOneColumn;
@@ -300,6 +300,16 @@ WCDB_SYNTAX_UNION_MEMBER_IMPLEMENT(ExpressionUnionMember, secondMember, Filter,
 WCDB_SYNTAX_UNION_MEMBER_IMPLEMENT(ExpressionUnionMember, thirdMember, StringView, table)
 WCDB_SYNTAX_UNION_MEMBER_IMPLEMENT(ExpressionUnionMember, thirdMember, StringView, function)
 
+bool ExpressionUnionMember::isWindowDefSet() const
+{
+    return m_firstMember == Member::windowDef;
+}
+
+bool ExpressionUnionMember::isWindowNameSet() const
+{
+    return m_firstMember == Member::windowName;
+}
+
 #pragma mark - Identifier
 Expression::~Expression() = default;
 
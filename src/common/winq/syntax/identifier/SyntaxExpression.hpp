@@ -73,6 +73,10 @@ public:
     const StringView& windowName() const;
     const StringView& function() const;
 
+    // Whether the window of a window function is specified by `windowDef` or `windowName`.
+    bool isWindowDefSet() const;
+    bool isWindowNameSet() const;
+
 protected:
     enum class Member : signed char {
         Invalid = 0,
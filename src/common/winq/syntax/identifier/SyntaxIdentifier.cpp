@@ -23,6 +23,7 @@
  */
 
 #include "Syntax.h"
+#include "PoolAllocator.hpp"
 #include "SyntaxAssertion.hpp"
 
 namespace WCDB {
@@ -84,115 +85,120 @@ void Identifier::iterate(const Iterator &iterator, bool &stop)
     }
 }
 
+// Syntax trees are cloned on every copy-on-write, so their roots are recycled by the pool.
+// The children are copied by their own containers with the global allocator.
+template<typename T>
+static std::shared_ptr<Identifier> cloneIdentifier(const Identifier *identifier)
+{
+    // Leave room for the control block allocated together.
+    static_assert(sizeof(T) + 64 <= PoolMemory::maxPooledSize,
+                  "The syntax node is too large to be pooled.");
+    return std::allocate_shared<T>(PoolAllocator<T>(), *static_cast<const T *>(identifier));
+}
+
 std::shared_ptr<Identifier> Identifier::clone() const
 {
     switch (getType()) {
     case Type::Column:
-        return std::make_shared<Column>(*static_cast<const Column *>(this));
+        return cloneIdentifier<Column>(this);
     case Type::Schema:
-        return std::make_shared<Schema>(*static_cast<const Schema *>(this));
+        return cloneIdentifier<Schema>(this);
     case Type::ColumnDef:
-        return std::make_shared<ColumnDef>(*static_cast<const ColumnDef *>(this));
+        return cloneIdentifier<ColumnDef>(this);
     case Type::ColumnConstraint:
-        return std::make_shared<ColumnConstraint>(
-        *static_cast<const ColumnConstraint *>(this));
+        return cloneIdentifier<ColumnConstraint>(this);
     case Type::Expression:
-        return std::make_shared<Expression>(*static_cast<const Expression *>(this));
+        return cloneIdentifier<Expression>(this);
     case Type::LiteralValue:
-        return std::make_shared<LiteralValue>(*static_cast<const LiteralValue *>(this));
+        return cloneIdentifier<LiteralValue>(this);
     case Type::ForeignKeyClause:
-        return std::make_shared<ForeignKeyClause>(
-        *static_cast<const ForeignKeyClause *>(this));
+        return cloneIdentifier<ForeignKeyClause>(this);
     case Type::BindParameter:
-        return std::make_shared<BindParameter>(*static_cast<const BindParameter *>(this));
+        return cloneIdentifier<BindParameter>(this);
     case Type::RaiseFunction:
-        return std::make_shared<RaiseFunction>(*static_cast<const RaiseFunction *>(this));
+        return cloneIdentifier<RaiseFunction>(this);
     case Type::WindowDef:
-        return std::make_shared<WindowDef>(*static_cast<const WindowDef *>(this));
+        return cloneIdentifier<WindowDef>(this);
     case Type::Filter:
-        return std::make_shared<Filter>(*static_cast<const Filter *>(this));
+        return cloneIdentifier<Filter>(this);
     case Type::IndexedColumn:
-        return std::make_shared<IndexedColumn>(*static_cast<const IndexedColumn *>(this));
+        return cloneIdentifier<IndexedColumn>(this);
     case Type::TableConstraint:
-        return std::make_shared<TableConstraint>(*static_cast<const TableConstraint *>(this));
+        return cloneIdentifier<TableConstraint>(this);
     case Type::CommonTableExpression:
-        return std::make_shared<CommonTableExpression>(
-        *static_cast<const CommonTableExpression *>(this));
+        return cloneIdentifier<CommonTableExpression>(this);
     case Type::QualifiedTableName:
-        return std::make_shared<QualifiedTableName>(
-        *static_cast<const QualifiedTableName *>(this));
+        return cloneIdentifier<QualifiedTableName>(this);
     case Type::OrderingTerm:
-        return std::make_shared<OrderingTerm>(*static_cast<const OrderingTerm *>(this));
+        return cloneIdentifier<OrderingTerm>(this);
     case Type::UpsertClause:
-        return std::make_shared<UpsertClause>(*static_cast<const UpsertClause *>(this));
+        return cloneIdentifier<UpsertClause>(this);
     case Type::Pragma:
-        return std::make_shared<Pragma>(*static_cast<const Pragma *>(this));
+        return cloneIdentifier<Pragma>(this);
     case Type::JoinClause:
-        return std::make_shared<JoinClause>(*static_cast<const JoinClause *>(this));
+        return cloneIdentifier<JoinClause>(this);
     case Type::TableOrSubquery:
-        return std::make_shared<TableOrSubquery>(*static_cast<const TableOrSubquery *>(this));
+        return cloneIdentifier<TableOrSubquery>(this);
     case Type::JoinConstraint:
-        return std::make_shared<JoinConstraint>(*static_cast<const JoinConstraint *>(this));
+        return cloneIdentifier<JoinConstraint>(this);
         //    case Type::SelectCore:
-        //        return std::make_shared<SelectCore>(*static_cast<const SelectCore *>(this));
+        //        return cloneIdentifier<SelectCore>(this);
     case Type::ResultColumn:
-        return std::make_shared<ResultColumn>(*static_cast<const ResultColumn *>(this));
+        return cloneIdentifier<ResultColumn>(this);
     case Type::FrameSpec:
-        return std::make_shared<FrameSpec>(*static_cast<const FrameSpec *>(this));
+        return cloneIdentifier<FrameSpec>(this);
     case Type::AlterTableSTMT:
-        return std::make_shared<AlterTableSTMT>(*static_cast<const AlterTableSTMT *>(this));
+        return cloneIdentifier<AlterTableSTMT>(this);
     case Type::AnalyzeSTMT:
-        return std::make_shared<AnalyzeSTMT>(*static_cast<const AnalyzeSTMT *>(this));
+        return cloneIdentifier<AnalyzeSTMT>(this);
     case Type::AttachSTMT:
-        return std::make_shared<AttachSTMT>(*static_cast<const AttachSTMT *>(this));
+        return cloneIdentifier<AttachSTMT>(this);
     case Type::BeginSTMT:
-        return std::make_shared<BeginSTMT>(*static_cast<const BeginSTMT *>(this));
+        return cloneIdentifier<BeginSTMT>(this);
     case Type::CommitSTMT:
-        return std::make_shared<CommitSTMT>(*static_cast<const CommitSTMT *>(this));
+        return cloneIdentifier<CommitSTMT>(this);
     case Type::RollbackSTMT:
-        return std::make_shared<RollbackSTMT>(*static_cast<const RollbackSTMT *>(this));
+        return cloneIdentifier<RollbackSTMT>(this);
     case Type::SavepointSTMT:
-        return std::make_shared<SavepointSTMT>(*static_cast<const SavepointSTMT *>(this));
+        return cloneIdentifier<SavepointSTMT>(this);
     case Type::ReleaseSTMT:
-        return std::make_shared<ReleaseSTMT>(*static_cast<const ReleaseSTMT *>(this));
+        return cloneIdentifier<ReleaseSTMT>(this);
     case Type::CreateIndexSTMT:
-        return std::make_shared<CreateIndexSTMT>(*static_cast<const CreateIndexSTMT *>(this));
+        return cloneIdentifier<CreateIndexSTMT>(this);
     case Type::CreateTableSTMT:
-        return std::make_shared<CreateTableSTMT>(*static_cast<const CreateTableSTMT *>(this));
+        return cloneIdentifier<CreateTableSTMT>(this);
     case Type::CreateTriggerSTMT:
-        return std::make_shared<CreateTriggerSTMT>(
-        *static_cast<const CreateTriggerSTMT *>(this));
+        return cloneIdentifier<CreateTriggerSTMT>(this);
     case Type::SelectSTMT:
-        return std::make_shared<SelectSTMT>(*static_cast<const SelectSTMT *>(this));
+        return cloneIdentifier<SelectSTMT>(this);
     case Type::InsertSTMT:
-        return std::make_shared<InsertSTMT>(*static_cast<const InsertSTMT *>(this));
+        return cloneIdentifier<InsertSTMT>(this);
     case Type::DeleteSTMT:
-        return std::make_shared<DeleteSTMT>(*static_cast<const DeleteSTMT *>(this));
+        return cloneIdentifier<DeleteSTMT>(this);
     case Type::UpdateSTMT:
-        return std::make_shared<UpdateSTMT>(*static_cast<const UpdateSTMT *>(this));
+        return cloneIdentifier<UpdateSTMT>(this);
     case Type::CreateViewSTMT:
-        return std::make_shared<CreateViewSTMT>(*static_cast<const CreateViewSTMT *>(this));
+        return cloneIdentifier<CreateViewSTMT>(this);
     case Type::CreateVirtualTableSTMT:
-        return std::make_shared<CreateVirtualTableSTMT>(
-        *static_cast<const CreateVirtualTableSTMT *>(this));
+        return cloneIdentifier<CreateVirtualTableSTMT>(this);
     case Type::DetachSTMT:
-        return std::make_shared<DetachSTMT>(*static_cast<const DetachSTMT *>(this));
+        return cloneIdentifier<DetachSTMT>(this);
     case Type::DropIndexSTMT:
-        return std::make_shared<DropIndexSTMT>(*static_cast<const DropIndexSTMT *>(this));
+        return cloneIdentifier<DropIndexSTMT>(this);
     case Type::DropTableSTMT:
-        return std::make_shared<DropTableSTMT>(*static_cast<const DropTableSTMT *>(this));
+        return cloneIdentifier<DropTableSTMT>(this);
     case Type::DropTriggerSTMT:
-        return std::make_shared<DropTriggerSTMT>(*static_cast<const DropTriggerSTMT *>(this));
+        return cloneIdentifier<DropTriggerSTMT>(this);
     case Type::DropViewSTMT:
-        return std::make_shared<DropViewSTMT>(*static_cast<const DropViewSTMT *>(this));
+        return cloneIdentifier<DropViewSTMT>(this);
     case Type::PragmaSTMT:
-        return std::make_shared<PragmaSTMT>(*static_cast<const PragmaSTMT *>(this));
+        return cloneIdentifier<PragmaSTMT>(this);
     case Type::ReindexSTMT:
-        return std::make_shared<ReindexSTMT>(*static_cast<const ReindexSTMT *>(this));
+        return cloneIdentifier<ReindexSTMT>(this);
     case Type::VacuumSTMT:
-        return std::make_shared<VacuumSTMT>(*static_cast<const VacuumSTMT *>(this));
+        return cloneIdentifier<VacuumSTMT>(this);
     case Type::ExplainSTMT:
-        return std::make_shared<ExplainSTMT>(*static_cast<const ExplainSTMT *>(this));
+        return cloneIdentifier<ExplainSTMT>(this);
     default:
         WCTAssert(false);
         return nullptr;
@@ -192,6 +192,18 @@ OneRowValue StatementOperation::getOneRow()
     return handleStatement->getOneRow();
 }
 
+ValueView StatementOperation::getValueView(int index)
+{
+    GetHandleStatementOrReturnValue(ValueView());
+    return handleStatement->getValueView(index);
+}
+
+OneRowValueView StatementOperation::getOneRowView()
+{
+    GetHandleStatementOrReturnValue(OneRowValueView());
+    return handleStatement->getOneRowView();
+}
+
 OptionalMultiRows StatementOperation::getAllRows()
 {
     GetHandleStatementOrReturnValue(OptionalMultiRows());
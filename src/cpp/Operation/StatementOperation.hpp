@@ -257,8 +257,23 @@ public:
      */
     OneRowValue getOneRow();
 
+    /**
+     @brief Zero-copy version of `StatementOperation::getValue()`.
+     @warning The text and BLOB of the result point to the memory of the statement directly. They are only valid until the next `step()`, `reset()` or `finalize()`.
+     @see   `WCDB::ValueView`
+     */
+    ValueView getValueView(int index = 0);
+
+    /**
+     @brief Zero-copy version of `StatementOperation::getOneRow()`.
+     @warning The text and BLOB of the result point to the memory of the statement directly. They are only valid until the next `step()`, `reset()` or `finalize()`.
+     */
+    OneRowValueView getOneRowView();
+
     /**
      @brief Extract the values of the current row and assign them into the fields specified by resultFields of a new object.
+     @note  The text and BLOB fields declared as `WCDB::TextView` and `WCDB::BLOBView` are extracted without copying, so they are only valid until the next `step()`, `reset()` or `finalize()`.
+            The class having them must declare `WCDB_CPP_ORM_ROW_SCOPED`, and can not be used with the APIs returning whole result, such as `getAllObjects()`.
      @return An object.
      */
     template<class ObjectType>
@@ -343,6 +358,7 @@ public:
     template<class ObjectType>
     OptionalValueArray<ObjectType> extractAllObjects(const ResultFields& resultFields)
     {
+        WCDB_CPP_ORM_STATIC_ASSERT_FOR_WHOLE_RESULT
         OptionalValueArray<ObjectType> result;
         bool succeed = false;
         while ((succeed = step()) && !done()) {
@@ -112,6 +112,7 @@ public:
      */
     OptionalValueArray<ObjectType> allObjects()
     {
+        WCDB_CPP_ORM_STATIC_ASSERT_FOR_WHOLE_RESULT
         OptionalValueArray<ObjectType> objects;
         if (prepareStatement()) {
             objects = m_handle->extractAllObjects<ObjectType>(m_fields);
@@ -127,6 +128,7 @@ public:
      */
     Optional<ObjectType> firstObject()
     {
+        WCDB_CPP_ORM_STATIC_ASSERT_FOR_WHOLE_RESULT
         Optional<ObjectType> object;
         bool succeed = false;
         if ((succeed = prepareStatement())) {
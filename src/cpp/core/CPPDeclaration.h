@@ -34,8 +34,42 @@
                   && std::is_copy_constructible<ObjectType>::value,                            \
                   "This class must be copy constructible and copy assignable.");
 
+// TextView and BLOBView point to the memory of statement, so the objects having them must be extracted row by row.
+#define WCDB_CPP_ORM_STATIC_ASSERT_FOR_WHOLE_RESULT                                            \
+    static_assert(!WCDB::IsRowScopedObject<ObjectType>::value,                                 \
+                  "Objects with TextView or BLOBView members can only be extracted "           \
+                  "row by row with StatementOperation::extractOneObject().");
+
 namespace WCDB {
 
+template<typename T>
+struct IsRowScopedMember : public ColumnIsRowScopedType<T> {
+};
+
+template<typename T>
+struct IsRowScopedMember<Optional<T>> : public IsRowScopedMember<T> {
+};
+
+template<typename T>
+struct IsRowScopedMember<std::shared_ptr<T>> : public IsRowScopedMember<T> {
+};
+
+#if defined(__cplusplus) && __cplusplus > 201402L
+template<typename T>
+struct IsRowScopedMember<std::optional<T>> : public IsRowScopedMember<T> {
+};
+#endif
+
+// The class declaring WCDB_CPP_ORM_ROW_SCOPED is allowed to have TextView or BLOBView members.
+template<typename T, typename Enable = void>
+struct IsRowScopedObject : public std::false_type {
+};
+
+template<typename T>
+struct IsRowScopedObject<T, typename std::enable_if<T::isRowScopedObject>::type>
+: public std::true_type {
+};
+
 class BaseAccessor;
 class Field;
 class ResultField;
@@ -30,10 +30,16 @@
 #include "CoreConst.h"
 #include "CustomConfig.hpp"
 #include "DBOperationNotifier.hpp"
+#include "FTS5Pretokenizer.hpp"
 #include "FileManager.hpp"
 #include "InnerDatabase.hpp"
+#include "MmapConfig.hpp"
+#include "ParallelSelect.hpp"
 #include "WCDBVersion.h"
+#include "WorkerPool.hpp"
+#include <atomic>
 #include <errno.h>
+#include <future>
 #include <stdlib.h>
 #ifndef _WIN32
 #include <unistd.h>
@@ -191,6 +197,81 @@ bool Database::passiveCheckpoint()
     return m_innerDatabase->checkpoint(false, InnerDatabase::CheckPointMode::Passive);
 }
 
+static_assert((int) Database::HandlePriority::Interactive == (int) HandlePriorityInteractive, "");
+static_assert((int) Database::HandlePriority::Normal == (int) HandlePriorityNormal, "");
+static_assert((int) Database::HandlePriority::Background == (int) HandlePriorityBackground, "");
+
+void Database::setHandlePriorityForCurrentThread(HandlePriority priority, double timeOut)
+{
+    m_innerDatabase->setThreadedHandlePriority((WCDB::HandlePriority) priority, timeOut);
+}
+
+void Database::setMaxAllowedNumberOfHandles(int maxAllowedNumberOfHandles, int maxAllowedNumberOfWriters)
+{
+    m_innerDatabase->setMaxAllowedNumberOfHandles(maxAllowedNumberOfHandles,
+                                                  maxAllowedNumberOfWriters);
+}
+
+Database::HandleWaitingInfo Database::getHandleWaitingInfo(HandlePriority priority) const
+{
+    auto statistic
+    = m_innerDatabase->getHandleWaitingStatistic((WCDB::HandlePriority) priority);
+    HandleWaitingInfo info;
+    info.acquiredCount = statistic.acquiredCount;
+    info.waitedCount = statistic.waitedCount;
+    info.timeoutCount = statistic.timeoutCount;
+    info.totalWaitingTime = statistic.totalWaitingTime;
+    info.maxWaitingTime = statistic.maxWaitingTime;
+    return info;
+}
+
+Database::SchemaCacheInfo Database::getSchemaCacheInfo() const
+{
+    auto statistic = m_innerDatabase->getSchemaCacheStatistic();
+    SchemaCacheInfo info;
+    info.hitCount = statistic.hitCount;
+    info.missCount = statistic.missCount;
+    return info;
+}
+
+void Database::enableStatementWarmup(bool enable)
+{
+    m_innerDatabase->enableStatementWarmup(enable);
+}
+
+void Database::setElasticHandlePool(int minIdleHandles, double growthThreshold, double idleTimeout)
+{
+    InnerDatabase::HandleElasticPolicy policy;
+    policy.minIdleHandles = minIdleHandles;
+    policy.growthThreshold = growthThreshold;
+    policy.idleTimeout = idleTimeout;
+    m_innerDatabase->setHandleElasticPolicy(policy);
+}
+
+Database::HandlePoolInfo Database::getHandlePoolInfo() const
+{
+    auto statistic = m_innerDatabase->getHandleElasticStatistic();
+    HandlePoolInfo info;
+    info.hitCount = statistic.hitCount;
+    info.missCount = statistic.missCount;
+    info.preopenedCount = statistic.preopenedCount;
+    info.shrunkCount = statistic.shrunkCount;
+    info.openedCount = statistic.openedCount;
+    info.totalOpeningTime = statistic.totalOpeningTime;
+    info.maxOpeningTime = statistic.maxOpeningTime;
+    return info;
+}
+
+Database::StatementPoolInfo Database::getStatementPoolInfo() const
+{
+    auto statistic = m_innerDatabase->getHandleStatementStatistic();
+    StatementPoolInfo info;
+    info.allocatedCount = statistic.allocatedCount;
+    info.reusedCount = statistic.reusedCount;
+    info.allocationsPerSecond = statistic.allocationsPerSecond;
+    return info;
+}
+
 #if defined(_WIN32)
 void Database::setUIThreadId(std::thread::id uiThreadId)
 {
@@ -322,6 +403,122 @@ void Database::globalTraceBusy(BusyTrace trace, double timeOut)
     Core::shared().setBusyMonitor(trace, timeOut);
 }
 
+#pragma mark - Parallel Query
+
+OptionalMultiRows Database::getAllRowsFromStatementInParallel(const StatementSelect& select,
+                                                              int parallelism,
+                                                              const Expression& rangeExpression)
+{
+    ParallelSelect parallelSelect(select, rangeExpression);
+    // Other handles can't see the uncommitted data of the transaction in current thread.
+    if (parallelism <= 1 || !parallelSelect.isParallelizable()
+        || m_innerDatabase->isInTransaction()) {
+        return getAllRowsFromStatement(select);
+    }
+    // Read the range and all partitions from the same snapshot so that they observe the same commit.
+    // Without snapshot support, each partition reads the latest commit by itself.
+    Snapshot snapshot;
+    if (isSnapshotSupported()) {
+        snapshot = captureSnapshot();
+        if (!snapshot.isValid()) {
+            return NullOpt;
+        }
+    }
+    auto readRows = [&](const StatementSelect& statement) {
+        if (!snapshot.isValid()) {
+            return getAllRowsFromStatement(statement);
+        }
+        OptionalMultiRows rows;
+        runInSnapshot(snapshot, [&](Handle& handle) {
+            rows = handle.getAllRowsFromStatement(statement);
+            return rows.succeed();
+        });
+        return rows;
+    };
+
+    auto range = readRows(parallelSelect.getStatementForSelectingRange());
+    if (range.failed()) {
+        return NullOpt;
+    }
+    if (range.value().size() != 1 || range.value()[0].size() != 2
+        || range.value()[0][0].getType() != ColumnType::Integer
+        || range.value()[0][1].getType() != ColumnType::Integer) {
+        // Empty table or non-integer range.
+        return readRows(select);
+    }
+    std::vector<StatementSelect> statements = parallelSelect.getPartitionedStatements(
+    range.value()[0][0].intValue(), range.value()[0][1].intValue(), parallelism);
+    WCTAssert(!statements.empty());
+
+    typedef std::pair<OptionalMultiRows, Error> PartialResult;
+    std::vector<PartialResult> partials(statements.size());
+    WorkerPool::shared().parallelFor(
+    statements.size(), parallelism, [&](size_t index) {
+        PartialResult& partial = partials[index];
+        partial.first = readRows(statements[index]);
+        if (partial.first.failed()) {
+            partial.second = getError();
+        }
+    });
+
+    std::vector<MultiRowsValue> results;
+    for (auto& partial : partials) {
+        if (partial.first.failed()) {
+            assignErrorToDatabase(partial.second);
+            return NullOpt;
+        }
+        results.push_back(std::move(partial.first.value()));
+    }
+    return parallelSelect.mergeResults(std::move(results));
+}
+
+#pragma mark - Snapshot
+
+Database::Snapshot::Snapshot() = default;
+
+Database::Snapshot::~Snapshot() = default;
+
+bool Database::Snapshot::isValid() const
+{
+    return m_snapshot != nullptr;
+}
+
+int Database::Snapshot::compare(const Snapshot& other) const
+{
+    WCTRemedialAssert(isValid() && other.isValid(), "Snapshot is invalid.", return 0;);
+    return m_snapshot->compare(*other.m_snapshot);
+}
+
+bool Database::isSnapshotSupported()
+{
+    return AbstractHandle::isSnapshotSupported();
+}
+
+Database::Snapshot Database::captureSnapshot()
+{
+    Snapshot snapshot;
+    snapshot.m_snapshot = m_innerDatabase->captureSnapshot();
+    return snapshot;
+}
+
+bool Database::runInSnapshot(const Snapshot& snapshot, SnapshotCallback inSnapshot)
+{
+    WCTRemedialAssert(snapshot.isValid(), "Snapshot is invalid.", return false;);
+    RecyclableHandle handle = getHandleHolder(false);
+    if (handle == nullptr) {
+        return false;
+    }
+    if (!handle->beginSnapshotRead(*snapshot.m_snapshot)) {
+        assignErrorToDatabase(handle->getError());
+        return false;
+    }
+    Handle snapshotHandle(getDatabaseHolder(), handle.get());
+    bool succeed = inSnapshot(snapshotHandle);
+    snapshotHandle.invalidate();
+    handle->endSnapshotRead();
+    return succeed;
+}
+
 #pragma mark - File
 
 bool Database::removeFiles()
@@ -351,6 +548,114 @@ void Database::enableAutoMergeFTS5Index(bool flag)
     Core::shared().enableAutoMergeFTSIndex(m_innerDatabase, flag);
 }
 
+Database::FTS5BulkBuildConfig::FTS5BulkBuildConfig()
+: pageSize(0)
+, crisisMerge(FTS5BulkBuildCrisisMerge)
+, numberOfTokenizeWorkers(FTS5BulkBuildMaxTokenizeWorkers)
+{
+}
+
+bool Database::beginFTS5BulkBuild(const UnsafeStringView& table, const FTS5BulkBuildConfig& config)
+{
+    InnerDatabase::FTSBulkBuildConfig innerConfig;
+    innerConfig.pageSize = config.pageSize;
+    innerConfig.crisisMerge = config.crisisMerge;
+    innerConfig.numberOfTokenizeWorkers = config.numberOfTokenizeWorkers;
+    return m_innerDatabase->beginFTSBulkBuild(table, innerConfig);
+}
+
+bool Database::bulkInsertRowsIntoFTS5Table(const MultiRowsValue& rows,
+                                           const Columns& columns,
+                                           const UnsafeStringView& table)
+{
+    auto config = m_innerDatabase->getFTSBulkBuildConfig(table);
+    WCTRemedialAssert(
+    config.hasValue(), "FTS5 bulk build of this table is not began.", return false;);
+    const size_t sliceSize = FTS5BulkBuildRowsPerTokenizeSlice;
+    size_t numberOfSlices = (rows.size() + sliceSize - 1) / sliceSize;
+    size_t numberOfWorkers = std::min<size_t>(
+    std::max(config.value().numberOfTokenizeWorkers, 0), numberOfSlices);
+    FTS5Pretokenizer pretokenizer(config.value().tokenizer, config.value().tokenizerParameters);
+    if (numberOfWorkers == 0 || !pretokenizer.isAvailable()) {
+        return insertRows(rows, columns, table);
+    }
+
+    // Slices are taken in order by the workers and the writer in current thread.
+    // The writer tokenizes the slice by itself if it's not taken by any worker yet, so that it never waits for a queued job.
+    FTS5Pretokenizer::PretokenizedRows pretokenizedRows(rows.size());
+    std::vector<std::promise<void>> slicePromises(numberOfSlices);
+    std::vector<std::future<void>> sliceFutures;
+    sliceFutures.reserve(numberOfSlices);
+    for (auto& promise : slicePromises) {
+        sliceFutures.push_back(promise.get_future());
+    }
+    // Shared with the jobs that may start after returning, which find nothing to do.
+    std::shared_ptr<std::atomic<size_t>> nextSlice
+    = std::make_shared<std::atomic<size_t>>(0);
+    auto tokenizeSlice = [&](size_t slice) {
+        size_t begin = slice * sliceSize;
+        pretokenizer.tokenize(rows, begin, std::min(begin + sliceSize, rows.size()), pretokenizedRows);
+        slicePromises[slice].set_value();
+    };
+    for (size_t i = 0; i < numberOfWorkers; ++i) {
+        WorkerPool::shared().async([nextSlice, numberOfSlices, &tokenizeSlice]() {
+            size_t slice;
+            while ((slice = (*nextSlice)++) < numberOfSlices) {
+                tokenizeSlice(slice);
+            }
+        });
+    }
+
+    bool succeed = lazyRunTransaction([&](Handle& handle) {
+        StatementInsert insert
+        = StatementInsert().insertIntoTable(table).columns(columns).values(
+        BindParameter::bindParameters(columns.size()));
+        if (!handle.prepare(insert)) {
+            assignErrorToDatabase(handle.getError());
+            return false;
+        }
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const OneRowValue& row = rows[i];
+            WCTRemedialAssert(columns.size() == row.size(),
+                              "Number of values is not equal to number of columns",
+                              handle.finalize();
+                              return false;);
+            if (i % sliceSize == 0) {
+                size_t slice;
+                while (nextSlice->load() <= i / sliceSize
+                       && (slice = (*nextSlice)++) < numberOfSlices) {
+                    tokenizeSlice(slice);
+                }
+                sliceFutures[i / sliceSize].wait();
+            }
+            handle.reset();
+            handle.bindRow(row);
+            PretokenizedFTS5Texts::setThreaded(&pretokenizedRows[i]);
+            bool stepped = handle.step();
+            PretokenizedFTS5Texts::setThreaded(nullptr);
+            pretokenizedRows[i].clear();
+            if (!stepped) {
+                handle.finalize();
+                assignErrorToDatabase(handle.getError());
+                return false;
+            }
+        }
+        handle.finalize();
+        return true;
+    });
+    // Stop the workers from tokenizing the remaining slices if it fails, and wait for the taken ones.
+    size_t takenSlices = std::min(nextSlice->exchange(numberOfSlices), numberOfSlices);
+    for (size_t slice = 0; slice < takenSlices; ++slice) {
+        sliceFutures[slice].wait();
+    }
+    return succeed;
+}
+
+bool Database::endFTS5BulkBuild(const UnsafeStringView& table)
+{
+    return m_innerDatabase->endFTSBulkBuild(table);
+}
+
 void Database::addTokenizer(const UnsafeStringView& tokenize)
 {
     StringView configName
@@ -411,6 +716,26 @@ void Database::purgeAll()
     Core::shared().purgeDatabasePool();
 }
 
+void Database::releaseSQLiteMemory(int bytes)
+{
+    Core::shared().releaseSQLiteMemory(bytes);
+}
+
+void Database::setPageCacheBudget(int64_t budget)
+{
+    Core::shared().setPageCacheBudget(budget);
+}
+
+Database::PageCacheInfo Database::getPageCacheInfo() const
+{
+    auto statistic = m_innerDatabase->getPageCacheStatistic();
+    PageCacheInfo info;
+    info.hitCount = statistic.hitCount;
+    info.missCount = statistic.missCount;
+    info.cacheSize = statistic.cacheSize;
+    return info;
+}
+
 #pragma mark - Repair
 
 void Database::setNotificationWhenCorrupted(Database::CorruptionNotification onCorrupted)
@@ -473,6 +798,15 @@ bool Database::vacuum(ProgressUpdateCallback onProgressUpdated)
     return m_innerDatabase->vacuum(onProgressUpdated);
 }
 
+bool Database::backupTo(const UnsafeStringView& destination,
+                        int pagesPerStep,
+                        double maxBytesPerSecond,
+                        ProgressUpdateCallback onProgressUpdated)
+{
+    return m_innerDatabase->backupTo(
+    destination, pagesPerStep, maxBytesPerSecond, onProgressUpdated);
+}
+
 #pragma mark - Config
 
 void Database::setCipherKey(const UnsafeData& cipherKey, int cipherPageSize, CipherVersion cipherVersion)
@@ -488,6 +822,18 @@ void Database::setCipherKey(const UnsafeData& cipherKey, int cipherPageSize, Cip
     }
 }
 
+void Database::setMmapSize(int64_t maxSize)
+{
+    if (maxSize > 0) {
+        m_innerDatabase->setConfig(
+        MmapConfigName,
+        std::static_pointer_cast<Config>(std::make_shared<MmapConfig>(maxSize)),
+        Configs::Priority::Default);
+    } else {
+        m_innerDatabase->removeConfig(MmapConfigName);
+    }
+}
+
 void Database::setDefaultCipherConfiguration(CipherVersion version)
 {
     Core::shared().setDefaultCipherConfiguration(version);
@@ -543,6 +889,21 @@ void Database::addScalarFunction(const UnsafeStringView& name)
                                WCDB::Configs::Priority::Higher);
 }
 
+void Database::registerAggregateFunction(const AggregateFunctionModule& module,
+                                         const UnsafeStringView& name)
+{
+    Core::shared().registerAggregateFunction(name, module);
+}
+
+void Database::addAggregateFunction(const UnsafeStringView& name)
+{
+    WCDB::StringView configName = WCDB::StringView::formatted(
+    "%s%s", WCDB::AggregateFunctionConfigPrefix.data(), name.data());
+    m_innerDatabase->setConfig(configName,
+                               WCDB::Core::shared().aggregateFunctionConfig(name),
+                               WCDB::Configs::Priority::Higher);
+}
+
 #pragma mark - Migration
 
 void Database::addMigration(const UnsafeStringView& sourcePath,
@@ -643,6 +1004,20 @@ void Database::CompressionInfo::addZSTDDictCompressField(const Field& field,
     ((CompressionTableUserInfo*) m_innerInfo)->addCompressingColumn(columnInfo);
 }
 
+void Database::CompressionInfo::setZSTDCompressionPolicy(const Field& field,
+                                                         size_t minCompressSize,
+                                                         bool recompressInBackground,
+                                                         int writeLevel)
+{
+    CompressionPolicy policy;
+    policy.minCompressSize = minCompressSize;
+    if (writeLevel != 0) {
+        policy.writeLevel = writeLevel;
+    }
+    policy.recompress = recompressInBackground;
+    ((CompressionTableUserInfo*) m_innerInfo)->setCompressionPolicy(field, policy);
+}
+
 Optional<Data> Database::trainDict(const std::vector<std::string>& strings, DictId dictId)
 {
     int index = 0;
@@ -676,6 +1051,16 @@ bool Database::registerZSTDDict(const UnsafeData& dict, DictId dictId)
     return CompressionCenter::shared().registerDict(dictId, dict);
 }
 
+Database::DictId Database::getCurrentZSTDDictId(DictId dictId)
+{
+    return (DictId) CompressionCenter::shared().getCurrentDictId(dictId);
+}
+
+bool Database::replaceZSTDDict(DictId dictId, DictId newDictId)
+{
+    return CompressionCenter::shared().replaceDict(dictId, newDictId);
+}
+
 void Database::setCompression(const CompressionFilter& filter)
 {
     InnerDatabase::CompressionTableFilter callback = nullptr;
@@ -730,6 +1115,15 @@ bool Database::isCompressed() const
     return m_innerDatabase->isCompressed();
 }
 
+Optional<Data> Database::retrainZSTDDict(const UnsafeStringView& table,
+                                         const Field& field,
+                                         DictId currentDictId,
+                                         DictId newDictId)
+{
+    return m_innerDatabase->retrainDict(
+    table, field, currentDictId, newDictId, InnerDatabase::DictRetrainingConfig());
+}
+
 #pragma mark - Version
 
 const StringView Database::getVersion()
@@ -23,10 +23,12 @@
  */
 
 #pragma once
+#include "AggregateFunctionTemplate.hpp"
 #include "AuxiliaryFunctionModule.hpp"
 #include "FTSTokenizerUtil.hpp"
 #include "Handle.hpp"
 #include "HandleORMOperation.hpp"
+#include "ScalarFunctionTemplate.hpp"
 #include "Statement.hpp"
 #include "TokenizerModule.hpp"
 #include "WCDBError.hpp"
@@ -35,6 +37,7 @@
 namespace WCDB {
 
 class BaseTable;
+class WALSnapshot;
 
 class WCDB_API Database final : public HandleORMOperation {
     friend BaseTable;
@@ -168,6 +171,96 @@ public:
      */
     bool passiveCheckpoint();
 
+    enum HandlePriority : unsigned char {
+        Interactive = 0,
+        Normal,
+        Background,
+    };
+
+    /**
+     @brief Set the priority and timeout for acquiring handles of current database in the current thread.
+     When the number of handles reaches the maximum allowed, threads acquiring handles will wait in place.
+     Waiting threads with higher priority will be served first, and a long waiting thread will be gradually promoted to avoid starvation.
+     @param priority priority of current thread.
+     @param timeOut timeout in seconds for waiting a handle. 0 means waiting until a handle is available.
+     */
+    void setHandlePriorityForCurrentThread(HandlePriority priority, double timeOut = 0);
+
+    /**
+     @brief Set the maximum number of handles and the maximum number of writing handles that can exist at the same time.
+     They are 32 and 4 by default.
+     @note  Handles in use are not closed when the limit is lowered. Acquiring a new handle fails with `Error::Code::Exceed` until enough of them are returned.
+     */
+    void setMaxAllowedNumberOfHandles(int maxAllowedNumberOfHandles, int maxAllowedNumberOfWriters);
+
+    typedef struct HandleWaitingInfo {
+        uint64_t acquiredCount; // Number of handles acquired, including those without waiting.
+        uint64_t waitedCount;   // Number of acquisitions that had to wait.
+        uint64_t timeoutCount;  // Number of acquisitions that gave up after timeout.
+        double totalWaitingTime;
+        double maxWaitingTime;
+    } HandleWaitingInfo;
+
+    /**
+     @brief Get the statistics of waiting for handles with specified priority.
+     */
+    HandleWaitingInfo getHandleWaitingInfo(HandlePriority priority) const;
+
+    typedef struct SchemaCacheInfo {
+        uint64_t hitCount;  // Number of catalog queries avoided by the schema cache shared among handles.
+        uint64_t missCount; // Number of catalog queries that had to be executed.
+    } SchemaCacheInfo;
+
+    /**
+     @brief Get the statistics of the schema cache, which is shared among handles to look up existence, columns and attributes of tables.
+     */
+    SchemaCacheInfo getSchemaCacheInfo() const;
+
+    /**
+     @brief Enable to record the statements prepared by `Handle::getOrCreatePreparedStatement()`, and persist them in a side file of database.
+     The most frequently prepared ones are prepared ahead on the spare handles opened in background by `setElasticHandlePool()`, so that the first queries on them skip the prepare cost.
+     The handles opened synchronously are not warmed up, so it should be enabled after the elastic handle pool. Otherwise, a warning is reported.
+     Note that the warmed statements only serve the first use of each spare handle, since the prepared statements of a handle are finalized once it's returned to the pool.
+     It does not work with the database being compressed or migrated.
+     For the encrypted database, the statements are recorded in memory only and never written to the side file.
+     */
+    void enableStatementWarmup(bool enable);
+
+    /**
+     @brief Keep some idle handles opened and fully configured, so that the bursts of traffic don't wait for opening handles synchronously.
+     The spare handles are opened in background once the idle handles are less than `minIdleHandles` or the ratio of handles in use reaches `growthThreshold`.
+     The idle handles beyond `minIdleHandles` are closed after being idle for `idleTimeout` seconds. 0 means never.
+     @param minIdleHandles 0 means disabled, which is the default.
+     @param growthThreshold It should be in (0, 1].
+     */
+    void setElasticHandlePool(int minIdleHandles, double growthThreshold = 0.75, double idleTimeout = 30);
+
+    typedef struct HandlePoolInfo {
+        uint64_t hitCount;        // Number of handles served by idle ones.
+        uint64_t missCount;       // Number of handles opened synchronously when acquired.
+        uint64_t preopenedCount;  // Number of handles opened in background.
+        uint64_t shrunkCount;     // Number of idle handles closed due to timeout.
+        uint64_t openedCount;     // Number of handles opened, including those in background.
+        double totalOpeningTime;
+        double maxOpeningTime;
+    } HandlePoolInfo;
+
+    /**
+     @brief Get the statistics of opening handles.
+     */
+    HandlePoolInfo getHandlePoolInfo() const;
+
+    typedef struct StatementPoolInfo {
+        uint64_t allocatedCount;     // Number of statements allocated newly.
+        uint64_t reusedCount;        // Number of statements reused from the free lists of handles.
+        double allocationsPerSecond; // Measured in the last second.
+    } StatementPoolInfo;
+
+    /**
+     @brief Get the statistics of allocating statements, which are kept in the free lists of handles once they are recycled.
+     */
+    StatementPoolInfo getStatementPoolInfo() const;
+
 #if defined(_WIN32)
     /**
      @brief Config the id of UI thread.
@@ -374,6 +467,87 @@ public:
      */
     static void globalTraceBusy(BusyTrace trace, double timeOut);
 
+#pragma mark - Parallel Query
+public:
+    /**
+     @brief Split a select statement on a single table into several disjoint ranges of an integer column, and run them concurrently on different handles.
+     It can make full use of multiple cores when scanning or aggregating a large table.
+     The following statements are supported:
+         1. Plain selection without DISTINCT, GROUP BY, HAVING, window, ORDER BY and LIMIT. The results are concatenated in the order of range.
+         2. Selection with only COUNT, SUM, TOTAL, MIN and MAX as result columns. The partial results are combined.
+     The other statements will be executed in the current thread as usual.
+     @note  The range and the sub-ranges are read from the same snapshot captured by `Database::captureSnapshot()`, so they observe the same commit even if the table is being modified concurrently.
+     If `Database::isSnapshotSupported()` returns false, the sub-ranges are still run concurrently, but each of them reads the latest commit by itself. The result may be inconsistent if the table is modified during the query.
+     It's executed in the current thread as usual if it's called within a transaction.
+     The sub-ranges are run on a shared pool with a bounded number of threads.
+     @param select The statement to be executed.
+     @param parallelism The maximum number of handles used concurrently.
+     @param rangeExpression An integer expression to split the table, which should be the rowid or the integer primary key for better performance.
+     @return All rows of the result.
+     */
+    OptionalMultiRows getAllRowsFromStatementInParallel(const StatementSelect &select,
+                                                        int parallelism,
+                                                        const Expression &rangeExpression
+                                                        = Column::rowid());
+
+#pragma mark - Snapshot
+public:
+    /**
+     A historical version of the database in WAL mode, which can be shared among threads and opened by any handle of the same database.
+     */
+    class WCDB_API Snapshot final {
+        friend class Database;
+
+    public:
+        Snapshot();
+        ~Snapshot();
+
+        /**
+         @brief Whether the snapshot is captured successfully.
+         */
+        bool isValid() const;
+
+        /**
+         @brief The wrapper of `sqlite3_snapshot_cmp`.
+         @return Negative if this snapshot is older than the other one, positive if newer and zero if they are the same.
+         */
+        int compare(const Snapshot &other) const;
+
+    private:
+        std::shared_ptr<WALSnapshot> m_snapshot;
+    };
+
+    /**
+     @brief Whether WCDB is built with `SQLITE_ENABLE_SNAPSHOT` macro. It's enabled in the CMake build.
+     The other builds follow the configuration of the sqlcipher they link to.
+     */
+    static bool isSnapshotSupported();
+
+    /**
+     @brief The wrapper of `sqlite3_snapshot_get`.
+     Capture the current version of the database, so that several readers can read the same version of data concurrently or in batches, without holding a long read transaction on one handle.
+     @note  Auto checkpoint is postponed until all the captured snapshots are released, because restarting the WAL file will invalidate them. But it may still be invalidated by the manual checkpoints such as `Database::truncateCheckpoint()`.
+     @warning WCDB and sqlcipher should be both built with `SQLITE_ENABLE_SNAPSHOT` macro. Otherwise, it always fails. See `Database::isSnapshotSupported()`.
+     @return A snapshot, which is invalid if any error occurs.
+     */
+    Snapshot captureSnapshot();
+
+    typedef std::function<bool(Handle &)> SnapshotCallback;
+
+    /**
+     @brief The wrapper of `sqlite3_snapshot_open`.
+     Run the read operations of `inSnapshot` on a handle whose read transaction is started on the snapshot.
+     It's safe to call this function from multiple threads with the same snapshot. Each call will use a separate handle.
+         WCDB::Database::Snapshot snapshot = database.captureSnapshot();
+         database.runInSnapshot(snapshot, [](WCDB::Handle &handle) {
+             auto rows = handle.getAllRowsFromStatement(firstPage);
+             return rows.succeed();
+         });
+     @warning It can't be called within a transaction. And the write operations are not allowed in `inSnapshot`.
+     @return True if the snapshot is opened successfully and `inSnapshot` returns true.
+     */
+    bool runInSnapshot(const Snapshot &snapshot, SnapshotCallback inSnapshot);
+
 #pragma mark - File
 public:
     /**
@@ -415,6 +589,58 @@ public:
      */
     void enableAutoMergeFTS5Index(bool flag);
 
+    /**
+     @brief Configuration of bulk building the index of fts5 table.
+     */
+    struct FTS5BulkBuildConfig {
+        FTS5BulkBuildConfig();
+        /**
+         Page size of fts5 index during bulk building. 0 by default, which means keeping the current page size.
+         */
+        int pageSize;
+        /**
+         Number of segments on one level that makes fts5 merge them while inserting. A larger one defers more merging to the end of bulk building. 64 by default.
+         */
+        int crisisMerge;
+        /**
+         Maximum number of threads that tokenize texts ahead of inserting. 4 by default.
+         The texts are tokenized ahead only if the tokenizer in the schema of fts5 table is a fts5 tokenizer registered to WCDB. Otherwise, they are tokenized while inserting as usual.
+         */
+        int numberOfTokenizeWorkers;
+    };
+
+    /**
+     @brief Begin bulk building the index of a fts5 table, which is designed for backfilling a large amount of rows.
+     The auto-merge of this table is suspended and the automerge, crisismerge and pgsz options of fts5 are tuned until `endFTS5BulkBuild` is called.
+     @warning The options are persistent in fts5 table, so you should always end the bulk building. The original options are also saved, and they will be restored by the next `endFTS5BulkBuild` of this table or on the next launch with auto merge enabled if it's not ended before exiting.
+     @param table The name of fts5 table.
+     @param config Configuration of bulk building.
+     @return true if no error occurs.
+     */
+    bool beginFTS5BulkBuild(const UnsafeStringView &table,
+                            const FTS5BulkBuildConfig &config = FTS5BulkBuildConfig());
+
+    /**
+     @brief Insert rows into the fts5 table in bulk building within one transaction.
+     The texts of rows are tokenized by workers in parallel ahead of inserting, and the results are replayed while inserting.
+     @warning Triggers that insert the same text into other fts5 tables with different tokenizers are not supported.
+     @param rows The rows to be inserted.
+     @param columns The columns of rows.
+     @param table The name of fts5 table, whose bulk building is began.
+     @return true if no error occurs.
+     */
+    bool bulkInsertRowsIntoFTS5Table(const MultiRowsValue &rows,
+                                     const Columns &columns,
+                                     const UnsafeStringView &table);
+
+    /**
+     @brief End bulk building the index of a fts5 table.
+     The options of fts5 are restored, and the segments of index are merged in background.
+     @param table The name of fts5 table.
+     @return true if no error occurs.
+     */
+    bool endFTS5BulkBuild(const UnsafeStringView &table);
+
     /**
      @brief Setup tokenizer with name for current database.
      It's recommended to use the builtin tokenizers defined in `FTSConst.h`.
@@ -522,6 +748,31 @@ public:
      */
     static void purgeAll();
 
+    /**
+     @brief Release at most `bytes` of memory cached by sqlite under memory pressure. It works the same as `sqlite3_release_memory`.
+     Memory-mapped I/O is suspended for a while in addition, see `setMmapSize`.
+     */
+    static void releaseSQLiteMemory(int bytes);
+
+    /**
+     @brief Set the process-wide budget of page cache in bytes, which is split among the handles of all databases.
+     Each handle keeps a small cache at least, and the rest of budget is rebalanced periodically to the databases with more recent reads, especially those with more cache misses.
+     The new cache size is applied once the handle is acquired next time.
+     @param budget 0 means each handle uses the default cache size of sqlite, which is the default.
+     */
+    static void setPageCacheBudget(int64_t budget);
+
+    typedef struct PageCacheInfo {
+        uint64_t hitCount;  // Number of page reads hit in the page cache, since the database is opened.
+        uint64_t missCount; // Number of page reads missed.
+        int cacheSize;      // The current cache size of each handle in KiB. 0 means it's not governed.
+    } PageCacheInfo;
+
+    /**
+     @brief Get the statistics of page cache governed by the budget. See `setPageCacheBudget`.
+     */
+    PageCacheInfo getPageCacheInfo() const;
+
 #pragma mark - Repair
     /**
      Triggered when a database is confirmed to be corrupted.
@@ -634,6 +885,23 @@ public:
      */
     bool vacuum(ProgressUpdateCallback onProgressUpdated);
 
+    /**
+     @brief Copy current database to the destination path page by page, which is a restorable hot copy of the database.
+     All pages are copied from the same snapshot of the database. Writes from other threads are neither blocked nor do they restart the copy.
+     The destination will be encrypted with the same cipher config as current database.
+     @note  Auto checkpoint is postponed until the copy is done.
+     @param destination path of the copy, which will be overwritten.
+     @param pagesPerStep number of pages copied in each step.
+     @param maxBytesPerSecond limit of the copying speed. 0 means unlimited.
+     @param onProgressUpdated block.
+     @see   `Database::ProgressUpdateCallback`.
+     @return True if the whole database is copied.
+     */
+    bool backupTo(const UnsafeStringView &destination,
+                  int pagesPerStep = 256,
+                  double maxBytesPerSecond = 0,
+                  ProgressUpdateCallback onProgressUpdated = nullptr);
+
 #pragma mark - Config
     enum CipherVersion : int {
         DefaultVersion = 0,
@@ -667,6 +935,14 @@ public:
      */
     static void setDefaultCipherConfiguration(CipherVersion version);
 
+    /**
+     @brief Enable memory-mapped I/O for a read-dominated database, so that the reading of pages skips the copy of page cache.
+     It's disabled automatically for the encrypted database and for the database file larger than `maxSize`.
+     The mapped memory of idle handles is released by `purge()`. And after `Database::releaseSQLiteMemory()`, new handles don't map the database file for a while.
+     @param maxSize The max size of database file to be mapped in bytes. 0 means disabled, which is the default.
+     */
+    void setMmapSize(int64_t maxSize);
+
     /**
      Configuration
      */
@@ -725,6 +1001,23 @@ public:
      */
     void addScalarFunction(const UnsafeStringView &name);
 
+    /**
+     @brief Register custom aggregate or window function.
+     @Note  The custom aggregate function needs to inherit `WCDB::AbstractAggregateFunctionObject`, and the custom window function needs to inherit `WCDB::AbstractWindowFunctionObject`.
+     The function object of each group is created in the aggregate context of sqlite, so it must be aligned to no more than 8 bytes.
+     @param module Aggregate function module. You can use WCDB::AggregateFunctionTemplate or WCDB::WindowFunctionTemplate to construct your custom function as aggregate function module.
+     @param name Name of aggregate function.
+     */
+    static void registerAggregateFunction(const AggregateFunctionModule &module,
+                                          const UnsafeStringView &name);
+
+    /**
+     @brief Setup aggregate or window function with name for current database.
+     @Note  Your custom aggregate function should be firstly registered through `static Database::registerAggregateFunction()`.
+     @see   `static Database::registerAggregateFunction()`
+     */
+    void addAggregateFunction(const UnsafeStringView &name);
+
 #pragma mark - Migration
     typedef struct MigrationInfo {
         StringView table;           // Target table of migration
@@ -822,6 +1115,19 @@ public:
                                  const Field &matchField,
                                  const std::map<int64_t /* Value of match column */, DictId> &dictIds);
 
+        /**
+         @brief Configure how the content of a compressing column is compressed.
+         @param field a column configured to be compressed by the methods above.
+         @param minCompressSize content smaller than it is stored without compression.
+         @param recompressInBackground whether to recompress the content written at `writeLevel` with a higher level in background.
+         @param writeLevel zstd level used to compress content when it's written. 0 means the default level of zstd. A fast level such as 1 makes writing faster at the cost of compression ratio, which is usually used with `recompressInBackground`.
+         @note The level used in background is selected by sampling the content of column.
+         */
+        void setZSTDCompressionPolicy(const Field &field,
+                                      size_t minCompressSize,
+                                      bool recompressInBackground = false,
+                                      int writeLevel = 0);
+
     protected:
         friend class Database;
         CompressionInfo(void *innerInfo);
@@ -857,6 +1163,21 @@ public:
      */
     static bool registerZSTDDict(const UnsafeData &dict, DictId dictId);
 
+    /**
+     @brief Get the id of the dict actually used when compressing with `dictId`.
+     @see   `Database::retrainZSTDDict()`
+     */
+    static DictId getCurrentZSTDDictId(DictId dictId);
+
+    /**
+     @brief Compress the content configured to be compressed with `dictId` using `newDictId` instead.
+     Content compressed before can still be decompressed with its original dict.
+     @Note The replacement is not persisted. It should be done at launch again, after both dicts are registered.
+     @see   `Database::retrainZSTDDict()`
+     @return true if both dicts are registered and the replacement is not circular.
+     */
+    static bool replaceZSTDDict(DictId dictId, DictId newDictId);
+
     /**
      Triggered at any time when WCDB needs to know whether a table in the current database needs to compress data,
      mainly including creating a new table, reading and writing a table,and starting to compress a new table.
@@ -915,6 +1236,27 @@ public:
      */
     bool isCompressed() const;
 
+    /**
+     @brief Retrain the zstd dict of a compressed column as its content drifts.
+     Samples of existing content are drawn with a background handle to train candidate dicts,
+     which are evaluated against the dict currently used on a hold-out part of the samples.
+     If a candidate compresses better without slowing down decompression much, it is registered as `newDictId`,
+     and then new content configured to be compressed with `currentDictId` uses the new dict.
+     Content compressed before can still be decompressed with its original dict.
+     @Warning The new dict is only registered in memory. You must persist the returned dict,
+     and register it with `Database::registerZSTDDict()` and call `Database::replaceZSTDDict()` at each launch,
+     before any content of the database is read. Otherwise the content compressed with the new dict can not be decompressed.
+     @param table the compressed table.
+     @param field the compressed column.
+     @param currentDictId id of the dict configured for the column.
+     @param newDictId id of the new dict. It can not be used by any registered dict.
+     @return data of the new dict if the dict is replaced, empty data if the current dict is kept, NullOpt if an error occurred.
+     */
+    Optional<Data> retrainZSTDDict(const UnsafeStringView &table,
+                                   const Field &field,
+                                   DictId currentDictId,
+                                   DictId newDictId);
+
 #pragma mark - Version
     /**
      Version of WCDB.
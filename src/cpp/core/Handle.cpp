@@ -23,6 +23,7 @@
  */
 
 #include "Handle.hpp"
+#include "HandleBlob.hpp"
 #include "InnerDatabase.hpp"
 #include "InnerHandle.hpp"
 #include "RecyclableHandle.hpp"
@@ -42,17 +43,17 @@
 namespace WCDB {
 
 Handle::Handle(Recyclable<InnerDatabase*> database)
-: m_databaseHolder(database), m_innerHandle(nullptr)
+: m_databaseHolder(database), m_innerHandle(nullptr), m_blob(nullptr)
 {
 }
 
 Handle::Handle(RecyclableHandle handle)
-: m_handleHolder(handle), m_innerHandle(handle.get())
+: m_handleHolder(handle), m_innerHandle(handle.get()), m_blob(nullptr)
 {
 }
 
 Handle::Handle(Recyclable<InnerDatabase*> database, InnerHandle* handle)
-: m_databaseHolder(database), m_innerHandle(handle)
+: m_databaseHolder(database), m_innerHandle(handle), m_blob(nullptr)
 {
 }
 
@@ -60,7 +61,9 @@ Handle::Handle(Handle&& other)
 : m_databaseHolder(std::move(other.m_databaseHolder))
 , m_handleHolder(std::move(other.m_handleHolder))
 , m_innerHandle(other.m_innerHandle)
+, m_blob(other.m_blob)
 {
+    other.m_blob = nullptr;
 }
 
 Handle::~Handle()
@@ -104,6 +107,7 @@ Recyclable<InnerDatabase*> Handle::getDatabaseHolder()
 
 void Handle::invalidate()
 {
+    closeBlob();
     m_innerHandle = nullptr;
     m_handleHolder = nullptr;
 }
@@ -167,6 +171,76 @@ void Handle::detachCancellationSignal()
     handle->detachCancellationSignal();
 }
 
+#pragma mark - Incremental BLOB I/O
+bool Handle::openBlob(const UnsafeStringView& table,
+                      const UnsafeStringView& column,
+                      int64_t rowid,
+                      bool writable,
+                      const Schema& schema)
+{
+    closeBlob();
+    InnerHandle* handle = getOrGenerateHandle(writable);
+    if (handle == nullptr) {
+        return false;
+    }
+    m_blob = handle->getBlob();
+    return m_blob->open(schema, table, column, rowid, writable);
+}
+
+bool Handle::reopenBlob(int64_t rowid)
+{
+    if (m_blob == nullptr) {
+        return false;
+    }
+    return m_blob->reopen(rowid);
+}
+
+void Handle::closeBlob()
+{
+    if (m_blob != nullptr) {
+        m_blob->close();
+        if (m_innerHandle != nullptr) {
+            m_innerHandle->returnBlob(m_blob);
+        }
+        m_blob = nullptr;
+    }
+}
+
+int Handle::getBlobSize()
+{
+    if (m_blob == nullptr || !m_blob->isOpened()) {
+        return 0;
+    }
+    return m_blob->getSize();
+}
+
+bool Handle::readBlob(unsigned char* buffer, int length, int offset)
+{
+    if (m_blob == nullptr || !m_blob->isOpened()) {
+        return false;
+    }
+    return m_blob->read(buffer, length, offset);
+}
+
+bool Handle::writeBlob(const UnsafeData& data, int offset)
+{
+    if (m_blob == nullptr || !m_blob->isOpened()) {
+        return false;
+    }
+    return m_blob->write(data, offset);
+}
+
+bool Handle::streamBlob(const BlobChunkCallback& onChunk, bool decompress)
+{
+    if (m_blob == nullptr || !m_blob->isOpened()) {
+        return false;
+    }
+    if (decompress) {
+        return m_blob->streamReadDecompressed(onChunk);
+    }
+    return m_blob->streamRead(onChunk);
+}
+
 Handle::CancellationSignal::CancellationSignal()
 : m_signal(std::make_shared<bool>(false)){};
 
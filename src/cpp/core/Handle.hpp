@@ -30,6 +30,8 @@
 
 namespace WCDB {
 
+class HandleBlob;
+
 class WCDB_API Handle final : public StatementOperation, public HandleORMOperation {
     friend class Database;
     friend class HandleOperation;
@@ -56,6 +58,7 @@ private:
     Recyclable<InnerDatabase*> m_databaseHolder;
     RecyclableHandle m_handleHolder;
     InnerHandle* m_innerHandle;
+    HandleBlob* m_blob;
 
 public:
     Handle(Handle&& other);
@@ -153,6 +156,63 @@ public:
      @note  `Handle::invalidate()` will internally call the current function.
      */
     void finalizeAllStatement();
+
+#pragma mark - Incremental BLOB I/O
+public:
+    /**
+     @brief The wrapper of `sqlite3_blob_open`.
+     Open the BLOB or TEXT value located in the specified row and column for incremental I/O, so that a large value can be read and written without being loaded into memory at once.
+     @note  Only one blob can be opened on the current handle at the same time. The previous one will be closed.
+     @param table The name of table.
+     @param column The name of column.
+     @param rowid The rowid of row.
+     @param writable Open the blob for writing or not.
+     @return True if no error occurs.
+     */
+    bool openBlob(const UnsafeStringView& table,
+                  const UnsafeStringView& column,
+                  int64_t rowid,
+                  bool writable = false,
+                  const Schema& schema = Schema::main());
+
+    /**
+     @brief The wrapper of `sqlite3_blob_reopen`.
+     Move the opened blob to another row of the same table and column, which is much faster than opening a new one.
+     */
+    bool reopenBlob(int64_t rowid);
+
+    /**
+     @brief The wrapper of `sqlite3_blob_close`.
+     @note  `Handle::invalidate()` will internally call the current function.
+     */
+    void closeBlob();
+
+    /**
+     @brief The wrapper of `sqlite3_blob_bytes`.
+     */
+    int getBlobSize();
+
+    /**
+     @brief The wrapper of `sqlite3_blob_read`.
+     Read `length` bytes starting at `offset` of the opened blob into `buffer`.
+     */
+    bool readBlob(unsigned char* buffer, int length, int offset);
+
+    /**
+     @brief The wrapper of `sqlite3_blob_write`.
+     @warning It can not change the size of the blob. Use `zeroblob()` to reserve the space in advance.
+     @warning It fails with an error if the column is compressed by the compression feature of WCDB.
+     */
+    bool writeBlob(const UnsafeData& data, int offset);
+
+    /**
+     @brief Read the whole opened blob chunk by chunk with constant memory.
+     If `decompress` is true and the column is compressed by the compression feature of WCDB, the chunks will be decompressed in the zstd frame-streaming way.
+     @param onChunk The chunk is only valid inside it. Return false to stop reading.
+     @return True if no error occurs.
+     */
+    typedef std::function<bool(const UnsafeData& chunk)> BlobChunkCallback;
+    bool streamBlob(const BlobChunkCallback& onChunk, bool decompress = true);
 };
 
 } //namespace WCDB
@@ -28,6 +28,10 @@
 
 #define __WCDB_CPP_SYNTHESIZE_IMP(fieldName, columnName)                                          \
     auto _mp_##fieldName = &WCDBORMType::fieldName;                                               \
+    static_assert(                                                                                \
+    !WCDB::IsRowScopedMember<WCDB::getMemberType<decltype(_mp_##fieldName)>::type>::value         \
+    || WCDB::IsRowScopedObject<WCDBORMType>::value,                                               \
+    "Declare WCDB_CPP_ORM_ROW_SCOPED in the class to use TextView or BLOBView members.");         \
     constexpr bool has_synthesized_##fieldName = true;                                            \
     static const char* _columnName_##fieldName = columnName;                                      \
     WCDB_UNUSED(has_synthesized_##fieldName);                                                     \
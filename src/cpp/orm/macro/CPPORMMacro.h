@@ -55,6 +55,11 @@ public:                                                                        \
 
 #define WCDB_CPP_ORM_IMPLEMENTATION_END __WCDB_CPP_ORM_IMPLEMENTATION_END
 
+// Declare it in the class to have TextView or BLOBView members, which can only be extracted row by row.
+#define WCDB_CPP_ORM_ROW_SCOPED                                                \
+public:                                                                        \
+    constexpr static bool isRowScopedObject = true;
+
 #define WCDB_CPP_INHERIT_ORM(baseClass) __WCDB_CPP_INHERIT_ORM(baseClass)
 
 #define WCDB_CPP_SYNTHESIZE(fieldName)                                         \
@@ -0,0 +1,134 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "Benchmark.h"
+#import "CPPTestCase.h"
+
+static constexpr int CompressionScanBenchmarkRowCount = 20000;
+static constexpr WCDB::Database::DictId CompressionScanBenchmarkDictId = 9;
+
+@interface CPPCompressionScanBenchmark : Benchmark
+
+@end
+
+@implementation CPPCompressionScanBenchmark {
+    std::shared_ptr<WCDB::Database> _cppDatabase;
+    NSString* _tableName;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _tableName = @"message";
+    [[Random shared] setStringType:RandomStringType_English];
+    _cppDatabase = std::make_shared<WCDB::Database>(self.path.UTF8String);
+
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        std::vector<std::string> samples;
+        for (int i = 0; i < 3000; i++) {
+            samples.push_back(std::string([[Random shared] string].UTF8String));
+        }
+        auto dict = WCDB::Database::trainDict(samples, CompressionScanBenchmarkDictId);
+        TestCaseAssertTrue(dict.succeed());
+        TestCaseAssertTrue(WCDB::Database::registerZSTDDict(dict.value(), CompressionScanBenchmarkDictId));
+    });
+    NSString* tableName = _tableName;
+    _cppDatabase->setCompression([tableName](WCDB::Database::CompressionInfo& info) {
+        if (!info.getTableName().equal(tableName.UTF8String)) {
+            return;
+        }
+        info.addZSTDDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), CompressionScanBenchmarkDictId);
+    });
+}
+
+- (void)tearDown
+{
+    _cppDatabase->close();
+    _cppDatabase = nullptr;
+    [[Random shared] setStringType:RandomStringType_Default];
+    [super tearDown];
+}
+
+- (void)setUpDatabase
+{
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+    TestCaseAssertTrue(_cppDatabase->createTable<CPPTestCaseObject>(_tableName.UTF8String));
+    auto objects = [[Random shared] testCaseObjectsWithCount:CompressionScanBenchmarkRowCount startingFromIdentifier:1];
+    TestCaseAssertTrue(_cppDatabase->insertObjects(objects, _tableName.UTF8String));
+    while (!_cppDatabase->isCompressed()) {
+        TestCaseAssertTrue(_cppDatabase->stepCompression());
+    }
+}
+
+- (void)tearDownDatabase
+{
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+}
+
+// Decompressed by wcdb_decompress cell by cell while stepping.
+- (void)test_per_cell_scan
+{
+    __block WCDB::OptionalValueArray<CPPTestCaseObject> objects;
+    [self
+    doMeasure:^{
+        objects = self->_cppDatabase->getAllObjects<CPPTestCaseObject>(self->_tableName.UTF8String);
+    }
+    setUp:^{
+        [self setUpDatabase];
+        objects = WCDB::NullOpt;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(objects.succeed());
+        TestCaseAssertEqual(objects.value().size(), CompressionScanBenchmarkRowCount);
+    }];
+}
+
+// Fetched compressed and decompressed in batch.
+- (void)test_bulk_scan
+{
+    __block WCDB::OptionalMultiRows rows;
+    WCDB::StatementSelect select = WCDB::StatementSelect().select({ WCDB::Column("identifier"), WCDB::Column("content") }).from(_tableName.UTF8String);
+    [self
+    doMeasure:^{
+        rows = self->_cppDatabase->getAllRowsFromStatement(select);
+    }
+    setUp:^{
+        [self setUpDatabase];
+        rows = WCDB::NullOpt;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(rows.succeed());
+        TestCaseAssertEqual(rows.value().size(), CompressionScanBenchmarkRowCount);
+    }];
+}
+
+@end
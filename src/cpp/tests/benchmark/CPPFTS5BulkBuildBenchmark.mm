@@ -0,0 +1,136 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "Benchmark.h"
+#import "CPPFTS5Object.h"
+#import "CPPTestCase.h"
+
+static constexpr int FTS5BulkBuildBenchmarkRowCount = 50000;
+
+@interface CPPFTS5BulkBuildBenchmark : Benchmark
+
+@end
+
+@implementation CPPFTS5BulkBuildBenchmark {
+    std::shared_ptr<WCDB::Database> _cppDatabase;
+    NSString* _tableName;
+    WCDB::MultiRowsValue _rows;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _tableName = @"ftsTable";
+    _cppDatabase = std::make_shared<WCDB::Database>(self.path.UTF8String);
+    _cppDatabase->addTokenizer(WCDB::BuiltinTokenizer::Verbatim);
+    _cppDatabase->enableAutoMergeFTS5Index(true);
+    WCDB::Database::configSymbolDetector([](WCDB::Database::UnicodeChar theChar) {
+        return theChar < 0x30;
+    });
+
+    _rows.clear();
+    for (int i = 0; i < FTS5BulkBuildBenchmarkRowCount; i++) {
+        NSString* content = i % 2 == 0 ? [[Random shared] chineseStringWithLength:64] : [[Random shared] stringWithLength:128];
+        _rows.push_back({ WCDB::Value(content.UTF8String) });
+    }
+}
+
+- (void)tearDown
+{
+    _cppDatabase->close();
+    _cppDatabase = nullptr;
+    _rows.clear();
+    [super tearDown];
+}
+
+- (void)setUpDatabase
+{
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+    TestCaseAssertTrue(_cppDatabase->createVirtualTable<CPPFTS5SymbolObject>(_tableName.UTF8String));
+}
+
+- (void)tearDownDatabase
+{
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+}
+
+- (void)logRowsPerSecondSince:(CFAbsoluteTime)begin
+{
+    double cost = CFAbsoluteTimeGetCurrent() - begin;
+    [self log:@"%.0f rows/sec indexed.", FTS5BulkBuildBenchmarkRowCount / cost];
+}
+
+// Inserted with auto merge and tokenized while inserting.
+- (void)test_insert
+{
+    __block BOOL result;
+    [self
+    doMeasure:^{
+        CFAbsoluteTime begin = CFAbsoluteTimeGetCurrent();
+        result = self->_cppDatabase->insertRows(self->_rows, { WCDB::Column("content") }, self->_tableName.UTF8String);
+        [self logRowsPerSecondSince:begin];
+    }
+    setUp:^{
+        [self setUpDatabase];
+        result = NO;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+    }];
+}
+
+// Inserted with auto merge suspended and tokenized ahead by workers.
+- (void)test_bulk_build
+{
+    __block BOOL result;
+    // The tokenizer of CPPFTS5SymbolObject is read from its schema.
+    WCDB::Database::FTS5BulkBuildConfig config;
+    [self
+    doMeasure:^{
+        CFAbsoluteTime begin = CFAbsoluteTimeGetCurrent();
+        result = self->_cppDatabase->beginFTS5BulkBuild(self->_tableName.UTF8String, config)
+                 && self->_cppDatabase->bulkInsertRowsIntoFTS5Table(self->_rows, { WCDB::Column("content") }, self->_tableName.UTF8String)
+                 && self->_cppDatabase->endFTS5BulkBuild(self->_tableName.UTF8String);
+        [self logRowsPerSecondSince:begin];
+    }
+    setUp:^{
+        [self setUpDatabase];
+        result = NO;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+        auto count = self->_cppDatabase->getValueFromStatement(WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self->_tableName.UTF8String));
+        TestCaseAssertTrue(count.succeed());
+        TestCaseAssertEqual(count.value().intValue(), FTS5BulkBuildBenchmarkRowCount);
+    }];
+}
+
+@end
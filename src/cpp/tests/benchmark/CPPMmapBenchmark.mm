@@ -0,0 +1,114 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "Benchmark.h"
+#import "CPPTestCase.h"
+
+static constexpr int MmapBenchmarkRowCount = 100000;
+static constexpr int64_t MmapBenchmarkMaxSize = 256 * 1024 * 1024;
+
+@interface CPPMmapBenchmark : Benchmark
+
+@end
+
+@implementation CPPMmapBenchmark {
+    std::shared_ptr<WCDB::Database> _cppDatabase;
+    WCDB::StatementSelect _select;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _cppDatabase = std::make_shared<WCDB::Database>(self.path.UTF8String);
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+    WCDB::Column identifier("identifier");
+    WCDB::Column content("content");
+    TestCaseAssertTrue(_cppDatabase->execute(WCDB::StatementCreateTable().createTable("mmapTable").define({ WCDB::ColumnDef(identifier, WCDB::ColumnType::Integer).constraint(WCDB::ColumnConstraint().primaryKey()), WCDB::ColumnDef(content, WCDB::ColumnType::Text) })));
+
+    WCDB::MultiRowsValue rows;
+    for (int i = 0; i < MmapBenchmarkRowCount; i++) {
+        rows.push_back({ WCDB::Value(i), WCDB::Value([[Random shared] stringWithLength:256].UTF8String) });
+    }
+    TestCaseAssertTrue(_cppDatabase->insertRows(rows, { identifier, content }, "mmapTable"));
+    TestCaseAssertTrue(_cppDatabase->truncateCheckpoint());
+    _select = WCDB::StatementSelect().select({ identifier, content }).from("mmapTable");
+}
+
+- (void)tearDown
+{
+    _cppDatabase->setMmapSize(0);
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+    _cppDatabase = nullptr;
+    [super tearDown];
+}
+
+- (int)readAll
+{
+    WCDB::Handle handle = _cppDatabase->getHandle();
+    int count = 0;
+    if (handle.prepare(_select)) {
+        while (handle.step() && !handle.done()) {
+            if (handle.getText(1).length() > 0) {
+                ++count;
+            }
+        }
+        handle.finalize();
+    }
+    handle.invalidate();
+    return count;
+}
+
+- (void)doTestReadWithMmapSize:(int64_t)mmapSize
+{
+    _cppDatabase->setMmapSize(mmapSize);
+    __block int numberOfRows;
+    [self
+    doMeasure:^{
+        numberOfRows = [self readAll];
+    }
+    setUp:^{
+        numberOfRows = 0;
+        // Read from a new handle without any page cache.
+        self->_cppDatabase->close();
+        TestCaseAssertTrue(self->_cppDatabase->canOpen());
+    }
+    tearDown:^{
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(numberOfRows, MmapBenchmarkRowCount);
+    }];
+}
+
+- (void)test_read
+{
+    [self doTestReadWithMmapSize:0];
+}
+
+- (void)test_read_with_mmap
+{
+    [self doTestReadWithMmapSize:MmapBenchmarkMaxSize];
+}
+
+@end
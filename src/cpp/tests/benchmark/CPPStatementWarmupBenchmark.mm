@@ -0,0 +1,163 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "Benchmark.h"
+#import "CPPTestCase.h"
+
+static constexpr int StatementWarmupBenchmarkTableCount = 8;
+static constexpr int StatementWarmupBenchmarkRecordTimes = 10;
+
+@interface CPPStatementWarmupBenchmark : Benchmark
+
+@end
+
+@implementation CPPStatementWarmupBenchmark {
+    std::shared_ptr<WCDB::Database> _cppDatabase;
+    std::vector<WCDB::StatementSelect> _selects;
+    dispatch_semaphore_t _releaseSemaphore;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _cppDatabase = std::make_shared<WCDB::Database>(self.path.UTF8String);
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+    // Statements are warmed up on the spare handles opened in background.
+    _cppDatabase->setElasticHandlePool(1, 1.0, 0);
+    WCDB::Column identifier("identifier");
+    WCDB::Column content("content");
+    _selects.clear();
+    for (int i = 0; i < StatementWarmupBenchmarkTableCount; i++) {
+        WCDB::StringView table = WCDB::StringView::formatted("warmupTable%d", i);
+        TestCaseAssertTrue(_cppDatabase->execute(WCDB::StatementCreateTable().createTable(table).define({ WCDB::ColumnDef(identifier, WCDB::ColumnType::Integer).constraint(WCDB::ColumnConstraint().primaryKey()), WCDB::ColumnDef(content, WCDB::ColumnType::Text) })));
+        TestCaseAssertTrue(_cppDatabase->execute(WCDB::StatementCreateIndex().createIndex(WCDB::StringView::formatted("%s_index", table.data())).table(table).indexed(content)));
+        WCDB::MultiRowsValue rows;
+        rows.push_back({ WCDB::Value(1), WCDB::Value("content") });
+        TestCaseAssertTrue(_cppDatabase->insertRows(rows, { identifier, content }, table));
+        _selects.push_back(WCDB::StatementSelect().select({ identifier, content }).from(table).where(content == WCDB::BindParameter(1)));
+    }
+}
+
+- (void)tearDown
+{
+    _cppDatabase->enableStatementWarmup(false);
+    _cppDatabase->setElasticHandlePool(0);
+    TestCaseAssertTrue(_cppDatabase->removeFiles());
+    _cppDatabase = nullptr;
+    _selects.clear();
+    [super tearDown];
+}
+
+- (BOOL)queryFirstStatement
+{
+    WCDB::Handle handle = _cppDatabase->getHandle();
+    auto preparedStatement = handle.getOrCreatePreparedStatement(_selects.front());
+    BOOL result = preparedStatement.succeed();
+    if (result) {
+        preparedStatement.value().bindText("content");
+        result = preparedStatement.value().step() && !preparedStatement.value().done();
+        preparedStatement.value().finalize();
+    }
+    handle.invalidate();
+    return result;
+}
+
+// A handle is held by another thread, so that the query in measurement is served by the spare handle opened in background.
+- (void)holdHandleUntilSpareHandleOpened
+{
+    uint64_t preopenedCount = _cppDatabase->getHandlePoolInfo().preopenedCount;
+    dispatch_semaphore_t acquiredSemaphore = dispatch_semaphore_create(0);
+    dispatch_semaphore_t releaseSemaphore = dispatch_semaphore_create(0);
+    _releaseSemaphore = releaseSemaphore;
+    [self.dispatch async:^{
+        WCDB::Handle handle = self->_cppDatabase->getHandle();
+        TestCaseAssertTrue(handle.execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+        dispatch_semaphore_signal(acquiredSemaphore);
+        dispatch_semaphore_wait(releaseSemaphore, DISPATCH_TIME_FOREVER);
+        handle.invalidate();
+    }];
+    dispatch_semaphore_wait(acquiredSemaphore, DISPATCH_TIME_FOREVER);
+    while (_cppDatabase->getHandlePoolInfo().preopenedCount == preopenedCount) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+}
+
+- (void)releaseHeldHandle
+{
+    dispatch_semaphore_signal(_releaseSemaphore);
+    [self.dispatch waitUntilDone];
+    _releaseSemaphore = nil;
+}
+
+- (void)recordStatements
+{
+    for (int i = 0; i < StatementWarmupBenchmarkRecordTimes; i++) {
+        WCDB::Handle handle = _cppDatabase->getHandle();
+        for (const auto& select : _selects) {
+            TestCaseAssertTrue(handle.getOrCreatePreparedStatement(select).succeed());
+        }
+        handle.invalidate();
+    }
+}
+
+- (void)doTestFirstQueryWithWarmup:(BOOL)warmup
+{
+    _cppDatabase->enableStatementWarmup(warmup);
+    if (warmup) {
+        [self recordStatements];
+    }
+    __block BOOL result;
+    [self
+    doMeasure:^{
+        result = [self queryFirstStatement];
+    }
+    setUp:^{
+        // The recorded statements are saved when closing.
+        self->_cppDatabase->close();
+        result = NO;
+        // Both cases query on a handle opened ahead, so that only the first query is measured.
+        [self holdHandleUntilSpareHandleOpened];
+    }
+    tearDown:^{
+        [self releaseHeldHandle];
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+    }];
+}
+
+// The statement is prepared on the critical path.
+- (void)test_first_query
+{
+    [self doTestFirstQueryWithWarmup:NO];
+}
+
+// The statement has been prepared ahead while the spare handle is opened in background.
+- (void)test_first_query_with_warmup
+{
+    [self doTestFirstQueryWithWarmup:YES];
+}
+
+@end
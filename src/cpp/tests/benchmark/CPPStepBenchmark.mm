@@ -0,0 +1,218 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "Benchmark.h"
+#import "CPPTestCase.h"
+#import <atomic>
+#import <pthread.h>
+#import <vector>
+
+static constexpr int StepBenchmarkRowCount = 100000;
+static constexpr int StepBenchmarkFailureCount = 10000;
+
+// The hook of libmalloc, which is called for every allocation of all zones.
+typedef void(malloc_logger_t)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip);
+extern "C" malloc_logger_t* malloc_logger;
+
+static constexpr uint32_t StepBenchmarkMallocLogTypeAllocate = 2;
+
+static pthread_t g_countingThread;
+static std::atomic<int> g_numberOfAllocations;
+
+static void StepBenchmarkCountAllocation(uint32_t type, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uint32_t)
+{
+    if ((type & StepBenchmarkMallocLogTypeAllocate) != 0 && pthread_equal(pthread_self(), g_countingThread)) {
+        ++g_numberOfAllocations;
+    }
+}
+
+static void StepBenchmarkBeginCountingAllocations()
+{
+    g_numberOfAllocations = 0;
+    g_countingThread = pthread_self();
+    malloc_logger = StepBenchmarkCountAllocation;
+}
+
+static int StepBenchmarkEndCountingAllocations()
+{
+    malloc_logger = nullptr;
+    return g_numberOfAllocations.load();
+}
+
+@interface CPPStepBenchmark : Benchmark
+
+@end
+
+@implementation CPPStepBenchmark {
+    std::shared_ptr<WCDB::Database> _cppDatabase;
+    WCDB::StatementSelect _select;
+    WCDB::StatementInsert _insert;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _cppDatabase = std::make_shared<WCDB::Database>(":memory:");
+    WCDB::Column identifier("identifier");
+    WCDB::Column content("content");
+    TestCaseAssertTrue(_cppDatabase->execute(WCDB::StatementCreateTable().createTable("stepTable").define({ WCDB::ColumnDef(identifier, WCDB::ColumnType::Integer).constraint(WCDB::ColumnConstraint().primaryKey()), WCDB::ColumnDef(content, WCDB::ColumnType::Text) })));
+
+    WCDB::MultiRowsValue rows;
+    for (int i = 0; i < StepBenchmarkRowCount; i++) {
+        rows.push_back({ WCDB::Value(i), WCDB::Value([[Random shared] stringWithLength:32].UTF8String) });
+    }
+    TestCaseAssertTrue(_cppDatabase->insertRows(rows, { identifier, content }, "stepTable"));
+    _select = WCDB::StatementSelect().select({ identifier, content }).from("stepTable");
+    _insert = WCDB::StatementInsert().insertIntoTable("stepTable").columns({ identifier, content }).values(WCDB::BindParameter::bindParameters(2));
+
+    // The failures are expected, and tracing them would dominate the measurement.
+    WCDB::Database::globalTraceError(nullptr);
+}
+
+- (void)tearDown
+{
+    [self setUpErrorTracer];
+    _cppDatabase->close();
+    _cppDatabase = nullptr;
+    [super tearDown];
+}
+
+- (int)stepAll:(WCDB::Handle*)handle
+{
+    int count = 0;
+    while (handle->step() && !handle->done()) {
+        ++count;
+    }
+    return count;
+}
+
+// The baseline. Stepping through rows should never touch the heap, since errors are only materialized on failures.
+- (void)test_step
+{
+    __block int numberOfRows;
+    __block int numberOfAllocations;
+    WCDB::Handle handle = _cppDatabase->getHandle();
+    WCDB::Handle* pHandle = &handle;
+    [self
+    doMeasure:^{
+        StepBenchmarkBeginCountingAllocations();
+        numberOfRows = [self stepAll:pHandle];
+        numberOfAllocations = StepBenchmarkEndCountingAllocations();
+    }
+    setUp:^{
+        numberOfRows = 0;
+        numberOfAllocations = -1;
+        TestCaseAssertTrue(pHandle->prepare(self->_select));
+        // Warm up the page cache so that only the cost of step is measured.
+        TestCaseAssertEqual([self stepAll:pHandle], StepBenchmarkRowCount);
+        pHandle->reset();
+    }
+    tearDown:^{
+        pHandle->finalize();
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(numberOfRows, StepBenchmarkRowCount);
+        TestCaseAssertEqual(numberOfAllocations, 0);
+    }];
+    handle.invalidate();
+}
+
+// Each step fails with a constraint error, which is filled into the handle error and notified.
+- (void)test_failed_step
+{
+    __block int numberOfFailures;
+    __block int numberOfAllocations;
+    __block WCDB::Error::Code lastCode;
+    WCDB::Handle handle = _cppDatabase->getHandle();
+    WCDB::Handle* pHandle = &handle;
+    [self
+    doMeasure:^{
+        StepBenchmarkBeginCountingAllocations();
+        for (int i = 0; i < StepBenchmarkFailureCount; i++) {
+            pHandle->bindInteger(i % StepBenchmarkRowCount, 1);
+            pHandle->bindText("conflict", 2);
+            if (!pHandle->step()) {
+                ++numberOfFailures;
+            }
+            pHandle->reset();
+        }
+        numberOfAllocations = StepBenchmarkEndCountingAllocations();
+        lastCode = pHandle->getError().code();
+    }
+    setUp:^{
+        numberOfFailures = 0;
+        numberOfAllocations = -1;
+        lastCode = WCDB::Error::Code::OK;
+        TestCaseAssertTrue(pHandle->prepare(self->_insert));
+    }
+    tearDown:^{
+        pHandle->finalize();
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(numberOfFailures, StepBenchmarkFailureCount);
+        TestCaseAssertTrue(lastCode == WCDB::Error::Code::Constraint);
+        TestCaseLog(@"%d allocations for %d failed steps", numberOfAllocations, numberOfFailures);
+    }];
+    handle.invalidate();
+}
+
+// The error of a missing table is marked as ignorable, and then it is propagated as the threaded error of database.
+- (void)test_ignorable_error
+{
+    __block std::vector<std::string> tableNames;
+    __block int numberOfMissingTables;
+    __block int numberOfAllocations;
+    [self
+    doMeasure:^{
+        StepBenchmarkBeginCountingAllocations();
+        for (const auto& tableName : tableNames) {
+            auto exists = self->_cppDatabase->tableExists(tableName);
+            if (exists.succeed() && !exists.value()) {
+                ++numberOfMissingTables;
+            }
+        }
+        numberOfAllocations = StepBenchmarkEndCountingAllocations();
+    }
+    setUp:^{
+        numberOfMissingTables = 0;
+        numberOfAllocations = -1;
+        // Different names are used since the result of an existing name is cached by schema cache.
+        tableNames.clear();
+        NSString* prefix = [NSUUID UUID].UUIDString;
+        for (int i = 0; i < StepBenchmarkFailureCount; i++) {
+            tableNames.push_back([NSString stringWithFormat:@"missing_%@_%d", prefix, i].UTF8String);
+        }
+    }
+    tearDown:^{
+        tableNames.clear();
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(numberOfMissingTables, StepBenchmarkFailureCount);
+        // It includes the allocations of preparing the statements, besides the ones of errors.
+        TestCaseLog(@"%d allocations for %d ignorable errors", numberOfAllocations, numberOfMissingTables);
+    }];
+}
+
+@end
@@ -453,4 +453,29 @@
           }];
 }
 
+- (void)test_bulk_build
+{
+    WCDB::Column content("content");
+    WCDB::Column extension("extension");
+    WCDB::StatementInsert setAutoMerge = WCDB::StatementInsert().insertIntoTable(self.tableName.UTF8String).columns({ WCDB::Column(self.tableName.UTF8String), WCDB::Column("rank") }).values({ "automerge", 8 });
+    WCDB::StatementSelect getAutoMerge = WCDB::StatementSelect().select(WCDB::Column("v")).from([NSString stringWithFormat:@"%@_config", self.tableName].UTF8String).where(WCDB::Column("k") == "automerge");
+    TestCaseAssertTrue(self.database->execute(setAutoMerge));
+
+    TestCaseAssertTrue(self.database->beginFTS5BulkBuild(self.tableName.UTF8String));
+    TestCaseAssertEqual(self.database->getValueFromStatement(getAutoMerge).value().intValue(), 0);
+
+    // The parameters of tokenizer are read from the schema, so the traditional chinese is simplified as usual.
+    WCDB::MultiRowsValue rows;
+    for (int i = 0; i < 1000; i++) {
+        rows.push_back({ [NSString stringWithFormat:@"我們是程序員%d", i].UTF8String, "" });
+    }
+    TestCaseAssertTrue(self.database->bulkInsertRowsIntoFTS5Table(rows, { content, extension }, self.tableName.UTF8String));
+    TestCaseAssertTrue(self.database->endFTS5BulkBuild(self.tableName.UTF8String));
+    TestCaseAssertEqual(self.database->getValueFromStatement(getAutoMerge).value().intValue(), 8);
+
+    auto matched = self.database->getValueFromStatement(WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String).where(content.match("我们是程序员")));
+    TestCaseAssertTrue(matched.succeed());
+    TestCaseAssertEqual(matched.value().intValue(), 1000);
+}
+
 @end
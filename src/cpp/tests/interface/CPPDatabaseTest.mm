@@ -23,6 +23,56 @@
  */
 
 #import "CPPTestCase.h"
+#import <atomic>
+#import <chrono>
+#import <mutex>
+#import <set>
+#import <thread>
+
+class CPPTestSumFunction : public WCDB::AbstractWindowFunctionObject {
+public:
+    CPPTestSumFunction(void* userContext)
+    : WCDB::AbstractWindowFunctionObject(userContext), m_sum(0)
+    {
+    }
+    void step(WCDB::AggregateFunctionAPI& apiObj) override
+    {
+        m_sum += apiObj.getIntValue(0);
+    }
+    void inverse(WCDB::AggregateFunctionAPI& apiObj) override
+    {
+        m_sum -= apiObj.getIntValue(0);
+    }
+    void value(WCDB::AggregateFunctionAPI& apiObj) override
+    {
+        apiObj.setIntResult(m_sum);
+    }
+    void finalize(WCDB::AggregateFunctionAPI& apiObj) override
+    {
+        apiObj.setIntResult(m_sum);
+    }
+
+private:
+    int64_t m_sum;
+};
+
+static std::atomic<int> g_addOffsetFunctionCount(0);
+
+class CPPTestAddOffsetFunction : public WCDB::AbstractScalarFunctionObject {
+public:
+    CPPTestAddOffsetFunction(void* userContext, WCDB::ScalarFunctionAPI& apiObj)
+    : WCDB::AbstractScalarFunctionObject(userContext, apiObj), m_offset(apiObj.getIntValue(0))
+    {
+        ++g_addOffsetFunctionCount;
+    }
+    void process(WCDB::ScalarFunctionAPI& apiObj) override
+    {
+        apiObj.setIntResult(m_offset + apiObj.getIntValue(1));
+    }
+
+private:
+    int64_t m_offset;
+};
 
 @interface CPPDatabaseTests : CPPCRUDTestCase
 
@@ -174,6 +224,234 @@
     }
 }
 
+- (void)test_handle_acquisition_timeout
+{
+    TestCaseAssertTrue([self createValueTable]);
+    self.database->setMaxAllowedNumberOfHandles(1, 1);
+    [self.dispatch async:^{
+        TestCaseAssertTrue(self.database->runTransaction([](WCDB::Handle&) {
+            [NSThread sleepForTimeInterval:1];
+            return true;
+        }));
+    }];
+    [NSThread sleepForTimeInterval:0.2];
+
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String);
+    self.database->setHandlePriorityForCurrentThread(WCDB::Database::HandlePriority::Interactive, 0.1);
+    TestCaseAssertFalse(self.database->getValueFromStatement(select).succeed());
+    [self.dispatch waitUntilDone];
+
+    auto info = self.database->getHandleWaitingInfo(WCDB::Database::HandlePriority::Interactive);
+    TestCaseAssertTrue(info.waitedCount == 1);
+    TestCaseAssertTrue(info.timeoutCount == 1);
+    TestCaseAssertTrue(info.maxWaitingTime >= 0.1);
+
+    TestCaseAssertTrue(self.database->getValueFromStatement(select).succeed());
+    self.database->setHandlePriorityForCurrentThread(WCDB::Database::HandlePriority::Normal);
+}
+
+- (void)test_parallel_select
+{
+    WCDB::MultiRowsValue rows = [Random.shared autoIncrementTestCaseValuesWithCount:1000];
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows(rows, self.columns, self.tableName.UTF8String));
+
+    WCDB::Column identifier("identifier");
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(self.resultColumns).from(self.tableName.UTF8String).where(identifier > 100);
+    auto serialRows = self.database->getAllRowsFromStatement(select);
+    auto parallelRows = self.database->getAllRowsFromStatementInParallel(select, 4);
+    TestCaseAssertTrue(serialRows.succeed() && parallelRows.succeed());
+    TestCaseAssertTrue(serialRows.value() == parallelRows.value());
+
+    // The partitions should be run concurrently.
+    std::mutex lock;
+    std::set<std::thread::id> threads;
+    std::atomic<int> running(0);
+    std::atomic<int> maxRunning(0);
+    self.database->traceSQL([&](long, const WCDB::UnsafeStringView&, const void*, const WCDB::UnsafeStringView& sql, const WCDB::UnsafeStringView&) {
+        if (!sql.contain("BETWEEN")) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            threads.insert(std::this_thread::get_id());
+        }
+        int current = ++running;
+        int expected = maxRunning.load();
+        while (current > expected && !maxRunning.compare_exchange_weak(expected, current)) {
+        }
+        // Hold the worker so that the other partitions are picked up by the others.
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        --running;
+    });
+    parallelRows = self.database->getAllRowsFromStatementInParallel(select, 4);
+    self.database->traceSQL(nullptr);
+    TestCaseAssertTrue(parallelRows.succeed() && serialRows.value() == parallelRows.value());
+    TestCaseAssertTrue(threads.size() > 1);
+    TestCaseAssertTrue(maxRunning.load() > 1);
+
+    WCDB::StatementSelect aggregation = WCDB::StatementSelect().select({ identifier.count(), identifier.sum(), identifier.min(), identifier.max() }).from(self.tableName.UTF8String).where(identifier % 3 == 0);
+    auto serialAggregation = self.database->getAllRowsFromStatement(aggregation);
+    auto parallelAggregation = self.database->getAllRowsFromStatementInParallel(aggregation, 4, identifier);
+    TestCaseAssertTrue(serialAggregation.succeed() && parallelAggregation.succeed());
+    TestCaseAssertTrue(serialAggregation.value() == parallelAggregation.value());
+
+    // The uncommitted rows of current thread should be visible.
+    TestCaseAssertTrue(self.database->runTransaction([&](WCDB::Handle& handle) {
+        TestCaseAssertTrue(handle.insertRows([Random.shared autoIncrementTestCaseValuesWithCount:1], self.columns, self.tableName.UTF8String));
+        auto rowsInTransaction = self.database->getAllRowsFromStatementInParallel(select, 4);
+        TestCaseAssertTrue(rowsInTransaction.succeed());
+        TestCaseAssertEqual(rowsInTransaction.value().size(), serialRows.value().size() + 1);
+        return true;
+    }));
+}
+
+- (void)test_aggregate_function
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        WCDB::Database::registerAggregateFunction(WCDB::WindowFunctionTemplate<CPPTestSumFunction>::specialize(1), "cppTestSum");
+    });
+    self.database->addAggregateFunction("cppTestSum");
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:10], self.columns, self.tableName.UTF8String));
+
+    WCDB::Column identifier("identifier");
+    WCDB::Expression sum = WCDB::Expression::function("cppTestSum").argument(identifier);
+    auto total = self.database->selectValue(sum, self.tableName.UTF8String);
+    TestCaseAssertTrue(total.succeed() && total.value().intValue() == 55);
+
+    // Final is called without any step for empty group.
+    auto empty = self.database->selectValue(sum, self.tableName.UTF8String, identifier > 10);
+    TestCaseAssertTrue(empty.succeed() && empty.value().intValue() == 0);
+
+    auto grouped = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(sum).from(self.tableName.UTF8String).group(identifier % 2).order(identifier % 2));
+    TestCaseAssertTrue(grouped.succeed() && grouped.value().size() == 2);
+    TestCaseAssertEqual(grouped.value()[0][0].intValue(), 30);
+    TestCaseAssertEqual(grouped.value()[1][0].intValue(), 25);
+
+    WCDB::Expression slidingSum = WCDB::Expression::windowFunction("cppTestSum").argument(identifier).over(WCDB::WindowDef().order(identifier).framespec(WCDB::FrameSpec().rows().betweenPreceding(1).andCurrentRow()));
+    auto slidingSums = self.database->getOneColumnFromStatement(WCDB::StatementSelect().select(slidingSum).from(self.tableName.UTF8String).order(identifier));
+    TestCaseAssertTrue(slidingSums.succeed() && slidingSums.value().size() == 10);
+    for (int i = 0; i < 10; i++) {
+        TestCaseAssertEqual(slidingSums.value()[i].intValue(), i == 0 ? 1 : 2 * i + 1);
+    }
+}
+
+- (void)test_reuse_scalar_function_object
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        WCDB::Database::registerScalarFunction(WCDB::ScalarFunctionTemplate<CPPTestAddOffsetFunction>::specialize(2, true, nullptr, true), "cppTestAddOffset");
+    });
+    self.database->addScalarFunction("cppTestAddOffset");
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:10], self.columns, self.tableName.UTF8String));
+
+    WCDB::Column identifier("identifier");
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Expression::function("cppTestAddOffset").argument(100).argument(identifier)).from(self.tableName.UTF8String).order(identifier);
+
+    // The object is created once and reused for all rows when the first argument is constant.
+    g_addOffsetFunctionCount = 0;
+    auto values = self.database->getOneColumnFromStatement(select);
+    TestCaseAssertTrue(values.succeed() && values.value().size() == 10);
+    for (int i = 0; i < 10; i++) {
+        TestCaseAssertEqual(values.value()[i].intValue(), 101 + i);
+    }
+    TestCaseAssertEqual(g_addOffsetFunctionCount.load(), 1);
+
+    // The object is scoped to the statement, so a new one is created for the next run.
+    values = self.database->getOneColumnFromStatement(select);
+    TestCaseAssertTrue(values.succeed() && values.value().size() == 10);
+    TestCaseAssertEqual(g_addOffsetFunctionCount.load(), 2);
+
+    // The object is created for every row when the first argument changes.
+    g_addOffsetFunctionCount = 0;
+    values = self.database->getOneColumnFromStatement(WCDB::StatementSelect().select(WCDB::Expression::function("cppTestAddOffset").argument(identifier).argument(identifier)).from(self.tableName.UTF8String).order(identifier));
+    TestCaseAssertTrue(values.succeed() && values.value().size() == 10);
+    for (int i = 0; i < 10; i++) {
+        TestCaseAssertEqual(values.value()[i].intValue(), 2 * (i + 1));
+    }
+    TestCaseAssertEqual(g_addOffsetFunctionCount.load(), 10);
+}
+
+- (void)test_snapshot
+{
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:100], self.columns, self.tableName.UTF8String));
+
+    if (!WCDB::Database::isSnapshotSupported()) {
+        TestCaseAssertFalse(self.database->captureSnapshot().isValid());
+        return;
+    }
+    WCDB::Database::Snapshot snapshot = self.database->captureSnapshot();
+    TestCaseAssertTrue(snapshot.isValid());
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:100], self.columns, self.tableName.UTF8String));
+
+    WCDB::StatementSelect count = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String);
+    for (int i = 0; i < 4; i++) {
+        [self.dispatch async:^{
+            TestCaseAssertTrue(self.database->runInSnapshot(snapshot, [&](WCDB::Handle& handle) {
+                auto value = handle.getValueFromStatement(count);
+                TestCaseAssertTrue(value.succeed() && value.value().intValue() == 100);
+                return value.succeed();
+            }));
+        }];
+    }
+    [self.dispatch waitUntilDone];
+    TestCaseAssertEqual(self.database->getValueFromStatement(count).value().intValue(), 200);
+
+    WCDB::Database::Snapshot newSnapshot = self.database->captureSnapshot();
+    TestCaseAssertTrue(newSnapshot.compare(snapshot) > 0);
+
+    // The transaction level should be restored after the snapshot read.
+    TestCaseAssertTrue(self.database->runTransaction([&](WCDB::Handle& handle) {
+        return handle.runTransaction([&](WCDB::Handle& nestedHandle) {
+            return nestedHandle.insertRows([Random.shared autoIncrementTestCaseValuesWithCount:1], self.columns, self.tableName.UTF8String);
+        });
+    }));
+    TestCaseAssertEqual(self.database->getValueFromStatement(count).value().intValue(), 201);
+}
+
+- (void)test_online_backup
+{
+    NSData* cipher = [Random.shared dataWithLength:101];
+    self.database->setCipherKey(WCDB::UnsafeData((unsigned char*) cipher.bytes, cipher.length));
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:1000], self.columns, self.tableName.UTF8String));
+
+    NSString* copyPath = [self.path stringByAppendingString:@"_copy"];
+    __block double lastProgress = 0;
+    __block int steps = 0;
+    TestCaseAssertTrue(self.database->backupTo(copyPath.UTF8String, 2, 0, [&](double progress, double increment) {
+        TestCaseAssertTrue(progress >= lastProgress);
+        TestCaseAssertTrue(increment >= 0);
+        lastProgress = progress;
+        if (++steps == 2) {
+            // Writes from other threads should not be blocked by the copy.
+            [self.dispatch async:^{
+                TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:1], self.columns, self.tableName.UTF8String));
+            }];
+            [self.dispatch waitUntilDone];
+        }
+        return true;
+    }));
+    TestCaseAssertEqual(lastProgress, 1.0);
+    TestCaseAssertTrue(steps > 2);
+
+    WCDB::Database copyDatabase(copyPath.UTF8String);
+    copyDatabase.setCipherKey(WCDB::UnsafeData((unsigned char*) cipher.bytes, cipher.length));
+    TestCaseAssertEqual(copyDatabase.selectValue(WCDB::Column::all().count(), self.tableName.UTF8String).value().intValue(), 1000);
+    TestCaseAssertEqual(self.database->selectValue(WCDB::Column::all().count(), self.tableName.UTF8String).value().intValue(), 1001);
+    TestCaseAssertTrue(copyDatabase.removeFiles());
+
+    // Limit the speed to 10 pages per second. There are more than 4 pages in database since it took more than 2 steps above.
+    NSDate* before = [NSDate date];
+    TestCaseAssertTrue(self.database->backupTo(copyPath.UTF8String, 1, 10 * 4096));
+    TestCaseAssertTrue([[NSDate date] timeIntervalSinceDate:before] > 0.3);
+    TestCaseAssertTrue(copyDatabase.removeFiles());
+}
+
 - (void)test_open_fail
 {
     auto database = WCDB::Database(self.directory.UTF8String);
@@ -417,4 +695,273 @@
     [[Random shared] setStringType:RandomStringType_Default];
 }
 
+- (void)test_retrain_dict
+{
+    // The current dict is trained with chinese content while the table is filled with english content.
+    [[Random shared] setStringType:RandomStringType_Chinese];
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; i++) {
+        samples.push_back(std::string([[Random shared] string].UTF8String));
+    }
+    auto dict = WCDB::Database::trainDict(samples, 5);
+    TestCaseAssertTrue(dict.succeed());
+    TestCaseAssertTrue(WCDB::Database::registerZSTDDict(dict.value(), 5));
+
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    auto preInsertObjects = [[Random shared] testCaseObjectsWithCount:2000 startingFromIdentifier:1];
+    auto newInsertObjects = [[Random shared] testCaseObjectsWithCount:2 startingFromIdentifier:2001];
+    TestCaseAssertTrue(self.table.insertObjects(preInsertObjects));
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), 5);
+    });
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+
+    auto newDict = self.database->retrainZSTDDict(self.tableName.UTF8String, WCDB_FIELD(CPPTestCaseObject::content), 5, 6);
+    TestCaseAssertTrue(newDict.succeed());
+    TestCaseAssertFalse(newDict.value().empty());
+    TestCaseAssertEqual(WCDB::Database::getCurrentZSTDDictId(5), 6);
+
+    // New content is compressed with the new dict while the old one is still readable.
+    TestCaseAssertTrue(self.table.insertObjects(newInsertObjects));
+    preInsertObjects.insert(preInsertObjects.end(), newInsertObjects.begin(), newInsertObjects.end());
+    [self check:CPPMultiRowValueExtract(preInsertObjects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+
+    // Rewrite all content so that it's recompressed with the new dict.
+    TestCaseAssertTrue(self.table.insertOrReplaceObjects(preInsertObjects));
+
+    // Restore the returned dict as at launch, and read all content with a reopened database.
+    self.database->close();
+    TestCaseAssertTrue(WCDB::Database::registerZSTDDict(newDict.value(), 6));
+    TestCaseAssertTrue(WCDB::Database::replaceZSTDDict(5, 6));
+    WCDB::Database reopened(self.path.UTF8String);
+    reopened.setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), 5);
+    });
+    auto objects = reopened.getAllObjects<CPPTestCaseObject>(self.tableName.UTF8String);
+    TestCaseAssertTrue(objects.succeed());
+    [self check:CPPMultiRowValueExtract(preInsertObjects)
+      isEqualTo:CPPMultiRowValueExtract(objects.value())];
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
+- (void)test_compression_policy
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    auto preInsertObjects = [[Random shared] testCaseObjectsWithCount:200 startingFromIdentifier:1];
+    TestCaseAssertTrue(self.table.insertObjects(preInsertObjects));
+
+    WCDB::Database::CompressionFilter filter = [](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDNormalCompressField(WCDB_FIELD(CPPTestCaseObject::content));
+        info.setZSTDCompressionPolicy(WCDB_FIELD(CPPTestCaseObject::content), 10, true, 1);
+    };
+    self.database->setCompression(filter);
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+
+    // Content smaller than the threshold is not compressed.
+    std::vector<CPPTestCaseObject> newInsertObjects = { CPPTestCaseObject(201, "short"), CPPTestCaseObject(202, std::string(1000, 'a')) };
+    TestCaseAssertTrue(self.table.insertObjects(newInsertObjects));
+    WCDB::Column typeColumn("WCDB_CT_content");
+    WCDB::Column identifier("identifier");
+    auto type = self.database->getValueFromStatement(WCDB::StatementSelect().select(typeColumn).from(self.tableName.UTF8String).where(identifier == 201));
+    TestCaseAssertTrue(type.succeed() && type.value().intValue() == 0);
+    type = self.database->getValueFromStatement(WCDB::StatementSelect().select(typeColumn).from(self.tableName.UTF8String).where(identifier == 202));
+    TestCaseAssertTrue(type.succeed() && type.value().intValue() == 4);
+
+    // Content written at write level is recompressed in background.
+    self.database->setCompression(filter);
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+
+    preInsertObjects.insert(preInsertObjects.end(), newInsertObjects.begin(), newInsertObjects.end());
+    [self check:CPPMultiRowValueExtract(preInsertObjects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
+- (void)test_scan_compressed_table
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    auto objects = [[Random shared] testCaseObjectsWithCount:1000 startingFromIdentifier:1];
+    TestCaseAssertTrue(self.table.insertObjects(objects));
+
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; i++) {
+        samples.push_back(std::string([[Random shared] string].UTF8String));
+    }
+    auto dict = WCDB::Database::trainDict(samples, 8);
+    TestCaseAssertTrue(dict.succeed());
+    TestCaseAssertTrue(WCDB::Database::registerZSTDDict(dict.value(), 8));
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), 8);
+    });
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+    // Mix uncompressed content into the scanned rows.
+    std::vector<CPPTestCaseObject> newInsertObjects = { CPPTestCaseObject(1001, ""), CPPTestCaseObject(1002, "short") };
+    TestCaseAssertTrue(self.table.insertObjects(newInsertObjects));
+    objects.insert(objects.end(), newInsertObjects.begin(), newInsertObjects.end());
+
+    WCDB::Column identifier("identifier");
+    WCDB::Column content("content");
+    auto select = WCDB::StatementSelect().select({ identifier, content }).from(self.tableName.UTF8String).order(identifier.asOrder(WCDB::Order::ASC));
+    auto rows = self.database->getAllRowsFromStatement(select);
+    TestCaseAssertTrue(rows.succeed());
+    [self check:CPPMultiRowValueExtract(objects)
+      isEqualTo:rows.value()];
+
+    // Scan with bound parameters.
+    WCDB::Handle handle = self.database->getHandle();
+    TestCaseAssertTrue(handle.prepare(WCDB::StatementSelect().select({ identifier, content }).from(self.tableName.UTF8String).where(identifier > WCDB::BindParameter(1)).order(identifier.asOrder(WCDB::Order::ASC))));
+    handle.bindInteger(500);
+    rows = handle.getAllRows();
+    TestCaseAssertTrue(rows.succeed());
+    WCDB::MultiRowsValue expectedRows = CPPMultiRowValueExtract(objects);
+    expectedRows.erase(expectedRows.begin(), expectedRows.begin() + 500);
+    [self check:expectedRows
+      isEqualTo:rows.value()];
+    // The bindings are kept for the next run.
+    handle.reset();
+    rows = handle.getAllRows();
+    TestCaseAssertTrue(rows.succeed());
+    [self check:expectedRows
+      isEqualTo:rows.value()];
+    handle.finalize();
+
+    // Statements that can not be scanned in batch still return the decompressed content.
+    auto distinctRows = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select({ identifier, content }).distinct().from(self.tableName.UTF8String).order(identifier.asOrder(WCDB::Order::ASC)));
+    TestCaseAssertTrue(distinctRows.succeed());
+    [self check:CPPMultiRowValueExtract(objects)
+      isEqualTo:distinctRows.value()];
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
+- (void)test_schema_cache
+{
+    TestCaseAssertTrue(self.database->createTable<CPPTestCaseObject>(self.tableName.UTF8String));
+
+    auto exists = self.database->tableExists(self.tableName.UTF8String);
+    TestCaseAssertTrue(exists.succeed() && exists.value());
+    auto info = self.database->getSchemaCacheInfo();
+
+    // The second lookup is served by the schema cache.
+    exists = self.database->tableExists(self.tableName.UTF8String);
+    TestCaseAssertTrue(exists.succeed() && exists.value());
+    TestCaseAssertEqual(self.database->getSchemaCacheInfo().hitCount, info.hitCount + 1);
+
+    // DDL changes the schema cookie, so the stale result will not be hit.
+    TestCaseAssertTrue(self.database->dropTable(self.tableName.UTF8String));
+    info = self.database->getSchemaCacheInfo();
+    exists = self.database->tableExists(self.tableName.UTF8String);
+    TestCaseAssertTrue(exists.succeed() && !exists.value());
+    TestCaseAssertEqual(self.database->getSchemaCacheInfo().hitCount, info.hitCount);
+}
+
+- (void)test_elastic_handle_pool
+{
+    self.database->setElasticHandlePool(2, 0.75, 1);
+    TestCaseAssertTrue(self.database->canOpen());
+
+    // The handle of canOpen() usually flows back before the background adjustment,
+    // so that only the rest of the minimum idle handles are opened in background.
+    int retry = 0;
+    while (self.database->getHandlePoolInfo().preopenedCount < 1 && retry++ < 50) {
+        [NSThread sleepForTimeInterval:0.1];
+    }
+    auto info = self.database->getHandlePoolInfo();
+    TestCaseAssertTrue(info.preopenedCount >= 1);
+    TestCaseAssertEqual(info.openedCount, info.missCount + info.preopenedCount);
+
+    // The next acquisition is served by an idle handle.
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    TestCaseAssertEqual(self.database->getHandlePoolInfo().hitCount, info.hitCount + 1);
+    TestCaseAssertEqual(self.database->getHandlePoolInfo().missCount, info.missCount);
+
+    // A burst holding more handles than the idle ones leaves more idle handles than the minimum after it.
+    int numberOfThreads = 3;
+    auto numberOfHolders = std::make_shared<std::atomic<int>>(0);
+    for (int i = 0; i < numberOfThreads; ++i) {
+        [self.dispatch async:^{
+            WCDB::Handle handle = self.database->getHandle();
+            TestCaseAssertTrue(handle.execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+            ++*numberOfHolders;
+            while (*numberOfHolders < numberOfThreads) {
+                [NSThread sleepForTimeInterval:0.01];
+            }
+            handle.invalidate();
+        }];
+    }
+    [self.dispatch waitUntilDone];
+    TestCaseAssertTrue(self.database->getHandlePoolInfo().openedCount >= (uint64_t) numberOfThreads);
+
+    // Idle handles beyond the minimum are closed after timeout.
+    retry = 0;
+    while (self.database->getHandlePoolInfo().shrunkCount == 0 && retry++ < 30) {
+        [NSThread sleepForTimeInterval:0.1];
+    }
+    TestCaseAssertTrue(self.database->getHandlePoolInfo().shrunkCount > 0);
+    TestCaseAssertTrue(self.database->isOpened());
+}
+
+- (void)test_statement_free_list
+{
+    TestCaseAssertTrue(self.database->createTable<CPPTestCaseObject>(self.tableName.UTF8String));
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column::all()).from(self.tableName.UTF8String);
+    WCDB::StatementPragma pragma = WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion());
+
+    // The statements are returned to the free list of handle once it's recycled, and reused by the next acquisition.
+    for (int i = 0; i < 3; ++i) {
+        WCDB::Handle handle = self.database->getHandle();
+        TestCaseAssertTrue(handle.getOrCreatePreparedStatement(select).succeed());
+        TestCaseAssertTrue(handle.getOrCreatePreparedStatement(pragma).succeed());
+        handle.invalidate();
+    }
+    auto info = self.database->getStatementPoolInfo();
+    TestCaseAssertTrue(info.allocatedCount > 0);
+    TestCaseAssertTrue(info.reusedCount >= 4);
+}
+
+- (void)test_page_cache_budget
+{
+    int64_t budget = 8 * 1024 * 1024;
+    WCDB::Database::setPageCacheBudget(budget);
+    TestCaseAssertTrue(self.database->createTable<CPPTestCaseObject>(self.tableName.UTF8String));
+    TestCaseAssertTrue(self.database->insertObjects<CPPTestCaseObject>([Random.shared autoIncrementTestCaseObjectsWithCount:100], self.tableName.UTF8String));
+
+    // The accesses are reported once the handle is acquired.
+    for (int i = 0; i < 3; ++i) {
+        TestCaseAssertTrue(self.database->getAllObjects<CPPTestCaseObject>(self.tableName.UTF8String).succeed());
+    }
+    auto info = self.database->getPageCacheInfo();
+    TestCaseAssertTrue(info.hitCount > 0);
+    TestCaseAssertTrue(info.cacheSize > 0 && info.cacheSize <= budget / 1024);
+    // It never exceeds the default cache size of sqlite.
+    TestCaseAssertTrue(info.cacheSize <= 2000);
+
+    // The min cache size is lowered to keep the total within a tiny budget.
+    int64_t tinyBudget = 64 * 1024;
+    WCDB::Database::setPageCacheBudget(tinyBudget);
+    TestCaseAssertTrue(self.database->getAllObjects<CPPTestCaseObject>(self.tableName.UTF8String).succeed());
+    info = self.database->getPageCacheInfo();
+    TestCaseAssertTrue(info.cacheSize > 0 && info.cacheSize <= tinyBudget / 1024);
+
+    WCDB::Database::setPageCacheBudget(0);
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    TestCaseAssertEqual(self.database->getPageCacheInfo().cacheSize, 0);
+}
+
 @end
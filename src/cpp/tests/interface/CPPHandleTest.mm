@@ -200,4 +200,57 @@
     WCDB::Database::globalTraceDatabaseOperation(nullptr);
 }
 
+- (void)test_incremental_blob_io
+{
+    const char* tableName = self.tableName.UTF8String;
+    const int blobSize = 1024 * 1024;
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTable().createTable(tableName).define(WCDB::ColumnDef("data", WCDB::ColumnType::BLOB))));
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementInsert().insertIntoTable(tableName).column(WCDB::Column("data")).value(WCDB::Expression::function("zeroblob").invoke().arguments(blobSize))));
+
+    NSMutableData* content = [NSMutableData dataWithCapacity:blobSize];
+    while (content.length < blobSize) {
+        [content appendData:Random.shared.data];
+    }
+    content.length = blobSize;
+
+    WCDB::Handle handle = self.database->getHandle();
+    TestCaseAssertTrue(handle.openBlob(tableName, "data", 1, true));
+    TestCaseAssertEqual(handle.getBlobSize(), blobSize);
+    const int chunkSize = 4096;
+    for (int offset = 0; offset < blobSize; offset += chunkSize) {
+        TestCaseAssertTrue(handle.writeBlob(WCDB::UnsafeData((unsigned char*) content.bytes + offset, chunkSize), offset));
+    }
+
+    unsigned char buffer[chunkSize];
+    TestCaseAssertTrue(handle.readBlob(buffer, chunkSize, chunkSize));
+    TestCaseAssertTrue(memcmp(buffer, (unsigned char*) content.bytes + chunkSize, chunkSize) == 0);
+
+    NSMutableData* streamed = [NSMutableData data];
+    TestCaseAssertTrue(handle.streamBlob([&](const WCDB::UnsafeData& chunk) {
+        [streamed appendBytes:chunk.buffer() length:chunk.size()];
+        return true;
+    }));
+    TestCaseAssertTrue([streamed isEqualToData:content]);
+
+    handle.closeBlob();
+    TestCaseAssertFalse(handle.readBlob(buffer, chunkSize, 0));
+    handle.invalidate();
+}
+
+- (void)test_write_blob_of_compressed_column
+{
+    const char* tableName = self.tableName.UTF8String;
+    // The type column makes "data" a column compressed by WCDB.
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTable().createTable(tableName).define(WCDB::ColumnDef("data", WCDB::ColumnType::BLOB)).define(WCDB::ColumnDef("WCDB_CT_data", WCDB::ColumnType::Integer))));
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementInsert().insertIntoTable(tableName).column(WCDB::Column("data")).value(WCDB::Expression::function("zeroblob").invoke().arguments(16))));
+
+    WCDB::Handle handle = self.database->getHandle();
+    TestCaseAssertTrue(handle.openBlob(tableName, "data", 1, true));
+    unsigned char buffer[16] = { 0 };
+    TestCaseAssertFalse(handle.writeBlob(WCDB::UnsafeData(buffer, sizeof(buffer)), 0));
+    TestCaseAssertTrue(handle.getError().code() == WCDB::Error::Code::Misuse);
+    TestCaseAssertTrue(handle.readBlob(buffer, sizeof(buffer), 0));
+    handle.invalidate();
+}
+
 @end
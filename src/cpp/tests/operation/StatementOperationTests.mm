@@ -24,6 +24,19 @@
 
 #import "CPPTestCase.h"
 
+class CPPRowScopedObject {
+public:
+    int identifier;
+    WCDB::TextView content;
+    WCDB_CPP_ORM_DECLARATION(CPPRowScopedObject)
+    WCDB_CPP_ORM_ROW_SCOPED
+};
+
+WCDB_CPP_ORM_IMPLEMENTATION_BEGIN(CPPRowScopedObject)
+WCDB_CPP_SYNTHESIZE(identifier)
+WCDB_CPP_SYNTHESIZE(content)
+WCDB_CPP_ORM_IMPLEMENTATION_END
+
 @interface StatementOperationTests : CPPCRUDTestCase
 
 @property (nonatomic, assign) std::shared_ptr<WCDB::Handle> handle;
@@ -320,6 +333,84 @@
     }
 }
 
+- (void)test_string_value_view
+{
+    NSString* value = Random.shared.string;
+    TestCaseAssertTrue(value != nil);
+    {
+        TestCaseAssertTrue(self.handle->prepare(self.statementInsert));
+        self.handle->bindValue(value.UTF8String);
+
+        TestCaseAssertTrue(self.handle->step());
+        self.handle->finalize();
+    }
+    {
+        TestCaseAssertTrue(self.handle->prepare(self.statementSelect));
+        TestCaseAssertTrue(self.handle->step());
+        WCDB::ValueView view = self.handle->getValueView();
+        TestCaseAssertTrue(view.getType() == WCDB::ColumnType::Text);
+        TestCaseAssertTrue(view.textValue().data() == self.handle->getText().data());
+        TestCaseAssertFalse(view.isExpired());
+        WCDB::Value copied = view.toValue();
+
+        TestCaseAssertTrue(self.handle->step());
+        TestCaseAssertTrue(view.isExpired());
+        TestCaseAssertCPPStringEqual(copied.textValue().data(), value.UTF8String);
+        self.handle->finalize();
+    }
+}
+
+- (void)test_data_value_view
+{
+    NSData* value = Random.shared.data;
+    TestCaseAssertTrue(value != nil);
+    {
+        TestCaseAssertTrue(self.handle->prepare(self.statementInsert));
+        self.handle->bindValue(WCDB::UnsafeData((unsigned char*) value.bytes, value.length));
+
+        TestCaseAssertTrue(self.handle->step());
+        self.handle->finalize();
+    }
+    {
+        TestCaseAssertTrue(self.handle->prepare(self.statementSelect));
+        TestCaseAssertTrue(self.handle->step());
+        WCDB::OneRowValueView row = self.handle->getOneRowView();
+        TestCaseAssertEqual(row.size(), 1);
+        WCDB::BLOBView result = row[0].blobValue();
+        TestCaseAssertTrue(result.buffer() == self.handle->getBLOB().buffer());
+        TestCaseAssertTrue(result.size() == value.length && memcmp(result.buffer(), value.bytes, result.size()) == 0);
+        self.handle->reset();
+        TestCaseAssertTrue(row[0].isExpired());
+        self.handle->finalize();
+    }
+}
+
+- (void)test_value_view_outlives_statement
+{
+    WCDB::ValueView view;
+    {
+        WCDB::Handle handle = self.database->getHandle();
+        auto preparedStatement = handle.getOrCreatePreparedStatement(WCDB::StatementSelect().select(WCDB::Column("content")).from(self.tableName.UTF8String));
+        TestCaseAssertTrue(preparedStatement.succeed());
+        TestCaseAssertTrue(preparedStatement.value().step());
+        view = preparedStatement.value().getValueView();
+        TestCaseAssertFalse(view.isExpired());
+        // The prepared statements are finalized and released once the handle is recycled.
+        handle.invalidate();
+    }
+    TestCaseAssertTrue(view.isExpired());
+}
+
+- (void)test_extract_row_scoped_object
+{
+    TestCaseAssertTrue(self.handle->prepare(WCDB::StatementSelect().select(CPPRowScopedObject::allFields()).from(self.tableName.UTF8String).order(WCDB::Column("identifier").asOrder(WCDB::Order::ASC))));
+    TestCaseAssertTrue(self.handle->step());
+    CPPRowScopedObject object = self.handle->extractOneObject<CPPRowScopedObject>(CPPRowScopedObject::allFields());
+    TestCaseAssertEqual(object.identifier, 1);
+    TestCaseAssertTrue(object.content.data() == self.handle->getText(1).data());
+    self.handle->finalize();
+}
+
 - (void)test_bind_index
 {
     NSString* value = Random.shared.string;
@@ -0,0 +1,206 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "CoreBridge.h"
+#import "DatabaseBridge.h"
+#import "ErrorBridge.h"
+#import "HandleBridge.h"
+#import "HandleStatementBridge.h"
+#import "TestCase.h"
+#include <string>
+#include <vector>
+
+static constexpr int HandleStatementBridgeTestsColumnCount = 4;
+
+@interface HandleStatementBridgeTests : DatabaseTestCase
+
+@end
+
+@implementation HandleStatementBridgeTests {
+    CPPDatabase _cppDatabase;
+    CPPHandle _handle;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _cppDatabase = WCDBCoreCreateDatabase(self.path.UTF8String);
+    _handle = WCDBDatabaseGetHandle(_cppDatabase, true);
+    TestCaseAssertTrue(WCDBHandleExecuteSQL(_handle, "CREATE TABLE testTable(c0 INTEGER PRIMARY KEY, c1 REAL, c2 TEXT, c3 BLOB)"));
+}
+
+- (void)tearDown
+{
+    WCDBReleaseCPPObject(_handle.innerValue);
+    WCDBReleaseCPPObject(_cppDatabase.innerValue);
+    [super tearDown];
+}
+
+- (void)insertTexts:(const std::vector<std::string>&)texts
+{
+    CPPHandleStatement statement = WCDBHandleGetMainStatement(_handle);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "INSERT INTO testTable VALUES(?1, ?2, ?3, ?4)"));
+    for (size_t i = 0; i < texts.size(); i++) {
+        // The blob is the text without the null terminator.
+        std::vector<unsigned char> arena(texts[i].begin(), texts[i].end());
+        arena.push_back('\0');
+        WCDBColumnValueType types[HandleStatementBridgeTestsColumnCount] = {
+            WCDBColumnValueTypeInterger, WCDBColumnValueTypeFloat, WCDBColumnValueTypeString, WCDBColumnValueTypeBLOB
+        };
+        CPPPackedCell cells[HandleStatementBridgeTestsColumnCount];
+        cells[0].intValue = (long long) i + 1;
+        cells[1].doubleValue = i * 0.5;
+        cells[2].offset = 0;
+        cells[2].size = texts[i].size();
+        cells[3].offset = 0;
+        cells[3].size = texts[i].size();
+        CPPPackedRows row = { HandleStatementBridgeTestsColumnCount, 1, types, cells, arena.data(), arena.size(), arena.size() };
+        WCDBHandleStatementReset(statement);
+        WCDBHandleStatementBindPackedRow(statement, &row, 0);
+        TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+    }
+    WCDBHandleStatementFinalize(statement);
+}
+
+- (void)checkRows:(const CPPPackedRows&)rows
+            count:(int)count
+    startingIndex:(int)startingIndex
+       matchTexts:(const std::vector<std::string>&)texts
+{
+    for (int i = 0; i < count; i++) {
+        const WCDBColumnValueType* types = rows.types + i * rows.columnCount;
+        const CPPPackedCell* cells = rows.cells + i * rows.columnCount;
+        const std::string& text = texts[startingIndex + i];
+        TestCaseAssertEqual(types[0], WCDBColumnValueTypeInterger);
+        TestCaseAssertEqual(cells[0].intValue, startingIndex + i + 1);
+        TestCaseAssertEqual(types[1], WCDBColumnValueTypeFloat);
+        TestCaseAssertEqual(cells[1].doubleValue, (startingIndex + i) * 0.5);
+        TestCaseAssertEqual(types[2], WCDBColumnValueTypeString);
+        TestCaseAssertEqual(cells[2].size, text.size());
+        TestCaseAssertTrue(strcmp((const char*) rows.arena + cells[2].offset, text.c_str()) == 0);
+        TestCaseAssertEqual(types[3], WCDBColumnValueTypeBLOB);
+        TestCaseAssertEqual(cells[3].size, text.size());
+        TestCaseAssertTrue(memcmp(rows.arena + cells[3].offset, text.data(), text.size()) == 0);
+    }
+}
+
+- (void)test_bind_and_fetch_packed_rows
+{
+    std::vector<std::string> texts = { "text", "", "多字节文本" };
+    [self insertTexts:texts];
+
+    std::vector<WCDBColumnValueType> types(2 * HandleStatementBridgeTestsColumnCount);
+    std::vector<CPPPackedCell> cells(2 * HandleStatementBridgeTestsColumnCount);
+    std::vector<unsigned char> arena(1024);
+    CPPPackedRows rows = { HandleStatementBridgeTestsColumnCount, 2, types.data(), cells.data(), arena.data(), arena.size(), 0 };
+
+    CPPHandleStatement statement = WCDBHandleGetMainStatement(_handle);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "SELECT c0, c1, c2, c3 FROM testTable ORDER BY c0"));
+    TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+
+    bool succeed = false;
+    int fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertTrue(succeed);
+    TestCaseAssertEqual(fetched, 2);
+    TestCaseAssertFalse(WCDBHandleStatementIsDone(statement));
+    [self checkRows:rows count:fetched startingIndex:0 matchTexts:texts];
+
+    fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertTrue(succeed);
+    TestCaseAssertEqual(fetched, 1);
+    TestCaseAssertTrue(WCDBHandleStatementIsDone(statement));
+    [self checkRows:rows count:fetched startingIndex:2 matchTexts:texts];
+
+    fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertTrue(succeed);
+    TestCaseAssertEqual(fetched, 0);
+    WCDBHandleStatementFinalize(statement);
+}
+
+- (void)test_fetch_with_small_arena
+{
+    // Each row needs 11 bytes for text with its null terminator and 10 bytes for blob.
+    std::vector<std::string> texts = { "0123456789", "9876543210" };
+    [self insertTexts:texts];
+
+    std::vector<WCDBColumnValueType> types(2 * HandleStatementBridgeTestsColumnCount);
+    std::vector<CPPPackedCell> cells(2 * HandleStatementBridgeTestsColumnCount);
+    std::vector<unsigned char> arena(32);
+    CPPPackedRows rows = { HandleStatementBridgeTestsColumnCount, 2, types.data(), cells.data(), arena.data(), 16, 0 };
+
+    CPPHandleStatement statement = WCDBHandleGetMainStatement(_handle);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "SELECT c0, c1, c2, c3 FROM testTable ORDER BY c0"));
+    TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+
+    // Nothing is fetched and the required size is reported.
+    bool succeed = false;
+    int fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertTrue(succeed);
+    TestCaseAssertEqual(fetched, 0);
+    TestCaseAssertEqual(rows.arenaSize, 21);
+    TestCaseAssertFalse(WCDBHandleStatementIsDone(statement));
+
+    // The arena is full after the first row, and the second one keeps current.
+    rows.arenaCapacity = arena.size();
+    fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertTrue(succeed);
+    TestCaseAssertEqual(fetched, 1);
+    TestCaseAssertEqual(rows.arenaSize, 21);
+    TestCaseAssertFalse(WCDBHandleStatementIsDone(statement));
+    [self checkRows:rows count:fetched startingIndex:0 matchTexts:texts];
+
+    fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertTrue(succeed);
+    TestCaseAssertEqual(fetched, 1);
+    TestCaseAssertTrue(WCDBHandleStatementIsDone(statement));
+    [self checkRows:rows count:fetched startingIndex:1 matchTexts:texts];
+    WCDBHandleStatementFinalize(statement);
+}
+
+- (void)test_fetch_with_failed_step
+{
+    std::vector<std::string> texts = { "text1", "text2", "text3" };
+    [self insertTexts:texts];
+
+    std::vector<WCDBColumnValueType> types(3);
+    std::vector<CPPPackedCell> cells(3);
+    CPPPackedRows rows = { 1, 3, types.data(), cells.data(), nullptr, 0, 0 };
+
+    // abs() fails with integer overflow on the second row.
+    CPPHandleStatement statement = WCDBHandleGetMainStatement(_handle);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "SELECT abs(CASE c0 WHEN 2 THEN -9223372036854775807 - 1 ELSE c0 END) FROM testTable ORDER BY c0"));
+    TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+
+    bool succeed = true;
+    int fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+    TestCaseAssertFalse(succeed);
+    TestCaseAssertEqual(fetched, 1);
+    TestCaseAssertEqual(types[0], WCDBColumnValueTypeInterger);
+    TestCaseAssertEqual(cells[0].intValue, 1);
+    TestCaseAssertEqual(WCDBErrorGetCode(WCDBHandleStatementGetError(statement)), (long) WCTErrorCodeError);
+    WCDBHandleStatementFinalize(statement);
+}
+
+@end
@@ -48,6 +48,7 @@
         database.lastMaterialPath,
         database.incrementalMaterialPath,
         [database.factoryRestorePath stringByAppendingPathComponent:path.lastPathComponent],
+        [path stringByAppendingString:@"-warmup"],
         database.journalPath,
         database.shmPath,
     ];
@@ -23,6 +23,39 @@
  */
 
 #import "ObjectsBasedBenchmark.h"
+#import "PoolAllocator.hpp"
+#import "TestCaseLog.h"
+#import <atomic>
+#import <pthread.h>
+
+// The hook of libmalloc, which is called for every allocation of all zones.
+typedef void(malloc_logger_t)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip);
+extern "C" malloc_logger_t* malloc_logger;
+
+static constexpr uint32_t BaselineBenchmarkMallocLogTypeAllocate = 2;
+
+static pthread_t g_countingThread;
+static std::atomic<int> g_numberOfAllocations;
+
+static void BaselineBenchmarkCountAllocation(uint32_t type, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uint32_t)
+{
+    if ((type & BaselineBenchmarkMallocLogTypeAllocate) != 0 && pthread_equal(pthread_self(), g_countingThread)) {
+        ++g_numberOfAllocations;
+    }
+}
+
+static void BaselineBenchmarkBeginCountingAllocations()
+{
+    g_numberOfAllocations = 0;
+    g_countingThread = pthread_self();
+    malloc_logger = BaselineBenchmarkCountAllocation;
+}
+
+static int BaselineBenchmarkEndCountingAllocations()
+{
+    malloc_logger = nullptr;
+    return g_numberOfAllocations.load();
+}
 
 @interface BaselineBenchmark : ObjectsBasedBenchmark
 
@@ -100,4 +133,64 @@
     checkCorrectness:nil];
 }
 
+- (void)test_winq_copy
+{
+    WCDB::StatementInsert insert = WCDB::StatementInsert().insertIntoTable(self.tableName).columns(TestCaseObject.allProperties).values(WCDB::BindParameter::bindParameters(TestCaseObject.allProperties.size()));
+    [self doTestWINQCopyNamed:@"insert"
+                copyAndTamper:^{
+                    WCDB::StatementInsert copied = insert;
+                    copied.orReplace();
+                }];
+
+    WCDB::StatementUpdate update = WCDB::StatementUpdate().update(self.tableName).set(TestCaseObject.content).to(WCDB::BindParameter(1)).where(TestCaseObject.identifier == 1);
+    [self doTestWINQCopyNamed:@"update"
+                copyAndTamper:^{
+                    WCDB::StatementUpdate copied = update;
+                    copied.orReplace();
+                }];
+
+    WCDB::StatementDelete deletion = WCDB::StatementDelete().deleteFrom(self.tableName).where(TestCaseObject.identifier == 1);
+    [self doTestWINQCopyNamed:@"delete"
+                copyAndTamper:^{
+                    WCDB::StatementDelete copied = deletion;
+                    copied.limit(1);
+                }];
+
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(TestCaseObject.allProperties).from(self.tableName).where(TestCaseObject.identifier == 1);
+    [self doTestWINQCopyNamed:@"select"
+                copyAndTamper:^{
+                    WCDB::StatementSelect copied = select;
+                    copied.distinct();
+                }];
+}
+
+// Tampering with a copy triggers the copy-on-write of the whole syntax tree.
+// Only the root of the cloned tree is allocated from the pool. The other nodes are still copied through the global allocator.
+- (void)doTestWINQCopyNamed:(NSString*)name copyAndTamper:(void (^)(void))block
+{
+    __block int heapAllocations;
+    __block WCDB::PoolMemory::Statistic statistic;
+    [self
+           doMeasure:^{
+               BaselineBenchmarkBeginCountingAllocations();
+               for (int i = 0; i < self.testQuality; i++) {
+                   block();
+               }
+               heapAllocations = BaselineBenchmarkEndCountingAllocations();
+               statistic = WCDB::PoolMemory::getThreadedStatistic();
+           }
+               setUp:^{
+                   heapAllocations = -1;
+                   WCDB::PoolMemory::resetThreadedStatistic();
+               }
+            tearDown:nil
+    checkCorrectness:^{
+        // Each block reused from the pool would be an allocation of the global allocator without the pool.
+        TestCaseLog(@"Heap allocations of %@ copies: %llu without pool, %d with pool", name, heapAllocations + statistic.reused, heapAllocations);
+        TestCaseAssertEqual(statistic.oversized, 0);
+        TestCaseAssertTrue(statistic.allocated + statistic.reused >= self.testQuality);
+        TestCaseAssertTrue(heapAllocations >= 0);
+    }];
+}
+
 @end
@@ -0,0 +1,212 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "CoreBridge.h"
+#import "DatabaseBridge.h"
+#import "HandleBridge.h"
+#import "HandleStatementBridge.h"
+#import "TestCase.h"
+#include <vector>
+
+static constexpr int BridgeBenchmarkColumnCount = 10;
+static constexpr int BridgeBenchmarkRowCount = 100000;
+static constexpr int BridgeBenchmarkBatchCount = 256;
+
+@interface BridgeBenchmark : Benchmark
+
+@end
+
+@implementation BridgeBenchmark {
+    CPPDatabase _cppDatabase;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _cppDatabase = WCDBCoreCreateDatabase(self.path.UTF8String);
+}
+
+- (void)tearDown
+{
+    WCDBReleaseCPPObject(_cppDatabase.innerValue);
+    [super tearDown];
+}
+
+- (void)setUpDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+    CPPHandle handle = WCDBDatabaseGetHandle(_cppDatabase, true);
+    TestCaseAssertTrue(WCDBHandleExecuteSQL(handle, "CREATE TABLE benchmark(c0 INTEGER PRIMARY KEY, c1 INTEGER, c2 INTEGER, c3 INTEGER, c4 REAL, c5 REAL, c6 TEXT, c7 TEXT, c8 TEXT, c9 BLOB)"));
+    TestCaseAssertTrue(WCDBHandleBeginTransaction(handle));
+    CPPHandleStatement statement = WCDBHandleGetMainStatement(handle);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "INSERT INTO benchmark VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10)"));
+
+    NSData* data = Random.shared.data;
+    NSString* text = Random.shared.string;
+    const char* string = text.UTF8String;
+    // The length of NSString counts UTF-16 units, not bytes.
+    size_t stringSize = strlen(string);
+    std::vector<unsigned char> arena(stringSize + 1 + data.length);
+    memcpy(arena.data(), string, stringSize + 1);
+    memcpy(arena.data() + stringSize + 1, data.bytes, data.length);
+    WCDBColumnValueType types[BridgeBenchmarkColumnCount] = {
+        WCDBColumnValueTypeInterger, WCDBColumnValueTypeInterger, WCDBColumnValueTypeInterger, WCDBColumnValueTypeInterger, WCDBColumnValueTypeFloat, WCDBColumnValueTypeFloat, WCDBColumnValueTypeString, WCDBColumnValueTypeString, WCDBColumnValueTypeString, WCDBColumnValueTypeBLOB
+    };
+    CPPPackedCell cells[BridgeBenchmarkColumnCount];
+    for (int i = 6; i < 9; i++) {
+        cells[i].offset = 0;
+        cells[i].size = stringSize;
+    }
+    cells[9].offset = stringSize + 1;
+    cells[9].size = data.length;
+    CPPPackedRows row = { BridgeBenchmarkColumnCount, 1, types, cells, arena.data(), arena.size(), arena.size() };
+    for (int i = 0; i < BridgeBenchmarkRowCount; i++) {
+        for (int j = 0; j < 4; j++) {
+            cells[j].intValue = i + j;
+        }
+        cells[4].doubleValue = i * 0.5;
+        cells[5].doubleValue = i * 0.25;
+        WCDBHandleStatementReset(statement);
+        WCDBHandleStatementBindPackedRow(statement, &row, 0);
+        TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+    }
+    WCDBHandleStatementFinalize(statement);
+    TestCaseAssertTrue(WCDBHandleCommitTransaction(handle));
+    WCDBReleaseCPPObject(handle.innerValue);
+}
+
+- (void)tearDownDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+}
+
+- (void)test_per_cell_fetch
+{
+    __block int count = 0;
+    __block unsigned long long checksum = 0;
+    [self
+    doMeasure:^{
+        CPPHandle handle = WCDBDatabaseGetHandle(self->_cppDatabase, false);
+        CPPHandleStatement statement = WCDBHandleGetMainStatement(handle);
+        TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "SELECT * FROM benchmark"));
+        TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+        while (!WCDBHandleStatementIsDone(statement)) {
+            for (int i = 0; i < BridgeBenchmarkColumnCount; i++) {
+                switch (WCDBHandleStatementGetColumnType(statement, i)) {
+                case WCDBColumnValueTypeInterger:
+                    checksum += WCDBHandleStatementGetInteger(statement, i);
+                    break;
+                case WCDBColumnValueTypeFloat:
+                    checksum += (unsigned long long) WCDBHandleStatementGetDouble(statement, i);
+                    break;
+                case WCDBColumnValueTypeString:
+                    checksum += WCDBHandleStatementGetText(statement, i)[0];
+                    checksum += WCDBHandleStatementGetColumnSize(statement, i);
+                    break;
+                case WCDBColumnValueTypeBLOB:
+                    checksum += WCDBHandleStatementGetBlob(statement, i)[0];
+                    checksum += WCDBHandleStatementGetColumnSize(statement, i);
+                    break;
+                case WCDBColumnValueTypeNull:
+                    break;
+                }
+            }
+            ++count;
+            TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+        }
+        WCDBHandleStatementFinalize(statement);
+        WCDBReleaseCPPObject(handle.innerValue);
+    }
+    setUp:^{
+        [self setUpDatabase];
+        count = 0;
+        checksum = 0;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(count, BridgeBenchmarkRowCount);
+        TestCaseAssertTrue(checksum > 0);
+    }];
+}
+
+- (void)test_packed_fetch
+{
+    __block int count = 0;
+    __block unsigned long long checksum = 0;
+    [self
+    doMeasure:^{
+        std::vector<WCDBColumnValueType> types(BridgeBenchmarkBatchCount * BridgeBenchmarkColumnCount);
+        std::vector<CPPPackedCell> cells(BridgeBenchmarkBatchCount * BridgeBenchmarkColumnCount);
+        std::vector<unsigned char> arena(1024 * 1024);
+        CPPPackedRows rows = { BridgeBenchmarkColumnCount, BridgeBenchmarkBatchCount, types.data(), cells.data(), arena.data(), arena.size(), 0 };
+
+        CPPHandle handle = WCDBDatabaseGetHandle(self->_cppDatabase, false);
+        CPPHandleStatement statement = WCDBHandleGetMainStatement(handle);
+        TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(statement, "SELECT * FROM benchmark"));
+        TestCaseAssertTrue(WCDBHandleStatementStep(statement));
+        while (!WCDBHandleStatementIsDone(statement)) {
+            bool succeed = false;
+            int fetched = WCDBHandleStatementFetchPackedRows(statement, &rows, &succeed);
+            TestCaseAssertTrue(succeed);
+            TestCaseAssertTrue(fetched > 0);
+            for (int i = 0; i < fetched * BridgeBenchmarkColumnCount; i++) {
+                switch (types[i]) {
+                case WCDBColumnValueTypeInterger:
+                    checksum += cells[i].intValue;
+                    break;
+                case WCDBColumnValueTypeFloat:
+                    checksum += (unsigned long long) cells[i].doubleValue;
+                    break;
+                case WCDBColumnValueTypeString:
+                case WCDBColumnValueTypeBLOB:
+                    checksum += arena[cells[i].offset];
+                    checksum += cells[i].size;
+                    break;
+                case WCDBColumnValueTypeNull:
+                    break;
+                }
+            }
+            count += fetched;
+        }
+        WCDBHandleStatementFinalize(statement);
+        WCDBReleaseCPPObject(handle.innerValue);
+    }
+    setUp:^{
+        [self setUpDatabase];
+        count = 0;
+        checksum = 0;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(count, BridgeBenchmarkRowCount);
+        TestCaseAssertTrue(checksum > 0);
+    }];
+}
+
+@end
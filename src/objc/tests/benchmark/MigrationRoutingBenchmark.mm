@@ -0,0 +1,96 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "MigrationBenchmark.h"
+
+@interface MigrationRoutingBenchmark : MigrationBenchmark
+
+@end
+
+@implementation MigrationRoutingBenchmark
+
+- (void)setUp
+{
+    self.isCrossDatabase = NO;
+    [super setUp];
+    self.factory.quality = 100000;
+    self.testQuality = 10000;
+}
+
+- (void)doTestReadMigratedRows
+{
+    __block NSMutableArray<TestCaseObject*>* result;
+    __block int maxIdentifier;
+    [self
+    doMeasure:^{
+        // Rows are migrated in descending order of primary key, so the largest ones are already in the target table.
+        for (int i = maxIdentifier; i > maxIdentifier - self.testQuality; i--) {
+            TestCaseObject* obj = [self.database getObjectOfClass:TestCaseObject.class fromTable:self.tableName where:TestCaseObject.identifier == i];
+            if (obj != nil) {
+                [result addObject:obj];
+            }
+        }
+    }
+    setUp:^{
+        [self setUpDatabase];
+        maxIdentifier = (int) self.factory.quality;
+        // Step until all the rows to be read are migrated, so that they are above the boundary of source table.
+        WCTValue* boundary = nil;
+        do {
+            TestCaseAssertTrue([self.database stepMigration]);
+            boundary = [self.database getValueOnResultColumn:TestCaseObject.identifier.max() fromTable:self.factory.tableName];
+        } while (boundary != nil && boundary.numberValue.intValue > maxIdentifier - self.testQuality);
+        TestCaseAssertFalse([self.database isMigrated]);
+        result = [[NSMutableArray alloc] initWithCapacity:self.testQuality];
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        // Statements in transaction are not routed, so they read both tables.
+        __block NSArray<TestCaseObject*>* expected = nil;
+        TestCaseAssertTrue([self.database runTransaction:^BOOL(WCTHandle* handle) {
+            expected = [handle getObjectsOfClass:TestCaseObject.class
+                                       fromTable:self.tableName
+                                           where:TestCaseObject.identifier > maxIdentifier - self.testQuality
+                                          orders:TestCaseObject.identifier.asOrder(WCTOrderedDescending)];
+            return expected != nil;
+        }]);
+        TestCaseAssertEqual(expected.count, self.testQuality);
+        TestCaseAssertTrue([result isEqualToArray:expected]);
+    }];
+}
+
+- (void)test_point_lookup_of_migrated_rows
+{
+    [self doTestReadMigratedRows];
+}
+
+- (void)test_point_lookup_of_unmigrated_rows
+{
+    [self doTestRead];
+}
+
+@end
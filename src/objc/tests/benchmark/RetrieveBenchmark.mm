@@ -95,6 +95,29 @@
     }];
 }
 
+// Compare with test_backup, which prefetches pages by default.
+- (void)test_backup_without_prefetch
+{
+    __block BOOL result;
+    [WCTDatabase setABTestConfigWithName:@"clicfg_wcdb_page_prefetch" andValue:@"0"];
+    [self
+    doMeasure:^{
+        result = [self.database backup];
+    }
+    setUp:^{
+        [self setUpDatabase];
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        result = NO;
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+        TestCaseAssertTrue([self.fileManager fileExistsAtPath:self.database.firstMaterialPath]);
+    }];
+    [WCTDatabase removeABTestConfigWithName:@"clicfg_wcdb_page_prefetch"];
+}
+
 - (void)test_cipher_backup
 {
     __block BOOL result;
@@ -178,6 +201,28 @@
     }];
 }
 
+// Compare with test_retrieve_without_backup, which prefetches pages by default.
+- (void)test_retrieve_without_backup_and_prefetch
+{
+    __block double score;
+    [WCTDatabase setABTestConfigWithName:@"clicfg_wcdb_page_prefetch" andValue:@"0"];
+    [self
+    doMeasure:^{
+        score = [self.database retrieve:nil];
+    }
+    setUp:^{
+        [self setUpDatabase];
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        score = 0.0f;
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(score, 1.0f);
+    }];
+    [WCTDatabase removeABTestConfigWithName:@"clicfg_wcdb_page_prefetch"];
+}
+
 - (void)test_ciper_retrieve_without_backup
 {
     __block double score;
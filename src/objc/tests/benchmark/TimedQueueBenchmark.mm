@@ -0,0 +1,146 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "IndexedHeap.hpp"
+#import "StringView.hpp"
+#import "TestCase.h"
+#import "Time.hpp"
+#import "TimedQueue.hpp"
+#import "UniqueList.hpp"
+#include <vector>
+
+static constexpr int TimedQueueBenchmarkKeyCount = 10000;
+
+@interface TimedQueueBenchmark : Benchmark
+
+@end
+
+@implementation TimedQueueBenchmark {
+    std::vector<WCDB::StringView> _keys;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _keys.clear();
+    for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+        _keys.push_back(WCDB::StringView::formatted("/path/to/database/%d.db", i));
+    }
+}
+
+// Each key is scheduled twice so that the second round reschedules the existing ones.
+- (void)test_unique_list_schedule
+{
+    __block size_t size = 0;
+    [self
+           doMeasure:^{
+               WCDB::UniqueList<WCDB::StringView, int, WCDB::SteadyClock> list;
+               WCDB::SteadyClock now = WCDB::SteadyClock::now();
+               for (int round = 0; round < 2; ++round) {
+                   for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+                       list.insert(self->_keys[i], i, now.steadyClockByAddingTimeInterval((i * 7919) % TimedQueueBenchmarkKeyCount));
+                   }
+               }
+               size = list.size();
+           }
+               setUp:nil
+            tearDown:nil
+    checkCorrectness:^{
+        TestCaseAssertEqual((int) size, TimedQueueBenchmarkKeyCount);
+    }];
+}
+
+- (void)test_indexed_heap_schedule
+{
+    __block size_t size = 0;
+    [self
+           doMeasure:^{
+               WCDB::IndexedHeap<WCDB::StringView, int, WCDB::SteadyClock> heap;
+               WCDB::SteadyClock now = WCDB::SteadyClock::now();
+               for (int round = 0; round < 2; ++round) {
+                   for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+                       heap.insert(self->_keys[i], i, now.steadyClockByAddingTimeInterval((i * 7919) % TimedQueueBenchmarkKeyCount));
+                   }
+               }
+               size = heap.size();
+           }
+               setUp:nil
+            tearDown:nil
+    checkCorrectness:^{
+        TestCaseAssertEqual((int) size, TimedQueueBenchmarkKeyCount);
+    }];
+}
+
+- (void)test_timed_queue_schedule
+{
+    __block size_t removed = 0;
+    [self
+           doMeasure:^{
+               WCDB::TimedQueue<WCDB::StringView, int> queue;
+               for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+                   queue.queue(self->_keys[i], 100 + (i * 7919) % TimedQueueBenchmarkKeyCount, i);
+               }
+               for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+                   queue.queue(self->_keys[i], 100 + i, i, WCDB::TimedQueue<WCDB::StringView, int>::Mode::ReQueue);
+               }
+               for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+                   queue.remove(self->_keys[i]);
+                   ++removed;
+               }
+           }
+               setUp:^{
+                   removed = 0;
+               }
+            tearDown:nil
+    checkCorrectness:^{
+        TestCaseAssertEqual((int) removed, TimedQueueBenchmarkKeyCount);
+    }];
+}
+
+- (void)test_indexed_heap_order
+{
+    WCDB::IndexedHeap<WCDB::StringView, int, int> heap;
+    for (int i = 0; i < TimedQueueBenchmarkKeyCount; ++i) {
+        heap.insert(_keys[i], i, (i * 7919) % 100);
+    }
+    for (int i = 0; i < TimedQueueBenchmarkKeyCount; i += 3) {
+        heap.erase(_keys[i]);
+    }
+    int lastOrder = -1;
+    int lastValue = -1;
+    while (!heap.empty()) {
+        const auto& top = heap.top();
+        TestCaseAssertTrue(top.order() >= lastOrder);
+        if (top.order() == lastOrder) {
+            // Same order pops in the inserted order.
+            TestCaseAssertTrue(top.value() > lastValue);
+        }
+        lastOrder = top.order();
+        lastValue = top.value();
+        heap.pop();
+    }
+}
+
+@end
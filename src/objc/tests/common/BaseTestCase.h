@@ -45,6 +45,9 @@
 
 @property (nonatomic, assign) BOOL skipDebugLog;
 
+// Log the errors into console. It is installed in setUp, and can be called again to restore it after the tracer is replaced.
+- (void)setUpErrorTracer;
+
 - (void)log:(NSString*)format, ...;
 
 @end
@@ -75,6 +75,25 @@
 
     [WCTDatabase globalTracePerformance:nil];
     [WCTDatabase globalTraceSQL:nil];
+    [self setUpErrorTracer];
+    [WCTDatabase simulateIOError:WCTSimulateNoneIOError];
+
+#if DEBUG
+    [self log:@"debuggable."];
+#endif
+
+    NSString *directory = self.directory;
+    NSString *abbreviatedPath = directory.stringByAbbreviatingWithTildeInPath;
+    if (abbreviatedPath.length > 0) {
+        directory = abbreviatedPath;
+    }
+    [self log:@"run at %@", directory];
+
+    [self refreshDirectory];
+}
+
+- (void)setUpErrorTracer
+{
     [WCTDatabase globalTraceError:^(WCTError *error) {
         NSThread *currentThread = [NSThread currentThread];
         NSString *threadName = currentThread.name;
@@ -108,20 +127,6 @@
             break;
         }
     }];
-    [WCTDatabase simulateIOError:WCTSimulateNoneIOError];
-
-#if DEBUG
-    [self log:@"debuggable."];
-#endif
-
-    NSString *directory = self.directory;
-    NSString *abbreviatedPath = directory.stringByAbbreviatingWithTildeInPath;
-    if (abbreviatedPath.length > 0) {
-        directory = abbreviatedPath;
-    }
-    [self log:@"run at %@", directory];
-
-    [self refreshDirectory];
 }
 
 - (void)tearDown
@@ -128,6 +128,43 @@
     }];
 }
 
+- (void)test_insert_repeatedly
+{
+    TestCaseLog(@"Start test insert repeatedly");
+    [self doTestMigration:^{
+        // The rewritten statements of the second insertion come from cache.
+        NSObject<MigrationTestObject>* newObject1 = [Random.shared migrationObjectWithClass:self.targetClass
+                                                                              andIdentifier:self.objects.lastObject.identifier + 1];
+        NSObject<MigrationTestObject>* newObject2 = [Random.shared migrationObjectWithClass:self.targetClass
+                                                                              andIdentifier:self.objects.lastObject.identifier + 2];
+        NSMutableArray<NSObject<MigrationTestObject>*>* expectedObjects = [NSMutableArray arrayWithArray:self.filterObjects];
+        [expectedObjects addObject:newObject1];
+        [expectedObjects addObject:newObject2];
+
+        NSMutableArray<NSString*>* sqls = [NSMutableArray array];
+        for (int i = 0; i < 2; i++) {
+            [sqls addObject:@"BEGIN IMMEDIATE"];
+            [sqls addObject:[NSString stringWithFormat:@"INSERT INTO %@%@(identifier, content) VALUES(?1, ?2)", self.schemaName, self.sourceTableName]];
+            [sqls addObject:[NSString stringWithFormat:@"DELETE FROM %@%@ WHERE rowid == ?1", self.schemaName, self.sourceTableName]];
+            if ([self.targetClass isAutoIncrement]) {
+                [sqls addObject:@"INSERT INTO main.testTable(identifier, content) VALUES(?1, ?2)"];
+            } else if ([self.targetClass hasIntegerPrimaryKey]) {
+                [sqls addObject:@"INSERT INTO main.testTable(identifier, content, rowid) VALUES(?1, ?2, ?3)"];
+            } else {
+                [sqls addObject:@"SELECT max(rowid) + 1 FROM main.testTable"];
+                [sqls addObject:@"INSERT INTO main.testTable(identifier, content, rowid) VALUES(?1, ?2, ?3)"];
+            }
+            [sqls addObject:@"COMMIT"];
+        }
+
+        [self doTestObjects:expectedObjects
+                    andSQLs:sqls
+          afterModification:^BOOL {
+              return [self.table insertObject:newObject1] && [self.table insertObject:newObject2];
+          }];
+    }];
+}
+
 - (void)test_insert_autoIncrement
 {
     TestCaseLog(@"Start test insert autoincrement");
@@ -354,6 +391,59 @@
     }];
 }
 
+- (void)test_routed_select
+{
+    TestCaseLog(@"Start test routed select");
+    [self doTestMigrationWithSourceClassFilter:nil
+    targetClassFIlter:^BOOL(Class<MigrationTestObject> targetClass) {
+        return [targetClass hasIntegerPrimaryKey];
+    }
+    andOperation:^{
+        // Rows with primary key larger than the boundary are only in the target table.
+        WCDB::Expression sourceCondition = [self.sourceClass identifier] > 0;
+        if (self.needFilter) {
+            sourceCondition = sourceCondition && [self.sourceClass classification] == MigrationClassificationB;
+        }
+        WCTValue* maxValue = [self.sourceTable getValueOnResultColumn:[self.sourceClass identifier].max() where:sourceCondition];
+        TestCaseAssertTrue(maxValue != nil);
+        int boundary = maxValue.numberValue.intValue;
+
+        NSMutableDictionary<NSNumber*, NSObject<MigrationTestObject>*>* expectedObjects = [NSMutableDictionary dictionary];
+        for (NSObject<MigrationTestObject>* object in self.filterObjects) {
+            expectedObjects[@(object.identifier)] = object;
+        }
+
+        // Below, at and above the boundary
+        for (int identifier = boundary - 1; identifier <= boundary + 1; identifier++) {
+            NSObject<MigrationTestObject>* object = [self.table getObjectWhere:[self.targetClass identifier] == identifier];
+            NSObject<MigrationTestObject>* expectedObject = expectedObjects[@(identifier)];
+            if (expectedObject != nil) {
+                TestCaseAssertTrue([object isEqual:expectedObject]);
+            } else {
+                TestCaseAssertTrue(object == nil);
+            }
+        }
+        NSArray* expectedRange = [self.filterObjects filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(NSObject<MigrationTestObject>* object, NSDictionary<NSString*, id>*) {
+                                                         return object.identifier >= boundary;
+                                                     }]];
+        NSArray* range = [self.table getObjectsWhere:[self.targetClass identifier] >= boundary
+                                              orders:[self.targetClass identifier].asOrder(WCTOrderedAscending)];
+        TestCaseAssertTrue([range isEqualToArray:expectedRange]);
+
+        // The row left in source table is moved above the boundary by updating its primary key.
+        NSObject<MigrationTestObject>* boundaryObject = expectedObjects[@(boundary)];
+        TestCaseAssertTrue(boundaryObject != nil);
+        NSObject<MigrationTestObject>* movedObject = [[(Class) self.targetClass alloc] init];
+        movedObject.identifier = self.objects.lastObject.identifier + 1;
+        movedObject.content = boundaryObject.content;
+        TestCaseAssertTrue([self.table updateProperty:[self.targetClass identifier]
+                                              toValue:@(movedObject.identifier)
+                                                where:[self.targetClass identifier] == boundary]);
+        TestCaseAssertTrue([self.table getObjectWhere:[self.targetClass identifier] == boundary] == nil);
+        TestCaseAssertTrue([[self.table getObjectWhere:[self.targetClass identifier] == movedObject.identifier] isEqual:movedObject]);
+    }];
+}
+
 - (void)test_drop_table
 {
     TestCaseLog(@"Start test drop table");
@@ -0,0 +1,245 @@
+//
+// Created by agent on 2026/10/18.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "StatementEncoding.hpp"
+#import "WINQAssertion.h"
+
+@interface StatementEncodingTests : BaseTestCase
+
+@end
+
+@implementation StatementEncodingTests {
+    WCDB::Column column1;
+    WCDB::Column column2;
+    WCDB::Schema schema;
+    WCDB::StatementSelect select;
+    WCDB::StatementInsert insert;
+    WCDB::StatementUpdate update;
+    WCDB::StatementDelete delete_;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    column1 = WCDB::Column("testColumn1");
+    column2 = WCDB::Column("testColumn2");
+    schema = @"testSchema";
+    select = WCDB::StatementSelect().select(1);
+    insert = WCDB::StatementInsert().insertIntoTable("testTable").values(WCDB::BindParameter::bindParameters(2));
+    update = WCDB::StatementUpdate().update("testTable").set(column1).to(1);
+    delete_ = WCDB::StatementDelete().deleteFrom("testTable").where(column1.isNull());
+}
+
+- (void)doTestRoundTrip:(const WCDB::Statement&)statement
+{
+    WCDB::Data encoded = WCDB::StatementEncoding::encode(statement);
+    TestCaseAssertFalse(encoded.empty());
+    WCDB::Optional<WCDB::Statement> decoded = WCDB::StatementEncoding::decode(encoded);
+    TestCaseAssertTrue(decoded.hasValue());
+    TestCaseAssertEqual(decoded.value().getType(), statement.getType());
+    TestCaseAssertSQLEqual(decoded.value(), @(statement.getDescription().data()));
+
+    // Any truncated data should be rejected.
+    for (size_t size = 0; size < encoded.size(); ++size) {
+        TestCaseAssertFalse(WCDB::StatementEncoding::decode(WCDB::UnsafeData::immutable(encoded.buffer(), size)).hasValue());
+    }
+}
+
+- (void)test_alter_table
+{
+    [self doTestRoundTrip:WCDB::StatementAlterTable().alterTable("testTable").schema(schema).renameToTable("testNewTable")];
+    [self doTestRoundTrip:WCDB::StatementAlterTable().alterTable("testTable").renameColumn(column1).toColumn(column2)];
+    [self doTestRoundTrip:WCDB::StatementAlterTable().alterTable("testTable").addColumn(WCDB::ColumnDef(column1, WCDB::ColumnType::Text).constraint(WCDB::ColumnConstraint().notNull()))];
+}
+
+- (void)test_analyze
+{
+    [self doTestRoundTrip:WCDB::StatementAnalyze().analyze()];
+    [self doTestRoundTrip:WCDB::StatementAnalyze().analyze().schema(schema).index("testIndex")];
+}
+
+- (void)test_attach
+{
+    [self doTestRoundTrip:WCDB::StatementAttach().attach("testPath").as(schema).key("testKey")];
+}
+
+- (void)test_begin
+{
+    [self doTestRoundTrip:WCDB::StatementBegin().beginImmediate()];
+}
+
+- (void)test_commit
+{
+    [self doTestRoundTrip:WCDB::StatementCommit().commit()];
+}
+
+- (void)test_create_index
+{
+    [self doTestRoundTrip:WCDB::StatementCreateIndex().createIndex("testIndex").schema(schema).unique().ifNotExists().table("testTable").indexed(WCDB::IndexedColumn(column1).collate("NOCASE").order(WCDB::Order::DESC)).indexed(column2.length()).where(column1 > 1)];
+}
+
+- (void)test_create_table
+{
+    [self doTestRoundTrip:WCDB::StatementCreateTable().createTable("testTable").schema(schema).temp().ifNotExists().define(WCDB::ColumnDef(column1, WCDB::ColumnType::Integer).constraint(WCDB::ColumnConstraint("pk").primaryKey().order(WCDB::Order::ASC).conflict(WCDB::Conflict::Replace).autoIncrement())).define(WCDB::ColumnDef(column2, WCDB::ColumnType::Text).constraint(WCDB::ColumnConstraint().default_("default")).constraint(WCDB::ColumnConstraint().collate("BINARY")).constraint(WCDB::ColumnConstraint().check(column2.notNull())).constraint(WCDB::ColumnConstraint().foreignKey(WCDB::ForeignKey().references("testForeignTable").column(column1).onDeleteCascade().onUpdateSetNull().match(WCDB::MatchType::Simple).deferrableInitiallyDeferred()))).constraint(WCDB::TableConstraint("unique").unique().indexed(column1).indexed(column2).conflict(WCDB::Conflict::Ignore)).constraint(WCDB::TableConstraint().foreignKey({ column1, column2 }, WCDB::ForeignKey().references("testForeignTable"))).withoutRowID()];
+    [self doTestRoundTrip:WCDB::StatementCreateTable().createTable("testTable").as(select)];
+}
+
+- (void)test_create_trigger
+{
+    [self doTestRoundTrip:WCDB::StatementCreateTrigger().createTrigger("testTrigger").schema(schema).temp().ifNotExists().before().update().column(column1).column(column2).on("testTable").forEachRow().when(column1 > 1).execute(insert).execute(update).execute(delete_).execute(select)];
+}
+
+- (void)test_create_view
+{
+    [self doTestRoundTrip:WCDB::StatementCreateView().createView("testView").schema(schema).temp().ifNotExists().columns({ column1, column2 }).as(select)];
+}
+
+- (void)test_create_virtual_table
+{
+    [self doTestRoundTrip:WCDB::StatementCreateVirtualTable().createVirtualTable("testTable").schema(schema).ifNotExists().usingModule("fts5").argument("testColumn1").argument("tokenize = 'unicode61'")];
+}
+
+- (void)test_delete
+{
+    [self doTestRoundTrip:WCDB::StatementDelete().with(WCDB::CommonTableExpression("testCTE").column(column1).as(select)).recursive().deleteFrom(WCDB::QualifiedTable("testTable").schema(schema).as("testAlias").indexed("testIndex")).where(column1.in(WCDB::StatementSelect().select(column1).from("testCTE"))).orders({ WCDB::OrderingTerm(column1).order(WCDB::Order::DESC) }).limit(1).offset(2)];
+}
+
+- (void)test_detach
+{
+    [self doTestRoundTrip:WCDB::StatementDetach().detach(schema)];
+}
+
+- (void)test_drop_index
+{
+    [self doTestRoundTrip:WCDB::StatementDropIndex().dropIndex("testIndex").schema(schema).ifExists()];
+}
+
+- (void)test_drop_table
+{
+    [self doTestRoundTrip:WCDB::StatementDropTable().dropTable("testTable").schema(schema).ifExists()];
+}
+
+- (void)test_drop_trigger
+{
+    [self doTestRoundTrip:WCDB::StatementDropTrigger().dropTrigger("testTrigger").schema(schema).ifExists()];
+}
+
+- (void)test_drop_view
+{
+    [self doTestRoundTrip:WCDB::StatementDropView().dropView("testView").schema(schema).ifExists()];
+}
+
+- (void)test_explain
+{
+    [self doTestRoundTrip:WCDB::StatementExplain().explainQueryPlan(WCDB::StatementSelect().select(column1).from("testTable").where(column1 == 1))];
+    [self doTestRoundTrip:WCDB::StatementExplain().explain(update)];
+}
+
+- (void)test_insert
+{
+    [self doTestRoundTrip:WCDB::StatementInsert().with(WCDB::CommonTableExpression("testCTE").as(select)).insertIntoTable("testTable").schema(schema).orReplace().as("testAlias").columns({ column1, column2 }).values({ 1, "testText" }).values({ 2.5, WCDB::BindParameter::colon("name") }).upsert(WCDB::Upsert().onConflict().indexed(column1).where(column1 > 0).doUpdate().set(column2).to(WCDB::Expression::function("excluded.testColumn2").invoke()).where(column2.notNull()))];
+    [self doTestRoundTrip:WCDB::StatementInsert().insertIntoTable("testTable").values(select).upsert(WCDB::Upsert().onConflict().doNothing())];
+    [self doTestRoundTrip:WCDB::StatementInsert().insertIntoTable("testTable").orIgnore().defaultValues()];
+}
+
+- (void)test_pragma
+{
+    [self doTestRoundTrip:WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion()).schema(schema).to(123)];
+    [self doTestRoundTrip:WCDB::StatementPragma().pragma(WCDB::Pragma::tableInfo()).with("testTable")];
+}
+
+- (void)test_reindex
+{
+    [self doTestRoundTrip:WCDB::StatementReindex().reindex().collation("testCollation")];
+    [self doTestRoundTrip:WCDB::StatementReindex().reindex().table("testTable").schema(schema)];
+}
+
+- (void)test_release
+{
+    [self doTestRoundTrip:WCDB::StatementRelease().release("testSavepoint")];
+}
+
+- (void)test_rollback
+{
+    [self doTestRoundTrip:WCDB::StatementRollback().rollbackToSavepoint("testSavepoint")];
+}
+
+- (void)test_savepoint
+{
+    [self doTestRoundTrip:WCDB::StatementSavepoint().savepoint("testSavepoint")];
+}
+
+- (void)test_select
+{
+    [self doTestRoundTrip:WCDB::StatementSelect().with(WCDB::CommonTableExpression("testCTE").column(column1).as(select)).recursive().select({ column1.as("testAlias"), WCDB::Column::all(), WCDB::Column("testColumn3").table("testTable").schema(schema), WCDB::Expression(WCDB::BindParameter(3)), WCDB::Expression(WCDB::BindParameter::at("at")), WCDB::Expression(WCDB::BindParameter::dollar("dollar")), WCDB::Expression(WCDB::LiteralValue(nullptr)), WCDB::Expression(WCDB::LiteralValue(true)), WCDB::Expression(WCDB::LiteralValue((int64_t) -9223372036854775807LL)), WCDB::Expression(WCDB::LiteralValue((uint64_t) 18446744073709551615ULL)), WCDB::Expression(WCDB::LiteralValue(0.1)), WCDB::Expression(WCDB::LiteralValue("it's")), WCDB::Expression(WCDB::LiteralValue::currentTimestamp()) }).distinct().from({ WCDB::TableOrSubquery("testTable").schema(schema).as("t1").notIndexed(), WCDB::TableOrSubquery::function("testFunction").argument(1).as("t2"), WCDB::TableOrSubquery(select).as("t3") }).where((column1.isNull() && column2.notLike("a%").escape("\\")) || !column1.between(1, 2) || column1.glob("*") || ~column1 < column2 || column1.in({ 1, 2, 3 }) || column1.notInTable("testTable") || column1.inFunction("testFunction") || column1.in() || column2.collate("NOCASE").is(nullptr) || column2.isNot(1) || WCDB::Expression::exists(select) || WCDB::Expression::notExists(select) || (column1 << 1 | column2 >> 2 & 3) % 4 != column1 * 2 / 3 - 1 + column2.concat("s") || column1.match("m") || column1.regexp("r")).groups({ column1, column2 }).having(column1.count().distinct() > 1).window("testWindow").as(WCDB::WindowDef().partition({ column1 }).order({ column2 }).framespec(WCDB::FrameSpec().rows().betweenPreceding(1).andFollowing(2))).union_().select({ WCDB::Expression::case_(column1).when(1).then("one").when(2).then("two").else_("other"), WCDB::Expression::case_().when(column1 > 0).then(1), WCDB::Expression::cast(column1).as(WCDB::ColumnType::Float), WCDB::Expression(WCDB::RaiseFunction().abort("message")), WCDB::Expression(select), WCDB::Expression::windowFunction("sum").invoke().argument(column1).filter(column1 > 0).over("testWindow"), WCDB::Expression::windowFunction("rank").invoke().over(WCDB::WindowDef().order({ column1 }).framespec(WCDB::FrameSpec().range().unboundedPreceding())), WCDB::Expression::function("count").invokeAll(), WCDB::Expression::function("testFunction").schema(schema).invoke().arguments({ column1, column2 }) }).from(WCDB::Join().table("testTable1").leftOuterJoin("testTable2").on(column1 == column2).naturalJoin("testTable3").crossJoin("testTable4").usingColumn(column1)).unionAll().values({ 1, 2 }).values({ 3, 4 }).orders({ WCDB::OrderingTerm(column1).collate("NOCASE").order(WCDB::Order::ASC), column2 }).limit(1, 2)];
+    [self doTestRoundTrip:WCDB::StatementSelect().select(column1).from(WCDB::TableOrSubquery(WCDB::TablesOrSubqueries({ "testTable1", "testTable2" }))).intersect().select(column1).from("testTable3").except().select(column1).from(WCDB::TableOrSubquery(WCDB::Join().table("a").join("b").on(column1.notNull()))).limit(1).offset(2)];
+}
+
+- (void)test_update
+{
+    [self doTestRoundTrip:WCDB::StatementUpdate().with(WCDB::CommonTableExpression("testCTE").as(select)).update(WCDB::QualifiedTable("testTable").schema(schema).notIndexed()).orRollback().set({ column1, column2 }).to(WCDB::Expression(WCDB::Expressions({ 1, 2 }))).set(column2).to(column2 + 1).where(column1 > 1).orders({ column1 }).limit(1, 2)];
+}
+
+- (void)test_vacuum
+{
+    [self doTestRoundTrip:WCDB::StatementVacuum().vacuum(schema)];
+    [self doTestRoundTrip:WCDB::StatementVacuum().vacuum()];
+}
+
+- (void)test_intern_identifiers
+{
+    NSString* longName = [@"" stringByPaddingToLength:100 withString:@"testColumn" startingAtIndex:0];
+    WCDB::Column column(longName);
+    WCDB::Data once = WCDB::StatementEncoding::encode(WCDB::StatementSelect().select(column).from("testTable"));
+    WCDB::Data twice = WCDB::StatementEncoding::encode(WCDB::StatementSelect().select(column).from("testTable").where(column.notNull()));
+    TestCaseAssertTrue(twice.size() < once.size() + longName.length);
+    [self doTestRoundTrip:WCDB::StatementSelect().select(column).from("testTable").where(column.notNull())];
+}
+
+- (void)test_malformed
+{
+    WCDB::Data encoded = WCDB::StatementEncoding::encode(update);
+    TestCaseAssertTrue(WCDB::StatementEncoding::decode(encoded).hasValue());
+
+    // Unknown version
+    WCDB::Data data(encoded.buffer(), encoded.size());
+    data.buffer()[0] = WCDB::StatementEncoding::version + 1;
+    TestCaseAssertFalse(WCDB::StatementEncoding::decode(data).hasValue());
+
+    // Not a statement
+    data = WCDB::Data(encoded.buffer(), encoded.size());
+    data.buffer()[1] = (unsigned char) WCDB::Syntax::Identifier::Type::Column;
+    TestCaseAssertFalse(WCDB::StatementEncoding::decode(data).hasValue());
+
+    // Trailing bytes
+    data = WCDB::Data(encoded.size() + 1);
+    memcpy(data.buffer(), encoded.buffer(), encoded.size());
+    TestCaseAssertFalse(WCDB::StatementEncoding::decode(data).hasValue());
+
+    // Statement that can't be encoded
+    TestCaseAssertTrue(WCDB::StatementEncoding::encode(WCDB::Statement(std::make_shared<WCDB::Syntax::Column>())).empty());
+}
+
+@end